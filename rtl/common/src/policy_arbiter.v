@@ -0,0 +1,209 @@
+/** @module : policy_arbiter
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Arbiter with configurable policies for shared buses. The grant and
+ *    valid outputs behave like those of arbiter.v.
+ *  - POLICY selects how the winner is picked from the eligible requests.
+ *    "PACKET", "CYCLE" and "TOP_ROT" use arbiter.v with that ARB_TYPE.
+ *    "AGE" grants the request that has waited the most cycles since its
+ *    port was last granted, with the lowest port winning ties.
+ *  - BANDWIDTH_WINDOW > 0 enables per-port bandwidth caps. A port that was
+ *    granted BANDWIDTH_CAPS[port] times in the current window of
+ *    BANDWIDTH_WINDOW cycles only wins when no uncapped port requests. A cap
+ *    of 0 leaves the port uncapped. BANDWIDTH_CAPS holds one 32 bit entry per
+ *    port, port 0 in the lowest bits.
+ *  - REPEAT_HOLDOFF > 0 holds back repeat requesters of lines that ping-pong.
+ *    After a grant for tag T, other ports that held T before and request T
+ *    again are not eligible for REPEAT_HOLDOFF idle cycles, cycles in which
+ *    no port is served. This gives the new owner of a contended line time to
+ *    use it. The hold off is bounded, so
+ *    requests do not starve.
+ *  - accept marks the cycle in which the user starts serving the granted
+ *    request. served marks ports with a transaction in progress, which do not
+ *    age or count wait cycles.
+ *  - grant_count and wait_cycles count, per port, the accepted grants and the
+ *    cycles spent requesting without being served.
+ */
+
+module policy_arbiter #(
+  parameter WIDTH            = 4,
+  parameter POLICY           = "PACKET",
+  parameter TAG_BITS         = 32,
+  parameter AGE_BITS         = 8,
+  parameter BANDWIDTH_WINDOW = 0,
+  parameter BANDWIDTH_CAPS   = {WIDTH{32'd0}},
+  parameter REPEAT_HOLDOFF   = 0,
+  parameter COUNTER_BITS     = 32
+) (
+  input clock,
+  input reset,
+  input [WIDTH-1:0] requests,
+  input [WIDTH*TAG_BITS-1:0] request_tags,
+  input [WIDTH-1:0] served,
+  input accept,
+  output [log2(WIDTH)-1:0] grant,
+  output valid,
+  output [WIDTH*COUNTER_BITS-1:0] grant_count,
+  output [WIDTH*COUNTER_BITS-1:0] wait_cycles
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+localparam GRANT_BITS   = log2(WIDTH);
+localparam WINDOW_BITS  = BANDWIDTH_WINDOW > 1 ? log2(BANDWIDTH_WINDOW) : 1;
+localparam HOLDOFF_BITS = REPEAT_HOLDOFF > 0 ? log2(REPEAT_HOLDOFF+1) : 1;
+localparam BASE_TYPE    = (POLICY == "AGE") ? "PACKET" : POLICY;
+
+genvar i;
+integer j;
+
+reg [AGE_BITS-1:0]     age           [WIDTH-1:0];
+reg [31:0]             window_grants [WIDTH-1:0];
+reg [TAG_BITS-1:0]     port_tag      [WIDTH-1:0];
+reg [WIDTH-1:0]        port_tag_valid;
+reg [COUNTER_BITS-1:0] grants        [WIDTH-1:0];
+reg [COUNTER_BITS-1:0] waits         [WIDTH-1:0];
+
+reg [WINDOW_BITS-1:0]  window_count;
+reg [TAG_BITS-1:0]     last_tag;
+reg [GRANT_BITS-1:0]   last_owner;
+reg [HOLDOFF_BITS-1:0] holdoff;
+
+reg [GRANT_BITS-1:0]   oldest;
+reg                    oldest_found;
+
+wire [WIDTH-1:0] capped;
+wire [WIDTH-1:0] held_off;
+wire [WIDTH-1:0] eligible;
+wire [WIDTH-1:0] candidates;
+wire [WIDTH-1:0] granted;
+wire [GRANT_BITS-1:0] base_grant;
+wire base_valid;
+wire window_end;
+
+generate
+  for(i=0; i<WIDTH; i=i+1) begin : PORTS
+    assign capped[i] = (BANDWIDTH_WINDOW != 0) & (BANDWIDTH_CAPS[i*32 +: 32] != 0) &
+                       (window_grants[i] >= BANDWIDTH_CAPS[i*32 +: 32]);
+
+    assign held_off[i] = (REPEAT_HOLDOFF != 0) & (holdoff != 0) & (last_owner != i) &
+                         port_tag_valid[i] & (port_tag[i] == last_tag) &
+                         (request_tags[i*TAG_BITS +: TAG_BITS] == last_tag);
+
+    assign granted[i] = accept & valid & (grant == i);
+
+    assign grant_count[i*COUNTER_BITS +: COUNTER_BITS] = grants[i];
+    assign wait_cycles[i*COUNTER_BITS +: COUNTER_BITS] = waits[i];
+  end
+endgenerate
+
+// Held off requests wait for the hold off to end. Capped requests only wait
+// while an uncapped request is eligible.
+assign eligible   = requests & ~held_off;
+assign candidates = |(eligible & ~capped) ? eligible & ~capped : eligible;
+
+arbiter #(
+  .WIDTH(WIDTH),
+  .ARB_TYPE(BASE_TYPE)
+) base_arbiter (
+  .clock(clock),
+  .reset(reset),
+  .requests(candidates),
+  .grant(base_grant),
+  .valid(base_valid)
+);
+
+// Oldest candidate, lowest port on ties
+always @(*) begin
+  oldest       = {GRANT_BITS{1'b0}};
+  oldest_found = 1'b0;
+  for(j=0; j<WIDTH; j=j+1) begin
+    if(candidates[j] & (~oldest_found | (age[j] > age[oldest]))) begin
+      oldest       = j;
+      oldest_found = 1'b1;
+    end
+  end
+end
+
+assign grant = (POLICY == "AGE") ? oldest : base_grant;
+assign valid = |candidates;
+
+assign window_end = (BANDWIDTH_WINDOW != 0) & (window_count == BANDWIDTH_WINDOW-1);
+
+always @(posedge clock) begin
+  if(reset) begin
+    window_count   <= {WINDOW_BITS{1'b0}};
+    last_tag       <= {TAG_BITS{1'b0}};
+    last_owner     <= {GRANT_BITS{1'b0}};
+    holdoff        <= {HOLDOFF_BITS{1'b0}};
+    port_tag_valid <= {WIDTH{1'b0}};
+    for(j=0; j<WIDTH; j=j+1) begin
+      age[j]           <= {AGE_BITS{1'b0}};
+      window_grants[j] <= 32'd0;
+      port_tag[j]      <= {TAG_BITS{1'b0}};
+      grants[j]        <= {COUNTER_BITS{1'b0}};
+      waits[j]         <= {COUNTER_BITS{1'b0}};
+    end
+  end
+  else begin
+    window_count <= window_end ? {WINDOW_BITS{1'b0}} : window_count + 1;
+
+    if(accept & valid) begin
+      last_tag   <= request_tags[grant*TAG_BITS +: TAG_BITS];
+      last_owner <= grant;
+      holdoff    <= REPEAT_HOLDOFF;
+    end
+    else if((holdoff != 0) & ~|served) begin
+      holdoff <= holdoff - 1;
+    end
+
+    for(j=0; j<WIDTH; j=j+1) begin
+      if(granted[j]) begin
+        age[j]            <= {AGE_BITS{1'b0}};
+        grants[j]         <= grants[j] + 1;
+        port_tag[j]       <= request_tags[j*TAG_BITS +: TAG_BITS];
+        port_tag_valid[j] <= 1'b1;
+      end
+      else if(requests[j] & ~served[j]) begin
+        if(~&age[j])
+          age[j] <= age[j] + 1;
+        waits[j] <= waits[j] + 1;
+      end
+
+      window_grants[j] <= window_end ? {31'd0, granted[j]} :
+                          granted[j] ? window_grants[j] + 1 :
+                          window_grants[j];
+    end
+  end
+end
+
+endmodule
@@ -0,0 +1,174 @@
+/** @module : tb_policy_arbiter
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_policy_arbiter();
+
+task print_state;
+  begin
+    $display("Requests       :%b", requests);
+    $display("Served         :%b", served);
+    $display("Granted access :%0d", grant);
+    $display("Valid          :%0d", valid);
+  end
+endtask
+
+task check_grant;
+  input [log2(WIDTH)-1:0] expected_grant;
+  input expected_valid;
+  begin
+    if((expected_valid & (grant != expected_grant)) | (valid != expected_valid))begin
+      $display("\ntb_policy_arbiter --> Test Failed!\n\n");
+      print_state();
+      $stop;
+    end
+  end
+endtask
+
+parameter WIDTH            = 4;
+parameter POLICY           = "AGE";
+parameter BANDWIDTH_WINDOW = 32;
+parameter BANDWIDTH_CAPS   = {32'd0, 32'd0, 32'd0, 32'd1};
+parameter REPEAT_HOLDOFF   = 2;
+
+//Define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+reg clock;
+reg reset;
+reg [WIDTH-1 : 0] requests;
+reg [WIDTH*32-1 : 0] request_tags;
+reg [WIDTH-1 : 0] served;
+reg accept;
+wire [log2(WIDTH)-1 : 0] grant;
+wire valid;
+wire [WIDTH*32-1 : 0] grant_count;
+wire [WIDTH*32-1 : 0] wait_cycles;
+
+// instantiate DUT
+policy_arbiter #(
+  .WIDTH(WIDTH),
+  .POLICY(POLICY),
+  .TAG_BITS(32),
+  .BANDWIDTH_WINDOW(BANDWIDTH_WINDOW),
+  .BANDWIDTH_CAPS(BANDWIDTH_CAPS),
+  .REPEAT_HOLDOFF(REPEAT_HOLDOFF)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .requests(requests),
+  .request_tags(request_tags),
+  .served(served),
+  .accept(accept),
+  .grant(grant),
+  .valid(valid),
+  .grant_count(grant_count),
+  .wait_cycles(wait_cycles)
+);
+
+// generate clock
+always #5 clock <= ~clock;
+
+initial begin
+
+  clock    <= 1;
+  reset    <= 1;
+  requests <= 4'b0000;
+  served   <= 4'b0000;
+  accept   <= 1'b0;
+  // Ports 1 and 2 contend for the same line
+  request_tags <= {32'h30, 32'hA0, 32'hA0, 32'h00};
+  #45;
+  reset    <= 0;
+  requests <= 4'b0110;
+  #20;
+  // Ports 1 and 2 waited 2 cycles, port 3 is new. Lowest port wins the tie.
+  requests <= 4'b1110;
+  #1;
+  check_grant(1, 1);
+  accept <= 1'b1;
+  #5;
+  // Port 1 is served, port 2 is now the oldest request
+  accept <= 1'b0;
+  served <= 4'b0010;
+  #1;
+  check_grant(2, 1);
+  if(grant_count[1*32 +: 32] != 1 || wait_cycles[1*32 +: 32] != 2 ||
+     wait_cycles[2*32 +: 32] != 3)begin
+    $display("\ntb_policy_arbiter --> Test Failed!\n\n");
+    $display("Grant count port 1 :%0d", grant_count[1*32 +: 32]);
+    $display("Wait cycles port 1 :%0d", wait_cycles[1*32 +: 32]);
+    $display("Wait cycles port 2 :%0d", wait_cycles[2*32 +: 32]);
+    $stop;
+  end
+  #9;
+  served   <= 4'b0000;
+  requests <= 4'b1100;
+  #1;
+  check_grant(2, 1);
+  accept <= 1'b1;
+  #9;
+  // Port 1 asks for the line port 2 just took and is held off for 2 cycles
+  accept   <= 1'b0;
+  requests <= 4'b0010;
+  #1;
+  check_grant(0, 0);
+  #10;
+  check_grant(0, 0);
+  #10;
+  check_grant(1, 1);
+  // Port 0 reaches its cap of 1 grant per window
+  requests <= 4'b0001;
+  #1;
+  check_grant(0, 1);
+  accept <= 1'b1;
+  #9;
+  requests <= 4'b0011;
+  #1;
+  check_grant(1, 1);
+  #9;
+  // Port 0 is older but capped
+  accept <= 1'b0;
+  #1;
+  check_grant(1, 1);
+  // Capped requests are granted when no other port requests
+  requests <= 4'b0001;
+  #1;
+  check_grant(0, 1);
+  if(grant_count[0*32 +: 32] != 1 || grant_count[1*32 +: 32] != 2)begin
+    $display("\ntb_policy_arbiter --> Test Failed!\n\n");
+    $display("Grant count port 0 :%0d", grant_count[0*32 +: 32]);
+    $display("Grant count port 1 :%0d", grant_count[1*32 +: 32]);
+    $stop;
+  end
+
+$display("\ntb_policy_arbiter --> Test Passed!\n\n");
+$stop;
+end
+
+endmodule
@@ -41,6 +41,48 @@ endfunction
 
 localparam LOG2_DATA_WIDTH = log2(DATA_WIDTH);
 
+// Zbb counts. The functions only read their argument so they can be used in
+// continuous assignments.
+function [LOG2_DATA_WIDTH:0] count_leading_zeros;
+input [DATA_WIDTH-1:0] value;
+integer i;
+reg found;
+begin
+  count_leading_zeros = 0;
+  found = 1'b0;
+  for(i=DATA_WIDTH-1; i>=0; i=i-1) begin
+    found = found | value[i];
+    if(~found)
+      count_leading_zeros = count_leading_zeros + 1;
+  end
+end
+endfunction
+
+function [LOG2_DATA_WIDTH:0] count_trailing_zeros;
+input [DATA_WIDTH-1:0] value;
+integer i;
+reg found;
+begin
+  count_trailing_zeros = 0;
+  found = 1'b0;
+  for(i=0; i<DATA_WIDTH; i=i+1) begin
+    found = found | value[i];
+    if(~found)
+      count_trailing_zeros = count_trailing_zeros + 1;
+  end
+end
+endfunction
+
+function [LOG2_DATA_WIDTH:0] count_ones;
+input [DATA_WIDTH-1:0] value;
+integer i;
+begin
+  count_ones = 0;
+  for(i=0; i<DATA_WIDTH; i=i+1)
+    count_ones = count_ones + value[i];
+end
+endfunction
+
 wire [LOG2_DATA_WIDTH:0] shamt;
 
 wire signed [DATA_WIDTH-1:0] signed_operand_A;
@@ -67,6 +109,18 @@ wire [DATA_WIDTH-1:0] word_arithmetic_shift_SE;
 wire [31:0] word_diff;
 wire [DATA_WIDTH-1:0] word_sub;
 
+// wires for the Zba and Zbb extensions
+wire [LOG2_DATA_WIDTH-1:0] rotate_amount;
+wire [(DATA_WIDTH*2)-1:0] rotate_left_double;
+wire [(DATA_WIDTH*2)-1:0] rotate_right_double;
+wire [DATA_WIDTH-1:0] unary_result;
+wire [DATA_WIDTH-1:0] byte_reverse;
+wire [DATA_WIDTH-1:0] byte_or_combine;
+wire [DATA_WIDTH-1:0] unsigned_word_A;
+wire [63:0] word_rotate_left_double;
+wire [63:0] word_rotate_right_double;
+wire [DATA_WIDTH-1:0] word_unary_result;
+
 assign shamt = operand_B [LOG2_DATA_WIDTH:0]; // I_immediate[5:0];
 
 assign signed_operand_A = operand_A;
@@ -100,6 +154,38 @@ assign word_arithmetic_shift_SE = { {DATA_WIDTH-32{word_arithmetic_shift[31]}},
 assign word_diff = word_operand_A - word_operand_B;
 assign word_sub = {{DATA_WIDTH-32{word_diff[31]}}, word_diff};
 
+// Zba/Zbb
+assign rotate_amount       = operand_B[LOG2_DATA_WIDTH-1:0];
+assign rotate_left_double  = {operand_A, operand_A} << rotate_amount;
+assign rotate_right_double = {operand_A, operand_A} >> rotate_amount;
+
+// CLZ, CTZ, CPOP, SEXT.B and SEXT.H share an opcode and funct7. The rs2 field
+// in the immediate selects the operation.
+assign unary_result =
+  (operand_B[2:0] == 3'd0) ? count_leading_zeros(operand_A)  :
+  (operand_B[2:0] == 3'd1) ? count_trailing_zeros(operand_A) :
+  (operand_B[2:0] == 3'd2) ? count_ones(operand_A)           :
+  (operand_B[2:0] == 3'd4) ? {{DATA_WIDTH-8{operand_A[7]}}, operand_A[7:0]} :
+                             {{DATA_WIDTH-16{operand_A[15]}}, operand_A[15:0]};
+
+genvar byte_index;
+generate
+  for(byte_index=0; byte_index<DATA_WIDTH/8; byte_index=byte_index+1) begin : BYTE_OPS
+    assign byte_reverse[8*byte_index +: 8]    = operand_A[DATA_WIDTH-8-8*byte_index +: 8];
+    assign byte_or_combine[8*byte_index +: 8] = {8{|operand_A[8*byte_index +: 8]}};
+  end
+endgenerate
+
+// RV64 Zba/Zbb word operations. Padding the word with ones or zeros makes the
+// full width counts return the word counts.
+assign unsigned_word_A          = {{DATA_WIDTH-32{1'b0}}, word_operand_A};
+assign word_rotate_left_double  = {word_operand_A, word_operand_A} << operand_B[4:0];
+assign word_rotate_right_double = {word_operand_A, word_operand_A} >> operand_B[4:0];
+assign word_unary_result =
+  (operand_B[1:0] == 2'd0) ? count_leading_zeros({word_operand_A, {DATA_WIDTH-32{1'b1}}})  :
+  (operand_B[1:0] == 2'd1) ? count_trailing_zeros({{DATA_WIDTH-32{1'b1}}, word_operand_A}) :
+                             count_ones(unsigned_word_A);
+
 
 assign ALU_result =
   (ALU_operation == 6'd0 )? operand_A + operand_B:     /* ADD, ADDI, LB, LH, LW,
@@ -124,6 +210,34 @@ assign ALU_result =
   (ALU_operation == 6'd17)? word_right_shift_SE:       /* SRLW, SRLIW */
   (ALU_operation == 6'd18)? word_arithmetic_shift_SE:  /* SRAW, SRAIW */
   (ALU_operation == 6'd19)? word_sub:                  /* SUBW, SUBIW*/
+  // 20-32 are the M extension, see m_control
+  (ALU_operation == 6'd33)? (operand_A << 1) + operand_B:       /* SH1ADD */
+  (ALU_operation == 6'd34)? (operand_A << 2) + operand_B:       /* SH2ADD */
+  (ALU_operation == 6'd35)? (operand_A << 3) + operand_B:       /* SH3ADD */
+  (ALU_operation == 6'd36)? operand_A & ~operand_B:             /* ANDN */
+  (ALU_operation == 6'd37)? operand_A | ~operand_B:             /* ORN */
+  (ALU_operation == 6'd38)? ~(operand_A ^ operand_B):           /* XNOR */
+  (ALU_operation == 6'd39)? unary_result:                       /* CLZ, CTZ, CPOP,
+                                                                   SEXT.B, SEXT.H */
+  (ALU_operation == 6'd40)? (signed_less_than ? operand_B : operand_A): /* MAX */
+  (ALU_operation == 6'd41)? (operand_A < operand_B ? operand_B : operand_A): /* MAXU */
+  (ALU_operation == 6'd42)? (signed_less_than ? operand_A : operand_B): /* MIN */
+  (ALU_operation == 6'd43)? (operand_A < operand_B ? operand_A : operand_B): /* MINU */
+  (ALU_operation == 6'd44)? {{DATA_WIDTH-16{1'b0}}, operand_A[15:0]}: /* ZEXT.H */
+  (ALU_operation == 6'd45)? rotate_left_double[DATA_WIDTH*2-1:DATA_WIDTH]: /* ROL */
+  (ALU_operation == 6'd46)? rotate_right_double[DATA_WIDTH-1:0]: /* ROR, RORI */
+  (ALU_operation == 6'd47)? byte_reverse:                       /* REV8 */
+  (ALU_operation == 6'd48)? byte_or_combine:                    /* ORC.B */
+  (ALU_operation == 6'd49)? unsigned_word_A + operand_B:        /* ADD.UW */
+  (ALU_operation == 6'd50)? (unsigned_word_A << 1) + operand_B: /* SH1ADD.UW */
+  (ALU_operation == 6'd51)? (unsigned_word_A << 2) + operand_B: /* SH2ADD.UW */
+  (ALU_operation == 6'd52)? (unsigned_word_A << 3) + operand_B: /* SH3ADD.UW */
+  (ALU_operation == 6'd53)? unsigned_word_A << rotate_amount:   /* SLLI.UW */
+  (ALU_operation == 6'd54)? word_unary_result:                  /* CLZW, CTZW, CPOPW */
+  (ALU_operation == 6'd55)? {{DATA_WIDTH-32{word_rotate_left_double[63]}},
+                             word_rotate_left_double[63:32]}:   /* ROLW */
+  (ALU_operation == 6'd56)? {{DATA_WIDTH-32{word_rotate_right_double[31]}},
+                             word_rotate_right_double[31:0]}:   /* RORW, RORIW */
   {DATA_WIDTH{1'b0}};
 
 endmodule
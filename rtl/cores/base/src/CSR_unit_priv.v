@@ -62,6 +62,9 @@ module CSR_unit_priv #(
   output [DATA_WIDTH-1:0] CSR_read_data,
 
   output                    intr_branch,
+  // An enabled interrupt is pending. Ignores the global interrupt enable bits
+  // so WFI also wakes up with interrupts disabled.
+  output                    interrupt_pending,
   output                    trap_branch,
   output [ADDRESS_BITS-1:0] trap_target,
 
@@ -1000,6 +1003,7 @@ assign u_trap = 1'b0;
 // Interrupt signal for control logic input
 assign trap_branch = m_trap | s_trap | u_trap | m_ret | s_ret | u_ret;
 assign intr_branch = m_interrupt | s_interrupt;
+assign interrupt_pending = |(mip_read & mie);
 
 // This is control logic,  but it is easier to put here than output all *tvec
 // and *epc register values
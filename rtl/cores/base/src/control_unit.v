@@ -91,10 +91,13 @@ localparam [6:0]R_TYPE  = 7'b0110011,
                 FENCE   = 7'b0001111,
                 SYSTEM  = 7'b1110011;
 
+// P extension (packed SIMD) opcode
+localparam [6:0]OP_P    = 7'b1110111;
+
 
 assign regWrite      = (opcode_decode == R_TYPE) | (opcode_decode == I_TYPE) | (opcode_decode == LOAD)
                        | (opcode_decode == JALR) | (opcode_decode == JAL)    | (opcode_decode == AUIPC)
-                       | (opcode_decode == LUI);
+                       | (opcode_decode == LUI)  | (opcode_decode == OP_P);
 
 assign memWrite      = (opcode_decode == STORE);
 assign branch_op     = (opcode_decode == BRANCH);
@@ -152,6 +155,27 @@ assign ALU_operation =
   (opcode_decode == R_TYPE & funct3 == 3'b101 & funct7 == 7'b0100000) ? 6'd13 : // SRA: arithmetic right shift
   (opcode_decode == R_TYPE & funct3 == 3'b110 & funct7 == 7'b0000000) ? 6'd9  : // OR: or
   (opcode_decode == R_TYPE & funct3 == 3'b111 & funct7 == 7'b0000000) ? 6'd10 : // AND: and
+  // Zba/Zbb
+  (opcode_decode == R_TYPE & funct3 == 3'b010 & funct7 == 7'b0010000) ? 6'd33 : // SH1ADD
+  (opcode_decode == R_TYPE & funct3 == 3'b100 & funct7 == 7'b0010000) ? 6'd34 : // SH2ADD
+  (opcode_decode == R_TYPE & funct3 == 3'b110 & funct7 == 7'b0010000) ? 6'd35 : // SH3ADD
+  (opcode_decode == R_TYPE & funct3 == 3'b111 & funct7 == 7'b0100000) ? 6'd36 : // ANDN
+  (opcode_decode == R_TYPE & funct3 == 3'b110 & funct7 == 7'b0100000) ? 6'd37 : // ORN
+  (opcode_decode == R_TYPE & funct3 == 3'b100 & funct7 == 7'b0100000) ? 6'd38 : // XNOR
+  (opcode_decode == I_TYPE & funct3 == 3'b001 & funct7 == 7'b0110000) ? 6'd39 : // CLZ, CTZ, CPOP, SEXT.B, SEXT.H
+  (opcode_decode == R_TYPE & funct3 == 3'b110 & funct7 == 7'b0000101) ? 6'd40 : // MAX
+  (opcode_decode == R_TYPE & funct3 == 3'b111 & funct7 == 7'b0000101) ? 6'd41 : // MAXU
+  (opcode_decode == R_TYPE & funct3 == 3'b100 & funct7 == 7'b0000101) ? 6'd42 : // MIN
+  (opcode_decode == R_TYPE & funct3 == 3'b101 & funct7 == 7'b0000101) ? 6'd43 : // MINU
+  (opcode_decode == R_TYPE & funct3 == 3'b100 & funct7 == 7'b0000100) ? 6'd44 : // ZEXT.H
+  (opcode_decode == R_TYPE & funct3 == 3'b001 & funct7 == 7'b0110000) ? 6'd45 : // ROL
+  (opcode_decode == R_TYPE & funct3 == 3'b101 & funct7 == 7'b0110000) ? 6'd46 : // ROR
+  (opcode_decode == I_TYPE & funct3 == 3'b101 & funct7 == 7'b0110000) ? 6'd46 : // RORI
+  (opcode_decode == I_TYPE & funct3 == 3'b101 & funct7 == 7'b0110100) ? 6'd47 : // REV8
+  (opcode_decode == I_TYPE & funct3 == 3'b101 & funct7 == 7'b0010100) ? 6'd48 : // ORC.B
+  // P extension, see packed_simd_unit
+  (opcode_decode == OP_P   & funct3 == 3'b000)                        ? 6'd57 : // 16 and 8 bit lane operations
+  (opcode_decode == OP_P   & funct3 == 3'b001)                        ? 6'd58 : // 32 bit lane operations
   6'd0; // Use addition by default
 
 assign operand_A_sel = (opcode_decode == AUIPC) ?  2'b01 :
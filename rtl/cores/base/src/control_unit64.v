@@ -95,12 +95,17 @@ localparam [6:0]R_TYPE  = 7'b0110011,
 localparam [6:0]IMM_32 = 7'b0011011,
                 OP_32  = 7'b0111011;
 
+// P extension (packed SIMD) opcode
+localparam [6:0]OP_P   = 7'b1110111;
+
 assign regWrite      = (opcode_decode == R_TYPE) | (opcode_decode == I_TYPE) |
                        (opcode_decode == LOAD)   | (opcode_decode == JALR)   |
                        (opcode_decode == JAL)    | (opcode_decode == AUIPC)  |
                        (opcode_decode == LUI)    |
                        // RV64
-                       (opcode_decode == OP_32)  | (opcode_decode == IMM_32);
+                       (opcode_decode == OP_32)  | (opcode_decode == IMM_32) |
+                       // P extension
+                       (opcode_decode == OP_P);
 
 
 assign memWrite      = (opcode_decode == STORE);
@@ -174,6 +179,36 @@ assign ALU_operation =
   (opcode_decode == OP_32  & funct3 == 3'b001 & funct7 == 7'b0000000) ? 6'd16 : // SLLW
   (opcode_decode == OP_32  & funct3 == 3'b101 & funct7 == 7'b0000000) ? 6'd17 : // SRLW
   (opcode_decode == OP_32  & funct3 == 3'b101 & funct7 == 7'b0100000) ? 6'd18 : // SRAW
+  // Zba/Zbb
+  (opcode_decode == R_TYPE & funct3 == 3'b010 & funct7 == 7'b0010000) ? 6'd33 : // SH1ADD
+  (opcode_decode == R_TYPE & funct3 == 3'b100 & funct7 == 7'b0010000) ? 6'd34 : // SH2ADD
+  (opcode_decode == R_TYPE & funct3 == 3'b110 & funct7 == 7'b0010000) ? 6'd35 : // SH3ADD
+  (opcode_decode == R_TYPE & funct3 == 3'b111 & funct7 == 7'b0100000) ? 6'd36 : // ANDN
+  (opcode_decode == R_TYPE & funct3 == 3'b110 & funct7 == 7'b0100000) ? 6'd37 : // ORN
+  (opcode_decode == R_TYPE & funct3 == 3'b100 & funct7 == 7'b0100000) ? 6'd38 : // XNOR
+  (opcode_decode == I_TYPE & funct3 == 3'b001 & funct7 == 7'b0110000) ? 6'd39 : // CLZ, CTZ, CPOP, SEXT.B, SEXT.H
+  (opcode_decode == R_TYPE & funct3 == 3'b110 & funct7 == 7'b0000101) ? 6'd40 : // MAX
+  (opcode_decode == R_TYPE & funct3 == 3'b111 & funct7 == 7'b0000101) ? 6'd41 : // MAXU
+  (opcode_decode == R_TYPE & funct3 == 3'b100 & funct7 == 7'b0000101) ? 6'd42 : // MIN
+  (opcode_decode == R_TYPE & funct3 == 3'b101 & funct7 == 7'b0000101) ? 6'd43 : // MINU
+  (opcode_decode == OP_32  & funct3 == 3'b100 & funct7 == 7'b0000100) ? 6'd44 : // ZEXT.H
+  (opcode_decode == R_TYPE & funct3 == 3'b001 & funct7 == 7'b0110000) ? 6'd45 : // ROL
+  (opcode_decode == R_TYPE & funct3 == 3'b101 & funct7 == 7'b0110000) ? 6'd46 : // ROR
+  (opcode_decode == I_TYPE & funct3 == 3'b101 & funct7[6:1] == 6'b011000) ? 6'd46 : // RORI
+  (opcode_decode == I_TYPE & funct3 == 3'b101 & funct7 == 7'b0110101) ? 6'd47 : // REV8
+  (opcode_decode == I_TYPE & funct3 == 3'b101 & funct7 == 7'b0010100) ? 6'd48 : // ORC.B
+  (opcode_decode == OP_32  & funct3 == 3'b000 & funct7 == 7'b0000100) ? 6'd49 : // ADD.UW
+  (opcode_decode == OP_32  & funct3 == 3'b010 & funct7 == 7'b0010000) ? 6'd50 : // SH1ADD.UW
+  (opcode_decode == OP_32  & funct3 == 3'b100 & funct7 == 7'b0010000) ? 6'd51 : // SH2ADD.UW
+  (opcode_decode == OP_32  & funct3 == 3'b110 & funct7 == 7'b0010000) ? 6'd52 : // SH3ADD.UW
+  (opcode_decode == IMM_32 & funct3 == 3'b001 & funct7[6:1] == 6'b000010) ? 6'd53 : // SLLI.UW
+  (opcode_decode == IMM_32 & funct3 == 3'b001 & funct7 == 7'b0110000) ? 6'd54 : // CLZW, CTZW, CPOPW
+  (opcode_decode == OP_32  & funct3 == 3'b001 & funct7 == 7'b0110000) ? 6'd55 : // ROLW
+  (opcode_decode == OP_32  & funct3 == 3'b101 & funct7 == 7'b0110000) ? 6'd56 : // RORW
+  (opcode_decode == IMM_32 & funct3 == 3'b101 & funct7 == 7'b0110000) ? 6'd56 : // RORIW
+  // P extension, see packed_simd_unit
+  (opcode_decode == OP_P   & funct3 == 3'b000)                        ? 6'd57 : // 16 and 8 bit lane operations
+  (opcode_decode == OP_P   & funct3 == 3'b001)                        ? 6'd58 : // 32 bit lane operations
   6'd0; // Use addition by default
 
 assign operand_A_sel = (opcode_decode == AUIPC) ?  2'b01 :
@@ -0,0 +1,76 @@
+/** @module : dual_write_regFile
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Register file with four read ports and two write ports for the two
+ *    lanes of seven_stage_dual_core.
+ *  - Write port 2 belongs to the younger instruction of a pair and wins when
+ *    both ports write the same register in the same cycle.
+ *  - Register 0 is never written. Reads return the old data during a write,
+ *    like regFile.
+ */
+
+module dual_write_regFile #(
+  parameter REG_DATA_WIDTH = 32,
+  parameter REG_SEL_BITS = 5
+) (
+  input clock,
+  input reset,
+  input wEn1,
+  input [REG_DATA_WIDTH-1:0] write_data1,
+  input [REG_SEL_BITS-1:0] write_sel1,
+  input wEn2,
+  input [REG_DATA_WIDTH-1:0] write_data2,
+  input [REG_SEL_BITS-1:0] write_sel2,
+  input [REG_SEL_BITS-1:0] read_sel1,
+  input [REG_SEL_BITS-1:0] read_sel2,
+  input [REG_SEL_BITS-1:0] read_sel3,
+  input [REG_SEL_BITS-1:0] read_sel4,
+  output[REG_DATA_WIDTH-1:0] read_data1,
+  output[REG_DATA_WIDTH-1:0] read_data2,
+  output[REG_DATA_WIDTH-1:0] read_data3,
+  output[REG_DATA_WIDTH-1:0] read_data4
+);
+
+// Two write ports do not map to distributed RAM, the registers are flip flops
+reg [REG_DATA_WIDTH-1:0] register_file[0:(1<<REG_SEL_BITS)-1];
+
+always @(posedge clock)
+  if(reset==1)
+    register_file[0] <= 0;
+  else begin
+    if (wEn1 & write_sel1 != 0 & ~(wEn2 & write_sel2 == write_sel1))
+      register_file[write_sel1] <= write_data1;
+    if (wEn2 & write_sel2 != 0)
+      register_file[write_sel2] <= write_data2;
+  end
+
+//----------------------------------------------------
+// Drive the outputs
+//----------------------------------------------------
+assign  read_data1 = register_file[read_sel1];
+assign  read_data2 = register_file[read_sel2];
+assign  read_data3 = register_file[read_sel3];
+assign  read_data4 = register_file[read_sel4];
+
+endmodule
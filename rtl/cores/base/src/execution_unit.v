@@ -25,6 +25,7 @@ module execution_unit #(
   parameter CORE            = 0,
   parameter DATA_WIDTH      = 32,
   parameter ADDRESS_BITS    = 32,
+  parameter P_EXTENSION     = 0,
   parameter SCAN_CYCLES_MIN = 0,
   parameter SCAN_CYCLES_MAX = 1000
 ) (
@@ -49,6 +50,7 @@ module execution_unit #(
 
 wire [DATA_WIDTH-1:0]  operand_A;
 wire [DATA_WIDTH-1:0]  operand_B;
+wire [DATA_WIDTH-1:0]  ALU_output;
 
 assign operand_A  =  (operand_A_sel == 2'b01) ? PC       :
                      (operand_A_sel == 2'b10) ? (PC + 4) :
@@ -68,9 +70,32 @@ ALU #(
   .ALU_operation(ALU_operation),
   .operand_A(operand_A),
   .operand_B(operand_B),
-  .ALU_result(ALU_result)
+  .ALU_result(ALU_output)
 );
 
+// P extension subset. ALU_operation 57 and 58 are the OP-P instructions,
+// funct7 and the rs2 field are in the I-type immediate.
+generate
+  if(P_EXTENSION) begin
+    wire [DATA_WIDTH-1:0] packed_result;
+
+    packed_simd_unit #(
+      .DATA_WIDTH(DATA_WIDTH)
+    ) PSU (
+      .ALU_operation(ALU_operation),
+      .funct7(extend[11:5]),
+      .rs2_field(extend[4:0]),
+      .operand_A(operand_A),
+      .operand_B(operand_B),
+      .packed_result(packed_result)
+    );
+    assign ALU_result = (ALU_operation == 6'd57) | (ALU_operation == 6'd58) ? packed_result : ALU_output;
+  end
+  else begin
+    assign ALU_result = ALU_output;
+  end
+endgenerate
+
 reg [31: 0] cycles;
 always @ (posedge clock) begin
   cycles <= reset? 0 : cycles + 1;
@@ -25,6 +25,7 @@ module execution_unit_multi_cycle #(
   parameter DATA_WIDTH      = 32,
   parameter ADDRESS_BITS    = 32,
   parameter M_EXTENSION     = "False",
+  parameter P_EXTENSION     = 0,
   parameter SCAN_CYCLES_MIN = 0,
   parameter SCAN_CYCLES_MAX = 1000
 ) (
@@ -68,7 +69,8 @@ assign operand_B  =  operand_B_sel ? extend : rs2_data;
 execution_unit #(
   .CORE(CORE),
   .DATA_WIDTH(DATA_WIDTH),
-  .ADDRESS_BITS(ADDRESS_BITS)
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .P_EXTENSION(P_EXTENSION)
 ) EXECUTE_BASE (
   .clock(clock),
   .reset(reset),
@@ -20,10 +20,32 @@
  *  THE SOFTWARE.
  */
 
+/** Module description
+ * --------------------
+ *  - Holds the PC and issues one instruction fetch per cycle.
+ *  - With COMPRESSED = 1 instructions are 2 or 4 bytes long. The length of
+ *    an instruction is only known once fetch receive has its data, so the
+ *    address issued in the cycle after a sequential fetch comes from fetch
+ *    receive (receive_next_PC) instead of PC_reg + 4. PC_reg holds the last
+ *    issued address and is reissued while fetch receive waits for its data.
+ *  - A 32 bit instruction that starts in the last halfword of a memory word
+ *    needs a second "tail" fetch of the next word. issue_tail marks it and
+ *    issue_half carries the first halfword to fetch receive.
+ *  - i_mem_read_address is aligned to DATA_WIDTH when COMPRESSED = 1.
+ *  - FETCH_WIDTH is the width of the instruction data returned by one fetch.
+ *    With FETCH_WIDTH = 64 (seven_stage_dual_core) a fetch returns an aligned
+ *    pair of instructions, i_mem_read_address is aligned to the pair and
+ *    sequential fetches skip to the next pair. Needs COMPRESSED = 0.
+ *  - With COMPRESSED = 0 and FETCH_WIDTH = 32 the PC is issued unchanged.
+ */
+
 module fetch_issue #(
   parameter CORE            =    0,
   parameter RESET_PC        =    0,
+  parameter DATA_WIDTH      =   32,
   parameter ADDRESS_BITS    =   32,
+  parameter COMPRESSED      =    0,
+  parameter FETCH_WIDTH     =   32,
   parameter SCAN_CYCLES_MIN =    1,
   parameter SCAN_CYCLES_MAX = 1000
 ) (
@@ -34,37 +56,137 @@ module fetch_issue #(
   input  [ADDRESS_BITS-1:0] target_PC,
   // Interface to fetch receive
   output [ADDRESS_BITS-1:0] issue_PC,
+  output issue_tail,
+  output [15:0] issue_half,
+  // Sequential PC from fetch receive, only used with COMPRESSED = 1
+  input  receive_valid,
+  input  [ADDRESS_BITS-1:0] receive_next_PC,
+  input  receive_next_tail,
+  input  [15:0] receive_next_half,
   // instruction cache interface
   output [ADDRESS_BITS-1:0] i_mem_read_address,
   // Scan signal
   input scan
 );
 
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+localparam LOG2_NUM_BYTES   = log2(DATA_WIDTH/8);
+localparam LOG2_FETCH_BYTES = log2(FETCH_WIDTH/8);
+
 reg [ADDRESS_BITS-1:0] PC_reg;
 
-// Assign Outputs
-assign issue_PC           = PC_reg;
-assign i_mem_read_address = PC_reg;
+generate
+  if(COMPRESSED) begin
+    reg        tail_reg;
+    reg [15:0] half_reg;
+    // The instruction issued last cycle is in fetch receive
+    reg        sequential;
 
+    wire follow_receive = sequential & receive_valid;
 
-always @(posedge clock)begin
-  if(reset)begin
-    PC_reg      <= RESET_PC;
+    // Assign Outputs
+    assign issue_PC   = follow_receive ? receive_next_PC   : PC_reg;
+    assign issue_tail = follow_receive ? receive_next_tail : tail_reg;
+    assign issue_half = follow_receive ? receive_next_half : half_reg;
+    assign i_mem_read_address = ((issue_PC >> LOG2_NUM_BYTES) + issue_tail) << LOG2_NUM_BYTES;
+
+    always @(posedge clock)begin
+      if(reset)begin
+        PC_reg     <= RESET_PC;
+        tail_reg   <= 1'b0;
+        half_reg   <= 16'd0;
+        sequential <= 1'b0;
+      end
+      else begin
+        case(next_PC_select)
+          2'b00  : begin
+            PC_reg     <= issue_PC;
+            tail_reg   <= issue_tail;
+            half_reg   <= issue_half;
+            sequential <= 1'b1;
+          end
+          // Keep reissuing the current fetch. Fetch receive only has the
+          // data for one cycle, so the address is registered if it came
+          // from there.
+          2'b01  : begin
+            PC_reg     <= issue_PC;
+            tail_reg   <= issue_tail;
+            half_reg   <= issue_half;
+            sequential <= sequential & ~receive_valid;
+          end
+          2'b10  : begin
+            PC_reg     <= target_PC;
+            tail_reg   <= 1'b0;
+            sequential <= 1'b0;
+          end
+          default: begin
+            PC_reg     <= {ADDRESS_BITS{1'b0}};
+            tail_reg   <= 1'b0;
+            sequential <= 1'b0;
+          end
+        endcase
+      end
+    end
+  end
+  else if(FETCH_WIDTH > 32) begin
+    // Assign Outputs
+    assign issue_PC           = PC_reg;
+    assign issue_tail         = 1'b0;
+    assign issue_half         = 16'd0;
+    assign i_mem_read_address = (PC_reg >> LOG2_FETCH_BYTES) << LOG2_FETCH_BYTES;
+
+    always @(posedge clock)begin
+      if(reset)begin
+        PC_reg      <= RESET_PC;
+      end
+      else begin
+        case(next_PC_select)
+          2'b00  : PC_reg <= ((PC_reg >> LOG2_FETCH_BYTES) + 1) << LOG2_FETCH_BYTES;
+          2'b01  : PC_reg <= PC_reg;
+          2'b10  : PC_reg <= target_PC;
+          default: PC_reg <= {ADDRESS_BITS{1'b0}};
+        endcase
+      end
+    end
   end
   else begin
-    case(next_PC_select)
-      2'b00  : PC_reg <= PC_reg + 4;
-      2'b01  : PC_reg <= PC_reg;
-      2'b10  : PC_reg <= target_PC;
-      default: PC_reg <= {ADDRESS_BITS{1'b0}};
-    endcase
+    // Assign Outputs
+    assign issue_PC           = PC_reg;
+    assign issue_tail         = 1'b0;
+    assign issue_half         = 16'd0;
+    assign i_mem_read_address = PC_reg;
+
+    always @(posedge clock)begin
+      if(reset)begin
+        PC_reg      <= RESET_PC;
+      end
+      else begin
+        case(next_PC_select)
+          2'b00  : PC_reg <= PC_reg + 4;
+          2'b01  : PC_reg <= PC_reg;
+          2'b10  : PC_reg <= target_PC;
+          default: PC_reg <= {ADDRESS_BITS{1'b0}};
+        endcase
+      end
+    end
   end
-end
+endgenerate
 
 endmodule
 
 /**** next_PC_select encoding ****
-* 2'b00: Increment PC (PC = PC  +  4 )
+* 2'b00: Increment PC (PC = PC  +  4 ), or the PC after the instruction in
+*        fetch receive with COMPRESSED = 1, or the next instruction pair with
+*        FETCH_WIDTH = 64
 * 2'b01: Stall        (PC =   PC     )
 * 2'b10: Jump/branch  (PC = target_PC)
 *************************************/
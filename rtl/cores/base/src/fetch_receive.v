@@ -20,9 +20,23 @@
  *  THE SOFTWARE.
  */
 
+/** Module description
+ * --------------------
+ *  - Selects the instruction at issue_PC from the instruction memory word.
+ *  - With COMPRESSED = 1 16 bit instructions are expanded by rvc_expander.
+ *    complete is low while a 32 bit instruction in the last halfword of the
+ *    word waits for its tail fetch, the instruction is a NOP then. The tail
+ *    fetch (issue_tail) returns the next word, whose low halfword completes
+ *    the instruction started by issue_half.
+ *  - fetch_address is the memory word address the data must come from and
+ *    next_PC/next_tail/next_half the fetch that follows the instruction. Both
+ *    are only used with COMPRESSED = 1, see fetch_issue.
+ */
+
 module fetch_receive #(
   parameter DATA_WIDTH      =   32,
   parameter ADDRESS_BITS    =   32,
+  parameter COMPRESSED      =    0,
   parameter SCAN_CYCLES_MIN =    0,
   parameter SCAN_CYCLES_MAX = 1000
 ) (
@@ -32,9 +46,19 @@ module fetch_receive #(
   // Instruction memory interface
   input  [DATA_WIDTH-1  :0] i_mem_data,
   input  [ADDRESS_BITS-1:0] issue_PC,
+  input  issue_tail,
+  input  [15:0] issue_half,
 
   // Outputs to with decode
   output [31            :0] instruction,
+  output compressed,
+  output complete,
+
+  // Outputs to fetch issue
+  output [ADDRESS_BITS-1:0] fetch_address,
+  output [ADDRESS_BITS-1:0] next_PC,
+  output next_tail,
+  output [15:0] next_half,
 
   //scan signal
   input scan
@@ -59,20 +83,64 @@ wire [LOG2_NUM_BYTES-1:0] byte_shift;
 wire [DATA_WIDTH-1:0] shifted_data;
 
 generate
-  if(DATA_WIDTH==32) begin
-    // No need to shift in RV32, cut out shifter because synthesizer is
-    // unlikely to automatically remove it.
-    assign byte_shift = 1'b0;
-    assign shifted_data = i_mem_data;
+  if(COMPRESSED) begin
+    wire [31:0] expanded_instruction;
+    wire [31:0] full_instruction;
+    wire last_half;
+    wire split;
+
+    // Instructions are halfword aligned in RV32 too
+    assign byte_shift   = issue_PC[LOG2_NUM_BYTES-1:0];
+    assign shifted_data = i_mem_data >> {byte_shift, 3'b000};
+
+    rvc_expander #(
+      .DATA_WIDTH(DATA_WIDTH)
+    ) RVC (
+      .compressed_instruction(shifted_data[15:0]),
+      .instruction(expanded_instruction)
+    );
+
+    assign last_half  = byte_shift == NUM_BYTES-2;
+    assign compressed = ~issue_tail & (shifted_data[1:0] != 2'b11);
+    assign split      = ~issue_tail & ~compressed & last_half;
+
+    assign full_instruction = issue_tail ? {i_mem_data[15:0], issue_half} :
+                                           shifted_data[31:0];
+
+    assign instruction = (flush | split) ? NOP                  :
+                         compressed      ? expanded_instruction :
+                                           full_instruction;
+    assign complete    = ~flush & ~split;
+
+    assign fetch_address = ((issue_PC >> LOG2_NUM_BYTES) + issue_tail) << LOG2_NUM_BYTES;
+    assign next_PC       = split      ? issue_PC     :
+                           compressed ? issue_PC + 2 :
+                                        issue_PC + 4;
+    assign next_tail     = split;
+    assign next_half     = shifted_data[15:0];
   end
   else begin
-    // Shift Double wide i_mem_data if instruction is in upper 4 bytes
-    assign byte_shift = issue_PC[LOG2_NUM_BYTES-1:0];
-    assign shifted_data = i_mem_data >> {byte_shift, 3'b000};
+    if(DATA_WIDTH==32) begin
+      // No need to shift in RV32, cut out shifter because synthesizer is
+      // unlikely to automatically remove it.
+      assign byte_shift = 1'b0;
+      assign shifted_data = i_mem_data;
+    end
+    else begin
+      // Shift Double wide i_mem_data if instruction is in upper 4 bytes
+      assign byte_shift = issue_PC[LOG2_NUM_BYTES-1:0];
+      assign shifted_data = i_mem_data >> {byte_shift, 3'b000};
+    end
+
+    // Only support 32 bit instructions
+    assign instruction   = flush ? NOP : shifted_data[31:0];
+    assign compressed    = 1'b0;
+    assign complete      = ~flush;
+    assign fetch_address = issue_PC;
+    assign next_PC       = issue_PC + 4;
+    assign next_tail     = 1'b0;
+    assign next_half     = 16'd0;
   end
 endgenerate
 
-// Only support 32 bit instructions
-assign instruction = flush ? NOP : shifted_data[31:0];
-
 endmodule
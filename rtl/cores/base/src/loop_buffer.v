@@ -0,0 +1,210 @@
+/** @module : loop_buffer
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - L0 loop buffer between the fetch stage of a core and its instruction
+ *    memory port (memory_interface).
+ *  - A jump or taken branch that sends fetch issue back by at most
+ *    LOOP_BUFFER_WORDS words (plus the fetches already issued behind the
+ *    branch) arms the buffer with a window of LOOP_BUFFER_WORDS memory words
+ *    starting at the target. Redirects to the start of the current window
+ *    keep its contents, other short backward redirects move the window.
+ *  - Instruction memory responses inside the window are captured. A fetch of
+ *    a captured word does not read the instruction memory, the buffer
+ *    returns the word the next cycle with the same valid/address handshake
+ *    as the memory. A buffer read is only issued when no memory read is
+ *    waiting for its data, so responses return in program order.
+ *  - Fetches outside the window, for example after the loop exits, go to the
+ *    instruction memory as before. invalidate (fence.i, traps) empties and
+ *    disarms the buffer.
+ *  - The buffer holds DATA_WIDTH memory words. fetch_address_in echoes the
+ *    fetch address, so cores that fetch 32 bit instructions from a 64 bit
+ *    memory word work unchanged.
+ *  - hit_count and fetch_count count the fetches served by the buffer and all
+ *    fetches, they can be read by test benches.
+ */
+
+module loop_buffer #(
+  parameter CORE              = 0,
+  parameter DATA_WIDTH        = 32,
+  parameter ADDRESS_BITS      = 32,
+  parameter LOOP_BUFFER_WORDS = 8,
+  parameter SCAN_CYCLES_MIN   = 0,
+  parameter SCAN_CYCLES_MAX   = 1000
+) (
+  input  clock,
+  input  reset,
+  // Loop detection, from fetch issue and the control unit
+  input  [1:0] next_PC_select,
+  input  [ADDRESS_BITS-1:0] target_PC,
+  input  invalidate,
+  // Core fetch interface
+  input  fetch_read,
+  input  [ADDRESS_BITS-1:0] fetch_address_out,
+  output [DATA_WIDTH-1  :0] fetch_data_in,
+  output [ADDRESS_BITS-1:0] fetch_address_in,
+  output fetch_valid,
+  output fetch_ready,
+  // Instruction memory interface
+  output i_mem_read,
+  output [ADDRESS_BITS-1:0] i_mem_address_in,
+  input  [DATA_WIDTH-1  :0] i_mem_data_out,
+  input  [ADDRESS_BITS-1:0] i_mem_address_out,
+  input  i_mem_valid,
+  input  i_mem_ready,
+
+  input  scan
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+localparam NUM_BYTES      = DATA_WIDTH/8;
+localparam LOG2_NUM_BYTES = log2(NUM_BYTES);
+localparam WINDOW_BYTES   = LOOP_BUFFER_WORDS * NUM_BYTES;
+// Fetch issue runs up to three fetches ahead of a branch resolved in execute
+localparam DETECT_BYTES   = WINDOW_BYTES + 3*NUM_BYTES;
+localparam INDEX_BITS     = (LOOP_BUFFER_WORDS > 1) ? log2(LOOP_BUFFER_WORDS) : 1;
+
+reg [DATA_WIDTH-1:0] buffer [LOOP_BUFFER_WORDS-1:0];
+reg [LOOP_BUFFER_WORDS-1:0] buffer_valid;
+reg armed;
+reg [ADDRESS_BITS-1:0] window_base;
+
+// Set while a memory read has not returned its data
+reg i_pending;
+
+reg hit_valid;
+reg [DATA_WIDTH-1  :0] hit_data;
+reg [ADDRESS_BITS-1:0] hit_address;
+
+reg [31:0] hit_count;
+reg [31:0] fetch_count;
+
+wire [ADDRESS_BITS-1:0] fetch_offset;
+wire [ADDRESS_BITS-1:0] response_offset;
+wire [ADDRESS_BITS-1:0] target_base;
+wire [INDEX_BITS-1:0] fetch_index;
+wire [INDEX_BITS-1:0] response_index;
+wire fetch_in_window;
+wire response_in_window;
+wire in_order;
+wire hit;
+wire backward_redirect;
+
+assign fetch_offset    = ((fetch_address_out >> LOG2_NUM_BYTES) << LOG2_NUM_BYTES) - window_base;
+assign response_offset = ((i_mem_address_out >> LOG2_NUM_BYTES) << LOG2_NUM_BYTES) - window_base;
+assign target_base     = (target_PC >> LOG2_NUM_BYTES) << LOG2_NUM_BYTES;
+
+assign fetch_in_window    = armed & (fetch_offset    < WINDOW_BYTES);
+assign response_in_window = armed & (response_offset < WINDOW_BYTES);
+assign fetch_index        = fetch_offset[LOG2_NUM_BYTES +: INDEX_BITS];
+assign response_index     = response_offset[LOG2_NUM_BYTES +: INDEX_BITS];
+
+assign in_order = ~i_pending | i_mem_valid;
+assign hit      = fetch_read & fetch_in_window & buffer_valid[fetch_index] & in_order &
+                  ~invalidate;
+
+assign backward_redirect = (next_PC_select == 2'b10) & (target_PC < fetch_address_out) &
+                           (fetch_address_out - target_PC <= DETECT_BYTES);
+
+assign i_mem_read       = fetch_read & ~hit;
+assign i_mem_address_in = fetch_address_out;
+
+assign fetch_data_in    = hit_valid ? hit_data    : i_mem_data_out;
+assign fetch_address_in = hit_valid ? hit_address : i_mem_address_out;
+assign fetch_valid      = hit_valid | i_mem_valid;
+assign fetch_ready      = hit | i_mem_ready;
+
+always @(posedge clock) begin
+  if(reset) begin
+    buffer_valid <= {LOOP_BUFFER_WORDS{1'b0}};
+    armed        <= 1'b0;
+    window_base  <= {ADDRESS_BITS{1'b0}};
+    i_pending    <= 1'b0;
+    hit_valid    <= 1'b0;
+    hit_data     <= {DATA_WIDTH{1'b0}};
+    hit_address  <= {ADDRESS_BITS{1'b0}};
+  end
+  else begin
+    i_pending   <= (i_mem_read & i_mem_ready) | (i_pending & ~i_mem_valid);
+    hit_valid   <= hit;
+    hit_data    <= buffer[fetch_index];
+    hit_address <= fetch_address_out;
+
+    if(invalidate) begin
+      buffer_valid <= {LOOP_BUFFER_WORDS{1'b0}};
+      armed        <= 1'b0;
+    end
+    else if(backward_redirect & (~armed | (target_base != window_base))) begin
+      buffer_valid <= {LOOP_BUFFER_WORDS{1'b0}};
+      armed        <= 1'b1;
+      window_base  <= target_base;
+    end
+    else if(i_mem_valid & response_in_window) begin
+      buffer_valid[response_index] <= 1'b1;
+    end
+  end
+end
+
+always @(posedge clock) begin
+  if(i_mem_valid & response_in_window) begin
+    buffer[response_index] <= i_mem_data_out;
+  end
+end
+
+always @(posedge clock) begin
+  if(reset) begin
+    hit_count   <= 32'd0;
+    fetch_count <= 32'd0;
+  end
+  else begin
+    hit_count   <= hit_count   + hit;
+    fetch_count <= fetch_count + (hit | (i_mem_read & i_mem_ready));
+  end
+end
+
+reg [31: 0] cycles;
+always @ (posedge clock) begin
+  cycles <= reset? 0 : cycles + 1;
+  if (scan  & ((cycles >= SCAN_CYCLES_MIN) & (cycles <= SCAN_CYCLES_MAX)) )begin
+    $display ("------ Core %d Loop Buffer - Current Cycle %d -----------------", CORE, cycles);
+    $display ("| Armed          [%b]", armed);
+    $display ("| Window Base    [%h]", window_base);
+    $display ("| Buffer Valid   [%b]", buffer_valid);
+    $display ("| Hit            [%b]", hit);
+    $display ("| I Pending      [%b]", i_pending);
+    $display ("| Hit Count      [%d]", hit_count);
+    $display ("| Fetch Count    [%d]", fetch_count);
+    $display ("----------------------------------------------------------------------");
+  end
+end
+
+endmodule
@@ -0,0 +1,237 @@
+/** @module : packed_simd_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Single cycle subset of the RISC-V P (packed SIMD) extension draft. The
+ *    instructions use the OP-P opcode (7'b1110111) and the draft encodings.
+ *  - ALU_operation 57 is the funct3 000 group, computed in 16 bit (and 8 bit)
+ *    lanes:
+ *      add16, sub16, radd16, rsub16, kadd16, ksub16, ukadd16, uksub16,
+ *      add8, sub8, kadd8, ksub8, ukadd8, uksub8,
+ *      sra16, srl16, sll16, ksll16, srai16, srli16, slli16, kslli16,
+ *      cmpeq16, scmplt16, scmple16, ucmplt16, ucmple16,
+ *      smin16, smax16, umin16, umax16 and khm16 (Q15 multiply).
+ *  - ALU_operation 58 is the funct3 001 group, computed in 32 bit lanes from
+ *    the two 16 bit halves of each lane:
+ *      kmda, kmxda, smds, smdrs, smxds (dual 16x16 multiply and add or
+ *      subtract) and pkbb16, pkbt16, pktb16, pktt16 (pack halves).
+ *  - funct7 and the rs2 field come from the I-type immediate (extend[11:0])
+ *    that decode generates for every instruction. The shift immediate of
+ *    srai16/srli16/slli16/kslli16 is the rs2 field.
+ *  - The k and uk operations saturate. The rounding (.u) shifts and the
+ *    accumulating multiplies that read rd are not implemented and return 0
+ *    like other unimplemented funct7 values.
+ *  - DATA_WIDTH 32 has 2 halfword lanes, DATA_WIDTH 64 has 4.
+ */
+
+module packed_simd_unit #(
+  parameter DATA_WIDTH = 32
+) (
+  input  [5:0] ALU_operation,
+  input  [6:0] funct7,
+  input  [4:0] rs2_field,
+  input  [DATA_WIDTH-1:0] operand_A,
+  input  [DATA_WIDTH-1:0] operand_B,
+  output [DATA_WIDTH-1:0] packed_result
+);
+
+localparam HALF_LANES = DATA_WIDTH/16;
+localparam BYTE_LANES = DATA_WIDTH/8;
+localparam WORD_LANES = DATA_WIDTH/32;
+
+// funct3 000
+localparam [6:0] RADD16   = 7'b0000000,
+                 RSUB16   = 7'b0000001,
+                 SCMPLT16 = 7'b0000110,
+                 KADD16   = 7'b0001000,
+                 KSUB16   = 7'b0001001,
+                 KADD8    = 7'b0001100,
+                 KSUB8    = 7'b0001101,
+                 SCMPLE16 = 7'b0001110,
+                 UCMPLT16 = 7'b0010110,
+                 UKADD16  = 7'b0011000,
+                 UKSUB16  = 7'b0011001,
+                 UKADD8   = 7'b0011100,
+                 UKSUB8   = 7'b0011101,
+                 UCMPLE16 = 7'b0011110,
+                 ADD16    = 7'b0100000,
+                 SUB16    = 7'b0100001,
+                 ADD8     = 7'b0100100,
+                 SUB8     = 7'b0100101,
+                 CMPEQ16  = 7'b0100110,
+                 SRA16    = 7'b0101000,
+                 SRL16    = 7'b0101001,
+                 SLL16    = 7'b0101010,
+                 KSLL16   = 7'b0110010,
+                 SRAI16   = 7'b0111000,
+                 SRLI16   = 7'b0111001,
+                 SLLI16   = 7'b0111010, // KSLLI16 with rs2_field[4] set
+                 SMIN16   = 7'b1000000,
+                 SMAX16   = 7'b1000001,
+                 KHM16    = 7'b1000011,
+                 UMIN16   = 7'b1001000,
+                 UMAX16   = 7'b1001001;
+
+// funct3 001
+localparam [6:0] PKBB16   = 7'b0000111,
+                 PKBT16   = 7'b0001111,
+                 PKTT16   = 7'b0010111,
+                 PKTB16   = 7'b0011111,
+                 KMDA     = 7'b0011100,
+                 KMXDA    = 7'b0011101,
+                 SMDS     = 7'b0101100,
+                 SMDRS    = 7'b0110100,
+                 SMXDS    = 7'b0111100;
+
+// Immediate shifts take the amount from the rs2 field, the others from rs2
+wire       immediate_shift;
+wire [3:0] shift_amount;
+wire       saturating_left_shift;
+
+wire [DATA_WIDTH-1:0] half_result;
+wire [DATA_WIDTH-1:0] byte_result;
+wire [DATA_WIDTH-1:0] word_result;
+wire                  byte_operation;
+
+assign immediate_shift       = (funct7 == SRAI16) | (funct7 == SRLI16) | (funct7 == SLLI16);
+assign shift_amount          = immediate_shift ? rs2_field[3:0] : operand_B[3:0];
+assign saturating_left_shift = (funct7 == KSLL16) | ((funct7 == SLLI16) & rs2_field[4]);
+
+assign byte_operation = (funct7 == ADD8)  | (funct7 == SUB8)   | (funct7 == KADD8) |
+                        (funct7 == KSUB8) | (funct7 == UKADD8) | (funct7 == UKSUB8);
+
+genvar lane;
+generate
+  for(lane=0; lane<HALF_LANES; lane=lane+1) begin : HALF_LANE
+    wire        [15:0] a = operand_A[16*lane +: 16];
+    wire        [15:0] b = operand_B[16*lane +: 16];
+    wire signed [15:0] signed_a = a;
+    wire signed [15:0] signed_b = b;
+
+    wire [16:0] signed_sum   = {a[15], a} + {b[15], b};
+    wire [16:0] signed_diff  = {a[15], a} - {b[15], b};
+    wire [16:0] unsigned_sum  = {1'b0, a} + {1'b0, b};
+    wire [16:0] unsigned_diff = {1'b0, a} - {1'b0, b};
+
+    wire [15:0] kadd  = (signed_sum[16]  != signed_sum[15])  ? {signed_sum[16],  {15{~signed_sum[16]}}}  : signed_sum[15:0];
+    wire [15:0] ksub  = (signed_diff[16] != signed_diff[15]) ? {signed_diff[16], {15{~signed_diff[16]}}} : signed_diff[15:0];
+    wire [15:0] ukadd = unsigned_sum[16]  ? 16'hFFFF : unsigned_sum[15:0];
+    wire [15:0] uksub = unsigned_diff[16] ? 16'h0000 : unsigned_diff[15:0];
+
+    wire [31:0] shifted_left = {{16{a[15]}}, a} << shift_amount;
+    wire        shift_overflow = (shifted_left[31:15] != {17{1'b0}}) & (shifted_left[31:15] != {17{1'b1}});
+    wire [15:0] sll   = shifted_left[15:0];
+    wire [15:0] ksll  = shift_overflow ? {a[15], {15{~a[15]}}} : sll;
+    wire [15:0] srl   = a >> shift_amount;
+    wire [15:0] sra   = signed_a >>> shift_amount;
+
+    wire        signed_less   = signed_a < signed_b;
+    wire        unsigned_less = a < b;
+
+    wire signed [31:0] product = signed_a * signed_b;
+    wire [15:0] khm = ((a == 16'h8000) & (b == 16'h8000)) ? 16'h7FFF : product[30:15];
+
+    assign half_result[16*lane +: 16] =
+      (funct7 == ADD16   ) ? signed_sum[15:0]   :
+      (funct7 == SUB16   ) ? signed_diff[15:0]  :
+      (funct7 == RADD16  ) ? signed_sum[16:1]   :
+      (funct7 == RSUB16  ) ? signed_diff[16:1]  :
+      (funct7 == KADD16  ) ? kadd               :
+      (funct7 == KSUB16  ) ? ksub               :
+      (funct7 == UKADD16 ) ? ukadd              :
+      (funct7 == UKSUB16 ) ? uksub              :
+      ((funct7 == SRA16) | ((funct7 == SRAI16) & ~rs2_field[4])) ? sra :
+      ((funct7 == SRL16) | ((funct7 == SRLI16) & ~rs2_field[4])) ? srl :
+      saturating_left_shift ? ksll              :
+      ((funct7 == SLL16) | (funct7 == SLLI16)) ? sll :
+      (funct7 == CMPEQ16 ) ? {16{a == b}}       :
+      (funct7 == SCMPLT16) ? {16{signed_less}}  :
+      (funct7 == SCMPLE16) ? {16{signed_less | (a == b)}}   :
+      (funct7 == UCMPLT16) ? {16{unsigned_less}}            :
+      (funct7 == UCMPLE16) ? {16{unsigned_less | (a == b)}} :
+      (funct7 == SMIN16  ) ? (signed_less   ? a : b) :
+      (funct7 == SMAX16  ) ? (signed_less   ? b : a) :
+      (funct7 == UMIN16  ) ? (unsigned_less ? a : b) :
+      (funct7 == UMAX16  ) ? (unsigned_less ? b : a) :
+      (funct7 == KHM16   ) ? khm                :
+      16'h0000;
+  end
+
+  for(lane=0; lane<BYTE_LANES; lane=lane+1) begin : BYTE_LANE
+    wire [7:0] a = operand_A[8*lane +: 8];
+    wire [7:0] b = operand_B[8*lane +: 8];
+
+    wire [8:0] signed_sum    = {a[7], a} + {b[7], b};
+    wire [8:0] signed_diff   = {a[7], a} - {b[7], b};
+    wire [8:0] unsigned_sum  = {1'b0, a} + {1'b0, b};
+    wire [8:0] unsigned_diff = {1'b0, a} - {1'b0, b};
+
+    assign byte_result[8*lane +: 8] =
+      (funct7 == ADD8  ) ? signed_sum[7:0]  :
+      (funct7 == SUB8  ) ? signed_diff[7:0] :
+      (funct7 == KADD8 ) ? ((signed_sum[8]  != signed_sum[7])  ? {signed_sum[8],  {7{~signed_sum[8]}}}  : signed_sum[7:0])  :
+      (funct7 == KSUB8 ) ? ((signed_diff[8] != signed_diff[7]) ? {signed_diff[8], {7{~signed_diff[8]}}} : signed_diff[7:0]) :
+      (funct7 == UKADD8) ? (unsigned_sum[8]  ? 8'hFF : unsigned_sum[7:0])  :
+      (funct7 == UKSUB8) ? (unsigned_diff[8] ? 8'h00 : unsigned_diff[7:0]) :
+      8'h00;
+  end
+
+  for(lane=0; lane<WORD_LANES; lane=lane+1) begin : WORD_LANE
+    wire        [15:0] a_low  = operand_A[32*lane      +: 16];
+    wire        [15:0] a_high = operand_A[32*lane + 16 +: 16];
+    wire        [15:0] b_low  = operand_B[32*lane      +: 16];
+    wire        [15:0] b_high = operand_B[32*lane + 16 +: 16];
+    wire signed [15:0] signed_a_low  = a_low;
+    wire signed [15:0] signed_a_high = a_high;
+    wire signed [15:0] signed_b_low  = b_low;
+    wire signed [15:0] signed_b_high = b_high;
+
+    wire signed [31:0] high_high = signed_a_high * signed_b_high;
+    wire signed [31:0] low_low   = signed_a_low  * signed_b_low;
+    wire signed [31:0] high_low  = signed_a_high * signed_b_low;
+    wire signed [31:0] low_high  = signed_a_low  * signed_b_high;
+
+    wire [32:0] dot   = {high_high[31], high_high} + {low_low[31], low_low};
+    wire [32:0] cross = {high_low[31],  high_low}  + {low_high[31], low_high};
+    wire [31:0] kmda  = (dot[32]   != dot[31])   ? {dot[32],   {31{~dot[32]}}}   : dot[31:0];
+    wire [31:0] kmxda = (cross[32] != cross[31]) ? {cross[32], {31{~cross[32]}}} : cross[31:0];
+
+    assign word_result[32*lane +: 32] =
+      (funct7 == KMDA  ) ? kmda                 :
+      (funct7 == KMXDA ) ? kmxda                :
+      (funct7 == SMDS  ) ? high_high - low_low  :
+      (funct7 == SMDRS ) ? low_low - high_high  :
+      (funct7 == SMXDS ) ? high_low - low_high  :
+      (funct7 == PKBB16) ? {a_low,  b_low}      :
+      (funct7 == PKBT16) ? {a_low,  b_high}     :
+      (funct7 == PKTT16) ? {a_high, b_high}     :
+      (funct7 == PKTB16) ? {a_high, b_low}      :
+      32'h00000000;
+  end
+endgenerate
+
+assign packed_result = (ALU_operation == 6'd58) ? word_result :
+                       byte_operation           ? byte_result :
+                       half_result;
+
+endmodule
@@ -84,6 +84,7 @@ module priv_control #(
   output m_ret_decode,
   output s_ret_decode,
   output u_ret_decode,
+  output wfi_decode,
 
   output [ADDRESS_BITS-1:0] trap_PC,
 
@@ -117,6 +118,7 @@ localparam SUPERVISOR = 2'b01;
 localparam USER       = 2'b00;
 
 wire ecall;
+wire wfi_interrupted;
 
 wire allow_CSR_access;
 wire illegal_CSR_access;
@@ -132,6 +134,10 @@ assign u_ret_decode = 1'b0; // User mode traps not supported
 assign ecall = (opcode_decode == SYSTEM) & (funct3 == 3'b000) &
   (funct7 == 7'b0000000) & (rs2 == 5'b00000) & (rs1 == 5'b00000);
 
+// WFI is allowed in all privilege levels. TW is not implemented.
+assign wfi_decode = (opcode_decode == SYSTEM) & (funct3 == 3'b000) &
+  (funct7 == 7'b0001000) & (rs2 == 5'b00101) & (rs1 == 5'b00000);
+
 // Exception Signals
 assign exception_fetch_receive  = i_mem_page_fault | i_mem_access_fault;
 assign exception_decode         = ecall | is_emulated_instruction | illegal_CSR_access;
@@ -164,8 +170,13 @@ assign interrupted_PC = ~inst_PC_memory_receive[0] ? inst_PC_memory_receive :
                         ~inst_PC_fetch_receive[0]  ? inst_PC_fetch_receive  :
                         issue_PC;
 
+// An interrupt that wakes up a WFI waiting in decode returns to the
+// instruction after the WFI.
+assign wfi_interrupted = wfi_decode & (interrupted_PC == inst_PC_decode);
+
 // This is the PC value that goes into [m|s]epc
-assign trap_PC = intr_branch                ? interrupted_PC         :
+assign trap_PC = intr_branch & wfi_interrupted ? interrupted_PC + 4 :
+                 intr_branch                   ? interrupted_PC     :
                  inst_PC_memory_receive;
 
 // TODO: this will not be needed unless memory exceptions can happen in more
@@ -201,6 +212,7 @@ always @ (posedge clock) begin
     $display ("| m_ret_decode   [%b]", m_ret_decode);
     $display ("| s_ret_decode   [%b]", s_ret_decode);
     $display ("| u_ret_decode   [%b]", u_ret_decode);
+    $display ("| wfi_decode     [%b]", wfi_decode);
     $display ("| exception      FR [%b]", exception_fetch_receive);
     $display ("| exception_code FR [%h]", exception_code_fetch_receive);
     $display ("| exception      D  [%b]", exception_decode);
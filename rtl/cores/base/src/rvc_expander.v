@@ -0,0 +1,187 @@
+/** @module : rvc_expander
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Expands a 16 bit RVC instruction into the 32 bit instruction it stands
+ *    for, so decode and control only see the base ISA.
+ *  - DATA_WIDTH selects RV32C (32) or RV64C (64). The two differ in quadrant 1
+ *    funct3 001 (c.jal/c.addiw), the c.subw/c.addw ALU group and the
+ *    c.flw/c.ld, c.fsw/c.sd, c.flwsp/c.ldsp, c.fswsp/c.sdsp slots.
+ *  - Floating point loads and stores and reserved encodings expand to
+ *    32'h00000000, which is an illegal instruction in the base ISA.
+ *  - c.jal and c.jalr link to PC+2. The core has to account for that, the
+ *    expanded jal/jalr link to PC+4.
+ */
+
+module rvc_expander #(
+  parameter DATA_WIDTH = 32
+) (
+  input  [15:0] compressed_instruction,
+  output reg [31:0] instruction
+);
+
+localparam OP_IMM    = 7'b0010011;
+localparam OP_IMM_32 = 7'b0011011;
+localparam OP        = 7'b0110011;
+localparam OP_32     = 7'b0111011;
+localparam LOAD      = 7'b0000011;
+localparam STORE     = 7'b0100011;
+localparam BRANCH    = 7'b1100011;
+localparam JALR      = 7'b1100111;
+localparam JAL       = 7'b1101111;
+localparam LUI       = 7'b0110111;
+localparam SYSTEM    = 7'b1110011;
+
+localparam ILLEGAL   = 32'h00000000;
+localparam EBREAK    = 32'h00100073;
+
+wire [15:0] c = compressed_instruction;
+
+// Register fields. The 3 bit fields address x8-x15.
+wire [4:0] rd    = c[11:7];
+wire [4:0] rs2   = c[6:2];
+wire [4:0] rd_p  = {2'b01, c[4:2]};
+wire [4:0] rs1_p = {2'b01, c[9:7]};
+wire [4:0] rs2_p = {2'b01, c[4:2]};
+
+// Immediates, zero or sign extended to the 12 bit I/S immediate
+wire [11:0] ci_imm       = {{6{c[12]}}, c[12], c[6:2]};
+wire [5:0]  shamt        = {c[12], c[6:2]};
+wire [11:0] addi4spn_imm = {2'b00, c[10:7], c[12:11], c[5], c[6], 2'b00};
+wire [11:0] addi16sp_imm = {{2{c[12]}}, c[12], c[4:3], c[5], c[2], c[6], 4'b0000};
+wire [11:0] lw_imm       = {5'b00000, c[5], c[12:10], c[6], 2'b00};
+wire [11:0] ld_imm       = {4'b0000, c[6:5], c[12:10], 3'b000};
+wire [11:0] lwsp_imm     = {4'b0000, c[3:2], c[12], c[6:4], 2'b00};
+wire [11:0] ldsp_imm     = {3'b000, c[4:2], c[12], c[6:5], 3'b000};
+wire [11:0] swsp_imm     = {4'b0000, c[8:7], c[12:9], 2'b00};
+wire [11:0] sdsp_imm     = {3'b000, c[9:7], c[12:10], 3'b000};
+wire [19:0] lui_imm      = {{15{c[12]}}, c[6:2]};
+wire [20:0] j_imm        = {{9{c[12]}}, c[12], c[8], c[10:9], c[6], c[7], c[2],
+                            c[11], c[5:3], 1'b0};
+wire [12:0] b_imm        = {{4{c[12]}}, c[12], c[6:5], c[2], c[11:10], c[4:3], 1'b0};
+
+// 32 bit encodings of the expanded instructions
+wire [31:0] j_type     = {j_imm[20], j_imm[10:1], j_imm[11], j_imm[19:12], 5'd0, JAL};
+wire [31:0] branch     = {b_imm[12], b_imm[10:5], 5'd0, rs1_p, 2'b00, c[13],
+                          b_imm[4:1], b_imm[11], BRANCH};
+wire [31:0] load_word  = {lw_imm, rs1_p, 3'b010, rd_p, LOAD};
+wire [31:0] load_dword = {ld_imm, rs1_p, 3'b011, rd_p, LOAD};
+wire [31:0] store_word = {lw_imm[11:5], rs2_p, rs1_p, 3'b010, lw_imm[4:0], STORE};
+wire [31:0] store_dword= {ld_imm[11:5], rs2_p, rs1_p, 3'b011, ld_imm[4:0], STORE};
+
+wire [2:0] funct3 = c[15:13];
+
+always @(*) begin
+  instruction = ILLEGAL;
+  case(c[1:0])
+    // Quadrant 0
+    2'b00: begin
+      case(funct3)
+        3'b000: instruction = (addi4spn_imm == 12'd0) ? ILLEGAL :
+                              {addi4spn_imm, 5'd2, 3'b000, rd_p, OP_IMM};  // c.addi4spn
+        3'b010: instruction = load_word;                                   // c.lw
+        3'b011: instruction = (DATA_WIDTH == 64) ? load_dword : ILLEGAL;   // c.ld
+        3'b110: instruction = store_word;                                  // c.sw
+        3'b111: instruction = (DATA_WIDTH == 64) ? store_dword : ILLEGAL;  // c.sd
+        default: instruction = ILLEGAL;                                    // c.fld, c.fsd
+      endcase
+    end
+    // Quadrant 1
+    2'b01: begin
+      case(funct3)
+        3'b000: instruction = {ci_imm, rd, 3'b000, rd, OP_IMM};            // c.addi, c.nop
+        3'b001: instruction = (DATA_WIDTH == 64) ?
+                              {ci_imm, rd, 3'b000, rd, OP_IMM_32} :        // c.addiw
+                              {j_type[31:12], 5'd1, JAL};                  // c.jal
+        3'b010: instruction = {ci_imm, 5'd0, 3'b000, rd, OP_IMM};          // c.li
+        3'b011: begin
+          if(rd == 5'd2)                                                   // c.addi16sp
+            instruction = (addi16sp_imm == 12'd0) ? ILLEGAL :
+                          {addi16sp_imm, 5'd2, 3'b000, 5'd2, OP_IMM};
+          else                                                             // c.lui
+            instruction = (shamt == 6'd0) ? ILLEGAL : {lui_imm, rd, LUI};
+        end
+        3'b100: begin
+          case(c[11:10])
+            2'b00: instruction = {6'b000000, shamt, rs1_p, 3'b101, rs1_p, OP_IMM}; // c.srli
+            2'b01: instruction = {6'b010000, shamt, rs1_p, 3'b101, rs1_p, OP_IMM}; // c.srai
+            2'b10: instruction = {ci_imm, rs1_p, 3'b111, rs1_p, OP_IMM};           // c.andi
+            default: begin
+              case({c[12], c[6:5]})
+                3'b000: instruction = {7'b0100000, rs2_p, rs1_p, 3'b000, rs1_p, OP}; // c.sub
+                3'b001: instruction = {7'b0000000, rs2_p, rs1_p, 3'b100, rs1_p, OP}; // c.xor
+                3'b010: instruction = {7'b0000000, rs2_p, rs1_p, 3'b110, rs1_p, OP}; // c.or
+                3'b011: instruction = {7'b0000000, rs2_p, rs1_p, 3'b111, rs1_p, OP}; // c.and
+                3'b100: instruction = (DATA_WIDTH == 64) ?                           // c.subw
+                                      {7'b0100000, rs2_p, rs1_p, 3'b000, rs1_p, OP_32} :
+                                      ILLEGAL;
+                3'b101: instruction = (DATA_WIDTH == 64) ?                           // c.addw
+                                      {7'b0000000, rs2_p, rs1_p, 3'b000, rs1_p, OP_32} :
+                                      ILLEGAL;
+                default: instruction = ILLEGAL;
+              endcase
+            end
+          endcase
+        end
+        3'b101: instruction = j_type;                                      // c.j
+        3'b110,                                                            // c.beqz
+        3'b111: instruction = branch;                                      // c.bnez
+        default: instruction = ILLEGAL;
+      endcase
+    end
+    // Quadrant 2
+    2'b10: begin
+      case(funct3)
+        3'b000: instruction = {6'b000000, shamt, rd, 3'b001, rd, OP_IMM};  // c.slli
+        3'b010: instruction = (rd == 5'd0) ? ILLEGAL :
+                              {lwsp_imm, 5'd2, 3'b010, rd, LOAD};          // c.lwsp
+        3'b011: instruction = (DATA_WIDTH == 64 && rd != 5'd0) ?
+                              {ldsp_imm, 5'd2, 3'b011, rd, LOAD} :         // c.ldsp
+                              ILLEGAL;
+        3'b100: begin
+          if(c[12] == 1'b0)
+            instruction = (rs2 == 5'd0) ?
+                          ((rd == 5'd0) ? ILLEGAL :
+                           {12'd0, rd, 3'b000, 5'd0, JALR}) :              // c.jr
+                          {7'b0000000, rs2, 5'd0, 3'b000, rd, OP};         // c.mv
+          else
+            instruction = (rs2 == 5'd0) ?
+                          ((rd == 5'd0) ? EBREAK :                         // c.ebreak
+                           {12'd0, rd, 3'b000, 5'd1, JALR}) :              // c.jalr
+                          {7'b0000000, rs2, rd, 3'b000, rd, OP};           // c.add
+        end
+        3'b110: instruction = {swsp_imm[11:5], rs2, 5'd2, 3'b010,
+                               swsp_imm[4:0], STORE};                      // c.swsp
+        3'b111: instruction = (DATA_WIDTH == 64) ?
+                              {sdsp_imm[11:5], rs2, 5'd2, 3'b011,
+                               sdsp_imm[4:0], STORE} :                     // c.sdsp
+                              ILLEGAL;
+        default: instruction = ILLEGAL;                                    // c.fldsp, c.fsdsp
+      endcase
+    end
+    // 2'b11 is a 32 bit instruction
+    default: instruction = ILLEGAL;
+  endcase
+end
+
+endmodule
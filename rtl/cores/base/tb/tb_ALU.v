@@ -107,6 +107,149 @@ initial begin
     $stop();
   end
 
+  operand_A     <= 32'h0000_0005;
+  operand_B     <= 32'h0000_0007;
+  ALU_operation <= 6'd33; // SH1ADD
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h00000011) begin
+    $display("\nError: SH1ADD operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hF0F0_F0F0;
+  operand_B     <= 32'hFF00_FF00;
+  ALU_operation <= 6'd36; // ANDN
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h00f000f0) begin
+    $display("\nError: ANDN operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h1234_5678;
+  operand_B     <= 32'h0F0F_0F0F;
+  ALU_operation <= 6'd38; // XNOR
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'he2c4a688) begin
+    $display("\nError: XNOR operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0001_0000;
+  operand_B     <= 32'h0000_0600;
+  ALU_operation <= 6'd39; // Count Leading Zeros
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h0000000f) begin
+    $display("\nError: CLZ operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0001_0000;
+  operand_B     <= 32'h0000_0601;
+  ALU_operation <= 6'd39; // Count Trailing Zeros
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h00000010) begin
+    $display("\nError: CTZ operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hF0F0_000F;
+  operand_B     <= 32'h0000_0602;
+  ALU_operation <= 6'd39; // Count Ones
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h0000000c) begin
+    $display("\nError: CPOP operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0000_0080;
+  operand_B     <= 32'h0000_0604;
+  ALU_operation <= 6'd39; // Sign Extend Byte
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'hffffff80) begin
+    $display("\nError: SEXT.B operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hffff_ffff;
+  operand_B     <= 32'h0000_0001;
+  ALU_operation <= 6'd40; // Signed Maximum
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h00000001) begin
+    $display("\nError: MAX operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hffff_ffff;
+  operand_B     <= 32'h0000_0001;
+  ALU_operation <= 6'd43; // Unsigned Minimum
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h00000001) begin
+    $display("\nError: MINU operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h8000_0001;
+  operand_B     <= 32'h0000_0004;
+  ALU_operation <= 6'd45; // Rotate Left
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h00000018) begin
+    $display("\nError: ROL operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h1234_5678;
+  operand_B     <= 32'h0000_0608;
+  ALU_operation <= 6'd46; // Rotate Right
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h78123456) begin
+    $display("\nError: RORI operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h1234_5678;
+  operand_B     <= 32'h0000_0698;
+  ALU_operation <= 6'd47; // Byte Reverse
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h78563412) begin
+    $display("\nError: REV8 operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0010_0200;
+  operand_B     <= 32'h0000_0287;
+  ALU_operation <= 6'd48; // OR Combine
+  repeat (1) @ (posedge clock);
+
+  if( ALU_result !== 32'h00ffff00) begin
+    $display("\nError: ORC.B operation failed!");
+    $display("\ntb_ALU --> Test Failed!\n\n");
+    $stop();
+  end
+
   $display("\ntb_ALU --> Test Passed!\n\n");
   $stop();
 end
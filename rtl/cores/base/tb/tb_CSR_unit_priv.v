@@ -91,6 +91,7 @@ reg [ADDRESS_BITS-1:0] exception_addr;
 reg [            31:0] exception_instr;
 
 wire                    intr_branch;
+wire                    interrupt_pending;
 wire                    trap_branch;
 wire [ADDRESS_BITS-1:0] trap_target;
 
@@ -152,6 +153,7 @@ CSR_unit_priv #(
   .exception_instr(exception_instr),
 
   .intr_branch(intr_branch),
+  .interrupt_pending(interrupt_pending),
   .trap_branch(trap_branch),
   .trap_target(trap_target),
 
@@ -306,6 +306,213 @@ initial begin
     $stop();
   end
 
+  opcode_decode <= 7'b0110011; // SH1ADD
+  funct3 <= 3'b010;
+  funct7 <= 7'b0010000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd33  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b10  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: SH1ADD operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0110011; // ANDN
+  funct3 <= 3'b111;
+  funct7 <= 7'b0100000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd36  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b11  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: ANDN operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0010011; // CLZ
+  funct3 <= 3'b001;
+  funct7 <= 7'b0110000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd39  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b1   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: CLZ operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0110011; // MAX
+  funct3 <= 3'b110;
+  funct7 <= 7'b0000101;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd40  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b10  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: MAX operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0110011; // ROL
+  funct3 <= 3'b001;
+  funct7 <= 7'b0110000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd45  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: ROL operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0010011; // RORI
+  funct3 <= 3'b101;
+  funct7 <= 7'b0110000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd46  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b1   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: RORI operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0010011; // REV8
+  funct3 <= 3'b101;
+  funct7 <= 7'b0110100;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd47  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b1   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: REV8 operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b1110111; // ADD16
+  funct3 <= 3'b000;
+  funct7 <= 7'b0100000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd57  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b00  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: ADD16 operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b1110111; // KMDA
+  funct3 <= 3'b001;
+  funct7 <= 7'b0011100;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd58  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: KMDA operation failed!");
+    $display("\ntb_control_unit--> Test Failed!\n\n");
+    $stop();
+  end
+
   $display("\ntb_control_unit--> Test Passed!\n\n");
   $stop();
 
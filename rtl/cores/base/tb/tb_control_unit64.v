@@ -356,6 +356,236 @@ initial begin
     $stop();
   end
 
+  opcode_decode <= 7'b0110011; // SH2ADD
+  funct3 <= 3'b100;
+  funct7 <= 7'b0010000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd34  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b00  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: SH2ADD operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0010011; // RORI
+  funct3 <= 3'b101;
+  funct7 <= 7'b0110001;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd46  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b1   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: RORI operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0010011; // REV8
+  funct3 <= 3'b101;
+  funct7 <= 7'b0110101;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd47  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b1   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: REV8 operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0111011; // ADD.UW
+  funct3 <= 3'b000;
+  funct7 <= 7'b0000100;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd49  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b00  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: ADD.UW operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0111011; // SH3ADD.UW
+  funct3 <= 3'b110;
+  funct7 <= 7'b0010000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd52  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b10  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: SH3ADD.UW operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0011011; // SLLI.UW
+  funct3 <= 3'b001;
+  funct7 <= 7'b0000101;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd53  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b1   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: SLLI.UW operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0011011; // CPOPW
+  funct3 <= 3'b001;
+  funct7 <= 7'b0110000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd54  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b1   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: CPOPW operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b0111011; // RORW
+  funct3 <= 3'b101;
+  funct7 <= 7'b0110000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd56  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b1   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: RORW operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b1110111; // ADD16
+  funct3 <= 3'b000;
+  funct7 <= 7'b0100000;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd57  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b00  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: ADD16 operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
+  opcode_decode <= 7'b1110111; // KMDA
+  funct3 <= 3'b001;
+  funct7 <= 7'b0011100;
+  repeat (1) @ (posedge clock);
+
+  if( branch_op     !== 1'b0   |
+      memRead       !== 1'b0   |
+      ALU_operation !== 6'd58  |
+      memWrite      !== 1'b0   |
+      log2_bytes    !== 2'b01  |
+      unsigned_load !== 1'b0   |
+      next_PC_sel   !== 2'b00  |
+      operand_A_sel !== 2'b00  |
+      operand_B_Sel !== 1'b0   |
+      extend_sel    !== 2'b00  |
+      regWrite      !== 1'b1   ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: KMDA operation failed!");
+    $display("\ntb_control_unit64 --> Test Failed!\n\n");
+    $stop();
+  end
+
   $display("\ntb_control_unit64 --> Test Passed!\n\n");
   $stop();
 
@@ -0,0 +1,166 @@
+/** @module : tb_dual_write_regFile
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_dual_write_regFile();
+
+reg clock;
+reg reset;
+reg wEn1;
+reg [31:0] write_data1;
+reg [4:0] write_sel1;
+reg wEn2;
+reg [31:0] write_data2;
+reg [4:0] write_sel2;
+reg [4:0] read_sel1;
+reg [4:0] read_sel2;
+reg [4:0] read_sel3;
+reg [4:0] read_sel4;
+
+wire [31:0] read_data1;
+wire [31:0] read_data2;
+wire [31:0] read_data3;
+wire [31:0] read_data4;
+
+dual_write_regFile uut (
+  .clock(clock),
+  .reset(reset),
+  .wEn1(wEn1),
+  .write_data1(write_data1),
+  .write_sel1(write_sel1),
+  .wEn2(wEn2),
+  .write_data2(write_data2),
+  .write_sel2(write_sel2),
+  .read_sel1(read_sel1),
+  .read_sel2(read_sel2),
+  .read_sel3(read_sel3),
+  .read_sel4(read_sel4),
+  .read_data1(read_data1),
+  .read_data2(read_data2),
+  .read_data3(read_data3),
+  .read_data4(read_data4)
+);
+
+
+always #5 clock = ~clock;
+
+integer data;
+integer addr;
+
+initial begin
+  clock = 1'b1;
+  reset = 1'b1;
+  wEn1 = 1'b0;
+  wEn2 = 1'b0;
+  write_data1 = 32'h00000000;
+  write_data2 = 32'h00000000;
+  write_sel1 = 5'd0;
+  write_sel2 = 5'd0;
+  read_sel1 = 5'd0;
+  read_sel2 = 5'd1;
+  read_sel3 = 5'd2;
+  read_sel4 = 5'd3;
+
+  #1
+  #20
+  reset = 1'b0;
+  #10
+  // Write two registers per cycle, even registers on port 1 and odd
+  // registers on port 2
+  for(addr=0; addr<32; addr= addr+2) begin
+    wEn1 = 1'b1;
+    wEn2 = 1'b1;
+    write_sel1 = addr;
+    write_sel2 = addr+1;
+    write_data1 = 100 + addr;
+    write_data2 = 101 + addr;
+    #10;
+  end
+  wEn1 = 1'b0;
+  wEn2 = 1'b0;
+  #10
+  // Check write data
+  for(addr=1; addr<32; addr= addr+1) begin
+    if(uut.register_file[addr] != 100 + addr) begin
+      $display("\nError: unexpected data in register file!");
+      $display("\ntb_dual_write_regFile --> Test Failed!\n\n");
+      $stop();
+    end
+  end
+
+  // Read data from each register on all read ports
+  for(addr=1; addr<32; addr= addr+1) begin
+    read_sel1 = addr;
+    read_sel2 = addr;
+    read_sel3 = addr;
+    read_sel4 = addr;
+    #10
+    if(read_data1 != 100 + addr | read_data2 != 100 + addr |
+       read_data3 != 100 + addr | read_data4 != 100 + addr) begin
+      $display("\nError: unexpected data from a read port!");
+      $display("\ntb_dual_write_regFile --> Test Failed!\n\n");
+      $stop();
+    end
+  end
+
+  read_sel1 = 0;
+  #10
+
+  // Check that register 0 is always 0x00000000
+  if(read_data1 != 0) begin
+      $display("\nError: Register 0 is not 0x00000000!");
+      $display("\ntb_dual_write_regFile --> Test Failed!\n\n");
+      $stop();
+  end
+
+  // Both ports write register 5, port 2 must win
+  write_sel1 = 5;
+  write_sel2 = 5;
+  write_data1 = 32'h11111111;
+  write_data2 = 32'h22222222;
+  wEn1 = 1'b1;
+  wEn2 = 1'b1;
+  read_sel2 = 5;
+
+  #1 // small delay before clock edge
+
+  // read during write check - make sure old data is read
+  if(read_data2 != 105) begin
+    $display("\nError: Did not read old data with read during write!");
+    $display("\ntb_dual_write_regFile --> Test Failed!\n\n");
+    $stop();
+  end
+  #9
+  wEn1 = 1'b0;
+  wEn2 = 1'b0;
+  #10
+
+  if(read_data2 != 32'h22222222) begin
+    $display("\nError: Write port 2 did not win a write conflict!");
+    $display("\ntb_dual_write_regFile --> Test Failed!\n\n");
+    $stop();
+  end
+
+  $display("\ntb_dual_write_regFile --> Test Passed!\n\n");
+  $stop();
+end
+
+endmodule
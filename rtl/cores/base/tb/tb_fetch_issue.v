@@ -36,6 +36,16 @@ wire [ADDRESS_BITS-1:0] i_mem_read_address;
 
 reg  scan;
 
+// Compressed fetch issue
+reg  receive_valid;
+reg  [ADDRESS_BITS-1:0] receive_next_PC;
+reg  receive_next_tail;
+reg  [15:0] receive_next_half;
+wire [ADDRESS_BITS-1:0] issue_PC_c;
+wire issue_tail_c;
+wire [15:0] issue_half_c;
+wire [ADDRESS_BITS-1:0] i_mem_read_address_c;
+
 //instantiate DUT
 fetch_issue #(
   .RESET_PC(RESET_PC),
@@ -46,10 +56,36 @@ fetch_issue #(
   .next_PC_select(next_PC_select),
   .target_PC(target_PC),
   .issue_PC(issue_PC),
+  .issue_tail(),
+  .issue_half(),
+  .receive_valid(1'b0),
+  .receive_next_PC({ADDRESS_BITS{1'b0}}),
+  .receive_next_tail(1'b0),
+  .receive_next_half(16'd0),
   .i_mem_read_address(i_mem_read_address),
   .scan(scan)
 );
 
+fetch_issue #(
+  .RESET_PC(RESET_PC),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .COMPRESSED(1)
+) DUT_C (
+  .clock(clock),
+  .reset(reset),
+  .next_PC_select(next_PC_select),
+  .target_PC(target_PC),
+  .issue_PC(issue_PC_c),
+  .issue_tail(issue_tail_c),
+  .issue_half(issue_half_c),
+  .receive_valid(receive_valid),
+  .receive_next_PC(receive_next_PC),
+  .receive_next_tail(receive_next_tail),
+  .receive_next_half(receive_next_half),
+  .i_mem_read_address(i_mem_read_address_c),
+  .scan(scan)
+);
+
 // generate clock signal
 always #5 clock = ~clock;
 
@@ -60,13 +96,18 @@ initial begin
   target_PC      = 0;
   scan           = 0;
 
+  receive_valid     = 1'b0;
+  receive_next_PC   = 0;
+  receive_next_tail = 1'b0;
+  receive_next_half = 16'd0;
+
   repeat (3) @ (posedge clock);
   reset          = 1'b0;
   next_PC_select = 0;
 
   repeat (1) @ (posedge clock);
   #1
-  if(issue_PC !== 4)begin
+  if(issue_PC !== 4 | i_mem_read_address !== 4)begin
     $display("\nTest 1 Error!");
     $display("\ntb_fetch_issue --> Test Failed!\n\n");
     $stop;
@@ -74,7 +115,7 @@ initial begin
 
   repeat (1) @ (posedge clock);
   #1
-  if(issue_PC !== 8)begin
+  if(issue_PC !== 8 | i_mem_read_address !== 8)begin
     $display("\nTest 2 Error!");
     $display("\ntb_fetch_issue --> Test Failed!\n\n");
     $stop;
@@ -82,7 +123,7 @@ initial begin
 
   repeat (1) @ (posedge clock);
   #1
-  if(issue_PC !== 32'd12)begin
+  if(issue_PC !== 32'd12 | i_mem_read_address !== 32'd12)begin
     $display("\nTest 3 Error!");
     $display("\ntb_fetch_issue --> Test Failed!\n\n");
     $stop;
@@ -92,13 +133,130 @@ initial begin
   target_PC      = 32'h8000;
   repeat (1) @ (posedge clock);
   #1
-  if(issue_PC != 32'h8000)begin
+  if(issue_PC != 32'h8000 | i_mem_read_address != 32'h8000)begin
     $display("\nTest 4 Error!");
     $display("\ntb_fetch_issue --> Test Failed!\n\n");
     $stop;
   end
 
+  // Compressed instructions. Jump to a halfword in the middle of a word.
+  next_PC_select = 2'b10;
+  target_PC      = 32'h00000102;
+  repeat (1) @ (posedge clock);
+  #1
+  // Without COMPRESSED the PC is issued unchanged
+  if(issue_PC !== 32'h102 | i_mem_read_address !== 32'h102)begin
+    $display("\nTest 5 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+  if(issue_PC_c !== 32'h102 | issue_tail_c !== 1'b0 |
+     i_mem_read_address_c !== 32'h100)begin
+    $display("\nTest 6 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // The next fetch follows fetch receive. A compressed instruction at 0x102
+  // is followed by a 32 bit instruction at 0x104.
+  next_PC_select = 2'b00;
+  repeat (1) @ (posedge clock);
+  #1
+  receive_valid     = 1'b1;
+  receive_next_PC   = 32'h104;
+  #1
+  if(issue_PC_c !== 32'h104 | issue_tail_c !== 1'b0 |
+     i_mem_read_address_c !== 32'h104)begin
+    $display("\nTest 7 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // A compressed instruction at 0x108, then a 32 bit instruction at 0x10A
+  // that straddles two words. Its tail fetch reads the word at 0x10C.
+  repeat (1) @ (posedge clock);
+  #1
+  receive_next_PC   = 32'h108;
+  #1
+  if(issue_PC_c !== 32'h108 | i_mem_read_address_c !== 32'h108)begin
+    $display("\nTest 8 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+  repeat (1) @ (posedge clock);
+  #1
+  receive_next_PC   = 32'h10A;
+  #1
+  if(issue_PC_c !== 32'h10A | issue_tail_c !== 1'b0 |
+     i_mem_read_address_c !== 32'h108)begin
+    $display("\nTest 9 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+  repeat (1) @ (posedge clock);
+  #1
+  receive_next_PC   = 32'h10A;
+  receive_next_tail = 1'b1;
+  receive_next_half = 16'h0513;
+  #1
+  if(issue_PC_c !== 32'h10A | issue_tail_c !== 1'b1 |
+     issue_half_c !== 16'h0513 | i_mem_read_address_c !== 32'h10C)begin
+    $display("\nTest 10 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // Stall on the tail fetch. Fetch receive only holds the data for one
+  // cycle, the tail fetch must be kept.
+  next_PC_select = 2'b01;
+  repeat (1) @ (posedge clock);
+  #1
+  receive_next_PC   = 32'h0;
+  receive_next_tail = 1'b0;
+  receive_next_half = 16'h0;
+  #1
+  if(issue_PC_c !== 32'h10A | issue_tail_c !== 1'b1 |
+     issue_half_c !== 16'h0513 | i_mem_read_address_c !== 32'h10C)begin
+    $display("\nTest 11 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+  repeat (1) @ (posedge clock);
+  #1
+  if(issue_PC_c !== 32'h10A | issue_tail_c !== 1'b1 |
+     i_mem_read_address_c !== 32'h10C)begin
+    $display("\nTest 12 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // The tail completes the instruction, fetch continues at 0x10E
+  next_PC_select = 2'b00;
+  repeat (1) @ (posedge clock);
+  #1
+  receive_next_PC   = 32'h10E;
+  #1
+  if(issue_PC_c !== 32'h10E | issue_tail_c !== 1'b0 |
+     i_mem_read_address_c !== 32'h10C)begin
+    $display("\nTest 13 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // A jump drops the fetch receive PC
+  next_PC_select = 2'b10;
+  target_PC      = 32'h00000200;
+  repeat (1) @ (posedge clock);
+  #1
+  if(issue_PC_c !== 32'h200 | issue_tail_c !== 1'b0 |
+     i_mem_read_address_c !== 32'h200)begin
+    $display("\nTest 14 Error!");
+    $display("\ntb_fetch_issue --> Test Failed!\n\n");
+    $stop;
+  end
+
   next_PC_select = 0;
+  receive_valid  = 1'b0;
 
   repeat (1) @ (posedge clock);
   $display("\ntb_fetch_issue --> Test Passed!\n\n");
@@ -32,6 +32,17 @@ reg  flush;
 reg  scan;
 wire [31  :0] instruction;
 
+// Compressed fetch receive
+reg  issue_tail;
+reg  [15:0] issue_half;
+wire [31  :0] instruction_c;
+wire compressed_c;
+wire complete_c;
+wire [ADDRESS_BITS-1:0] fetch_address_c;
+wire [ADDRESS_BITS-1:0] next_PC_c;
+wire next_tail_c;
+wire [15:0] next_half_c;
+
 //instantiate fetch_receive module
 fetch_receive #(
   .DATA_WIDTH(DATA_WIDTH),
@@ -40,12 +51,42 @@ fetch_receive #(
   .flush(flush),
   .i_mem_data(i_mem_data),
   .issue_PC(issue_PC),
+  .issue_tail(1'b0),
+  .issue_half(16'd0),
   .instruction(instruction),
+  .compressed(),
+  .complete(),
+  .fetch_address(),
+  .next_PC(),
+  .next_tail(),
+  .next_half(),
+  .scan(scan)
+);
+
+fetch_receive #(
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .COMPRESSED(1)
+) DUT_C (
+  .flush(flush),
+  .i_mem_data(i_mem_data),
+  .issue_PC(issue_PC),
+  .issue_tail(issue_tail),
+  .issue_half(issue_half),
+  .instruction(instruction_c),
+  .compressed(compressed_c),
+  .complete(complete_c),
+  .fetch_address(fetch_address_c),
+  .next_PC(next_PC_c),
+  .next_tail(next_tail_c),
+  .next_half(next_half_c),
   .scan(scan)
 );
 
 initial begin
   flush      <= 0;
+  issue_tail <= 0;
+  issue_half <= 16'd0;
   i_mem_data <= 32'hFEFEFEFE;
   issue_PC   <= 32'd0;
   scan       <= 0;
@@ -88,6 +129,82 @@ initial begin
     $stop;
   end
 
+  // Compressed instructions. c.li a0,1 in the low halfword and the first
+  // halfword of addi a0,x0,1 in the high halfword.
+  #5;
+  i_mem_data <= 32'h05134505;
+  issue_PC   <= 32'd0;
+  #1;
+  if(instruction_c !== 32'h00100513 | compressed_c !== 1'b1 |
+     complete_c !== 1'b1 | next_PC_c !== 32'd2 | next_tail_c !== 1'b0 |
+     fetch_address_c !== 32'd0)begin
+    $display("Test 5 Error!");
+    $display("\ntb_fetch_receive --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // The 32 bit instruction at 2 straddles two words. It is not complete
+  // until the tail fetch returns the next word.
+  #5;
+  issue_PC   <= 32'd2;
+  #1;
+  if(instruction_c !== NOP | compressed_c !== 1'b0 | complete_c !== 1'b0 |
+     next_PC_c !== 32'd2 | next_tail_c !== 1'b1 | next_half_c !== 16'h0513 |
+     fetch_address_c !== 32'd0)begin
+    $display("Test 6 Error!");
+    $display("\ntb_fetch_receive --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // Tail fetch of the word at 4
+  #5;
+  i_mem_data <= 32'h45050010;
+  issue_tail <= 1'b1;
+  issue_half <= 16'h0513;
+  #1;
+  if(instruction_c !== 32'h00100513 | compressed_c !== 1'b0 |
+     complete_c !== 1'b1 | next_PC_c !== 32'd6 | next_tail_c !== 1'b0 |
+     fetch_address_c !== 32'd4)begin
+    $display("Test 7 Error!");
+    $display("\ntb_fetch_receive --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // Compressed instruction in the high halfword after the tail
+  #5;
+  issue_PC   <= 32'd6;
+  issue_tail <= 1'b0;
+  issue_half <= 16'd0;
+  #1;
+  if(instruction_c !== 32'h00100513 | compressed_c !== 1'b1 |
+     complete_c !== 1'b1 | next_PC_c !== 32'd8 | fetch_address_c !== 32'd4)begin
+    $display("Test 8 Error!");
+    $display("\ntb_fetch_receive --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // Word aligned 32 bit instruction
+  #5;
+  i_mem_data <= 32'h00100513;
+  issue_PC   <= 32'd8;
+  #1;
+  if(instruction_c !== 32'h00100513 | compressed_c !== 1'b0 |
+     complete_c !== 1'b1 | next_PC_c !== 32'd12 | fetch_address_c !== 32'd8)begin
+    $display("Test 9 Error!");
+    $display("\ntb_fetch_receive --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // Flush
+  #5;
+  flush      <= 1;
+  #1;
+  if(instruction_c !== NOP | complete_c !== 1'b0)begin
+    $display("Test 10 Error!");
+    $display("\ntb_fetch_receive --> Test Failed!\n\n");
+    $stop;
+  end
+
   $display("\ntb_fetch_receive --> Test Passed!\n\n");
   $stop;
 
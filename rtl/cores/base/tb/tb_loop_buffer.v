@@ -0,0 +1,187 @@
+/** @module : tb_loop_buffer
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_loop_buffer();
+
+parameter CORE              = 0;
+parameter DATA_WIDTH        = 32;
+parameter ADDRESS_BITS      = 32;
+parameter LOOP_BUFFER_WORDS = 8;
+parameter SCAN_CYCLES_MIN   = 0;
+parameter SCAN_CYCLES_MAX   = 1000;
+
+reg clock;
+reg reset;
+reg [1:0] next_PC_select;
+reg [ADDRESS_BITS-1:0] target_PC;
+reg invalidate;
+reg fetch_read;
+reg [ADDRESS_BITS-1:0] fetch_address_out;
+wire [DATA_WIDTH-1  :0] fetch_data_in;
+wire [ADDRESS_BITS-1:0] fetch_address_in;
+wire fetch_valid;
+wire fetch_ready;
+wire i_mem_read;
+wire [ADDRESS_BITS-1:0] i_mem_address_in;
+reg  [DATA_WIDTH-1  :0] i_mem_data_out;
+reg  [ADDRESS_BITS-1:0] i_mem_address_out;
+reg  i_mem_valid;
+reg  scan;
+
+integer x;
+
+loop_buffer #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .next_PC_select(next_PC_select),
+  .target_PC(target_PC),
+  .invalidate(invalidate),
+  .fetch_read(fetch_read),
+  .fetch_address_out(fetch_address_out),
+  .fetch_data_in(fetch_data_in),
+  .fetch_address_in(fetch_address_in),
+  .fetch_valid(fetch_valid),
+  .fetch_ready(fetch_ready),
+  .i_mem_read(i_mem_read),
+  .i_mem_address_in(i_mem_address_in),
+  .i_mem_data_out(i_mem_data_out),
+  .i_mem_address_out(i_mem_address_out),
+  .i_mem_valid(i_mem_valid),
+  .i_mem_ready(1'b1),
+  .scan(scan)
+);
+
+// Clock generator
+always #1 clock = ~clock;
+
+// Instruction memory with one cycle latency. The data is the address in the
+// low half so every word is different.
+always @(posedge clock) begin
+  i_mem_valid       <= ~reset & i_mem_read;
+  i_mem_address_out <= i_mem_address_in;
+  i_mem_data_out    <= {16'hC0DE, i_mem_address_in[15:0]};
+end
+
+initial begin
+  clock             = 1;
+  reset             = 1;
+  scan              = 0;
+  fetch_read        = 0;
+  fetch_address_out = 0;
+  next_PC_select    = 2'b00;
+  target_PC         = 0;
+  invalidate        = 0;
+
+  repeat (2) @ (posedge clock);
+  reset      <= 0;
+  fetch_read <= 1;
+
+  // Straight line code, no loop detected yet
+  for(x=0; x<8; x=x+1) begin
+    fetch_address_out <= 4*x;
+    @(negedge clock);
+    if(i_mem_read !== 1'b1) begin
+    $display("\nError: Fetch without a loop did not read the instruction memory!");
+    $display("\ntb_loop_buffer --> Test Failed!\n\n");
+    $stop();
+    end
+    @(posedge clock);
+  end
+
+  // A branch at 0x14 back to 0x08 resolves while 0x1C is fetched
+  next_PC_select    <= 2'b10;
+  target_PC         <= 32'h00000008;
+  fetch_address_out <= 32'h0000001C;
+  @(posedge clock);
+  next_PC_select    <= 2'b00;
+
+  // First iteration comes from the instruction memory and is captured
+  for(x=2; x<6; x=x+1) begin
+    fetch_address_out <= 4*x;
+    @(negedge clock);
+    if(i_mem_read !== 1'b1) begin
+    $display("\nError: First loop iteration did not read the instruction memory!");
+    $display("\ntb_loop_buffer --> Test Failed!\n\n");
+    $stop();
+    end
+    @(posedge clock);
+  end
+
+  // Second iteration, the window start does not change
+  next_PC_select    <= 2'b10;
+  target_PC         <= 32'h00000008;
+  fetch_address_out <= 32'h00000018;
+  @(posedge clock);
+  next_PC_select    <= 2'b00;
+  fetch_address_out <= 32'h00000008;
+  @(negedge clock);
+  if(i_mem_read !== 1'b0 | fetch_ready !== 1'b1) begin
+    $display("\nError: Loop buffer hit read the instruction memory!");
+    $display("\ntb_loop_buffer --> Test Failed!\n\n");
+    $stop();
+  end
+
+  @(posedge clock);
+  fetch_address_out <= 32'h0000000C;
+  @(negedge clock);
+  if(fetch_valid      !== 1'b1         |
+     fetch_address_in !== 32'h00000008 |
+     fetch_data_in    !== 32'hC0DE0008 |
+     i_mem_read       !== 1'b0         ) begin
+    $display("\nError: Loop buffer returned the wrong instruction!");
+    $display("\ntb_loop_buffer --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // fence.i empties the buffer
+  @(posedge clock);
+  invalidate        <= 1'b1;
+  fetch_address_out <= 32'h00000010;
+  @(negedge clock);
+  if(fetch_data_in !== 32'hC0DE000C | i_mem_read !== 1'b1) begin
+    $display("\nError: Invalidate did not send the fetch to the instruction memory!");
+    $display("\ntb_loop_buffer --> Test Failed!\n\n");
+    $stop();
+  end
+
+  @(posedge clock);
+  invalidate        <= 1'b0;
+  fetch_address_out <= 32'h00000008;
+  @(negedge clock);
+  if(i_mem_read !== 1'b1 | DUT.hit_count !== 32'd2) begin
+    $display("\nError: Loop buffer was not emptied by invalidate!");
+    $display("\ntb_loop_buffer --> Test Failed!\n\n");
+    $stop();
+  end
+
+  $display("\ntb_loop_buffer --> Test Passed!\n\n");
+  $stop();
+end
+
+endmodule
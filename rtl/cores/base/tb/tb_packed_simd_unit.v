@@ -0,0 +1,362 @@
+/** @module : tb_packed_simd_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_packed_simd_unit();
+
+parameter SCAN_CYCLES_MIN = 0;
+parameter SCAN_CYCLES_MAX = 1000;
+
+reg clock;
+reg [5:0] ALU_operation;
+reg [6:0] funct7;
+reg [4:0] rs2_field;
+reg [31:0] operand_A;
+reg [31:0] operand_B;
+wire [31:0] packed_result;
+
+// Not in packed_simd_unit module
+reg scan;
+reg [31:0] cycles;
+
+packed_simd_unit #(
+  .DATA_WIDTH(32)
+) DUT (
+  .ALU_operation(ALU_operation),
+  .funct7(funct7),
+  .rs2_field(rs2_field),
+  .operand_A(operand_A),
+  .operand_B(operand_B),
+  .packed_result(packed_result)
+);
+
+// Clock generator
+always #1 clock = ~clock;
+
+initial begin
+  clock  = 0;
+  scan   = 0;
+  cycles = 0;
+
+  repeat (1) @ (posedge clock);
+
+  operand_A     <= 32'h7fff_0001;
+  operand_B     <= 32'h0001_0002;
+  funct7        <= 7'b0100000;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // add16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h80000003) begin
+    $display("\nError: ADD16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0001_0005;
+  operand_B     <= 32'h0002_0003;
+  funct7        <= 7'b0100001;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // sub16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'hffff0002) begin
+    $display("\nError: SUB16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h7fff_8000;
+  operand_B     <= 32'h7fff_8000;
+  funct7        <= 7'b0000000;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // radd16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h7fff8000) begin
+    $display("\nError: RADD16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h7fff_8000;
+  operand_B     <= 32'h0001_8000;
+  funct7        <= 7'b0001000;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // kadd16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h7fff8000) begin
+    $display("\nError: KADD16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h8000_7fff;
+  operand_B     <= 32'h0001_ffff;
+  funct7        <= 7'b0001001;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // ksub16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h80007fff) begin
+    $display("\nError: KSUB16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hfff0_0010;
+  operand_B     <= 32'h0020_0020;
+  funct7        <= 7'b0011000;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // ukadd16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'hffff0030) begin
+    $display("\nError: UKADD16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0010_0030;
+  operand_B     <= 32'h0020_0010;
+  funct7        <= 7'b0011001;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // uksub16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h00000020) begin
+    $display("\nError: UKSUB16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h01ff_7f80;
+  operand_B     <= 32'h0101_017f;
+  funct7        <= 7'b0100100;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // add8
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h020080ff) begin
+    $display("\nError: ADD8 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hf010_2030;
+  operand_B     <= 32'h2010_1010;
+  funct7        <= 7'b0011100;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // ukadd8
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'hff203040) begin
+    $display("\nError: UKADD8 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h8040_7f00;
+  operand_B     <= 32'h01c0_ff01;
+  funct7        <= 7'b0001101;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // ksub8
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h807f7fff) begin
+    $display("\nError: KSUB8 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h8000_fff0;
+  operand_B     <= 32'h0000_0004;
+  funct7        <= 7'b0101000;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // sra16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'hf800ffff) begin
+    $display("\nError: SRA16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h8000_0040;
+  operand_B     <= 32'h0000_0000;
+  funct7        <= 7'b0111001;
+  rs2_field     <= 5'b00011;
+  ALU_operation <= 6'd57; // srli16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h10000008) begin
+    $display("\nError: SRLI16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h2000_1000;
+  operand_B     <= 32'h0000_0000;
+  funct7        <= 7'b0111010;
+  rs2_field     <= 5'b10010;
+  ALU_operation <= 6'd57; // kslli16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h7fff4000) begin
+    $display("\nError: KSLLI16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h1234_5678;
+  operand_B     <= 32'h1234_0000;
+  funct7        <= 7'b0100110;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // cmpeq16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'hffff0000) begin
+    $display("\nError: CMPEQ16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hffff_0001;
+  operand_B     <= 32'h0001_0000;
+  funct7        <= 7'b0000110;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // scmplt16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'hffff0000) begin
+    $display("\nError: SCMPLT16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'hffff_0001;
+  operand_B     <= 32'h0001_0002;
+  funct7        <= 7'b1001001;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // umax16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'hffff0002) begin
+    $display("\nError: UMAX16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h8000_4000;
+  operand_B     <= 32'h8000_4000;
+  funct7        <= 7'b1000011;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd57; // khm16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h7fff2000) begin
+    $display("\nError: KHM16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0003_0004;
+  operand_B     <= 32'h0005_0006;
+  funct7        <= 7'b0011100;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd58; // kmda
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h00000027) begin
+    $display("\nError: KMDA operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h8000_8000;
+  operand_B     <= 32'h8000_8000;
+  funct7        <= 7'b0011101;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd58; // kmxda
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h7fffffff) begin
+    $display("\nError: KMXDA operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h0002_0003;
+  operand_B     <= 32'h0004_0005;
+  funct7        <= 7'b0110100;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd58; // smdrs
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h00000007) begin
+    $display("\nError: SMDRS operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h1111_aaaa;
+  operand_B     <= 32'h2222_bbbb;
+  funct7        <= 7'b0000111;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd58; // pkbb16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'haaaabbbb) begin
+    $display("\nError: PKBB16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  operand_A     <= 32'h1111_aaaa;
+  operand_B     <= 32'h2222_bbbb;
+  funct7        <= 7'b0010111;
+  rs2_field     <= 5'b00000;
+  ALU_operation <= 6'd58; // pktt16
+  repeat (1) @ (posedge clock);
+
+  if( packed_result !== 32'h11112222) begin
+    $display("\nError: PKTT16 operation failed!");
+    $display("\ntb_packed_simd_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+
+  $display("\ntb_packed_simd_unit --> Test Passed!\n\n");
+  $stop();
+end
+
+// Scan reporting logic is in test bench because no clock is fed to packed_simd_unit.
+always @ (posedge clock) begin
+  cycles <= cycles+1;
+  if(scan & ((cycles >= SCAN_CYCLES_MIN) & (cycles <= SCAN_CYCLES_MAX)) ) begin
+    $display ("ALU_operation [%d], funct7 [%b] operand_A [%h] operand_B [%h]", ALU_operation, funct7, operand_A, operand_B);
+    $display ("packed_result [%h] ", packed_result);
+  end
+end
+
+
+endmodule
@@ -102,6 +102,7 @@ wire [3:0] exception_code_memory_receive;
 wire m_ret_decode;
 wire s_ret_decode;
 wire u_ret_decode;
+wire wfi_decode;
 
 wire [ADDRESS_BITS-1:0] trap_PC;
 
@@ -181,6 +182,7 @@ priv_control #(
   .m_ret_decode(m_ret_decode),
   .s_ret_decode(s_ret_decode),
   .u_ret_decode(u_ret_decode),
+  .wfi_decode(wfi_decode),
 
   .trap_PC(trap_PC),
 
@@ -348,6 +350,43 @@ initial begin
     $stop();
   end
 
+  // wfi interrupted while waiting in decode
+  opcode_decode = SYSTEM;
+  funct3        = 3'b000;
+  funct7        = 7'b0001000;
+  rs1           = 5'b00000;
+  rs2           = 5'b00101;
+
+  priv = MACHINE;
+
+  issue_PC               = 32'h00000001;
+  inst_PC_fetch_receive  = 32'h00000001;
+  inst_PC_decode         = 32'h00000040;
+  inst_PC_execute        = 32'h00000001;
+  inst_PC_memory_issue   = 32'h00000001;
+  inst_PC_memory_receive = 32'h00000001;
+  intr_branch            = 1'b1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  if( wfi_decode            !== 1'b1 |
+      s_ret_decode          !== 1'b0 |
+      exception_decode      !== 1'b0 |
+      trap_PC               !== 32'h00000044 ) begin
+
+    $display("Error: Unexpected control signals for interrupted WFI!");
+    $display("\ntb_priv_control --> Test Failed!\n\n");
+    $stop();
+  end
+
+  issue_PC               = 0;
+  inst_PC_fetch_receive  = 0;
+  inst_PC_decode         = 0;
+  inst_PC_execute        = 0;
+  inst_PC_memory_issue   = 0;
+  inst_PC_memory_receive = 0;
+  intr_branch            = 1'b0;
+
   // Illegal CSR access
   opcode_decode = SYSTEM;
   funct3        = 3'b001;
@@ -0,0 +1,94 @@
+/** @module : tb_rvc_expander
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_rvc_expander();
+
+reg  [15:0] compressed_instruction;
+wire [31:0] instruction32;
+wire [31:0] instruction64;
+
+integer errors;
+
+rvc_expander #(
+  .DATA_WIDTH(32)
+) DUT32 (
+  .compressed_instruction(compressed_instruction),
+  .instruction(instruction32)
+);
+
+rvc_expander #(
+  .DATA_WIDTH(64)
+) DUT64 (
+  .compressed_instruction(compressed_instruction),
+  .instruction(instruction64)
+);
+
+task check;
+  input [15:0] in;
+  input [31:0] expected32;
+  input [31:0] expected64;
+  begin
+    compressed_instruction = in;
+    #1;
+    if(instruction32 !== expected32 | instruction64 !== expected64) begin
+      $display("Error: %h expanded to %h/%h, expected %h/%h", in,
+               instruction32, instruction64, expected32, expected64);
+      errors = errors + 1;
+    end
+  end
+endtask
+
+initial begin
+  errors = 0;
+
+  check(16'h0800, 32'h01010413, 32'h01010413); // c.addi4spn s0,sp,16
+  check(16'h4188, 32'h0005a503, 32'h0005a503); // c.lw a0,0(a1)
+  check(16'hc188, 32'h00a5a023, 32'h00a5a023); // c.sw a0,0(a1)
+  check(16'h6188, 32'h00000000, 32'h0005b503); // c.flw / c.ld a0,0(a1)
+  check(16'h0505, 32'h00150513, 32'h00150513); // c.addi a0,1
+  check(16'h1141, 32'hff010113, 32'hff010113); // c.addi sp,-16
+  check(16'h2505, 32'h620000ef, 32'h0015051b); // c.jal 0x620 / c.addiw a0,1
+  check(16'h4501, 32'h00000513, 32'h00000513); // c.li a0,0
+  check(16'h6505, 32'h00001537, 32'h00001537); // c.lui a0,1
+  check(16'h8505, 32'h40155513, 32'h40155513); // c.srai a0,1
+  check(16'h8d89, 32'h40a585b3, 32'h40a585b3); // c.sub a1,a0
+  check(16'h9d2d, 32'h00000000, 32'h00b5053b); // c.addw a0,a1 (RV64 only)
+  check(16'ha001, 32'h0000006f, 32'h0000006f); // c.j 0
+  check(16'hc119, 32'h00050363, 32'h00050363); // c.beqz a0,6
+  check(16'hfff5, 32'hfe079ee3, 32'hfe079ee3); // c.bnez a5,-4
+  check(16'h40b2, 32'h00c12083, 32'h00c12083); // c.lwsp ra,12(sp)
+  check(16'hc606, 32'h00112623, 32'h00112623); // c.swsp ra,12(sp)
+  check(16'he022, 32'h00000000, 32'h00813023); // c.fswsp / c.sdsp s0,0(sp)
+  check(16'h8082, 32'h00008067, 32'h00008067); // c.jr ra
+  check(16'h852e, 32'h00b00533, 32'h00b00533); // c.mv a0,a1
+  check(16'h9532, 32'h00c50533, 32'h00c50533); // c.add a0,a2
+  check(16'h9002, 32'h00100073, 32'h00100073); // c.ebreak
+  check(16'h0000, 32'h00000000, 32'h00000000); // illegal
+
+  if(errors == 0)
+    $display("\ntb_rvc_expander --> Test Passed!\n\n");
+  else
+    $display("\ntb_rvc_expander --> Test Failed!\n\n");
+  $stop;
+end
+
+endmodule
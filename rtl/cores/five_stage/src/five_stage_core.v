@@ -243,6 +243,12 @@ fetch_issue #(
   .next_PC_select(next_PC_select),
   .target_PC(target_PC),
   .issue_PC(issue_PC),
+  .issue_tail(),
+  .issue_half(),
+  .receive_valid(1'b0),
+  .receive_next_PC({ADDRESS_BITS{1'b0}}),
+  .receive_next_tail(1'b0),
+  .receive_next_half(16'd0),
   // instruction cache interface
   .i_mem_read_address(fetch_address_out),
   //scan signal
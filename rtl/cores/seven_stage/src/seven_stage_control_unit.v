@@ -85,6 +85,10 @@ module seven_stage_control_unit #(
   output flush_memory_receive,
   output flush_writeback,
 
+  // Pipeline trace port
+  // {clog, JAL, JALR_branch, i_mem_recv, i_mem_issue, d_mem_recv, d_mem_issue, true_data}
+  output [7:0] hazards,
+
   // Seven Stage Bypass Unit Ports
   output [2:0] rs1_data_bypass,
   output [2:0] rs2_data_bypass,
@@ -128,6 +132,9 @@ localparam[6:0] R_TYPE  = 7'b0110011,
 localparam [6:0]IMM_32 = 7'b0011011,
                 OP_32  = 7'b0111011;
 
+// P extension (packed SIMD) opcode
+localparam [6:0]OP_P   = 7'b1110111;
+
 
 wire rs1_read;
 wire rs2_read;
@@ -177,12 +184,14 @@ generate
                       (opcode_decode == BRANCH) |
                       (opcode_decode == JALR  ) |
                       (opcode_decode == IMM_32) |
-                      (opcode_decode == OP_32 );
+                      (opcode_decode == OP_32 ) |
+                      (opcode_decode == OP_P  );
 
     assign rs2_read = (opcode_decode == R_TYPE) |
                       (opcode_decode == STORE ) |
                       (opcode_decode == BRANCH) |
-                      (opcode_decode == OP_32 );
+                      (opcode_decode == OP_32 ) |
+                      (opcode_decode == OP_P  );
   end
   else begin
     assign rs1_read = (opcode_decode == R_TYPE) |
@@ -190,11 +199,13 @@ generate
                       (opcode_decode == STORE ) |
                       (opcode_decode == LOAD  ) |
                       (opcode_decode == BRANCH) |
-                      (opcode_decode == JALR  );
+                      (opcode_decode == JALR  ) |
+                      (opcode_decode == OP_P  );
 
     assign rs2_read = (opcode_decode == R_TYPE) |
                       (opcode_decode == STORE ) |
-                      (opcode_decode == BRANCH);
+                      (opcode_decode == BRANCH) |
+                      (opcode_decode == OP_P  );
 
   end
 endgenerate
@@ -252,6 +263,16 @@ assign next_PC_sel = JALR_branch_hazard      ? 2'b10 : // target_PC
 
 assign clog = stall_decode & issue_request & fetch_valid & (issue_PC == fetch_address_in);
 
+assign hazards = { clog,
+                   JAL_hazard,
+                   JALR_branch_hazard,
+                   i_mem_recv_hazard,
+                   i_mem_issue_hazard,
+                   d_mem_recv_hazard,
+                   d_mem_issue_hazard,
+                   true_data_hazard
+                 };
+
 hazard_detection_unit #(
   .CORE(CORE),
   .ADDRESS_BITS(ADDRESS_BITS),
@@ -26,6 +26,9 @@ module seven_stage_core #(
   parameter DATA_WIDTH      = 32,
   parameter ADDRESS_BITS    = 32,
   parameter NUM_BYTES       = DATA_WIDTH/8,
+  parameter COMPRESSED      = 0,
+  parameter P_EXTENSION     = 0,
+  parameter LOOP_BUFFER_WORDS = 0,
   parameter SCAN_CYCLES_MIN = 0,
   parameter SCAN_CYCLES_MAX = 1000
 ) (
@@ -49,6 +52,21 @@ module seven_stage_core #(
   output [NUM_BYTES-1:   0] memory_byte_en,
   output [ADDRESS_BITS-1:0] memory_address_out,
   output [DATA_WIDTH-1  :0] memory_data_out,
+  //commit trace interface
+  output trace_retire,
+  output [ADDRESS_BITS-1:0] trace_PC,
+  output [31            :0] trace_instruction,
+  output trace_reg_write,
+  output [4             :0] trace_rd,
+  output [DATA_WIDTH-1  :0] trace_rd_data,
+  output trace_memory_access,
+  output trace_store,
+  output [ADDRESS_BITS-1:0] trace_memory_address,
+  //pipeline occupancy interface
+  output [5             :0] trace_stage_valid, // {WB, MR, MI, EX, ID, FR}
+  output [4             :0] trace_stall,       // {MR, MI, EX, ID, FR}
+  output [4             :0] trace_flush,       // {WB, MR, EX, ID, FR}
+  output [7             :0] trace_hazards,
   //scan signal
   input  scan
 );
@@ -67,13 +85,17 @@ localparam LOG2_NUM_BYTES  = log2(NUM_BYTES);
 
 // Pipe Parameters
 localparam FETCH_RECEIVE_PIPE_WIDTH = ADDRESS_BITS // issue_PC
+                                   + 1            // issue_tail
+                                   + 16           // issue_half
                                    + 1;           // issue_request
 
 localparam DECODE_PIPE_WIDTH = DATA_WIDTH    // instruction
-                            + ADDRESS_BITS; // inst_pc
+                            + ADDRESS_BITS  // inst_pc
+                            + 1;            // compressed
 
 
 localparam EXECUTE_PIPE_WIDTH = ADDRESS_BITS   // inst_PC
+                              + 1              // compressed
                               + DATA_WIDTH     // rs1_data
                               + DATA_WIDTH     // rs2_data
                               + 5              // rd
@@ -116,22 +138,58 @@ localparam WRITEBACK_PIPE_WIDTH = 1           // regWrite_writeback
                                + DATA_WIDTH  // ALU_result_writeback
                                + DATA_WIDTH; // load_data_writeback
 
+// Trace Pipe Parameters
+localparam TRACE_MEMORY_ISSUE_PIPE_WIDTH = 1             // valid
+                                         + ADDRESS_BITS; // inst_PC
 
+localparam TRACE_MEMORY_RECEIVE_PIPE_WIDTH = 1             // valid
+                                           + ADDRESS_BITS  // inst_PC
+                                           + 1;            // store
+
+localparam TRACE_WRITEBACK_PIPE_WIDTH = 1             // valid
+                                      + ADDRESS_BITS  // inst_PC
+                                      + 1             // memory access
+                                      + 1             // store
+                                      + ADDRESS_BITS; // memory address
+
+
+
+// Loop Buffer Wires, the fetch interface seen by the pipeline
+wire core_fetch_read;
+wire [ADDRESS_BITS-1:0] core_fetch_address_out;
+wire [DATA_WIDTH-1  :0] core_fetch_data_in;
+wire [ADDRESS_BITS-1:0] core_fetch_address_in;
+wire core_fetch_valid;
+wire core_fetch_ready;
+wire fence_i_decode;
 
 // Fetch Issue Stage Wires
 wire [ADDRESS_BITS-1:0] inst_PC_fetch;
 wire [1:0] next_PC_select;
 wire [ADDRESS_BITS-1:0] target_PC;
 wire [ADDRESS_BITS-1:0] issue_PC;
+wire issue_tail;
+wire [15:0] issue_half;
 
 // Fetch Receive Stage Wires
 wire [31:0] instruction_fetch_receive;
 wire [ADDRESS_BITS-1:0] issue_PC_fetch_receive;
+wire issue_tail_fetch_receive;
+wire [15:0] issue_half_fetch_receive;
 wire issue_request_fetch_receive;
+wire compressed_fetch_receive;
+wire complete_fetch_receive;
+wire [ADDRESS_BITS-1:0] fetch_address_fetch_receive;
+wire [ADDRESS_BITS-1:0] next_PC_fetch_receive;
+wire next_tail_fetch_receive;
+wire [15:0] next_half_fetch_receive;
+wire fetch_match;
+wire [ADDRESS_BITS-1:0] fetch_address_compare;
 
 // Decode Stage Wires
 wire [31:0] instruction_decode;
 wire [ADDRESS_BITS-1:0] inst_PC_decode;
+wire compressed_decode;
 wire [1:0] extend_sel_decode;
 wire [DATA_WIDTH-1:0] rs1_data_decode;
 wire [DATA_WIDTH-1:0] rs2_data_decode;
@@ -174,6 +232,8 @@ wire memWrite_execute;
 wire [LOG2_NUM_BYTES-1:0] log2_bytes_execute;
 wire unsigned_load_execute;
 wire [ADDRESS_BITS-1:0] inst_PC_execute;
+wire compressed_execute;
+wire [ADDRESS_BITS-1:0] link_PC_execute;
 wire [1:0] operand_A_sel_execute;
 wire operand_B_sel_execute;
 wire regWrite_execute;
@@ -258,6 +318,20 @@ wire [WRITEBACK_PIPE_WIDTH-1:0] writeback_pipe_input;
 wire [WRITEBACK_PIPE_WIDTH-1:0] writeback_pipe_flush;
 wire [WRITEBACK_PIPE_WIDTH-1:0] writeback_pipe_output;
 
+// Trace Wires
+wire valid_decode;
+wire valid_execute;
+wire valid_memory_issue;
+wire valid_memory_receive;
+wire valid_writeback;
+wire [ADDRESS_BITS-1:0] inst_PC_memory_issue;
+wire [ADDRESS_BITS-1:0] inst_PC_memory_receive;
+wire [ADDRESS_BITS-1:0] inst_PC_writeback;
+wire store_memory_receive;
+wire memory_access_writeback;
+wire store_writeback;
+wire [ADDRESS_BITS-1:0] memory_address_writeback;
+
 
 
 
@@ -268,7 +342,9 @@ assign generated_address_execute = ALU_result_execute; //in case ADDRESS_BITS an
 fetch_issue #(
   .CORE(CORE),
   .RESET_PC(RESET_PC),
+  .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
+  .COMPRESSED(COMPRESSED),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) FI (
@@ -277,23 +353,80 @@ fetch_issue #(
   .next_PC_select(next_PC_select),
   .target_PC(target_PC),
   .issue_PC(issue_PC),
+  .issue_tail(issue_tail),
+  .issue_half(issue_half),
+  .receive_valid(issue_request_fetch_receive & core_fetch_valid & fetch_match),
+  .receive_next_PC(next_PC_fetch_receive),
+  .receive_next_tail(next_tail_fetch_receive),
+  .receive_next_half(next_half_fetch_receive),
   // instruction cache interface
-  .i_mem_read_address(fetch_address_out),
+  .i_mem_read_address(core_fetch_address_out),
   //scan signal
   .scan(scan)
 );
 
 
+/*loop buffer*/
+// fence.i in decode empties the loop buffer.
+assign fence_i_decode = (instruction_decode[6:0] == 7'b0001111) & (instruction_decode[14:12] == 3'b001);
+
+generate
+  if(LOOP_BUFFER_WORDS > 0) begin : LOOP
+    loop_buffer #(
+      .CORE(CORE),
+      .DATA_WIDTH(DATA_WIDTH),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
+      .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+      .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+    ) buffer (
+      .clock(clock),
+      .reset(reset),
+      .next_PC_select(next_PC_select),
+      .target_PC(target_PC),
+      .invalidate(fence_i_decode),
+      .fetch_read(core_fetch_read),
+      .fetch_address_out(core_fetch_address_out),
+      .fetch_data_in(core_fetch_data_in),
+      .fetch_address_in(core_fetch_address_in),
+      .fetch_valid(core_fetch_valid),
+      .fetch_ready(core_fetch_ready),
+      .i_mem_read(fetch_read),
+      .i_mem_address_in(fetch_address_out),
+      .i_mem_data_out(fetch_data_in),
+      .i_mem_address_out(fetch_address_in),
+      .i_mem_valid(fetch_valid),
+      .i_mem_ready(fetch_ready),
+      .scan(scan)
+    );
+  end
+  else begin : NO_LOOP
+    assign fetch_read            = core_fetch_read;
+    assign fetch_address_out     = core_fetch_address_out;
+    assign core_fetch_data_in    = fetch_data_in;
+    assign core_fetch_address_in = fetch_address_in;
+    assign core_fetch_valid      = fetch_valid;
+    assign core_fetch_ready      = fetch_ready;
+  end
+endgenerate
+
+
 /*fetch receive*/
 assign fetch_receive_pipe_input = { issue_PC,
-                                    fetch_read
+                                    issue_tail,
+                                    issue_half,
+                                    core_fetch_read
                                   };
 
 assign fetch_receive_pipe_flush = { {ADDRESS_BITS{1'b0}},
+                                    1'b0,
+                                    16'd0,
                                     1'b0
                                   };
 
 assign { issue_PC_fetch_receive      ,
+         issue_tail_fetch_receive    ,
+         issue_half_fetch_receive    ,
          issue_request_fetch_receive } = fetch_receive_pipe_output;
 
 pipeline_register #(
@@ -317,30 +450,51 @@ pipeline_register #(
 fetch_receive #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
+  .COMPRESSED(COMPRESSED),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) FR (
   .flush(~issue_request_fetch_receive),
-  .i_mem_data(fetch_data_in),
+  .i_mem_data(core_fetch_data_in),
   .issue_PC(issue_PC_fetch_receive),
+  .issue_tail(issue_tail_fetch_receive),
+  .issue_half(issue_half_fetch_receive),
   .instruction(instruction_fetch_receive),
+  .compressed(compressed_fetch_receive),
+  .complete(complete_fetch_receive),
+  .fetch_address(fetch_address_fetch_receive),
+  .next_PC(next_PC_fetch_receive),
+  .next_tail(next_tail_fetch_receive),
+  .next_half(next_half_fetch_receive),
   //scan signal
   .scan(scan)
 );
 
-assign inst_PC_fetch     = fetch_address_in;
+assign fetch_match = core_fetch_address_in == fetch_address_fetch_receive;
+
+// With compressed instructions the memory returns the word address while the
+// fetch receive stage holds the instruction PC. The hazard detection unit
+// only compares the two, so it is given the instruction PC on a match.
+assign fetch_address_compare = (COMPRESSED == 0) ? core_fetch_address_in  :
+                               fetch_match       ? issue_PC_fetch_receive :
+                                                   ~issue_PC_fetch_receive;
+
+assign inst_PC_fetch     = COMPRESSED ? issue_PC_fetch_receive : core_fetch_address_in;
 
 
 assign decode_pipe_input = { instruction_fetch_receive,
-                             inst_PC_fetch
+                             inst_PC_fetch,
+                             compressed_fetch_receive
                            };
 
 assign decode_pipe_flush = { 32'h00000013,
-                             {ADDRESS_BITS{1'b0}}
+                             {ADDRESS_BITS{1'b0}},
+                             1'b0
                            };
 
 assign { instruction_decode,
-         inst_PC_decode } = decode_pipe_output;
+         inst_PC_decode,
+         compressed_decode } = decode_pipe_output;
 
 pipeline_register #(
   .PIPELINE_STAGE("Decode Pipe"),
@@ -439,13 +593,13 @@ seven_stage_control_unit #(
   .regWrite(regWrite_decode),
 
   .target_PC(target_PC),
-  .i_mem_read(fetch_read),
+  .i_mem_read(core_fetch_read),
 
   // Base Hazard Detection Unit Ports
-  .fetch_valid(fetch_valid),
-  .fetch_ready(fetch_ready),
+  .fetch_valid(core_fetch_valid),
+  .fetch_ready(core_fetch_ready),
   .issue_PC(issue_PC_fetch_receive),
-  .fetch_address_in(fetch_address_in),
+  .fetch_address_in(fetch_address_compare),
   .memory_valid(memory_valid),
   .memory_ready(memory_ready),
   .load_memory_receive(memRead_memory_receive), // memRead_memory_receive
@@ -466,6 +620,8 @@ seven_stage_control_unit #(
   .flush_memory_receive(flush_memory_receive),
   .flush_writeback(flush_writeback),
 
+  .hazards(trace_hazards),
+
   // Seven Stage Bypass Unit Ports
   .rs1_data_bypass(rs1_data_bypass),
   .rs2_data_bypass(rs2_data_bypass),
@@ -490,6 +646,7 @@ seven_stage_control_unit #(
 
 
 assign execute_pipe_input = { inst_PC_decode,
+                              compressed_decode,
                               rs1_data_decode,
                               rs2_data_decode,
                               rd_decode,
@@ -508,6 +665,7 @@ assign execute_pipe_input = { inst_PC_decode,
                             };
 
 assign execute_pipe_flush = { {ADDRESS_BITS{1'b0}},   // inst_PC
+                              1'b0,                   // compressed
                               {DATA_WIDTH{1'b0}},     // rs1_data,
                               {DATA_WIDTH{1'b0}},     // rs2_data,
                               5'b00000,               // rd,
@@ -526,6 +684,7 @@ assign execute_pipe_flush = { {ADDRESS_BITS{1'b0}},   // inst_PC
                             };
 
 assign { inst_PC_execute,
+         compressed_execute,
          rs1_data_execute,
          rs2_data_execute,
          rd_execute,
@@ -582,18 +741,23 @@ pipeline_register #(
 );
 
 
+// The execution unit links jal/jalr to PC+4. Expanded c.jal and c.jalr link
+// to PC+2, and nothing else in a compressed instruction reads the PC there.
+assign link_PC_execute = compressed_execute ? inst_PC_execute - 2 : inst_PC_execute;
+
 /*execute unit*/
 execution_unit #(
   .CORE(CORE),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
+  .P_EXTENSION(P_EXTENSION),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) EX (
   .clock(clock),
   .reset(reset),
   .ALU_operation(ALU_operation_execute),
-  .PC(inst_PC_execute),
+  .PC(link_PC_execute),
   .operand_A_sel(operand_A_sel_execute),
   .operand_B_sel(operand_B_sel_execute),
   .branch_op(branch_op_execute),
@@ -873,4 +1037,135 @@ writeback_unit #(
   .scan(scan)
 );
 
+
+/*commit and pipeline occupancy trace*/
+// The trace pipes follow the stall and flush signals of the main pipes so
+// that each instruction is reported exactly once when it leaves writeback.
+// Nothing in the core reads them; synthesis removes them when the trace
+// outputs are left unconnected.
+pipeline_register #(
+  .PIPELINE_STAGE("Trace Decode Pipe"),
+  .PIPE_WIDTH(1),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) trace_decode_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_decode),
+  .flush(flush_decode),
+  .pipe_input(complete_fetch_receive),
+  .flush_input(1'b0),
+  .pipe_output(valid_decode),
+  //scan signal
+  .scan(scan)
+);
+
+pipeline_register #(
+  .PIPELINE_STAGE("Trace Execute Pipe"),
+  .PIPE_WIDTH(1),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) trace_execute_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_execute),
+  .flush(flush_execute),
+  .pipe_input(valid_decode),
+  .flush_input(1'b0),
+  .pipe_output(valid_execute),
+  //scan signal
+  .scan(scan)
+);
+
+pipeline_register #(
+  .PIPELINE_STAGE("Trace Memory Pipe"),
+  .PIPE_WIDTH(TRACE_MEMORY_ISSUE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) trace_memory_issue_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_memory_issue),
+  .flush(1'b0),
+  .pipe_input({valid_execute, inst_PC_execute}),
+  .flush_input({TRACE_MEMORY_ISSUE_PIPE_WIDTH{1'b0}}),
+  .pipe_output({valid_memory_issue, inst_PC_memory_issue}),
+  //scan signal
+  .scan(scan)
+);
+
+pipeline_register #(
+  .PIPELINE_STAGE("Trace Memory Receive Pipe"),
+  .PIPE_WIDTH(TRACE_MEMORY_RECEIVE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) trace_memory_receive_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_memory_receive),
+  .flush(flush_memory_receive),
+  .pipe_input({valid_memory_issue, inst_PC_memory_issue, memWrite_memory_issue}),
+  .flush_input({TRACE_MEMORY_RECEIVE_PIPE_WIDTH{1'b0}}),
+  .pipe_output({valid_memory_receive, inst_PC_memory_receive, store_memory_receive}),
+  //scan signal
+  .scan(scan)
+);
+
+pipeline_register #(
+  .PIPELINE_STAGE("Trace Writeback Pipe"),
+  .PIPE_WIDTH(TRACE_WRITEBACK_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) trace_writeback_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(1'b0),
+  .flush(flush_writeback),
+  .pipe_input({valid_memory_receive,
+               inst_PC_memory_receive,
+               memRead_memory_receive | store_memory_receive,
+               store_memory_receive,
+               generated_address_memory_receive}),
+  .flush_input({TRACE_WRITEBACK_PIPE_WIDTH{1'b0}}),
+  .pipe_output({valid_writeback,
+                inst_PC_writeback,
+                memory_access_writeback,
+                store_writeback,
+                memory_address_writeback}),
+  //scan signal
+  .scan(scan)
+);
+
+assign trace_retire         = valid_writeback;
+assign trace_PC             = inst_PC_writeback;
+assign trace_instruction    = instruction_writeback;
+assign trace_reg_write      = write_writeback & (write_reg_writeback != 5'd0);
+assign trace_rd             = write_reg_writeback;
+assign trace_rd_data        = write_data_writeback;
+assign trace_memory_access  = memory_access_writeback;
+assign trace_store          = store_writeback;
+assign trace_memory_address = memory_address_writeback;
+
+assign trace_stage_valid = { valid_writeback,
+                             valid_memory_receive,
+                             valid_memory_issue,
+                             valid_execute,
+                             valid_decode,
+                             issue_request_fetch_receive
+                           };
+
+assign trace_stall = { stall_memory_receive,
+                       stall_memory_issue,
+                       stall_execute,
+                       stall_decode,
+                       stall_fetch_receive
+                     };
+
+assign trace_flush = { flush_writeback,
+                       flush_memory_receive,
+                       flush_execute,
+                       flush_decode,
+                       flush_fetch_receive
+                     };
+
 endmodule
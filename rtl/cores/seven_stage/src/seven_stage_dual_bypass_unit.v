@@ -0,0 +1,92 @@
+/** @module : seven_stage_dual_bypass_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Bypass mux control for the four source operands of seven_stage_dual_core.
+ *  - Each *_hazard input has one bit per lane and stage that writes the
+ *    register, ordered from the youngest to the oldest instruction:
+ *      bit 0 execute lane 1,        bit 1 execute lane 0,
+ *      bit 2 memory issue lane 1,   bit 3 memory issue lane 0,
+ *      bit 4 memory receive lane 1, bit 5 memory receive lane 0,
+ *      bit 6 writeback lane 1,      bit 7 writeback lane 0.
+ *    Lane 1 holds the younger instruction of a pair.
+ *  - The youngest writer is forwarded. The bypass select is the index of its
+ *    bit plus one, 0 selects the register file.
+ *  - true_data_hazard_0/1 disable bypassing for the operands of lane 0/1.
+ */
+
+module seven_stage_dual_bypass_unit #(
+  parameter CORE            = 0,
+  parameter SCAN_CYCLES_MIN = 0,
+  parameter SCAN_CYCLES_MAX = 1000
+) (
+  input clock,
+  input reset,
+
+  input true_data_hazard_0,
+  input true_data_hazard_1,
+
+  input [7:0] rs1_hazard_0,
+  input [7:0] rs2_hazard_0,
+  input [7:0] rs1_hazard_1,
+  input [7:0] rs2_hazard_1,
+
+  output [3:0] rs1_data_bypass_0,
+  output [3:0] rs2_data_bypass_0,
+  output [3:0] rs1_data_bypass_1,
+  output [3:0] rs2_data_bypass_1,
+
+  input scan
+);
+
+function [3:0] bypass_select;
+input [7:0] hazard;
+integer i;
+begin
+  bypass_select = 4'd0;
+  for(i=7; i>=0; i=i-1)
+    if(hazard[i])
+      bypass_select = i+1;
+end
+endfunction
+
+// Generate bypass mux control signal
+assign rs1_data_bypass_0 = true_data_hazard_0 ? 4'd0 : bypass_select(rs1_hazard_0);
+assign rs2_data_bypass_0 = true_data_hazard_0 ? 4'd0 : bypass_select(rs2_hazard_0);
+assign rs1_data_bypass_1 = true_data_hazard_1 ? 4'd0 : bypass_select(rs1_hazard_1);
+assign rs2_data_bypass_1 = true_data_hazard_1 ? 4'd0 : bypass_select(rs2_hazard_1);
+
+reg [31: 0] cycles;
+always @ (posedge clock) begin
+  cycles <= reset? 0 : cycles + 1;
+  if (scan  & ((cycles >= SCAN_CYCLES_MIN) & (cycles <= SCAN_CYCLES_MAX)) )begin
+    $display ("------ Core %d Seven Stage Dual Bypass Unit - Current Cycle %d -", CORE, cycles);
+    $display ("| Lane 0 RS1 Data Bypass  [%d]", rs1_data_bypass_0);
+    $display ("| Lane 0 RS2 Data Bypass  [%d]", rs2_data_bypass_0);
+    $display ("| Lane 1 RS1 Data Bypass  [%d]", rs1_data_bypass_1);
+    $display ("| Lane 1 RS2 Data Bypass  [%d]", rs2_data_bypass_1);
+    $display ("----------------------------------------------------------------------");
+  end
+end
+
+endmodule
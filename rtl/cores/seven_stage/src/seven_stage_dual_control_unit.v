@@ -0,0 +1,645 @@
+/** @module : seven_stage_dual_control_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Control, hazard detection and issue logic of seven_stage_dual_core.
+ *  - Decode holds an instruction pair. Lane 0 is the older instruction, lane
+ *    1 the younger one. valid_1 is low when the pair was fetched from its
+ *    second word (a jump target) and lane 1 is empty.
+ *  - Both instructions issue to execute in the same cycle when
+ *      - neither has a true data (load use) hazard,
+ *      - lane 1 does not read the destination register of lane 0,
+ *      - at most one of them is a load or store,
+ *      - lane 0 is not a branch, JAL or JALR.
+ *    Otherwise lane 0 issues alone and decode is held for one more cycle to
+ *    issue lane 1 ("split"), unless lane 0 is a JAL that discards lane 1.
+ *    Instructions stay in their lane, so issue_0/issue_1 select which lanes
+ *    of the execute pipe get an instruction and which get a NOP.
+ *  - Branches and JALR are resolved in execute in either lane. A taken branch
+ *    in lane 1 keeps the older instruction of lane 0. A branch in lane 0 is
+ *    never paired, so there is nothing younger in execute to discard.
+ *  - A held pair is reported to seven_stage_stall_unit as a true data hazard,
+ *    which stalls fetch receive and decode the same way. The execute flush of
+ *    the stall unit is not used, lanes that do not issue get a NOP instead.
+ *  - See seven_stage_dual_bypass_unit for the bit order of the hazard vectors
+ *    and the bypass select encoding.
+ */
+
+module seven_stage_dual_control_unit #(
+  parameter CORE            = 0,
+  parameter DATA_WIDTH      = 32,
+  parameter ADDRESS_BITS    = 32,
+  parameter NUM_BYTES       = DATA_WIDTH/8,
+  parameter LOG2_NUM_BYTES  = log2(NUM_BYTES),
+  parameter SCAN_CYCLES_MIN = 0,
+  parameter SCAN_CYCLES_MAX = 1000
+) (
+  input clock,
+  input reset,
+
+  // Decode stage pair
+  input valid_1,
+  input [6:0] opcode_0,
+  input [2:0] funct3_0,
+  input [6:0] funct7_0,
+  input [4:0] rs1_0,
+  input [4:0] rs2_0,
+  input [4:0] rd_0,
+  input [6:0] opcode_1,
+  input [2:0] funct3_1,
+  input [6:0] funct7_1,
+  input [4:0] rs1_1,
+  input [4:0] rs2_1,
+  input [4:0] rd_1,
+  input [ADDRESS_BITS-1:0] JAL_target_decode_0,
+  input [ADDRESS_BITS-1:0] JAL_target_decode_1,
+
+  // Execute stage branches
+  input [ADDRESS_BITS-1:0] JALR_target_execute_0,
+  input [ADDRESS_BITS-1:0] JALR_target_execute_1,
+  input [ADDRESS_BITS-1:0] branch_target_execute_0,
+  input [ADDRESS_BITS-1:0] branch_target_execute_1,
+  input branch_execute_0,
+  input branch_execute_1,
+
+  // Instructions in flight, used for hazards and bypassing
+  input [6:0] opcode_execute_0,
+  input [6:0] opcode_execute_1,
+  input [6:0] opcode_memory_issue_0,
+  input [6:0] opcode_memory_issue_1,
+  input [6:0] opcode_memory_receive_0,
+  input [6:0] opcode_memory_receive_1,
+  input [4:0] rd_execute_0,
+  input [4:0] rd_execute_1,
+  input [4:0] rd_memory_issue_0,
+  input [4:0] rd_memory_issue_1,
+  input [4:0] rd_memory_receive_0,
+  input [4:0] rd_memory_receive_1,
+  input [4:0] rd_writeback_0,
+  input [4:0] rd_writeback_1,
+  input regWrite_execute_0,
+  input regWrite_execute_1,
+  input regWrite_memory_issue_0,
+  input regWrite_memory_issue_1,
+  input regWrite_memory_receive_0,
+  input regWrite_memory_receive_1,
+  input regWrite_writeback_0,
+  input regWrite_writeback_1,
+
+  // Decoded control signals of both lanes
+  output branch_op_0,
+  output memRead_0,
+  output [5:0] ALU_operation_0,
+  output memWrite_0,
+  output [LOG2_NUM_BYTES-1:0] log2_bytes_0,
+  output unsigned_load_0,
+  output [1:0] operand_A_sel_0,
+  output operand_B_sel_0,
+  output [1:0] extend_sel_0,
+  output regWrite_0,
+
+  output branch_op_1,
+  output memRead_1,
+  output [5:0] ALU_operation_1,
+  output memWrite_1,
+  output [LOG2_NUM_BYTES-1:0] log2_bytes_1,
+  output unsigned_load_1,
+  output [1:0] operand_A_sel_1,
+  output operand_B_sel_1,
+  output [1:0] extend_sel_1,
+  output regWrite_1,
+
+  // Lanes that enter execute this cycle
+  output issue_0,
+  output issue_1,
+
+  output [1:0] next_PC_sel,
+  output [ADDRESS_BITS-1:0] target_PC,
+  output i_mem_read,
+
+  // Base Hazard Detection Unit Ports
+  input fetch_valid,
+  input fetch_ready,
+  input issue_request,
+  input [ADDRESS_BITS-1:0] issue_PC,
+  input [ADDRESS_BITS-1:0] fetch_address_in,
+  input memory_valid,
+  input memory_ready,
+
+  input load_memory_receive,
+  input store_memory_issue,
+  input [ADDRESS_BITS-1:0] load_address_receive,
+  input [ADDRESS_BITS-1:0] memory_address_in,
+
+  // Seven Stage Stall Unit Ports
+  output stall_fetch_receive,
+  output stall_decode,
+  output stall_execute,
+  output stall_memory_issue,
+  output stall_memory_receive,
+
+  output flush_fetch_receive,
+  output flush_decode,
+  output flush_execute,
+  output flush_memory_receive,
+  output flush_writeback,
+
+  // Seven Stage Dual Bypass Unit Ports
+  output [3:0] rs1_data_bypass_0,
+  output [3:0] rs2_data_bypass_0,
+  output [3:0] rs1_data_bypass_1,
+  output [3:0] rs2_data_bypass_1,
+
+  input scan
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+
+localparam[6:0] R_TYPE  = 7'b0110011,
+                I_TYPE  = 7'b0010011,
+                STORE   = 7'b0100011,
+                LOAD    = 7'b0000011,
+                BRANCH  = 7'b1100011,
+                JALR    = 7'b1100111,
+                JAL     = 7'b1101111;
+
+// RV64 Opcodes
+localparam [6:0]IMM_32 = 7'b0011011,
+                OP_32  = 7'b0111011;
+
+// P extension (packed SIMD) opcode
+localparam [6:0]OP_P   = 7'b1110111;
+
+function reads_rs1;
+input [6:0] opcode;
+begin
+  reads_rs1 = (opcode == R_TYPE) |
+              (opcode == I_TYPE) |
+              (opcode == STORE ) |
+              (opcode == LOAD  ) |
+              (opcode == BRANCH) |
+              (opcode == JALR  ) |
+              (opcode == OP_P  ) |
+              ((DATA_WIDTH == 64) & ((opcode == IMM_32) | (opcode == OP_32)));
+end
+endfunction
+
+function reads_rs2;
+input [6:0] opcode;
+begin
+  reads_rs2 = (opcode == R_TYPE) |
+              (opcode == STORE ) |
+              (opcode == BRANCH) |
+              (opcode == OP_P  ) |
+              ((DATA_WIDTH == 64) & (opcode == OP_32));
+end
+endfunction
+
+// One bit per writer, youngest first. See seven_stage_dual_bypass_unit.
+function [7:0] writer_hazards;
+input [4:0]  rs;
+input        read;
+input [39:0] writer_rd;
+input [7:0]  writer_enable;
+integer i;
+begin
+  for(i=0; i<8; i=i+1)
+    writer_hazards[i] = read & (rs != 5'd0) & writer_enable[i] &
+                        (writer_rd[5*i +: 5] == rs);
+end
+endfunction
+
+wire [39:0] writer_rd;
+wire [7:0]  writer_enable;
+wire [7:0]  writer_load;
+
+wire rs1_read_0;
+wire rs2_read_0;
+wire rs1_read_1;
+wire rs2_read_1;
+
+wire [7:0] rs1_hazard_0;
+wire [7:0] rs2_hazard_0;
+wire [7:0] rs1_hazard_1;
+wire [7:0] rs2_hazard_1;
+
+wire true_data_hazard_0;
+wire true_data_hazard_1;
+
+wire memory_op_0;
+wire memory_op_1;
+wire control_0;
+wire lane_1_reads_rd_0;
+wire pair;
+wire split;
+wire issue_hazard;
+
+wire d_mem_hazard;
+wire d_mem_issue_hazard;
+wire d_mem_recv_hazard;
+wire i_mem_hazard;
+wire i_mem_issue_hazard;
+wire i_mem_recv_hazard;
+wire JALR_branch_hazard;
+wire JAL_hazard;
+wire clog;
+
+// Lane 0 of the pair in decode went to execute, lane 1 is still waiting
+reg lane_0_issued;
+
+assign writer_rd = { rd_writeback_0,
+                     rd_writeback_1,
+                     rd_memory_receive_0,
+                     rd_memory_receive_1,
+                     rd_memory_issue_0,
+                     rd_memory_issue_1,
+                     rd_execute_0,
+                     rd_execute_1
+                   };
+
+assign writer_enable = { regWrite_writeback_0,
+                         regWrite_writeback_1,
+                         regWrite_memory_receive_0,
+                         regWrite_memory_receive_1,
+                         regWrite_memory_issue_0,
+                         regWrite_memory_issue_1,
+                         regWrite_execute_0,
+                         regWrite_execute_1
+                       };
+
+// Load data is forwarded from writeback only
+assign writer_load = { 1'b0,
+                       1'b0,
+                       opcode_memory_receive_0 == LOAD,
+                       opcode_memory_receive_1 == LOAD,
+                       opcode_memory_issue_0   == LOAD,
+                       opcode_memory_issue_1   == LOAD,
+                       opcode_execute_0        == LOAD,
+                       opcode_execute_1        == LOAD
+                     };
+
+assign rs1_read_0 = reads_rs1(opcode_0);
+assign rs2_read_0 = reads_rs2(opcode_0);
+assign rs1_read_1 = reads_rs1(opcode_1);
+assign rs2_read_1 = reads_rs2(opcode_1);
+
+// Detect data hazards between decode and other stages
+assign rs1_hazard_0 = writer_hazards(rs1_0, rs1_read_0, writer_rd, writer_enable);
+assign rs2_hazard_0 = writer_hazards(rs2_0, rs2_read_0, writer_rd, writer_enable);
+assign rs1_hazard_1 = writer_hazards(rs1_1, rs1_read_1, writer_rd, writer_enable);
+assign rs2_hazard_1 = writer_hazards(rs2_1, rs2_read_1, writer_rd, writer_enable);
+
+assign true_data_hazard_0 = |((rs1_hazard_0 | rs2_hazard_0) & writer_load);
+assign true_data_hazard_1 = |((rs1_hazard_1 | rs2_hazard_1) & writer_load);
+
+// Pairing rules
+assign memory_op_0 = memRead_0 | memWrite_0;
+assign memory_op_1 = memRead_1 | memWrite_1;
+assign control_0   = (opcode_0 == BRANCH) | (opcode_0 == JALR) | (opcode_0 == JAL);
+
+assign lane_1_reads_rd_0 = regWrite_0 & (rd_0 != 5'd0) &
+                           ((rs1_read_1 & (rs1_1 == rd_0)) |
+                            (rs2_read_1 & (rs2_1 == rd_0)));
+
+assign pair = valid_1 & ~(memory_op_0 & memory_op_1) & ~control_0 & ~lane_1_reads_rd_0;
+
+assign issue_0 = ~lane_0_issued & ~true_data_hazard_0;
+assign issue_1 = valid_1 & ~true_data_hazard_1 & (lane_0_issued | (issue_0 & pair));
+
+assign split = issue_0 & valid_1 & ~issue_1 & (opcode_0 != JAL);
+
+// Nothing issues or lane 1 still has to issue, hold decode
+assign issue_hazard = (lane_0_issued ? true_data_hazard_1 : true_data_hazard_0) | split;
+
+always @(posedge clock) begin
+  if(reset)
+    lane_0_issued <= 1'b0;
+  else if(flush_decode | ~stall_decode)
+    lane_0_issued <= 1'b0;
+  else if(~d_mem_hazard)
+    lane_0_issued <= lane_0_issued | split;
+end
+
+assign d_mem_hazard = d_mem_issue_hazard | d_mem_recv_hazard;
+assign i_mem_hazard = i_mem_issue_hazard | i_mem_recv_hazard;
+
+// Only one lane of execute can hold a branch or JALR, see pairing rules
+assign JALR_branch_hazard = (opcode_execute_0 == JALR) |
+                            ((opcode_execute_0 == BRANCH) & branch_execute_0) |
+                            (opcode_execute_1 == JALR) |
+                            ((opcode_execute_1 == BRANCH) & branch_execute_1);
+
+assign JAL_hazard = (issue_0 & (opcode_0 == JAL)) | (issue_1 & (opcode_1 == JAL));
+
+assign target_PC = (opcode_execute_0 == JALR)                      ? JALR_target_execute_0   :
+                   (opcode_execute_1 == JALR)                      ? JALR_target_execute_1   :
+                   (opcode_execute_0 == BRANCH) & branch_execute_0 ? branch_target_execute_0 :
+                   (opcode_execute_1 == BRANCH) & branch_execute_1 ? branch_target_execute_1 :
+                   issue_1 & (opcode_1 == JAL)                     ? JAL_target_decode_1     :
+                   issue_0 & (opcode_0 == JAL)                     ? JAL_target_decode_0     :
+                   clog                                            ? issue_PC                :
+                   {ADDRESS_BITS{1'b0}};
+
+assign next_PC_sel = JALR_branch_hazard  ? 2'b10 : // target_PC
+                     issue_hazard & clog ? 2'b10 : // target_PC
+                     issue_hazard        ? 2'b01 : // stall
+                     JAL_hazard          ? 2'b10 : // targeet_PC
+                     i_mem_hazard        ? 2'b01 : // stall
+                     d_mem_hazard & clog ? 2'b10 : // target_PC
+                     d_mem_hazard        ? 2'b01 : // stall
+                     2'b00;                        // next pair
+
+assign clog = stall_decode & issue_request & fetch_valid & (issue_PC == fetch_address_in);
+
+// Lanes that do not issue get a NOP, only taken branches flush execute
+assign flush_execute = JALR_branch_hazard & ~d_mem_hazard;
+
+hazard_detection_unit #(
+  .CORE(CORE),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) base_hazard_unit (
+  .clock(clock),
+  .reset(reset),
+  .fetch_valid(fetch_valid),
+  .fetch_ready(fetch_ready),
+  .issue_request(issue_request),
+  .issue_PC(issue_PC),
+  .fetch_address_in(fetch_address_in),
+  .memory_valid(memory_valid),
+  .memory_ready(memory_ready),
+
+  .load_memory(load_memory_receive),
+  .store_memory(store_memory_issue),
+  .load_address(load_address_receive),
+  .memory_address_in(memory_address_in),
+
+  .opcode_decode(opcode_0),
+  .opcode_execute(opcode_execute_0),
+  .branch_execute(branch_execute_0),
+
+  // No solo instructions for non-priviledged cores
+  .solo_instr_decode(1'b0),
+  .solo_instr_execute(1'b0),
+  .solo_instr_memory_issue(1'b0),
+  .solo_instr_memory_receive(1'b0),
+  .solo_instr_writeback(1'b0),
+
+  .i_mem_issue_hazard(i_mem_issue_hazard),
+  .i_mem_recv_hazard(i_mem_recv_hazard),
+  .d_mem_issue_hazard(d_mem_issue_hazard),
+  .d_mem_recv_hazard(d_mem_recv_hazard),
+  .JALR_branch_hazard(), // Both lanes, see above
+  .JAL_hazard(),         // Both lanes, see above
+  .solo_instr_hazard(),
+
+  .scan(scan)
+);
+
+
+seven_stage_stall_unit #(
+  .CORE(CORE),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) stall_unit (
+  .clock(clock),
+  .reset(reset),
+  .execute_invalid_hazard(1'b0),
+  .true_data_hazard(issue_hazard),
+  .d_mem_issue_hazard(d_mem_issue_hazard),
+  .d_mem_recv_hazard(d_mem_recv_hazard),
+  .i_mem_issue_hazard(i_mem_issue_hazard),
+  .i_mem_recv_hazard(i_mem_recv_hazard),
+  .JALR_branch_hazard(JALR_branch_hazard),
+  .JAL_hazard(JAL_hazard),
+
+  .clog(clog),
+
+  .stall_fetch_receive(stall_fetch_receive),
+  .stall_decode(stall_decode),
+  .stall_execute(stall_execute),
+  .stall_memory_issue(stall_memory_issue),
+  .stall_memory_receive(stall_memory_receive),
+
+  .flush_fetch_receive(flush_fetch_receive),
+  .flush_decode(flush_decode),
+  .flush_execute(),
+  .flush_memory_issue(),
+  .flush_memory_receive(flush_memory_receive),
+  .flush_writeback(flush_writeback),
+
+  .scan(scan)
+);
+
+seven_stage_dual_bypass_unit #(
+  .CORE(CORE),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) bypass_unit (
+  .clock(clock),
+  .reset(reset),
+
+  .true_data_hazard_0(true_data_hazard_0),
+  .true_data_hazard_1(true_data_hazard_1),
+
+  .rs1_hazard_0(rs1_hazard_0),
+  .rs2_hazard_0(rs2_hazard_0),
+  .rs1_hazard_1(rs1_hazard_1),
+  .rs2_hazard_1(rs2_hazard_1),
+
+  .rs1_data_bypass_0(rs1_data_bypass_0),
+  .rs2_data_bypass_0(rs2_data_bypass_0),
+  .rs1_data_bypass_1(rs1_data_bypass_1),
+  .rs2_data_bypass_1(rs2_data_bypass_1),
+
+  .scan(scan)
+);
+
+
+// Instruction decoders of both lanes. next_PC_sel and target_PC are computed
+// for the pair above, so their hazard inputs are not needed.
+genvar lane;
+generate
+  for(lane=0; lane<2; lane=lane+1) begin : LANE
+    wire [6:0] opcode = (lane == 0) ? opcode_0 : opcode_1;
+    wire [2:0] funct3 = (lane == 0) ? funct3_0 : funct3_1;
+    wire [6:0] funct7 = (lane == 0) ? funct7_0 : funct7_1;
+
+    wire branch_op;
+    wire memRead;
+    wire [5:0] ALU_operation;
+    wire memWrite;
+    wire [LOG2_NUM_BYTES-1:0] log2_bytes;
+    wire unsigned_load;
+    wire [1:0] operand_A_sel;
+    wire operand_B_sel;
+    wire [1:0] extend_sel;
+    wire regWrite;
+
+    // This could have been done with a macro but as a convention, we use
+    // generate statements for different 32-bit/64-bit logic
+    if(DATA_WIDTH == 64) begin : RV64
+      control_unit64 #(
+        .CORE(CORE),
+        .ADDRESS_BITS(ADDRESS_BITS),
+        .NUM_BYTES(NUM_BYTES),
+        .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+        .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+      ) control (
+        .clock(clock),
+        .reset(reset),
+        .opcode_decode(opcode),
+        .opcode_execute(7'b0110011),
+        .funct3(funct3),
+        .funct7(funct7),
+
+        .JALR_target_execute({ADDRESS_BITS{1'b0}}),
+        .branch_target_execute({ADDRESS_BITS{1'b0}}),
+        .JAL_target_decode({ADDRESS_BITS{1'b0}}),
+        .branch_execute(1'b0),
+
+        .true_data_hazard(1'b0),
+        .d_mem_issue_hazard(1'b0),
+        .d_mem_recv_hazard(1'b0),
+        .i_mem_hazard(1'b0),
+        .JALR_branch_hazard(1'b0),
+        .JAL_hazard(1'b0),
+
+        .branch_op(branch_op),
+        .memRead(memRead),
+        .ALU_operation(ALU_operation),
+        .memWrite(memWrite),
+        .log2_bytes(log2_bytes),
+        .unsigned_load(unsigned_load),
+        .next_PC_sel(),
+        .operand_A_sel(operand_A_sel),
+        .operand_B_sel(operand_B_sel),
+        .extend_sel(extend_sel),
+        .regWrite(regWrite),
+
+        .solo_instr_decode(),
+
+        .target_PC(),
+        .i_mem_read(),
+
+        .scan(scan)
+      );
+    end
+    else begin : RV32
+      control_unit #(
+        .CORE(CORE),
+        .ADDRESS_BITS(ADDRESS_BITS),
+        .NUM_BYTES(NUM_BYTES),
+        .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+        .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+      ) control (
+        .clock(clock),
+        .reset(reset),
+        .opcode_decode(opcode),
+        .opcode_execute(7'b0110011),
+        .funct3(funct3),
+        .funct7(funct7),
+
+        .JALR_target_execute({ADDRESS_BITS{1'b0}}),
+        .branch_target_execute({ADDRESS_BITS{1'b0}}),
+        .JAL_target_decode({ADDRESS_BITS{1'b0}}),
+        .branch_execute(1'b0),
+
+        .true_data_hazard(1'b0),
+        .d_mem_issue_hazard(1'b0),
+        .d_mem_recv_hazard(1'b0),
+        .i_mem_hazard(1'b0),
+        .JALR_branch_hazard(1'b0),
+        .JAL_hazard(1'b0),
+
+        .branch_op(branch_op),
+        .memRead(memRead),
+        .ALU_operation(ALU_operation),
+        .memWrite(memWrite),
+        .log2_bytes(log2_bytes),
+        .unsigned_load(unsigned_load),
+        .next_PC_sel(),
+        .operand_A_sel(operand_A_sel),
+        .operand_B_sel(operand_B_sel),
+        .extend_sel(extend_sel),
+        .regWrite(regWrite),
+
+        .solo_instr_decode(),
+
+        .target_PC(),
+        .i_mem_read(),
+
+        .scan(scan)
+      );
+    end
+  end
+endgenerate
+
+assign branch_op_0     = LANE[0].branch_op;
+assign memRead_0       = LANE[0].memRead;
+assign ALU_operation_0 = LANE[0].ALU_operation;
+assign memWrite_0      = LANE[0].memWrite;
+assign log2_bytes_0    = LANE[0].log2_bytes;
+assign unsigned_load_0 = LANE[0].unsigned_load;
+assign operand_A_sel_0 = LANE[0].operand_A_sel;
+assign operand_B_sel_0 = LANE[0].operand_B_sel;
+assign extend_sel_0    = LANE[0].extend_sel;
+assign regWrite_0      = LANE[0].regWrite;
+
+assign branch_op_1     = LANE[1].branch_op;
+assign memRead_1       = LANE[1].memRead;
+assign ALU_operation_1 = LANE[1].ALU_operation;
+assign memWrite_1      = LANE[1].memWrite;
+assign log2_bytes_1    = LANE[1].log2_bytes;
+assign unsigned_load_1 = LANE[1].unsigned_load;
+assign operand_A_sel_1 = LANE[1].operand_A_sel;
+assign operand_B_sel_1 = LANE[1].operand_B_sel;
+assign extend_sel_1    = LANE[1].extend_sel;
+assign regWrite_1      = LANE[1].regWrite;
+
+assign i_mem_read = 1'b1;
+
+reg [31: 0] cycles;
+always @ (posedge clock) begin
+  cycles <= reset? 0 : cycles + 1;
+  if (scan  & ((cycles >= SCAN_CYCLES_MIN) & (cycles <= SCAN_CYCLES_MAX)) )begin
+    $display ("------ Core %d Seven Stage Dual Control Unit - Current Cycle %d -", CORE, cycles);
+    $display ("| Issue 0 [%b] Issue 1 [%b]", issue_0, issue_1);
+    $display ("| Pair    [%b] Split   [%b]", pair, split);
+    $display ("| Lane 0 Issued  [%b]", lane_0_issued);
+    $display ("| Issue Hazard   [%b]", issue_hazard);
+    $display ("----------------------------------------------------------------------");
+  end
+end
+
+endmodule
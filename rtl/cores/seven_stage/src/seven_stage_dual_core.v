@@ -0,0 +1,1124 @@
+/** @module : seven_stage_dual_core
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Dual issue, in-order variant of seven_stage_core (RV32I or RV64I).
+ *  - Each fetch returns a 64 bit aligned pair of instructions on
+ *    fetch_data_in, which is the full memory word with DATA_WIDTH = 64. With
+ *    DATA_WIDTH = 32 the instruction side of the memory must return two words
+ *    (FETCH_WIDTH = 64 in memory_interface, see seven_stage_dual_BRAM_top).
+ *    A jump to the second word of a pair only fetches that instruction.
+ *  - Every stage after fetch receive has two lanes. Lane 0 holds the older
+ *    instruction. seven_stage_dual_control_unit decides when both issue.
+ *  - Both lanes read and write one dual_write_regFile. Results of both lanes
+ *    are forwarded from all stages, see seven_stage_dual_bypass_unit.
+ *  - There is one data memory port. Memory issue and memory receive serve the
+ *    load or store of either lane and memory_lane_* records which one.
+ *  - The commit trace ports of seven_stage_core are not implemented.
+ */
+
+module seven_stage_dual_core #(
+  parameter CORE            = 0,
+  parameter RESET_PC        = 0,
+  parameter DATA_WIDTH      = 32,
+  parameter ADDRESS_BITS    = 32,
+  parameter NUM_BYTES       = DATA_WIDTH/8,
+  parameter P_EXTENSION     = 0,
+  parameter SCAN_CYCLES_MIN = 0,
+  parameter SCAN_CYCLES_MAX = 1000
+) (
+  input  clock,
+  input  reset,
+  input  start,
+  input  [ADDRESS_BITS-1:0] program_address,
+  //memory interface
+  input  fetch_valid,
+  input  fetch_ready,
+  input  [63            :0] fetch_data_in,
+  input  [ADDRESS_BITS-1:0] fetch_address_in,
+  input  memory_valid,
+  input  memory_ready,
+  input  [DATA_WIDTH-1  :0] memory_data_in,
+  input  [ADDRESS_BITS-1:0] memory_address_in,
+  output fetch_read,
+  output [ADDRESS_BITS-1:0] fetch_address_out,
+  output memory_read,
+  output memory_write,
+  output [NUM_BYTES-1:   0] memory_byte_en,
+  output [ADDRESS_BITS-1:0] memory_address_out,
+  output [DATA_WIDTH-1  :0] memory_data_out,
+  //scan signal
+  input  scan
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+localparam LOG2_NUM_BYTES  = log2(NUM_BYTES);
+
+localparam NOP = 32'h00000013;
+
+// Pipe Parameters
+localparam FETCH_RECEIVE_PIPE_WIDTH = ADDRESS_BITS // issue_PC
+                                   + 1;           // issue_request
+
+localparam DECODE_PIPE_WIDTH = 32            // instruction_0
+                            + 32            // instruction_1
+                            + ADDRESS_BITS  // inst_PC
+                            + 1;            // valid_1
+
+localparam EXECUTE_PIPE_WIDTH = ADDRESS_BITS   // inst_PC
+                              + DATA_WIDTH     // rs1_data
+                              + DATA_WIDTH     // rs2_data
+                              + 5              // rd
+                              + DATA_WIDTH     // extend_imm
+                              + ADDRESS_BITS   // branch_target
+                              + 1              // branch_op
+                              + 1              // memRead
+                              + 6              // ALU_operation
+                              + 1              // memWrite
+                              + LOG2_NUM_BYTES // log2_bytes
+                              + 1              // unsigned_load
+                              + 2              // operand_A_sel
+                              + 1              // operand_B_sel
+                              + 1              // regWrite
+                              + 7;             // opcode
+
+localparam MEMORY_ISSUE_PIPE_WIDTH = 1              // load // memRead,
+                                   + 1              // store // memWrite,
+                                   + LOG2_NUM_BYTES // log2_bytes
+                                   + 1              // unsigned_load
+                                   + ADDRESS_BITS   // generated_address,
+                                   + DATA_WIDTH     // rs2_data
+                                   + 1              // memory_lane
+                                   + 2*1            // regWrite_memory_issue,
+                                   + 2*5            // rd_memory_issue,
+                                   + 2*DATA_WIDTH   // ALU_result_memory,
+                                   + 2*7;           // opcode
+
+localparam MEMORY_RECEIVE_PIPE_WIDTH = 1             // load //memRead_memory_receive
+                                    + ADDRESS_BITS   // load address
+                                    + LOG2_NUM_BYTES // log2_bytes
+                                    + 1              // unsigned_load
+                                    + 1              // memory_lane
+                                    + 2*DATA_WIDTH   // ALU_result
+                                    + 2*1            // regWrite
+                                    + 2*5            // rd
+                                    + 2*7;           // opcode
+
+localparam WRITEBACK_PIPE_WIDTH = 1             // memRead_writeback
+                               + 1             // memory_lane
+                               + DATA_WIDTH    // load_data_writeback
+                               + 2*1           // regWrite_writeback
+                               + 2*5           // rd_writeback
+                               + 2*DATA_WIDTH; // ALU_result_writeback
+
+
+
+// Fetch Issue Stage Wires
+wire [1:0] next_PC_select;
+wire [ADDRESS_BITS-1:0] target_PC;
+wire [ADDRESS_BITS-1:0] issue_PC;
+
+// Fetch Receive Stage Wires
+wire [31:0] instruction_0_fetch_receive;
+wire [31:0] instruction_1_fetch_receive;
+wire valid_1_fetch_receive;
+wire [ADDRESS_BITS-1:0] issue_PC_fetch_receive;
+wire issue_request_fetch_receive;
+wire fetch_match;
+wire [ADDRESS_BITS-1:0] fetch_address_compare;
+
+// Decode Stage Wires
+wire [31:0] instruction_0_decode;
+wire [31:0] instruction_1_decode;
+wire [ADDRESS_BITS-1:0] inst_PC_decode;
+wire valid_1_decode;
+
+wire [1:0] extend_sel_decode_0;
+wire [DATA_WIDTH-1:0] rs1_data_decode_0;
+wire [DATA_WIDTH-1:0] rs2_data_decode_0;
+wire [4:0] rd_decode_0;
+wire [6:0] opcode_decode_0;
+wire [6:0] funct7_decode_0;
+wire [2:0] funct3_decode_0;
+wire [DATA_WIDTH-1:0] extend_imm_decode_0;
+wire [ADDRESS_BITS-1:0] branch_target_decode_0;
+wire [ADDRESS_BITS-1:0] JAL_target_decode_0;
+wire branch_op_decode_0;
+wire memRead_decode_0;
+wire [5:0] ALU_operation_decode_0;
+wire memWrite_decode_0;
+wire [LOG2_NUM_BYTES-1:0] log2_bytes_decode_0;
+wire unsigned_load_decode_0;
+wire [1:0] operand_A_sel_decode_0;
+wire operand_B_sel_decode_0;
+wire regWrite_decode_0;
+
+wire [1:0] extend_sel_decode_1;
+wire [DATA_WIDTH-1:0] rs1_data_decode_1;
+wire [DATA_WIDTH-1:0] rs2_data_decode_1;
+wire [4:0] rd_decode_1;
+wire [6:0] opcode_decode_1;
+wire [6:0] funct7_decode_1;
+wire [2:0] funct3_decode_1;
+wire [DATA_WIDTH-1:0] extend_imm_decode_1;
+wire [ADDRESS_BITS-1:0] branch_target_decode_1;
+wire [ADDRESS_BITS-1:0] JAL_target_decode_1;
+wire branch_op_decode_1;
+wire memRead_decode_1;
+wire [5:0] ALU_operation_decode_1;
+wire memWrite_decode_1;
+wire [LOG2_NUM_BYTES-1:0] log2_bytes_decode_1;
+wire unsigned_load_decode_1;
+wire [1:0] operand_A_sel_decode_1;
+wire operand_B_sel_decode_1;
+wire regWrite_decode_1;
+
+wire issue_0;
+wire issue_1;
+
+wire stall_fetch_receive;
+wire stall_decode;
+wire stall_execute;
+wire stall_memory_issue;
+wire stall_memory_receive;
+wire flush_fetch_receive;
+wire flush_decode;
+wire flush_execute;
+wire flush_memory_receive;
+wire flush_writeback;
+
+wire [3:0] rs1_data_bypass_0;
+wire [3:0] rs2_data_bypass_0;
+wire [3:0] rs1_data_bypass_1;
+wire [3:0] rs2_data_bypass_1;
+
+// Execute Stage Wires
+wire [ADDRESS_BITS-1:0] inst_PC_execute_0;
+wire [DATA_WIDTH-1:0] rs1_data_execute_0;
+wire [DATA_WIDTH-1:0] rs2_data_execute_0;
+wire [4:0] rd_execute_0;
+wire [DATA_WIDTH-1:0] extend_imm_execute_0;
+wire [ADDRESS_BITS-1:0] branch_target_execute_0;
+wire branch_op_execute_0;
+wire memRead_execute_0;
+wire [5:0] ALU_operation_execute_0;
+wire memWrite_execute_0;
+wire [LOG2_NUM_BYTES-1:0] log2_bytes_execute_0;
+wire unsigned_load_execute_0;
+wire [1:0] operand_A_sel_execute_0;
+wire operand_B_sel_execute_0;
+wire regWrite_execute_0;
+wire [6:0] opcode_execute_0;
+wire branch_execute_0;
+wire [DATA_WIDTH-1:0] ALU_result_execute_0;
+wire [ADDRESS_BITS-1:0] JALR_target_execute_0;
+
+wire [ADDRESS_BITS-1:0] inst_PC_execute_1;
+wire [DATA_WIDTH-1:0] rs1_data_execute_1;
+wire [DATA_WIDTH-1:0] rs2_data_execute_1;
+wire [4:0] rd_execute_1;
+wire [DATA_WIDTH-1:0] extend_imm_execute_1;
+wire [ADDRESS_BITS-1:0] branch_target_execute_1;
+wire branch_op_execute_1;
+wire memRead_execute_1;
+wire [5:0] ALU_operation_execute_1;
+wire memWrite_execute_1;
+wire [LOG2_NUM_BYTES-1:0] log2_bytes_execute_1;
+wire unsigned_load_execute_1;
+wire [1:0] operand_A_sel_execute_1;
+wire operand_B_sel_execute_1;
+wire regWrite_execute_1;
+wire [6:0] opcode_execute_1;
+wire branch_execute_1;
+wire [DATA_WIDTH-1:0] ALU_result_execute_1;
+wire [ADDRESS_BITS-1:0] JALR_target_execute_1;
+
+wire memory_lane_execute;
+
+// Memory Issue Stage Wires
+wire memRead_memory_issue;
+wire memWrite_memory_issue;
+wire [LOG2_NUM_BYTES-1:0] log2_bytes_memory_issue;
+wire unsigned_load_memory_issue;
+wire [ADDRESS_BITS-1:0] generated_address_memory_issue;
+wire [DATA_WIDTH-1:0] rs2_data_memory_issue;
+wire memory_lane_memory_issue;
+wire regWrite_memory_issue_0;
+wire regWrite_memory_issue_1;
+wire [4:0] rd_memory_issue_0;
+wire [4:0] rd_memory_issue_1;
+wire [DATA_WIDTH-1:0] ALU_result_memory_issue_0;
+wire [DATA_WIDTH-1:0] ALU_result_memory_issue_1;
+wire [6:0] opcode_memory_issue_0;
+wire [6:0] opcode_memory_issue_1;
+
+// Memory Receive Stage Wires
+wire memRead_memory_receive;
+wire [ADDRESS_BITS-1:0] generated_address_memory_receive;
+wire [LOG2_NUM_BYTES-1:0] log2_bytes_memory_receive;
+wire unsigned_load_memory_receive;
+wire memory_lane_memory_receive;
+wire [DATA_WIDTH-1:0] ALU_result_memory_receive_0;
+wire [DATA_WIDTH-1:0] ALU_result_memory_receive_1;
+wire regWrite_memory_receive_0;
+wire regWrite_memory_receive_1;
+wire [4:0] rd_memory_receive_0;
+wire [4:0] rd_memory_receive_1;
+wire [6:0] opcode_memory_receive_0;
+wire [6:0] opcode_memory_receive_1;
+wire [DATA_WIDTH-1:0] load_data_memory_receive;
+
+// Writeback Stage Wires
+wire memRead_writeback;
+wire memory_lane_writeback;
+wire [DATA_WIDTH-1:0] load_data_writeback;
+wire regWrite_writeback_0;
+wire regWrite_writeback_1;
+wire [4:0] rd_writeback_0;
+wire [4:0] rd_writeback_1;
+wire [DATA_WIDTH-1:0] ALU_result_writeback_0;
+wire [DATA_WIDTH-1:0] ALU_result_writeback_1;
+
+wire write_writeback_0;
+wire [4:0] write_reg_writeback_0;
+wire [DATA_WIDTH-1:0] write_data_writeback_0;
+wire write_writeback_1;
+wire [4:0] write_reg_writeback_1;
+wire [DATA_WIDTH-1:0] write_data_writeback_1;
+
+// Pipe Wires
+wire [FETCH_RECEIVE_PIPE_WIDTH-1:0] fetch_receive_pipe_input;
+wire [FETCH_RECEIVE_PIPE_WIDTH-1:0] fetch_receive_pipe_flush;
+wire [FETCH_RECEIVE_PIPE_WIDTH-1:0] fetch_receive_pipe_output;
+
+wire [DECODE_PIPE_WIDTH-1:0] decode_pipe_input;
+wire [DECODE_PIPE_WIDTH-1:0] decode_pipe_flush;
+wire [DECODE_PIPE_WIDTH-1:0] decode_pipe_output;
+
+wire [EXECUTE_PIPE_WIDTH-1:0] execute_pipe_0_input;
+wire [EXECUTE_PIPE_WIDTH-1:0] execute_pipe_1_input;
+wire [EXECUTE_PIPE_WIDTH-1:0] execute_pipe_flush;
+wire [EXECUTE_PIPE_WIDTH-1:0] execute_pipe_0_output;
+wire [EXECUTE_PIPE_WIDTH-1:0] execute_pipe_1_output;
+
+wire [MEMORY_ISSUE_PIPE_WIDTH-1:0] memory_issue_pipe_input;
+wire [MEMORY_ISSUE_PIPE_WIDTH-1:0] memory_issue_pipe_flush;
+wire [MEMORY_ISSUE_PIPE_WIDTH-1:0] memory_issue_pipe_output;
+
+wire [MEMORY_RECEIVE_PIPE_WIDTH-1:0] memory_receive_pipe_input;
+wire [MEMORY_RECEIVE_PIPE_WIDTH-1:0] memory_receive_pipe_flush;
+wire [MEMORY_RECEIVE_PIPE_WIDTH-1:0] memory_receive_pipe_output;
+
+wire [WRITEBACK_PIPE_WIDTH-1:0] writeback_pipe_input;
+wire [WRITEBACK_PIPE_WIDTH-1:0] writeback_pipe_flush;
+wire [WRITEBACK_PIPE_WIDTH-1:0] writeback_pipe_output;
+
+
+
+
+/*fetch issue*/
+fetch_issue #(
+  .CORE(CORE),
+  .RESET_PC(RESET_PC),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .FETCH_WIDTH(64),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) FI (
+  .clock(clock),
+  .reset(reset),
+  .next_PC_select(next_PC_select),
+  .target_PC(target_PC),
+  .issue_PC(issue_PC),
+  .issue_tail(),
+  .issue_half(),
+  .receive_valid(1'b0),
+  .receive_next_PC({ADDRESS_BITS{1'b0}}),
+  .receive_next_tail(1'b0),
+  .receive_next_half(16'd0),
+  // instruction cache interface
+  .i_mem_read_address(fetch_address_out),
+  //scan signal
+  .scan(scan)
+);
+
+
+/*fetch receive*/
+assign fetch_receive_pipe_input = { issue_PC,
+                                    fetch_read
+                                  };
+
+assign fetch_receive_pipe_flush = { {ADDRESS_BITS{1'b0}},
+                                    1'b0
+                                  };
+
+assign { issue_PC_fetch_receive      ,
+         issue_request_fetch_receive } = fetch_receive_pipe_output;
+
+pipeline_register #(
+  .PIPELINE_STAGE("Fetch receive Pipe"),
+  .PIPE_WIDTH(FETCH_RECEIVE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) fetch_receive_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_fetch_receive),
+  .flush(flush_fetch_receive),
+  .pipe_input(fetch_receive_pipe_input),
+  .flush_input(fetch_receive_pipe_flush),
+  .pipe_output(fetch_receive_pipe_output),
+  //scan signal
+  .scan(scan)
+);
+
+/*fetch receive*/
+// Lane 0 gets the instruction at issue_PC, lane 1 the second word of the
+// pair if issue_PC is the first one.
+fetch_receive #(
+  .DATA_WIDTH(64),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) FR (
+  .flush(~issue_request_fetch_receive),
+  .i_mem_data(fetch_data_in),
+  .issue_PC(issue_PC_fetch_receive),
+  .issue_tail(1'b0),
+  .issue_half(16'd0),
+  .instruction(instruction_0_fetch_receive),
+  .compressed(),
+  .complete(),
+  .fetch_address(),
+  .next_PC(),
+  .next_tail(),
+  .next_half(),
+  //scan signal
+  .scan(scan)
+);
+
+assign valid_1_fetch_receive       = issue_request_fetch_receive & ~issue_PC_fetch_receive[2];
+assign instruction_1_fetch_receive = valid_1_fetch_receive ? fetch_data_in[63:32] : NOP;
+
+// The memory returns the aligned pair address while fetch receive holds the
+// instruction PC. The hazard detection unit only compares the two, so it is
+// given the instruction PC on a match.
+assign fetch_match           = (fetch_address_in >> 3) == (issue_PC_fetch_receive >> 3);
+assign fetch_address_compare = fetch_match ? issue_PC_fetch_receive : ~issue_PC_fetch_receive;
+
+
+assign decode_pipe_input = { instruction_0_fetch_receive,
+                             instruction_1_fetch_receive,
+                             issue_PC_fetch_receive,
+                             valid_1_fetch_receive
+                           };
+
+assign decode_pipe_flush = { NOP,
+                             NOP,
+                             {ADDRESS_BITS{1'b0}},
+                             1'b0
+                           };
+
+assign { instruction_0_decode,
+         instruction_1_decode,
+         inst_PC_decode,
+         valid_1_decode } = decode_pipe_output;
+
+pipeline_register #(
+  .PIPELINE_STAGE("Decode Pipe"),
+  .PIPE_WIDTH(DECODE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) decode_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_decode),
+  .flush(flush_decode),
+  .pipe_input(decode_pipe_input),
+  .flush_input(decode_pipe_flush),
+  .pipe_output(decode_pipe_output),
+  //scan signal
+  .scan(scan)
+);
+
+
+/*decode unit*/
+seven_stage_dual_decode_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) ID (
+  .clock(clock),
+  .reset(reset),
+
+  .PC_0(inst_PC_decode),
+  .PC_1(inst_PC_decode + 4),
+  .instruction_0(instruction_0_decode),
+  .instruction_1(instruction_1_decode),
+  .extend_sel_0(extend_sel_decode_0),
+  .extend_sel_1(extend_sel_decode_1),
+  .write_0(write_writeback_0),
+  .write_reg_0(write_reg_writeback_0),
+  .write_data_0(write_data_writeback_0),
+  .write_1(write_writeback_1),
+  .write_reg_1(write_reg_writeback_1),
+  .write_data_1(write_data_writeback_1),
+
+  .rs1_data_0(rs1_data_decode_0),
+  .rs2_data_0(rs2_data_decode_0),
+  .rd_0(rd_decode_0),
+  .opcode_0(opcode_decode_0),
+  .funct7_0(funct7_decode_0),
+  .funct3_0(funct3_decode_0),
+  .extend_imm_0(extend_imm_decode_0),
+  .branch_target_0(branch_target_decode_0),
+  .JAL_target_0(JAL_target_decode_0),
+
+  .rs1_data_1(rs1_data_decode_1),
+  .rs2_data_1(rs2_data_decode_1),
+  .rd_1(rd_decode_1),
+  .opcode_1(opcode_decode_1),
+  .funct7_1(funct7_decode_1),
+  .funct3_1(funct3_decode_1),
+  .extend_imm_1(extend_imm_decode_1),
+  .branch_target_1(branch_target_decode_1),
+  .JAL_target_1(JAL_target_decode_1),
+
+  // Data Bypassing Signals
+  .rs1_data_bypass_0(rs1_data_bypass_0),
+  .rs2_data_bypass_0(rs2_data_bypass_0),
+  .rs1_data_bypass_1(rs1_data_bypass_1),
+  .rs2_data_bypass_1(rs2_data_bypass_1),
+  .ALU_result_execute_0(ALU_result_execute_0),
+  .ALU_result_execute_1(ALU_result_execute_1),
+  .ALU_result_memory_issue_0(ALU_result_memory_issue_0),
+  .ALU_result_memory_issue_1(ALU_result_memory_issue_1),
+  .ALU_result_memory_receive_0(ALU_result_memory_receive_0),
+  .ALU_result_memory_receive_1(ALU_result_memory_receive_1),
+  .ALU_result_writeback_0(write_data_writeback_0),
+  .ALU_result_writeback_1(write_data_writeback_1),
+
+  //scan signal
+  .scan(scan)
+);
+
+
+/*control unit*/
+seven_stage_dual_control_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) CTRL (
+  .clock(clock),
+  .reset(reset),
+
+  // Decode stage pair
+  .valid_1(valid_1_decode),
+  .opcode_0(opcode_decode_0),
+  .funct3_0(funct3_decode_0),
+  .funct7_0(funct7_decode_0),
+  .rs1_0(instruction_0_decode[19:15]),
+  .rs2_0(instruction_0_decode[24:20]),
+  .rd_0(rd_decode_0),
+  .opcode_1(opcode_decode_1),
+  .funct3_1(funct3_decode_1),
+  .funct7_1(funct7_decode_1),
+  .rs1_1(instruction_1_decode[19:15]),
+  .rs2_1(instruction_1_decode[24:20]),
+  .rd_1(rd_decode_1),
+  .JAL_target_decode_0(JAL_target_decode_0),
+  .JAL_target_decode_1(JAL_target_decode_1),
+
+  // Execute stage branches
+  .JALR_target_execute_0(JALR_target_execute_0),
+  .JALR_target_execute_1(JALR_target_execute_1),
+  .branch_target_execute_0(branch_target_execute_0),
+  .branch_target_execute_1(branch_target_execute_1),
+  .branch_execute_0(branch_execute_0),
+  .branch_execute_1(branch_execute_1),
+
+  // Instructions in flight
+  .opcode_execute_0(opcode_execute_0),
+  .opcode_execute_1(opcode_execute_1),
+  .opcode_memory_issue_0(opcode_memory_issue_0),
+  .opcode_memory_issue_1(opcode_memory_issue_1),
+  .opcode_memory_receive_0(opcode_memory_receive_0),
+  .opcode_memory_receive_1(opcode_memory_receive_1),
+  .rd_execute_0(rd_execute_0),
+  .rd_execute_1(rd_execute_1),
+  .rd_memory_issue_0(rd_memory_issue_0),
+  .rd_memory_issue_1(rd_memory_issue_1),
+  .rd_memory_receive_0(rd_memory_receive_0),
+  .rd_memory_receive_1(rd_memory_receive_1),
+  .rd_writeback_0(rd_writeback_0),
+  .rd_writeback_1(rd_writeback_1),
+  .regWrite_execute_0(regWrite_execute_0),
+  .regWrite_execute_1(regWrite_execute_1),
+  .regWrite_memory_issue_0(regWrite_memory_issue_0),
+  .regWrite_memory_issue_1(regWrite_memory_issue_1),
+  .regWrite_memory_receive_0(regWrite_memory_receive_0),
+  .regWrite_memory_receive_1(regWrite_memory_receive_1),
+  .regWrite_writeback_0(regWrite_writeback_0),
+  .regWrite_writeback_1(regWrite_writeback_1),
+
+  // Decoded control signals
+  .branch_op_0(branch_op_decode_0),
+  .memRead_0(memRead_decode_0),
+  .ALU_operation_0(ALU_operation_decode_0),
+  .memWrite_0(memWrite_decode_0),
+  .log2_bytes_0(log2_bytes_decode_0),
+  .unsigned_load_0(unsigned_load_decode_0),
+  .operand_A_sel_0(operand_A_sel_decode_0),
+  .operand_B_sel_0(operand_B_sel_decode_0),
+  .extend_sel_0(extend_sel_decode_0),
+  .regWrite_0(regWrite_decode_0),
+
+  .branch_op_1(branch_op_decode_1),
+  .memRead_1(memRead_decode_1),
+  .ALU_operation_1(ALU_operation_decode_1),
+  .memWrite_1(memWrite_decode_1),
+  .log2_bytes_1(log2_bytes_decode_1),
+  .unsigned_load_1(unsigned_load_decode_1),
+  .operand_A_sel_1(operand_A_sel_decode_1),
+  .operand_B_sel_1(operand_B_sel_decode_1),
+  .extend_sel_1(extend_sel_decode_1),
+  .regWrite_1(regWrite_decode_1),
+
+  .issue_0(issue_0),
+  .issue_1(issue_1),
+
+  .next_PC_sel(next_PC_select),
+  .target_PC(target_PC),
+  .i_mem_read(fetch_read),
+
+  // Base Hazard Detection Unit Ports
+  .fetch_valid(fetch_valid),
+  .fetch_ready(fetch_ready),
+  .issue_request(issue_request_fetch_receive),
+  .issue_PC(issue_PC_fetch_receive),
+  .fetch_address_in(fetch_address_compare),
+  .memory_valid(memory_valid),
+  .memory_ready(memory_ready),
+  .load_memory_receive(memRead_memory_receive),
+  .store_memory_issue(memWrite_memory_issue),
+  .load_address_receive(generated_address_memory_receive),
+  .memory_address_in(memory_address_in),
+
+  // Seven Stage Stall Unit Ports
+  .stall_fetch_receive(stall_fetch_receive),
+  .stall_decode(stall_decode),
+  .stall_execute(stall_execute),
+  .stall_memory_issue(stall_memory_issue),
+  .stall_memory_receive(stall_memory_receive),
+
+  .flush_fetch_receive(flush_fetch_receive),
+  .flush_decode(flush_decode),
+  .flush_execute(flush_execute),
+  .flush_memory_receive(flush_memory_receive),
+  .flush_writeback(flush_writeback),
+
+  // Seven Stage Dual Bypass Unit Ports
+  .rs1_data_bypass_0(rs1_data_bypass_0),
+  .rs2_data_bypass_0(rs2_data_bypass_0),
+  .rs1_data_bypass_1(rs1_data_bypass_1),
+  .rs2_data_bypass_1(rs2_data_bypass_1),
+
+  .scan(scan)
+);
+
+
+/*execute*/
+// Lanes that do not issue this cycle get the flush value (a NOP)
+assign execute_pipe_0_input = ~issue_0 ? execute_pipe_flush :
+                            { inst_PC_decode,
+                              rs1_data_decode_0,
+                              rs2_data_decode_0,
+                              rd_decode_0,
+                              extend_imm_decode_0,
+                              branch_target_decode_0,
+                              branch_op_decode_0,
+                              memRead_decode_0,
+                              ALU_operation_decode_0,
+                              memWrite_decode_0,
+                              log2_bytes_decode_0,
+                              unsigned_load_decode_0,
+                              operand_A_sel_decode_0,
+                              operand_B_sel_decode_0,
+                              regWrite_decode_0,
+                              opcode_decode_0
+                            };
+
+assign execute_pipe_1_input = ~issue_1 ? execute_pipe_flush :
+                            { inst_PC_decode + 4,
+                              rs1_data_decode_1,
+                              rs2_data_decode_1,
+                              rd_decode_1,
+                              extend_imm_decode_1,
+                              branch_target_decode_1,
+                              branch_op_decode_1,
+                              memRead_decode_1,
+                              ALU_operation_decode_1,
+                              memWrite_decode_1,
+                              log2_bytes_decode_1,
+                              unsigned_load_decode_1,
+                              operand_A_sel_decode_1,
+                              operand_B_sel_decode_1,
+                              regWrite_decode_1,
+                              opcode_decode_1
+                            };
+
+assign execute_pipe_flush = { {ADDRESS_BITS{1'b0}},   // inst_PC
+                              {DATA_WIDTH{1'b0}},     // rs1_data,
+                              {DATA_WIDTH{1'b0}},     // rs2_data,
+                              5'b00000,               // rd,
+                              {DATA_WIDTH{1'b0}},     // extend_imm,
+                              {ADDRESS_BITS{1'b0}},   // branch_target,
+                              1'b0,                   // branch_op,
+                              1'b0,                   // memRead,
+                              6'b000000,              // ALU_operation,
+                              1'b0,                   // memWrite,
+                              {LOG2_NUM_BYTES{1'b0}}, // log2_bytes,
+                              1'b0,                   // unsigned_load,
+                              2'b00,                  // operand_A_sel,
+                              1'b0,                   // operand_B_sel,
+                              1'b0,                   // regWrite
+                              7'b0110011              // opcode
+                            };
+
+assign { inst_PC_execute_0,
+         rs1_data_execute_0,
+         rs2_data_execute_0,
+         rd_execute_0,
+         extend_imm_execute_0,
+         branch_target_execute_0,
+         branch_op_execute_0,
+         memRead_execute_0,
+         ALU_operation_execute_0,
+         memWrite_execute_0,
+         log2_bytes_execute_0,
+         unsigned_load_execute_0,
+         operand_A_sel_execute_0,
+         operand_B_sel_execute_0,
+         regWrite_execute_0,
+         opcode_execute_0
+       } = execute_pipe_0_output;
+
+assign { inst_PC_execute_1,
+         rs1_data_execute_1,
+         rs2_data_execute_1,
+         rd_execute_1,
+         extend_imm_execute_1,
+         branch_target_execute_1,
+         branch_op_execute_1,
+         memRead_execute_1,
+         ALU_operation_execute_1,
+         memWrite_execute_1,
+         log2_bytes_execute_1,
+         unsigned_load_execute_1,
+         operand_A_sel_execute_1,
+         operand_B_sel_execute_1,
+         regWrite_execute_1,
+         opcode_execute_1
+       } = execute_pipe_1_output;
+
+pipeline_register #(
+  .PIPELINE_STAGE("Execute Pipe Lane 0"),
+  .PIPE_WIDTH(EXECUTE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) execute_pipe_0 (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_execute),
+  .flush(flush_execute),
+  .pipe_input(execute_pipe_0_input),
+  .flush_input(execute_pipe_flush),
+  .pipe_output(execute_pipe_0_output),
+  //scan signal
+  .scan(scan)
+);
+
+pipeline_register #(
+  .PIPELINE_STAGE("Execute Pipe Lane 1"),
+  .PIPE_WIDTH(EXECUTE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) execute_pipe_1 (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_execute),
+  .flush(flush_execute),
+  .pipe_input(execute_pipe_1_input),
+  .flush_input(execute_pipe_flush),
+  .pipe_output(execute_pipe_1_output),
+  //scan signal
+  .scan(scan)
+);
+
+
+/*execute units*/
+execution_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .P_EXTENSION(P_EXTENSION),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) EX_0 (
+  .clock(clock),
+  .reset(reset),
+  .ALU_operation(ALU_operation_execute_0),
+  .PC(inst_PC_execute_0),
+  .operand_A_sel(operand_A_sel_execute_0),
+  .operand_B_sel(operand_B_sel_execute_0),
+  .branch_op(branch_op_execute_0),
+  .rs1_data(rs1_data_execute_0),
+  .rs2_data(rs2_data_execute_0),
+  .extend(extend_imm_execute_0),
+
+  .branch(branch_execute_0),
+  .ALU_result(ALU_result_execute_0),
+  .JALR_target(JALR_target_execute_0),
+  //scan signal
+  .scan(scan)
+);
+
+execution_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .P_EXTENSION(P_EXTENSION),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) EX_1 (
+  .clock(clock),
+  .reset(reset),
+  .ALU_operation(ALU_operation_execute_1),
+  .PC(inst_PC_execute_1),
+  .operand_A_sel(operand_A_sel_execute_1),
+  .operand_B_sel(operand_B_sel_execute_1),
+  .branch_op(branch_op_execute_1),
+  .rs1_data(rs1_data_execute_1),
+  .rs2_data(rs2_data_execute_1),
+  .extend(extend_imm_execute_1),
+
+  .branch(branch_execute_1),
+  .ALU_result(ALU_result_execute_1),
+  .JALR_target(JALR_target_execute_1),
+  //scan signal
+  .scan(scan)
+);
+
+
+/*memory issue*/
+// At most one lane of a pair accesses memory
+assign memory_lane_execute = memRead_execute_1 | memWrite_execute_1;
+
+assign memory_issue_pipe_input = { memRead_execute_0  | memRead_execute_1,
+                                   memWrite_execute_0 | memWrite_execute_1,
+                                   memory_lane_execute ? log2_bytes_execute_1    : log2_bytes_execute_0,
+                                   memory_lane_execute ? unsigned_load_execute_1 : unsigned_load_execute_0,
+                                   memory_lane_execute ? ALU_result_execute_1    : ALU_result_execute_0,
+                                   memory_lane_execute ? rs2_data_execute_1      : rs2_data_execute_0,
+                                   memory_lane_execute,
+                                   regWrite_execute_0,
+                                   regWrite_execute_1,
+                                   rd_execute_0,
+                                   rd_execute_1,
+                                   ALU_result_execute_0,
+                                   ALU_result_execute_1,
+                                   opcode_execute_0,
+                                   opcode_execute_1
+                                 };
+
+assign memory_issue_pipe_flush = { 1'b0,                   // memRead_execute,
+                                   1'b0,                   // memWrite_execute,
+                                   {LOG2_NUM_BYTES{1'b0}}, // log2_bytes,
+                                   1'b0,                   // unsigned_load,
+                                   {ADDRESS_BITS{1'b0}},   // generated_address_execute,
+                                   {DATA_WIDTH{1'b0}},     // rs2_data_execute,
+                                   1'b0,                   // memory_lane,
+                                   1'b0,                   // regWrite_execute_0,
+                                   1'b0,                   // regWrite_execute_1,
+                                   5'b00000,               // rd_execute_0,
+                                   5'b00000,               // rd_execute_1,
+                                   {DATA_WIDTH{1'b0}},     // ALU_result_execute_0,
+                                   {DATA_WIDTH{1'b0}},     // ALU_result_execute_1,
+                                   7'b0110011,             // opcode_0
+                                   7'b0110011              // opcode_1
+                                 };
+
+assign { memRead_memory_issue,
+         memWrite_memory_issue,
+         log2_bytes_memory_issue,
+         unsigned_load_memory_issue,
+         generated_address_memory_issue,
+         rs2_data_memory_issue,
+         memory_lane_memory_issue,
+         regWrite_memory_issue_0,
+         regWrite_memory_issue_1,
+         rd_memory_issue_0,
+         rd_memory_issue_1,
+         ALU_result_memory_issue_0,
+         ALU_result_memory_issue_1,
+         opcode_memory_issue_0,
+         opcode_memory_issue_1
+       } = memory_issue_pipe_output;
+
+pipeline_register #(
+  .PIPELINE_STAGE("Memory Pipe"),
+  .PIPE_WIDTH(MEMORY_ISSUE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) memory_issue_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_memory_issue),
+  .flush(1'b0),
+  .pipe_input(memory_issue_pipe_input),
+  .flush_input(memory_issue_pipe_flush),
+  .pipe_output(memory_issue_pipe_output),
+  //scan signal
+  .scan(scan)
+);
+
+
+memory_issue #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) MI (
+  .clock(clock),
+  .reset(reset),
+  // Execute stage interface
+  .load(memRead_memory_issue),
+  .store(memWrite_memory_issue),
+  .address(generated_address_memory_issue),
+  .store_data(rs2_data_memory_issue),
+  .log2_bytes(log2_bytes_memory_issue),
+  // Memory interface
+  .memory_read(memory_read),
+  .memory_write(memory_write),
+  .memory_byte_en(memory_byte_en),
+  .memory_address(memory_address_out),
+  .memory_data(memory_data_out),
+  // scan signal
+  .scan(scan)
+);
+
+
+/*memory receive*/
+assign memory_receive_pipe_input = { memRead_memory_issue,
+                                     generated_address_memory_issue,
+                                     log2_bytes_memory_issue,
+                                     unsigned_load_memory_issue,
+                                     memory_lane_memory_issue,
+                                     ALU_result_memory_issue_0,
+                                     ALU_result_memory_issue_1,
+                                     regWrite_memory_issue_0,
+                                     regWrite_memory_issue_1,
+                                     rd_memory_issue_0,
+                                     rd_memory_issue_1,
+                                     opcode_memory_issue_0,
+                                     opcode_memory_issue_1
+                                   };
+
+assign memory_receive_pipe_flush = { 1'b0,                   // memory read
+                                     {ADDRESS_BITS{1'b0}},   // memory read address
+                                     {LOG2_NUM_BYTES{1'b0}}, // log2_bytes
+                                     1'b0,                   // unsigned_load
+                                     1'b0,                   // memory_lane
+                                     {DATA_WIDTH{1'b0}},     // ALU result 0
+                                     {DATA_WIDTH{1'b0}},     // ALU result 1
+                                     1'b0,                   // regWrite 0
+                                     1'b0,                   // regWrite 1
+                                     5'd0,                   // rd 0
+                                     5'd0,                   // rd 1
+                                     7'b0110011,             // opcode 0
+                                     7'b0110011              // opcode 1
+                                   };
+
+assign { memRead_memory_receive,
+         generated_address_memory_receive,
+         log2_bytes_memory_receive,
+         unsigned_load_memory_receive,
+         memory_lane_memory_receive,
+         ALU_result_memory_receive_0,
+         ALU_result_memory_receive_1,
+         regWrite_memory_receive_0,
+         regWrite_memory_receive_1,
+         rd_memory_receive_0,
+         rd_memory_receive_1,
+         opcode_memory_receive_0,
+         opcode_memory_receive_1
+       } = memory_receive_pipe_output;
+
+pipeline_register #(
+  .PIPELINE_STAGE("Memory Receive Pipe"),
+  .PIPE_WIDTH(MEMORY_RECEIVE_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) memory_receive_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(stall_memory_receive),
+  .flush(flush_memory_receive),
+  .pipe_input(memory_receive_pipe_input),
+  .flush_input(memory_receive_pipe_flush),
+  .pipe_output(memory_receive_pipe_output),
+  //scan signal
+  .scan(scan)
+);
+
+
+memory_receive #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS)
+) MR (
+  .clock(clock),
+  .reset(reset),
+  .log2_bytes(log2_bytes_memory_receive),
+  .unsigned_load(unsigned_load_memory_receive),
+  // Memory interface
+  .memory_data_in(memory_data_in),
+  .memory_address_in(memory_address_in),
+  // Writeback interface
+  .load_data(load_data_memory_receive),
+  // scan signal
+  .scan(scan)
+);
+
+assign writeback_pipe_input = { memRead_memory_receive    ,
+                                memory_lane_memory_receive,
+                                load_data_memory_receive  ,
+                                regWrite_memory_receive_0 ,
+                                regWrite_memory_receive_1 ,
+                                rd_memory_receive_0       ,
+                                rd_memory_receive_1       ,
+                                ALU_result_memory_receive_0,
+                                ALU_result_memory_receive_1
+                              };
+
+assign writeback_pipe_flush = { 1'b0,               // memRead_writeback
+                                1'b0,               // memory_lane_writeback
+                                {DATA_WIDTH{1'b0}}, // load_data_writeback
+                                1'b0,               // regWrite_writeback_0
+                                1'b0,               // regWrite_writeback_1
+                                5'd0,               // rd_writeback_0
+                                5'd0,               // rd_writeback_1
+                                {DATA_WIDTH{1'b0}}, // ALU_result_writeback_0
+                                {DATA_WIDTH{1'b0}}  // ALU_result_writeback_1
+                              };
+
+assign { memRead_writeback,
+         memory_lane_writeback,
+         load_data_writeback,
+         regWrite_writeback_0,
+         regWrite_writeback_1,
+         rd_writeback_0,
+         rd_writeback_1,
+         ALU_result_writeback_0,
+         ALU_result_writeback_1
+         } = writeback_pipe_output;
+
+pipeline_register #(
+  .PIPELINE_STAGE("Writeback Pipe"),
+  .PIPE_WIDTH(WRITEBACK_PIPE_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) writeback_pipe (
+  .clock(clock),
+  .reset(reset),
+  .stall(1'b0),
+  .flush(flush_writeback),
+  .pipe_input(writeback_pipe_input),
+  .flush_input(writeback_pipe_flush),
+  .pipe_output(writeback_pipe_output),
+  //scan signal
+  .scan(scan)
+);
+
+
+/*writeback units*/
+writeback_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) WB_0 (
+  .clock(clock),
+  .reset(reset),
+
+  .opWrite(regWrite_writeback_0),
+  .opSel(memRead_writeback & ~memory_lane_writeback),
+  .opReg(rd_writeback_0),
+  .ALU_result(ALU_result_writeback_0),
+  .memory_data(load_data_writeback),
+  //decode unit interface
+  .write(write_writeback_0),
+  .write_reg(write_reg_writeback_0),
+  .write_data(write_data_writeback_0),
+  //scan signal
+  .scan(scan)
+);
+
+writeback_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) WB_1 (
+  .clock(clock),
+  .reset(reset),
+
+  .opWrite(regWrite_writeback_1),
+  .opSel(memRead_writeback & memory_lane_writeback),
+  .opReg(rd_writeback_1),
+  .ALU_result(ALU_result_writeback_1),
+  .memory_data(load_data_writeback),
+  //decode unit interface
+  .write(write_writeback_1),
+  .write_reg(write_reg_writeback_1),
+  .write_data(write_data_writeback_1),
+  //scan signal
+  .scan(scan)
+);
+
+endmodule
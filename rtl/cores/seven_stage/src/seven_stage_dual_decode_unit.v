@@ -0,0 +1,242 @@
+/** @module : seven_stage_dual_decode_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Decodes the instruction pair of seven_stage_dual_core. Lane 0 holds the
+ *    older and lane 1 the younger instruction.
+ *  - The source operands of both lanes are read from one dual_write_regFile,
+ *    which both writeback lanes write. The base decode units only supply
+ *    the fields, immediates and jump targets. Their own register files are
+ *    never written and their read data is unused, so synthesis removes them.
+ *  - rs*_data_bypass selects the register file (0) or a forwarded result,
+ *    see seven_stage_dual_bypass_unit for the encoding.
+ */
+
+module seven_stage_dual_decode_unit #(
+  parameter CORE            = 0,
+  parameter DATA_WIDTH      = 32,
+  parameter ADDRESS_BITS    = 20,
+  parameter SCAN_CYCLES_MIN = 0,
+  parameter SCAN_CYCLES_MAX = 1000
+) (
+  input  clock,
+  input  reset,
+
+  input  [ADDRESS_BITS-1:0] PC_0,
+  input  [ADDRESS_BITS-1:0] PC_1,
+  input  [31:0] instruction_0,
+  input  [31:0] instruction_1,
+  input  [1:0] extend_sel_0,
+  input  [1:0] extend_sel_1,
+  input  write_0,
+  input  [4:0]  write_reg_0,
+  input  [DATA_WIDTH-1:0] write_data_0,
+  input  write_1,
+  input  [4:0]  write_reg_1,
+  input  [DATA_WIDTH-1:0] write_data_1,
+
+  output [DATA_WIDTH-1:0] rs1_data_0,
+  output [DATA_WIDTH-1:0] rs2_data_0,
+  output [4:0]  rd_0,
+  output [6:0]  opcode_0,
+  output [6:0]  funct7_0,
+  output [2:0]  funct3_0,
+  output [DATA_WIDTH-1:0] extend_imm_0,
+  output [ADDRESS_BITS-1:0] branch_target_0,
+  output [ADDRESS_BITS-1:0] JAL_target_0,
+
+  output [DATA_WIDTH-1:0] rs1_data_1,
+  output [DATA_WIDTH-1:0] rs2_data_1,
+  output [4:0]  rd_1,
+  output [6:0]  opcode_1,
+  output [6:0]  funct7_1,
+  output [2:0]  funct3_1,
+  output [DATA_WIDTH-1:0] extend_imm_1,
+  output [ADDRESS_BITS-1:0] branch_target_1,
+  output [ADDRESS_BITS-1:0] JAL_target_1,
+
+  // Data Bypassing Signals
+  input [3:0] rs1_data_bypass_0,
+  input [3:0] rs2_data_bypass_0,
+  input [3:0] rs1_data_bypass_1,
+  input [3:0] rs2_data_bypass_1,
+  input [DATA_WIDTH-1:0] ALU_result_execute_0,
+  input [DATA_WIDTH-1:0] ALU_result_execute_1,
+  input [DATA_WIDTH-1:0] ALU_result_memory_issue_0,
+  input [DATA_WIDTH-1:0] ALU_result_memory_issue_1,
+  input [DATA_WIDTH-1:0] ALU_result_memory_receive_0,
+  input [DATA_WIDTH-1:0] ALU_result_memory_receive_1,
+  input [DATA_WIDTH-1:0] ALU_result_writeback_0,
+  input [DATA_WIDTH-1:0] ALU_result_writeback_1,
+
+  input scan
+
+);
+
+wire [DATA_WIDTH-1:0] rs1_data_decode_0;
+wire [DATA_WIDTH-1:0] rs2_data_decode_0;
+wire [DATA_WIDTH-1:0] rs1_data_decode_1;
+wire [DATA_WIDTH-1:0] rs2_data_decode_1;
+
+// Select signal for data bypassing. Lane 1 results are younger than lane 0
+// results of the same stage.
+assign rs1_data_0 = (rs1_data_bypass_0 == 4'd0)? rs1_data_decode_0           :
+                    (rs1_data_bypass_0 == 4'd1)? ALU_result_execute_1        :
+                    (rs1_data_bypass_0 == 4'd2)? ALU_result_execute_0        :
+                    (rs1_data_bypass_0 == 4'd3)? ALU_result_memory_issue_1   :
+                    (rs1_data_bypass_0 == 4'd4)? ALU_result_memory_issue_0   :
+                    (rs1_data_bypass_0 == 4'd5)? ALU_result_memory_receive_1 :
+                    (rs1_data_bypass_0 == 4'd6)? ALU_result_memory_receive_0 :
+                    (rs1_data_bypass_0 == 4'd7)? ALU_result_writeback_1      :
+                    (rs1_data_bypass_0 == 4'd8)? ALU_result_writeback_0      :
+                    {DATA_WIDTH{1'b0}};
+
+assign rs2_data_0 = (rs2_data_bypass_0 == 4'd0)? rs2_data_decode_0           :
+                    (rs2_data_bypass_0 == 4'd1)? ALU_result_execute_1        :
+                    (rs2_data_bypass_0 == 4'd2)? ALU_result_execute_0        :
+                    (rs2_data_bypass_0 == 4'd3)? ALU_result_memory_issue_1   :
+                    (rs2_data_bypass_0 == 4'd4)? ALU_result_memory_issue_0   :
+                    (rs2_data_bypass_0 == 4'd5)? ALU_result_memory_receive_1 :
+                    (rs2_data_bypass_0 == 4'd6)? ALU_result_memory_receive_0 :
+                    (rs2_data_bypass_0 == 4'd7)? ALU_result_writeback_1      :
+                    (rs2_data_bypass_0 == 4'd8)? ALU_result_writeback_0      :
+                    {DATA_WIDTH{1'b0}};
+
+assign rs1_data_1 = (rs1_data_bypass_1 == 4'd0)? rs1_data_decode_1           :
+                    (rs1_data_bypass_1 == 4'd1)? ALU_result_execute_1        :
+                    (rs1_data_bypass_1 == 4'd2)? ALU_result_execute_0        :
+                    (rs1_data_bypass_1 == 4'd3)? ALU_result_memory_issue_1   :
+                    (rs1_data_bypass_1 == 4'd4)? ALU_result_memory_issue_0   :
+                    (rs1_data_bypass_1 == 4'd5)? ALU_result_memory_receive_1 :
+                    (rs1_data_bypass_1 == 4'd6)? ALU_result_memory_receive_0 :
+                    (rs1_data_bypass_1 == 4'd7)? ALU_result_writeback_1      :
+                    (rs1_data_bypass_1 == 4'd8)? ALU_result_writeback_0      :
+                    {DATA_WIDTH{1'b0}};
+
+assign rs2_data_1 = (rs2_data_bypass_1 == 4'd0)? rs2_data_decode_1           :
+                    (rs2_data_bypass_1 == 4'd1)? ALU_result_execute_1        :
+                    (rs2_data_bypass_1 == 4'd2)? ALU_result_execute_0        :
+                    (rs2_data_bypass_1 == 4'd3)? ALU_result_memory_issue_1   :
+                    (rs2_data_bypass_1 == 4'd4)? ALU_result_memory_issue_0   :
+                    (rs2_data_bypass_1 == 4'd5)? ALU_result_memory_receive_1 :
+                    (rs2_data_bypass_1 == 4'd6)? ALU_result_memory_receive_0 :
+                    (rs2_data_bypass_1 == 4'd7)? ALU_result_writeback_1      :
+                    (rs2_data_bypass_1 == 4'd8)? ALU_result_writeback_0      :
+                    {DATA_WIDTH{1'b0}};
+
+dual_write_regFile #(
+  .REG_DATA_WIDTH(DATA_WIDTH),
+  .REG_SEL_BITS(5)
+) registers (
+  .clock(clock),
+  .reset(reset),
+  .wEn1(write_0),
+  .write_data1(write_data_0),
+  .write_sel1(write_reg_0),
+  .wEn2(write_1),
+  .write_data2(write_data_1),
+  .write_sel2(write_reg_1),
+  .read_sel1(instruction_0[19:15]),
+  .read_sel2(instruction_0[24:20]),
+  .read_sel3(instruction_1[19:15]),
+  .read_sel4(instruction_1[24:20]),
+  .read_data1(rs1_data_decode_0),
+  .read_data2(rs2_data_decode_0),
+  .read_data3(rs1_data_decode_1),
+  .read_data4(rs2_data_decode_1)
+);
+
+decode_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) base_decode_0 (
+  .clock(clock),
+  .reset(reset),
+
+  .PC(PC_0),
+  .instruction(instruction_0),
+  .extend_sel(extend_sel_0),
+  .write(1'b0),
+  .write_reg(5'd0),
+  .write_data({DATA_WIDTH{1'b0}}),
+
+  .rs1_data(),
+  .rs2_data(),
+  .rd(rd_0),
+  .opcode(opcode_0),
+  .funct7(funct7_0),
+  .funct3(funct3_0),
+  .extend_imm(extend_imm_0),
+  .branch_target(branch_target_0),
+  .JAL_target(JAL_target_0),
+
+  .scan(scan)
+);
+
+decode_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) base_decode_1 (
+  .clock(clock),
+  .reset(reset),
+
+  .PC(PC_1),
+  .instruction(instruction_1),
+  .extend_sel(extend_sel_1),
+  .write(1'b0),
+  .write_reg(5'd0),
+  .write_data({DATA_WIDTH{1'b0}}),
+
+  .rs1_data(),
+  .rs2_data(),
+  .rd(rd_1),
+  .opcode(opcode_1),
+  .funct7(funct7_1),
+  .funct3(funct3_1),
+  .extend_imm(extend_imm_1),
+  .branch_target(branch_target_1),
+  .JAL_target(JAL_target_1),
+
+  .scan(scan)
+);
+
+reg [31: 0] cycles;
+always @ (posedge clock) begin
+  cycles <= reset? 0 : cycles + 1;
+  if (scan  & ((cycles >= SCAN_CYCLES_MIN) & (cycles <= SCAN_CYCLES_MAX)) )begin
+    $display ("------ Core %d Seven Stage Dual Decode Unit - Current Cycle %d --", CORE, cycles);
+    $display ("| rs1_data_0  [%d]", rs1_data_0);
+    $display ("| rs2_data_0  [%d]", rs2_data_0);
+    $display ("| rs1_data_1  [%d]", rs1_data_1);
+    $display ("| rs2_data_1  [%d]", rs2_data_1);
+    $display ("----------------------------------------------------------------------");
+  end
+end
+
+endmodule
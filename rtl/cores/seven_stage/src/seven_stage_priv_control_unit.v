@@ -96,6 +96,7 @@ module seven_stage_priv_control_unit #(
   input [1:0] priv,
   input       intr_branch,
   input       trap_branch,
+  input       interrupt_pending,
 
   input [ADDRESS_BITS-1:0] inst_PC_fetch_receive,
   input [ADDRESS_BITS-1:0] inst_PC_decode,
@@ -193,6 +194,9 @@ localparam[6:0] R_TYPE  = 7'b0110011,
 localparam [6:0]IMM_32 = 7'b0011011,
                 OP_32  = 7'b0111011;
 
+// P extension (packed SIMD) opcode
+localparam [6:0]OP_P   = 7'b1110111;
+
 
 wire rs1_read;
 wire rs2_read;
@@ -238,6 +242,8 @@ wire JALR_branch_hazard_base;
 wire JAL_hazard_base;
 wire solo_instr_hazard_base;
 
+wire wfi_decode;
+wire wfi_hazard;
 wire true_data_hazard;
 wire execute_invalid_hazard;
 wire d_mem_hazard;
@@ -283,13 +289,15 @@ generate
                       (opcode_decode == IMM_32) |
                       (opcode_decode == OP_32 ) |
                       (opcode_decode == SYSTEM) |
-                      (opcode_decode == AMO   );
+                      (opcode_decode == AMO   ) |
+                      (opcode_decode == OP_P  );
 
     assign rs2_read = (opcode_decode == R_TYPE) |
                       (opcode_decode == STORE ) |
                       (opcode_decode == BRANCH) |
                       (opcode_decode == OP_32 ) |
-                      (opcode_decode == AMO   );
+                      (opcode_decode == AMO   ) |
+                      (opcode_decode == OP_P  );
   end
   else begin
     assign rs1_read = (opcode_decode == R_TYPE) |
@@ -299,12 +307,14 @@ generate
                       (opcode_decode == BRANCH) |
                       (opcode_decode == JALR  ) |
                       (opcode_decode == SYSTEM) |
-                      (opcode_decode == AMO   );
+                      (opcode_decode == AMO   ) |
+                      (opcode_decode == OP_P  );
 
     assign rs2_read = (opcode_decode == R_TYPE) |
                       (opcode_decode == STORE ) |
                       (opcode_decode == BRANCH) |
-                      (opcode_decode == AMO   );
+                      (opcode_decode == AMO   ) |
+                      (opcode_decode == OP_P  );
 
   end
 endgenerate
@@ -360,7 +370,12 @@ assign rs2_true_hazard = rs2_load_hazard_execute       |
                          rs2_system_hazard_memory_issue   |
                          rs2_system_hazard_memory_receive ;
 
-assign true_data_hazard = rs1_true_hazard | rs2_true_hazard;
+// WFI waits in decode until an interrupt is pending. It is a solo
+// instruction, so fetch is already stopped and the core does not access
+// memory while it waits.
+assign wfi_hazard = wfi_decode & ~interrupt_pending;
+
+assign true_data_hazard = rs1_true_hazard | rs2_true_hazard | wfi_hazard;
 assign execute_invalid_hazard = ~execute_valid_result;
 
 assign i_mem_hazard = i_mem_issue_hazard | i_mem_recv_hazard;
@@ -607,6 +622,7 @@ priv_control #(
   .m_ret_decode(m_ret_decode),
   .s_ret_decode(s_ret_decode),
   .u_ret_decode(u_ret_decode),
+  .wfi_decode(wfi_decode),
 
   .trap_PC(trap_PC),
 
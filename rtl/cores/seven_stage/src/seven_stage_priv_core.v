@@ -30,6 +30,8 @@ module seven_stage_priv_core #(
   parameter PPN_BITS       = DATA_WIDTH == 32 ? 22 : 44,
   parameter NUM_BYTES       = DATA_WIDTH/8,
   parameter M_EXTENSION     = "True",
+  parameter P_EXTENSION     = 0,
+  parameter LOOP_BUFFER_WORDS = 0,
   parameter SCAN_CYCLES_MIN = 0,
   parameter SCAN_CYCLES_MAX = 1000
 ) (
@@ -176,6 +178,15 @@ localparam WRITEBACK_PIPE_WIDTH = 1             // regWrite_writeback
 
 
 
+// Loop Buffer Wires, the fetch interface seen by the pipeline
+wire core_fetch_read;
+wire [ADDRESS_BITS-1:0] core_fetch_address_out;
+wire [DATA_WIDTH-1  :0] core_fetch_data_in;
+wire [ADDRESS_BITS-1:0] core_fetch_address_in;
+wire core_fetch_valid;
+wire core_fetch_ready;
+wire fence_i_decode;
+
 // Fetch Issue Stage Wires
 wire [1:0] next_PC_select;
 wire [ADDRESS_BITS-1:0] target_PC;
@@ -372,6 +383,7 @@ wire u_ret_memory_receive;
 
 wire intr_branch;
 wire trap_branch;
+wire interrupt_pending;
 wire CSR_read_en_memory_receive;
 wire CSR_write_en_memory_receive;
 wire CSR_set_en_memory_receive;
@@ -449,7 +461,7 @@ fetch_issue_intr #(
   .next_PC_select(next_PC_select),
   .target_PC(target_PC),
   .issue_PC(issue_PC),
-  .i_mem_read_address(fetch_address_out),
+  .i_mem_read_address(core_fetch_address_out),
   .trap_branch(trap_branch),
   .trap_target(trap_target),
   .next_PC(next_PC),
@@ -457,9 +469,54 @@ fetch_issue_intr #(
 );
 
 
+/*loop buffer*/
+// fence.i in decode and traps empties the loop buffer.
+assign fence_i_decode = (instruction_decode[6:0] == 7'b0001111) & (instruction_decode[14:12] == 3'b001);
+
+generate
+  if(LOOP_BUFFER_WORDS > 0) begin : LOOP
+    loop_buffer #(
+      .CORE(CORE),
+      .DATA_WIDTH(DATA_WIDTH),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
+      .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+      .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+    ) buffer (
+      .clock(clock),
+      .reset(reset),
+      .next_PC_select(next_PC_select),
+      .target_PC(target_PC),
+      .invalidate(fence_i_decode | trap_branch),
+      .fetch_read(core_fetch_read),
+      .fetch_address_out(core_fetch_address_out),
+      .fetch_data_in(core_fetch_data_in),
+      .fetch_address_in(core_fetch_address_in),
+      .fetch_valid(core_fetch_valid),
+      .fetch_ready(core_fetch_ready),
+      .i_mem_read(fetch_read),
+      .i_mem_address_in(fetch_address_out),
+      .i_mem_data_out(fetch_data_in),
+      .i_mem_address_out(fetch_address_in),
+      .i_mem_valid(fetch_valid),
+      .i_mem_ready(fetch_ready),
+      .scan(scan)
+    );
+  end
+  else begin : NO_LOOP
+    assign fetch_read            = core_fetch_read;
+    assign fetch_address_out     = core_fetch_address_out;
+    assign core_fetch_data_in    = fetch_data_in;
+    assign core_fetch_address_in = fetch_address_in;
+    assign core_fetch_valid      = fetch_valid;
+    assign core_fetch_ready      = fetch_ready;
+  end
+endgenerate
+
+
 /*fetch receive*/
 assign fetch_receive_pipe_input = { issue_PC,
-                                    fetch_read
+                                    core_fetch_read
                                   };
 
 assign fetch_receive_pipe_flush = { {{ADDRESS_BITS-1{1'b0}}, 1'b1},
@@ -494,9 +551,17 @@ fetch_receive #(
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) FR (
   .flush(~issue_request_fetch_receive),
-  .i_mem_data(fetch_data_in),
+  .i_mem_data(core_fetch_data_in),
   .issue_PC(issue_PC_fetch_receive),
+  .issue_tail(1'b0),
+  .issue_half(16'd0),
   .instruction(instruction_fetch_receive),
+  .compressed(),
+  .complete(),
+  .fetch_address(),
+  .next_PC(),
+  .next_tail(),
+  .next_half(),
   //scan signal
   .scan(scan)
 );
@@ -504,7 +569,7 @@ fetch_receive #(
 assign exception_fetch_receive      = new_exception_fetch_receive;
 assign exception_code_fetch_receive = new_exception_code_fetch_receive;
 
-assign inst_PC_fetch_receive = fetch_address_in;
+assign inst_PC_fetch_receive = core_fetch_address_in;
 
 
 assign decode_pipe_input = { instruction_fetch_receive,
@@ -622,13 +687,13 @@ seven_stage_priv_control_unit #(
   .regWrite(regWrite_decode),
 
   .target_PC(target_PC),
-  .i_mem_read(fetch_read),
+  .i_mem_read(core_fetch_read),
 
   // Base Hazard Detection Unit Ports
-  .fetch_valid(fetch_valid),
-  .fetch_ready(fetch_ready),
+  .fetch_valid(core_fetch_valid),
+  .fetch_ready(core_fetch_ready),
   .issue_PC(issue_PC_fetch_receive),
-  .fetch_address_in(fetch_address_in),
+  .fetch_address_in(core_fetch_address_in),
   .memory_valid(memory_valid),
   .memory_ready(memory_ready),
   .load_memory_receive(memRead_memory_receive), // memRead_memory_receive
@@ -694,6 +759,7 @@ seven_stage_priv_control_unit #(
 
   .trap_PC(trap_PC),
   .trap_branch(trap_branch),
+  .interrupt_pending(interrupt_pending),
 
   .CSR_read_en(CSR_read_en_decode),
   .CSR_write_en(CSR_write_en_decode),
@@ -869,6 +935,7 @@ execution_unit_multi_cycle #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
   .M_EXTENSION(M_EXTENSION),
+  .P_EXTENSION(P_EXTENSION),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) EX (
@@ -1197,6 +1264,7 @@ CSR_unit_priv #(
   .CSR_read_data(CSR_read_data_memory_receive),
 
   .intr_branch(intr_branch),
+  .interrupt_pending(interrupt_pending),
   .trap_branch(trap_branch),
   .trap_target(trap_target),
 
@@ -0,0 +1,184 @@
+/** @module : seven_stage_trace_writer
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Simulation only. Writes the seven_stage_core commit and pipeline
+ *    occupancy trace ports to a compact binary file.
+ *  - Tracing is enabled with the +trace=<prefix> plusarg. Each core writes
+ *    <prefix>.core<CORE>.trc. Add +trace_no_occupancy to record retired
+ *    instructions only.
+ *  - The file is a stream of little endian 32-bit words. It starts with the
+ *    header {"TRT1", {DATA_WIDTH[15:0], ADDRESS_BITS[15:0]}, CORE} and is
+ *    followed by records. Every record holds the number of cycles since the
+ *    previous record.
+ *      commit    : {2'b01, reg_write, mem_access, store, rd[4:0], delta[21:0]},
+ *                  PC, instruction, rd data (if reg_write),
+ *                  memory address (if mem_access)
+ *      occupancy : {2'b10, delta[5:0], stage_valid[5:0], stall[4:0],
+ *                  flush[4:0], hazards[7:0]}, written only when it changes
+ *      sync      : {2'b11, 30'd0}, cycle[31:0], cycle[63:32], written first
+ *                  and whenever a delta does not fit in its record
+ *  - PC, rd data and addresses wider than 32 bits take multiple words, least
+ *    significant word first.
+ *  - software/helper_scripts/trace_decode.py converts traces to text or to
+ *    the Kanata format used by the Konata pipeline viewer.
+ */
+
+module seven_stage_trace_writer #(
+  parameter CORE         = 0,
+  parameter DATA_WIDTH   = 32,
+  parameter ADDRESS_BITS = 32
+) (
+  input clock,
+  input reset,
+  //commit trace interface
+  input trace_retire,
+  input [ADDRESS_BITS-1:0] trace_PC,
+  input [31            :0] trace_instruction,
+  input trace_reg_write,
+  input [4             :0] trace_rd,
+  input [DATA_WIDTH-1  :0] trace_rd_data,
+  input trace_memory_access,
+  input trace_store,
+  input [ADDRESS_BITS-1:0] trace_memory_address,
+  //pipeline occupancy interface
+  input [5             :0] trace_stage_valid,
+  input [4             :0] trace_stall,
+  input [4             :0] trace_flush,
+  input [7             :0] trace_hazards
+);
+
+localparam MAGIC            = 32'h54525431; // "TRT1"
+localparam COMMIT_RECORD    = 2'b01;
+localparam OCCUPANCY_RECORD = 2'b10;
+localparam SYNC_RECORD      = 2'b11;
+localparam MAX_COMMIT_DELTA    = (1 << 22) - 1;
+localparam MAX_OCCUPANCY_DELTA = (1 << 6) - 1;
+
+localparam ADDRESS_WORDS = (ADDRESS_BITS + 31)/32;
+localparam DATA_WORDS    = (DATA_WIDTH + 31)/32;
+
+integer file;
+integer w;
+reg occupancy_enable;
+reg [1023:0] prefix;
+reg [1023:0] file_name;
+
+reg [63:0] cycles;
+reg [63:0] last_record;
+reg [23:0] occupancy;
+reg [23:0] last_occupancy;
+reg first_record;
+reg [63:0] delta;
+reg [31:0] word;
+
+initial begin
+  file             = 0;
+  first_record     = 1'b1;
+  last_record      = 64'd0;
+  last_occupancy   = 24'd0;
+  occupancy_enable = !$test$plusargs("trace_no_occupancy");
+  if($value$plusargs("trace=%s", prefix)) begin
+    $sformat(file_name, "%0s.core%0d.trc", prefix, CORE);
+    file = $fopen(file_name, "wb");
+    if(file == 0) begin
+      $display("seven_stage_trace_writer: could not open %0s", file_name);
+    end
+    else begin
+      $fwrite(file, "%u", MAGIC);
+      word = (DATA_WIDTH << 16) | ADDRESS_BITS;
+      $fwrite(file, "%u", word);
+      word = CORE;
+      $fwrite(file, "%u", word);
+    end
+  end
+end
+
+task write_sync;
+  begin
+    word = {SYNC_RECORD, 30'd0};
+    $fwrite(file, "%u", word);
+    write_wide(cycles, 2);
+    last_record  = cycles;
+    first_record = 1'b0;
+  end
+endtask
+
+// Writes a sync record first if the delta to the previous record would not
+// fit in max_delta.
+task prepare_record;
+  input [63:0] max_delta;
+  begin
+    if(first_record | ((cycles - last_record) > max_delta))
+      write_sync;
+    delta = cycles - last_record;
+  end
+endtask
+
+task write_wide;
+  input [127:0] value;
+  input integer num_words;
+  begin
+    for(w=0; w<num_words; w=w+1) begin
+      word = value >> (32*w);
+      $fwrite(file, "%u", word);
+    end
+  end
+endtask
+
+always @(posedge clock) begin
+  if(reset) begin
+    cycles <= 64'd0;
+  end
+  else begin
+    cycles <= cycles + 64'd1;
+  end
+end
+
+always @(posedge clock) begin
+  if(~reset & (file != 0)) begin
+    occupancy = {trace_stage_valid, trace_stall, trace_flush, trace_hazards};
+    if(occupancy_enable & (first_record | (occupancy != last_occupancy))) begin
+      prepare_record(MAX_OCCUPANCY_DELTA);
+      word = {OCCUPANCY_RECORD, delta[5:0], occupancy};
+      $fwrite(file, "%u", word);
+      last_record    = cycles;
+      last_occupancy = occupancy;
+    end
+    if(trace_retire) begin
+      prepare_record(MAX_COMMIT_DELTA);
+      word = {COMMIT_RECORD, trace_reg_write, trace_memory_access, trace_store,
+              trace_rd, delta[21:0]};
+      $fwrite(file, "%u", word);
+      write_wide(trace_PC, ADDRESS_WORDS);
+      write_wide(trace_instruction, 1);
+      if(trace_reg_write)
+        write_wide(trace_rd_data, DATA_WORDS);
+      if(trace_memory_access)
+        write_wide(trace_memory_address, ADDRESS_WORDS);
+      last_record = cycles;
+    end
+  end
+end
+
+endmodule
@@ -0,0 +1,155 @@
+/** @module : tb_seven_stage_dual_bypass_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_seven_stage_dual_bypass_unit();
+
+parameter CORE            = 0;
+parameter SCAN_CYCLES_MIN = 0;
+parameter SCAN_CYCLES_MAX = 1000;
+
+reg clock;
+reg reset;
+
+reg true_data_hazard_0;
+reg true_data_hazard_1;
+
+reg [7:0] rs1_hazard_0;
+reg [7:0] rs2_hazard_0;
+reg [7:0] rs1_hazard_1;
+reg [7:0] rs2_hazard_1;
+
+wire [3:0] rs1_data_bypass_0;
+wire [3:0] rs2_data_bypass_0;
+wire [3:0] rs1_data_bypass_1;
+wire [3:0] rs2_data_bypass_1;
+
+reg scan;
+
+seven_stage_dual_bypass_unit #(
+  .CORE(CORE),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) uut (
+  .clock(clock),
+  .reset(reset),
+
+  .true_data_hazard_0(true_data_hazard_0),
+  .true_data_hazard_1(true_data_hazard_1),
+
+  .rs1_hazard_0(rs1_hazard_0),
+  .rs2_hazard_0(rs2_hazard_0),
+  .rs1_hazard_1(rs1_hazard_1),
+  .rs2_hazard_1(rs2_hazard_1),
+
+  .rs1_data_bypass_0(rs1_data_bypass_0),
+  .rs2_data_bypass_0(rs2_data_bypass_0),
+  .rs1_data_bypass_1(rs1_data_bypass_1),
+  .rs2_data_bypass_1(rs2_data_bypass_1),
+
+  .scan(scan)
+);
+
+always #5 clock = ~clock;
+
+initial begin
+  clock = 1'b1;
+  reset = 1'b1;
+
+  true_data_hazard_0 = 1'b0;
+  true_data_hazard_1 = 1'b0;
+
+  rs1_hazard_0 = 8'b00000000;
+  rs2_hazard_0 = 8'b00000000;
+  rs1_hazard_1 = 8'b00000000;
+  rs2_hazard_1 = 8'b00000000;
+
+  scan = 1'b0;
+
+  repeat (1) @ (posedge clock);
+  reset = 1'b0;
+
+  repeat (1) @ (posedge clock);
+
+  if( rs1_data_bypass_0 != 4'd0 | rs2_data_bypass_0 != 4'd0 |
+      rs1_data_bypass_1 != 4'd0 | rs2_data_bypass_1 != 4'd0 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Bypassing should not be active!");
+    $display("\ntb_seven_stage_dual_bypass_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // One writer per operand
+  rs1_hazard_0 = 8'b00000001; // execute lane 1
+  rs2_hazard_0 = 8'b00000010; // execute lane 0
+  rs1_hazard_1 = 8'b00100000; // memory receive lane 0
+  rs2_hazard_1 = 8'b10000000; // writeback lane 0
+
+  repeat (1) @ (posedge clock);
+
+  if( rs1_data_bypass_0 != 4'd1 | rs2_data_bypass_0 != 4'd2 |
+      rs1_data_bypass_1 != 4'd6 | rs2_data_bypass_1 != 4'd8 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: The only writer should be forwarded!");
+    $display("\ntb_seven_stage_dual_bypass_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Several writers, the youngest one is forwarded
+  rs1_hazard_0 = 8'b00000011; // both execute lanes
+  rs2_hazard_0 = 8'b11000000; // both writeback lanes
+  rs1_hazard_1 = 8'b10001000; // memory issue lane 0 and writeback lane 0
+  rs2_hazard_1 = 8'b00110100; // memory issue lane 1 and memory receive lanes
+
+  repeat (1) @ (posedge clock);
+
+  if( rs1_data_bypass_0 != 4'd1 | rs2_data_bypass_0 != 4'd7 |
+      rs1_data_bypass_1 != 4'd4 | rs2_data_bypass_1 != 4'd3 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: The youngest writer should be forwarded!");
+    $display("\ntb_seven_stage_dual_bypass_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // True data hazards only disable the bypass of their lane
+  true_data_hazard_0 = 1'b1;
+
+  repeat (1) @ (posedge clock);
+
+  if( rs1_data_bypass_0 != 4'd0 | rs2_data_bypass_0 != 4'd0 |
+      rs1_data_bypass_1 != 4'd4 | rs2_data_bypass_1 != 4'd3 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Bypassing should only stop in the lane with a true data hazard!");
+    $display("\ntb_seven_stage_dual_bypass_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  repeat (1) @ (posedge clock);
+  $display("\ntb_seven_stage_dual_bypass_unit --> Test Passed!\n\n");
+  $stop();
+
+end
+
+endmodule
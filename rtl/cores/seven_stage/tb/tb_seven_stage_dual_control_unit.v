@@ -0,0 +1,389 @@
+/** @module : tb_seven_stage_dual_control_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_seven_stage_dual_control_unit();
+
+parameter [6:0] R_TYPE  = 7'b0110011,
+                I_TYPE  = 7'b0010011,
+                STORE   = 7'b0100011,
+                LOAD    = 7'b0000011,
+                BRANCH  = 7'b1100011,
+                JALR    = 7'b1100111,
+                JAL     = 7'b1101111;
+
+parameter CORE            = 0;
+parameter DATA_WIDTH      = 32;
+parameter ADDRESS_BITS    = 20;
+parameter SCAN_CYCLES_MIN = 0;
+parameter SCAN_CYCLES_MAX = 1000;
+
+reg clock;
+reg reset;
+
+// Decode stage pair
+reg valid_1;
+reg [6:0] opcode_0;
+reg [4:0] rs1_0;
+reg [4:0] rs2_0;
+reg [4:0] rd_0;
+reg [6:0] opcode_1;
+reg [4:0] rs1_1;
+reg [4:0] rs2_1;
+reg [4:0] rd_1;
+
+// Execute stage branches
+reg branch_execute_0;
+reg branch_execute_1;
+
+// Instructions in flight
+reg [6:0] opcode_execute_0;
+reg [6:0] opcode_execute_1;
+reg [4:0] rd_execute_0;
+reg [4:0] rd_execute_1;
+reg regWrite_execute_0;
+reg regWrite_execute_1;
+
+wire issue_0;
+wire issue_1;
+wire [1:0] next_PC_sel;
+wire [ADDRESS_BITS-1:0] target_PC;
+
+wire stall_fetch_receive;
+wire stall_decode;
+wire stall_execute;
+wire stall_memory_issue;
+wire stall_memory_receive;
+wire flush_fetch_receive;
+wire flush_decode;
+wire flush_execute;
+wire flush_memory_receive;
+wire flush_writeback;
+
+wire [3:0] rs1_data_bypass_0;
+wire [3:0] rs2_data_bypass_0;
+wire [3:0] rs1_data_bypass_1;
+wire [3:0] rs2_data_bypass_1;
+
+reg scan;
+
+seven_stage_dual_control_unit #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+
+  .valid_1(valid_1),
+  .opcode_0(opcode_0),
+  .funct3_0(3'b000),
+  .funct7_0(7'b0000000),
+  .rs1_0(rs1_0),
+  .rs2_0(rs2_0),
+  .rd_0(rd_0),
+  .opcode_1(opcode_1),
+  .funct3_1(3'b010),
+  .funct7_1(7'b0000000),
+  .rs1_1(rs1_1),
+  .rs2_1(rs2_1),
+  .rd_1(rd_1),
+  .JAL_target_decode_0(20'd12),
+  .JAL_target_decode_1(20'd16),
+
+  .JALR_target_execute_0(20'd4),
+  .JALR_target_execute_1(20'd24),
+  .branch_target_execute_0(20'd8),
+  .branch_target_execute_1(20'd28),
+  .branch_execute_0(branch_execute_0),
+  .branch_execute_1(branch_execute_1),
+
+  .opcode_execute_0(opcode_execute_0),
+  .opcode_execute_1(opcode_execute_1),
+  .opcode_memory_issue_0(R_TYPE),
+  .opcode_memory_issue_1(R_TYPE),
+  .opcode_memory_receive_0(R_TYPE),
+  .opcode_memory_receive_1(R_TYPE),
+  .rd_execute_0(rd_execute_0),
+  .rd_execute_1(rd_execute_1),
+  .rd_memory_issue_0(5'd0),
+  .rd_memory_issue_1(5'd0),
+  .rd_memory_receive_0(5'd0),
+  .rd_memory_receive_1(5'd0),
+  .rd_writeback_0(5'd0),
+  .rd_writeback_1(5'd0),
+  .regWrite_execute_0(regWrite_execute_0),
+  .regWrite_execute_1(regWrite_execute_1),
+  .regWrite_memory_issue_0(1'b0),
+  .regWrite_memory_issue_1(1'b0),
+  .regWrite_memory_receive_0(1'b0),
+  .regWrite_memory_receive_1(1'b0),
+  .regWrite_writeback_0(1'b0),
+  .regWrite_writeback_1(1'b0),
+
+  .branch_op_0(),
+  .memRead_0(),
+  .ALU_operation_0(),
+  .memWrite_0(),
+  .log2_bytes_0(),
+  .unsigned_load_0(),
+  .operand_A_sel_0(),
+  .operand_B_sel_0(),
+  .extend_sel_0(),
+  .regWrite_0(),
+
+  .branch_op_1(),
+  .memRead_1(),
+  .ALU_operation_1(),
+  .memWrite_1(),
+  .log2_bytes_1(),
+  .unsigned_load_1(),
+  .operand_A_sel_1(),
+  .operand_B_sel_1(),
+  .extend_sel_1(),
+  .regWrite_1(),
+
+  .issue_0(issue_0),
+  .issue_1(issue_1),
+
+  .next_PC_sel(next_PC_sel),
+  .target_PC(target_PC),
+  .i_mem_read(),
+
+  .fetch_valid(1'b1),
+  .fetch_ready(1'b1),
+  .issue_request(1'b1),
+  .issue_PC(20'd0),
+  .fetch_address_in(20'd0),
+  .memory_valid(1'b1),
+  .memory_ready(1'b1),
+  .load_memory_receive(1'b0),
+  .store_memory_issue(1'b0),
+  .load_address_receive(20'd0),
+  .memory_address_in(20'd0),
+
+  .stall_fetch_receive(stall_fetch_receive),
+  .stall_decode(stall_decode),
+  .stall_execute(stall_execute),
+  .stall_memory_issue(stall_memory_issue),
+  .stall_memory_receive(stall_memory_receive),
+
+  .flush_fetch_receive(flush_fetch_receive),
+  .flush_decode(flush_decode),
+  .flush_execute(flush_execute),
+  .flush_memory_receive(flush_memory_receive),
+  .flush_writeback(flush_writeback),
+
+  .rs1_data_bypass_0(rs1_data_bypass_0),
+  .rs2_data_bypass_0(rs2_data_bypass_0),
+  .rs1_data_bypass_1(rs1_data_bypass_1),
+  .rs2_data_bypass_1(rs2_data_bypass_1),
+
+  .scan(scan)
+);
+
+always #5 clock = ~clock;
+
+initial begin
+  clock = 1'b1;
+  reset = 1'b1;
+
+  valid_1  = 1'b1;
+  opcode_0 = R_TYPE;
+  rs1_0    = 5'd1;
+  rs2_0    = 5'd2;
+  rd_0     = 5'd3;
+  opcode_1 = R_TYPE;
+  rs1_1    = 5'd4;
+  rs2_1    = 5'd5;
+  rd_1     = 5'd6;
+
+  branch_execute_0   = 1'b0;
+  branch_execute_1   = 1'b0;
+  opcode_execute_0   = R_TYPE;
+  opcode_execute_1   = R_TYPE;
+  rd_execute_0       = 5'd0;
+  rd_execute_1       = 5'd0;
+  regWrite_execute_0 = 1'b0;
+  regWrite_execute_1 = 1'b0;
+
+  scan = 1'b0;
+
+  repeat (1) @ (posedge clock);
+  reset = 1'b0;
+  #1
+
+  // Independent pair issues together
+  if( issue_0      !== 1'b1  |
+      issue_1      !== 1'b1  |
+      stall_decode !== 1'b0  |
+      next_PC_sel  !== 2'b00 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for independent pair!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Lane 1 reads the result of lane 0, lane 0 issues alone. The fetch in
+  // fetch receive is valid, so it is issued again (clog).
+  rs1_1 = 5'd3;
+  #1
+  if( issue_0      !== 1'b1  |
+      issue_1      !== 1'b0  |
+      stall_decode !== 1'b1  |
+      flush_decode !== 1'b0  |
+      next_PC_sel  !== 2'b10 |
+      target_PC    !== 20'd0 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for dependent pair!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Lane 1 issues in the next cycle and reads lane 0 in execute
+  repeat (1) @ (posedge clock);
+  rd_execute_0       = 5'd3;
+  regWrite_execute_0 = 1'b1;
+  #1
+  if( issue_0           !== 1'b0  |
+      issue_1           !== 1'b1  |
+      stall_decode      !== 1'b0  |
+      next_PC_sel       !== 2'b00 |
+      rs1_data_bypass_1 !== 4'd2  ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for second half of dependent pair!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  repeat (1) @ (posedge clock);
+  rs1_1              = 5'd4;
+  rd_execute_0       = 5'd0;
+  regWrite_execute_0 = 1'b0;
+
+  // Two memory operations are split
+  opcode_0 = LOAD;
+  opcode_1 = STORE;
+  #1
+  if( issue_0      !== 1'b1 |
+      issue_1      !== 1'b0 |
+      stall_decode !== 1'b1 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for two memory operations!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  repeat (1) @ (posedge clock);
+  #1
+  if( issue_0      !== 1'b0 |
+      issue_1      !== 1'b1 |
+      stall_decode !== 1'b0 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for second memory operation!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  repeat (1) @ (posedge clock);
+  opcode_0 = R_TYPE;
+  opcode_1 = R_TYPE;
+
+  // JAL in lane 0 discards lane 1
+  opcode_0 = JAL;
+  #1
+  if( issue_0      !== 1'b1  |
+      issue_1      !== 1'b0  |
+      flush_decode !== 1'b1  |
+      next_PC_sel  !== 2'b10 |
+      target_PC    !== 20'd12) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for JAL in lane 0!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // JAL in lane 1 pairs
+  opcode_0 = R_TYPE;
+  opcode_1 = JAL;
+  #1
+  if( issue_0      !== 1'b1  |
+      issue_1      !== 1'b1  |
+      flush_decode !== 1'b1  |
+      next_PC_sel  !== 2'b10 |
+      target_PC    !== 20'd16) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for JAL in lane 1!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Load use hazard in lane 0 holds the pair
+  opcode_1           = R_TYPE;
+  opcode_execute_1   = LOAD;
+  rd_execute_1       = 5'd1;
+  regWrite_execute_1 = 1'b1;
+  #1
+  if( issue_0       !== 1'b0  |
+      issue_1       !== 1'b0  |
+      stall_decode  !== 1'b1  |
+      flush_execute !== 1'b0  |
+      next_PC_sel   !== 2'b10 |
+      target_PC     !== 20'd0 ) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for load use hazard!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Taken branch in execute lane 1
+  opcode_execute_1   = BRANCH;
+  branch_execute_1   = 1'b1;
+  rd_execute_1       = 5'd0;
+  regWrite_execute_1 = 1'b0;
+  #1
+  if( flush_execute !== 1'b1  |
+      flush_decode  !== 1'b1  |
+      next_PC_sel   !== 2'b10 |
+      target_PC     !== 20'd28) begin
+    scan = 1'b1;
+    repeat (1) @ (posedge clock);
+    $display("\nError: Unexpected output for taken branch in lane 1!");
+    $display("\ntb_seven_stage_dual_control_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  repeat (1) @ (posedge clock);
+  $display("\ntb_seven_stage_dual_control_unit --> Test Passed!\n\n");
+  $stop();
+end
+
+endmodule
@@ -119,6 +119,7 @@ wire [2:0] rs2_data_bypass;
 // CSR & Privilege Control Ports
 reg [1:0] priv;
 reg       intr_branch;
+reg       interrupt_pending;
 reg       trap_branch;
 
 reg  [ADDRESS_BITS-1:0] inst_PC_fetch_receive;
@@ -270,6 +271,7 @@ seven_stage_priv_control_unit #(
   // CSR & Privilege Control Ports
   .priv(priv),
   .intr_branch(intr_branch),
+  .interrupt_pending(interrupt_pending),
   .trap_branch(trap_branch),
 
   .inst_PC_fetch_receive(inst_PC_fetch_receive),
@@ -383,6 +385,7 @@ initial begin
   // CSR & Privilege Control Ports
   priv = 2'b11;
   intr_branch = 1'b0;
+  interrupt_pending = 1'b0;
   trap_branch = 1'b0;
 
   inst_PC_fetch_receive = 0;
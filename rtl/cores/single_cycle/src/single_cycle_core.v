@@ -123,6 +123,12 @@ fetch_issue #(
   .next_PC_select(next_PC_select),
   .target_PC(target_PC),
   .issue_PC(issue_PC),
+  .issue_tail(),
+  .issue_half(),
+  .receive_valid(1'b0),
+  .receive_next_PC({ADDRESS_BITS{1'b0}}),
+  .receive_next_tail(1'b0),
+  .receive_next_half(16'd0),
   // instruction cache interface
   .i_mem_read_address(fetch_address_out),
   //scan signal
@@ -139,7 +145,15 @@ fetch_receive #(
   .flush(flush_fetch_receive),
   .i_mem_data(fetch_data_in),
   .issue_PC(issue_PC),
+  .issue_tail(1'b0),
+  .issue_half(16'd0),
   .instruction(instruction),
+  .compressed(),
+  .complete(),
+  .fetch_address(),
+  .next_PC(),
+  .next_tail(),
+  .next_half(),
   //scan signal
   .scan(scan)
 );
@@ -35,7 +35,8 @@ localparam NO_REQ     = 4'd0,
            REQ_FLUSH  = 4'd11, //Same as invalidation request from L2
            MEM_C_RESP = 4'd12,
            MEM_RESP   = 4'd13, //memory responding with E data (DataE)
-           MEM_RESP_S = 4'd14; //memory responding with S data (Data)
+           MEM_RESP_S = 4'd14, //memory responding with S data (Data)
+           WB_CLEAN   = 4'd15; //writeback of a clean line to an exclusive Lx
 
 
 // coherence states
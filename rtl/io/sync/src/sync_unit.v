@@ -0,0 +1,223 @@
+/** @module : sync_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Memory mapped inter-processor interrupts and hardware barriers shared by
+ *    all harts of a multicore top. Every hart has its own request port.
+ *  - Register map, offsets from the base of the window (address[11:0]):
+ *      0x000 + 4*h  : MSIP of hart h. Bit 0 drives software_interrupt[h].
+ *      0x100 + 16*b : MASK of barrier b. One bit per participating hart,
+ *                     all harts after reset.
+ *      0x104 + 16*b : ARRIVE of barrier b. Holds the sense bit of the
+ *                     accessing hart. Writing the inverse of the value read
+ *                     marks the hart as arrived.
+ *      0x108 + 16*b : WAIT of barrier b. Blocking read. Responds once the
+ *                     barrier released the accessing hart.
+ *  - A barrier releases when every hart in MASK has arrived. All waiting
+ *    harts get their WAIT response in the same cycle. The ready signal of a
+ *    waiting hart is low, so the hart stops issuing memory requests.
+ *  - Writes and reads are idempotent, so a request the core presents for
+ *    more than one cycle does not arrive twice.
+ *  - Other reads return 0 one cycle after the request. Writes use the bytes
+ *    holding bit 0 (MSIP, ARRIVE) or the MASK bits and do not respond.
+ *  - Supports up to 64 harts and 16 barriers. NUM_HARTS must not be larger
+ *    than DATA_WIDTH.
+ */
+
+module sync_unit #(
+  parameter NUM_HARTS    = 4,
+  parameter NUM_BARRIERS = 4,
+  parameter DATA_WIDTH   = 32,
+  parameter ADDRESS_BITS = 32,
+  parameter NUM_BYTES    = DATA_WIDTH/8,
+  parameter BARRIER_BITS = NUM_BARRIERS > 1 ? log2(NUM_BARRIERS) : 1
+) (
+  input clock,
+  input reset,
+
+  // One memory port per hart
+  input  [NUM_HARTS-1:0]                  read,
+  input  [NUM_HARTS-1:0]                  write,
+  input  [NUM_HARTS*NUM_BYTES-1:0]        byte_en,
+  input  [NUM_HARTS*ADDRESS_BITS-1:0]     address,
+  input  [NUM_HARTS*DATA_WIDTH-1:0]       data_in,
+  output reg [NUM_HARTS*DATA_WIDTH-1:0]   data_out,
+  output reg [NUM_HARTS*ADDRESS_BITS-1:0] out_address,
+  output reg [NUM_HARTS-1:0]              valid,
+  output [NUM_HARTS-1:0]                  ready,
+
+  // MSIP of each hart
+  output reg [NUM_HARTS-1:0] software_interrupt,
+  // The hart is blocked in a barrier WAIT read
+  output [NUM_HARTS-1:0]     barrier_wait
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+localparam [3:0] MSIP_REGION    = 4'h0,
+                 BARRIER_REGION = 4'h1;
+
+localparam [1:0] MASK_REG   = 2'd0,
+                 ARRIVE_REG = 2'd1,
+                 WAIT_REG   = 2'd2;
+
+genvar b, h;
+integer x, y;
+
+reg [NUM_HARTS-1:0]    barrier_mask [NUM_BARRIERS-1:0];
+reg [NUM_HARTS-1:0]    hart_sense   [NUM_BARRIERS-1:0];
+reg [NUM_BARRIERS-1:0] barrier_sense;
+
+reg [NUM_HARTS-1:0]              pending;
+reg [NUM_HARTS*BARRIER_BITS-1:0] pending_barrier;
+reg [NUM_HARTS*ADDRESS_BITS-1:0] pending_address;
+
+wire [NUM_BARRIERS-1:0] barrier_release;
+
+wire [NUM_HARTS*12-1:0]           offset;
+wire [NUM_HARTS*6-1:0]            msip_index;
+wire [NUM_HARTS*BARRIER_BITS-1:0] barrier_index;
+wire [NUM_HARTS-1:0]              msip_access;
+wire [NUM_HARTS-1:0]              mask_access;
+wire [NUM_HARTS-1:0]              arrive_access;
+wire [NUM_HARTS-1:0]              wait_access;
+wire [NUM_HARTS-1:0]              wait_done;
+wire [NUM_HARTS-1:0]              wait_sense;
+wire [NUM_HARTS*DATA_WIDTH-1:0]   read_data;
+
+generate
+  // A barrier releases when all participating harts have a sense bit that
+  // differs from the barrier sense. Flipping the barrier sense releases them
+  // and resets the barrier for the next round at the same time.
+  for(b=0; b<NUM_BARRIERS; b=b+1) begin : BARRIERS
+    assign barrier_release[b] = (|barrier_mask[b]) &
+      ~(|(barrier_mask[b] & ~(hart_sense[b] ^ {NUM_HARTS{barrier_sense[b]}})));
+  end
+
+  for(h=0; h<NUM_HARTS; h=h+1) begin : HARTS
+    wire [BARRIER_BITS-1:0] wait_barrier;
+    wire [DATA_WIDTH-1:0]   msip_data;
+    wire [DATA_WIDTH-1:0]   mask_data;
+    wire [DATA_WIDTH-1:0]   arrive_data;
+
+    assign offset[h*12 +: 12]  = address[h*ADDRESS_BITS +: 12];
+    assign msip_index[h*6 +: 6] = offset[h*12+2 +: 6];
+    assign barrier_index[h*BARRIER_BITS +: BARRIER_BITS] = offset[h*12+4 +: BARRIER_BITS];
+
+    assign msip_access[h] = (offset[h*12+8 +: 4] == MSIP_REGION) &
+                            (msip_index[h*6 +: 6] < NUM_HARTS);
+    assign mask_access[h]   = (offset[h*12+8 +: 4] == BARRIER_REGION) &
+                              (offset[h*12+4 +: 4] < NUM_BARRIERS) &
+                              (offset[h*12+2 +: 2] == MASK_REG);
+    assign arrive_access[h] = (offset[h*12+8 +: 4] == BARRIER_REGION) &
+                              (offset[h*12+4 +: 4] < NUM_BARRIERS) &
+                              (offset[h*12+2 +: 2] == ARRIVE_REG);
+    assign wait_access[h]   = (offset[h*12+8 +: 4] == BARRIER_REGION) &
+                              (offset[h*12+4 +: 4] < NUM_BARRIERS) &
+                              (offset[h*12+2 +: 2] == WAIT_REG);
+
+    assign wait_barrier  = pending_barrier[h*BARRIER_BITS +: BARRIER_BITS];
+    assign wait_sense[h] = barrier_sense[wait_barrier];
+    assign wait_done[h]  = pending[h] & (hart_sense[wait_barrier][h] == wait_sense[h]);
+
+    assign msip_data   = software_interrupt[msip_index[h*6 +: 6]];
+    assign mask_data   = barrier_mask[barrier_index[h*BARRIER_BITS +: BARRIER_BITS]];
+    assign arrive_data = hart_sense[barrier_index[h*BARRIER_BITS +: BARRIER_BITS]][h];
+
+    assign read_data[h*DATA_WIDTH +: DATA_WIDTH] = msip_access[h]   ? msip_data   :
+                                                   mask_access[h]   ? mask_data   :
+                                                   arrive_access[h] ? arrive_data :
+                                                   {DATA_WIDTH{1'b0}};
+
+    assign ready[h]        = ~pending[h];
+    assign barrier_wait[h] = pending[h];
+  end
+endgenerate
+
+always @(posedge clock) begin
+  if(reset) begin
+    software_interrupt <= {NUM_HARTS{1'b0}};
+    barrier_sense      <= {NUM_BARRIERS{1'b0}};
+    pending            <= {NUM_HARTS{1'b0}};
+    pending_barrier    <= {NUM_HARTS*BARRIER_BITS{1'b0}};
+    pending_address    <= {NUM_HARTS*ADDRESS_BITS{1'b0}};
+    valid              <= {NUM_HARTS{1'b0}};
+    data_out           <= {NUM_HARTS*DATA_WIDTH{1'b0}};
+    out_address        <= {NUM_HARTS*ADDRESS_BITS{1'b0}};
+    for(y=0; y<NUM_BARRIERS; y=y+1) begin
+      barrier_mask[y] <= {NUM_HARTS{1'b1}};
+      hart_sense[y]   <= {NUM_HARTS{1'b0}};
+    end
+  end
+  else begin
+    for(y=0; y<NUM_BARRIERS; y=y+1) begin
+      if(barrier_release[y])
+        barrier_sense[y] <= ~barrier_sense[y];
+    end
+
+    for(x=0; x<NUM_HARTS; x=x+1) begin
+      // Responses
+      if(wait_done[x]) begin
+        pending[x]  <= 1'b0;
+        valid[x]    <= 1'b1;
+        data_out[x*DATA_WIDTH +: DATA_WIDTH] <= {{DATA_WIDTH-1{1'b0}}, wait_sense[x]};
+        out_address[x*ADDRESS_BITS +: ADDRESS_BITS] <= pending_address[x*ADDRESS_BITS +: ADDRESS_BITS];
+      end
+      else if(read[x] & ~pending[x] & wait_access[x]) begin
+        pending[x] <= 1'b1;
+        valid[x]   <= 1'b0;
+        pending_barrier[x*BARRIER_BITS +: BARRIER_BITS] <= barrier_index[x*BARRIER_BITS +: BARRIER_BITS];
+        pending_address[x*ADDRESS_BITS +: ADDRESS_BITS] <= address[x*ADDRESS_BITS +: ADDRESS_BITS];
+      end
+      else if(read[x] & ~pending[x]) begin
+        valid[x] <= 1'b1;
+        data_out[x*DATA_WIDTH +: DATA_WIDTH] <= read_data[x*DATA_WIDTH +: DATA_WIDTH];
+        out_address[x*ADDRESS_BITS +: ADDRESS_BITS] <= address[x*ADDRESS_BITS +: ADDRESS_BITS];
+      end
+      else begin
+        valid[x] <= 1'b0;
+      end
+
+      // Writes. Harts writing the same register in the same cycle are
+      // resolved in favor of the highest hart number.
+      if(write[x] & ~pending[x]) begin
+        if(msip_access[x] & byte_en[x*NUM_BYTES])
+          software_interrupt[msip_index[x*6 +: 6]] <= data_in[x*DATA_WIDTH];
+        if(mask_access[x])
+          barrier_mask[barrier_index[x*BARRIER_BITS +: BARRIER_BITS]] <= data_in[x*DATA_WIDTH +: NUM_HARTS];
+        if(arrive_access[x] & byte_en[x*NUM_BYTES])
+          hart_sense[barrier_index[x*BARRIER_BITS +: BARRIER_BITS]][x] <= data_in[x*DATA_WIDTH];
+      end
+    end
+  end
+end
+
+endmodule
@@ -0,0 +1,262 @@
+/** @module : tb_sync_unit
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_sync_unit();
+
+parameter NUM_HARTS    = 3;
+parameter NUM_BARRIERS = 2;
+parameter DATA_WIDTH   = 32;
+parameter ADDRESS_BITS = 32;
+
+localparam MSIP1    = 32'h000F0004,
+           MASK1    = 32'h000F0110,
+           ARRIVE0  = 32'h000F0104,
+           WAIT0    = 32'h000F0108,
+           ARRIVE1  = 32'h000F0114,
+           WAIT1    = 32'h000F0118;
+
+reg  clock;
+reg  reset;
+
+reg  [NUM_HARTS-1:0]                read;
+reg  [NUM_HARTS-1:0]                write;
+reg  [NUM_HARTS*DATA_WIDTH/8-1:0]   byte_en;
+reg  [ADDRESS_BITS-1:0]             address0;
+reg  [ADDRESS_BITS-1:0]             address1;
+reg  [ADDRESS_BITS-1:0]             address2;
+reg  [DATA_WIDTH-1:0]               data_in0;
+reg  [DATA_WIDTH-1:0]               data_in1;
+reg  [DATA_WIDTH-1:0]               data_in2;
+wire [NUM_HARTS*DATA_WIDTH-1:0]     data_out;
+wire [NUM_HARTS*ADDRESS_BITS-1:0]   out_address;
+wire [NUM_HARTS-1:0]                valid;
+wire [NUM_HARTS-1:0]                ready;
+wire [NUM_HARTS-1:0]                software_interrupt;
+wire [NUM_HARTS-1:0]                barrier_wait;
+
+sync_unit #(
+  .NUM_HARTS(NUM_HARTS),
+  .NUM_BARRIERS(NUM_BARRIERS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .read(read),
+  .write(write),
+  .byte_en(byte_en),
+  .address({address2, address1, address0}),
+  .data_in({data_in2, data_in1, data_in0}),
+  .data_out(data_out),
+  .out_address(out_address),
+  .valid(valid),
+  .ready(ready),
+  .software_interrupt(software_interrupt),
+  .barrier_wait(barrier_wait)
+);
+
+always #5 clock = ~clock;
+
+initial begin
+  clock    = 1'b1;
+  reset    = 1'b1;
+  read     = 3'b000;
+  write    = 3'b000;
+  byte_en  = 12'hfff;
+  address0 = 32'd0;
+  address1 = 32'd0;
+  address2 = 32'd0;
+  data_in0 = 32'd0;
+  data_in1 = 32'd0;
+  data_in2 = 32'd0;
+
+  repeat (3) @ (posedge clock);
+  reset = 1'b0;
+
+  repeat (1) @ (posedge clock);
+
+  // Hart 0 sends an interrupt to hart 1
+  write    = 3'b001;
+  address0 = MSIP1;
+  data_in0 = 32'd1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  if( software_interrupt !== 3'b010 ) begin
+    $display("\nError: Unexpected software interrupts after MSIP write!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Hart 1 reads its MSIP
+  write    = 3'b000;
+  read     = 3'b010;
+  address1 = MSIP1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  if( valid                       !== 3'b010 |
+      data_out[DATA_WIDTH +: 32]  !== 32'd1 |
+      out_address[ADDRESS_BITS +: 32] !== MSIP1 ) begin
+    $display("\nError: Unexpected MSIP read response!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Hart 1 clears its MSIP
+  read     = 3'b000;
+  write    = 3'b010;
+  data_in1 = 32'd0;
+
+  repeat (1) @ (posedge clock);
+  #1
+  if( software_interrupt !== 3'b000 ) begin
+    $display("\nError: Unexpected software interrupts after MSIP clear!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Harts 0 and 1 arrive at barrier 0 and wait
+  write    = 3'b011;
+  address0 = ARRIVE0;
+  address1 = ARRIVE0;
+  data_in0 = 32'd1;
+  data_in1 = 32'd1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  write    = 3'b000;
+  read     = 3'b011;
+  address0 = WAIT0;
+  address1 = WAIT0;
+
+  repeat (1) @ (posedge clock);
+  #1
+  read = 3'b000;
+
+  repeat (4) @ (posedge clock);
+  #1
+  if( valid        !== 3'b000 |
+      ready        !== 3'b100 |
+      barrier_wait !== 3'b011 ) begin
+    $display("\nError: Harts were released before hart 2 arrived!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Hart 2 arrives. The arrive write is presented twice.
+  write    = 3'b100;
+  address2 = ARRIVE0;
+  data_in2 = 32'd1;
+
+  repeat (2) @ (posedge clock);
+  #1
+  write = 3'b000;
+
+  // Both waiting harts are released in the same cycle
+  while(valid === 3'b000) begin
+    repeat (1) @ (posedge clock);
+    #1;
+  end
+  if( valid                            !== 3'b011 |
+      data_out[0 +: 32]                !== 32'd1  |
+      data_out[DATA_WIDTH +: 32]       !== 32'd1  |
+      out_address[0 +: 32]             !== WAIT0  |
+      out_address[ADDRESS_BITS +: 32]  !== WAIT0  ) begin
+    $display("\nError: Unexpected barrier release!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  repeat (1) @ (posedge clock);
+  #1
+  if( valid !== 3'b000 | ready !== 3'b111 | barrier_wait !== 3'b000 ) begin
+    $display("\nError: Unexpected state after barrier release!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Hart 2 waits after the release and is not blocked
+  read     = 3'b100;
+  address2 = WAIT0;
+
+  repeat (1) @ (posedge clock);
+  #1
+  read = 3'b000;
+
+  repeat (2) @ (posedge clock);
+  #1
+  if( ready !== 3'b111 | barrier_wait !== 3'b000 ) begin
+    $display("\nError: Hart 2 blocked after the barrier released!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Barrier 1 only includes hart 0
+  write    = 3'b001;
+  address0 = MASK1;
+  data_in0 = 32'd1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  address0 = ARRIVE1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  write    = 3'b000;
+  read     = 3'b001;
+  address0 = WAIT1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  read = 3'b000;
+
+  repeat (3) @ (posedge clock);
+  #1
+  if( ready !== 3'b111 | barrier_wait !== 3'b000 ) begin
+    $display("\nError: Barrier 1 did not release hart 0!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Reading ARRIVE returns the new sense of the hart
+  read     = 3'b001;
+  address0 = ARRIVE1;
+
+  repeat (1) @ (posedge clock);
+  #1
+  if( valid !== 3'b001 | data_out[0 +: 32] !== 32'd1 ) begin
+    $display("\nError: Unexpected ARRIVE read response!");
+    $display("\ntb_sync_unit --> Test Failed!\n\n");
+    $stop();
+  end
+
+  read = 3'b000;
+
+  repeat (1) @ (posedge clock);
+
+  $display("\ntb_sync_unit --> Test Passed!\n\n");
+  $stop();
+
+end
+
+endmodule
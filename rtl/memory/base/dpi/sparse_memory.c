@@ -0,0 +1,436 @@
+/** @module : sparse_memory
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - DPI-C backing store for the SPARSE_MEMORY build of the base memories.
+ *    See sparse_memory.vh for the Verilog side.
+ *  - Every memory instance opens its own store. A store is byte addressed:
+ *    word N of a DATA_WIDTH memory occupies bytes N*ceil(DATA_WIDTH/8) and up,
+ *    least significant byte first. With a power of two word size this makes
+ *    the store offset equal to the byte address the core uses.
+ *  - Storage is allocated in 4 KiB pages on the first write to a page. Reads
+ *    of pages that were never written return 0 and do not allocate.
+ *  - Pages are kept in an open addressing hash table keyed by page number, so
+ *    the full 64-bit index range can be used.
+ *  - Images are loaded without touching the rest of the store:
+ *      ELF32/ELF64 (little endian) : PT_LOAD segments at their physical
+ *                                    address, .bss zero filled
+ *      $readmemh text              : @addr is a word address, see
+ *                                    sparse_memory_load
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PAGE_BITS 12
+#define PAGE_SIZE (1u << PAGE_BITS)
+#define PAGE_MASK (PAGE_SIZE - 1)
+
+#define INITIAL_SLOTS 64
+
+typedef struct {
+  uint64_t  key;
+  uint8_t  *page;
+} page_slot_t;
+
+typedef struct {
+  char        *name;
+  unsigned     word_bytes;
+  page_slot_t *slots;
+  uint64_t     num_slots; // power of two
+  uint64_t     num_pages;
+  // Most accesses fall in the page touched last
+  uint64_t     last_key;
+  uint8_t     *last_page;
+} sparse_store_t;
+
+static sparse_store_t **stores     = NULL;
+static int              num_stores = 0;
+
+static inline uint64_t hash_key(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return key;
+}
+
+static uint8_t *find_page(sparse_store_t *store, uint64_t key) {
+  uint64_t mask = store->num_slots - 1;
+  uint64_t slot = hash_key(key) & mask;
+
+  if(store->last_page && store->last_key == key)
+    return store->last_page;
+
+  while(store->slots[slot].page) {
+    if(store->slots[slot].key == key) {
+      store->last_key  = key;
+      store->last_page = store->slots[slot].page;
+      return store->last_page;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return NULL;
+}
+
+static void insert_slot(page_slot_t *slots, uint64_t num_slots, uint64_t key,
+                        uint8_t *page) {
+  uint64_t mask = num_slots - 1;
+  uint64_t slot = hash_key(key) & mask;
+
+  while(slots[slot].page)
+    slot = (slot + 1) & mask;
+  slots[slot].key  = key;
+  slots[slot].page = page;
+}
+
+static uint8_t *touch_page(sparse_store_t *store, uint64_t key) {
+  uint8_t *page = find_page(store, key);
+  uint64_t i;
+
+  if(page)
+    return page;
+
+  // Keep the load factor at or below one half
+  if(2*(store->num_pages + 1) > store->num_slots) {
+    uint64_t     num_slots = store->num_slots * 2;
+    page_slot_t *slots     = calloc(num_slots, sizeof(page_slot_t));
+    if(!slots) {
+      fprintf(stderr, "sparse_memory: %s: out of host memory\n", store->name);
+      exit(1);
+    }
+    for(i=0; i<store->num_slots; i++) {
+      if(store->slots[i].page)
+        insert_slot(slots, num_slots, store->slots[i].key, store->slots[i].page);
+    }
+    free(store->slots);
+    store->slots     = slots;
+    store->num_slots = num_slots;
+  }
+
+  page = calloc(1, PAGE_SIZE);
+  if(!page) {
+    fprintf(stderr, "sparse_memory: %s: out of host memory\n", store->name);
+    exit(1);
+  }
+  insert_slot(store->slots, store->num_slots, key, page);
+  store->num_pages++;
+  store->last_key  = key;
+  store->last_page = page;
+  return page;
+}
+
+static sparse_store_t *get_store(int handle) {
+  if(handle < 0 || handle >= num_stores || !stores[handle]) {
+    fprintf(stderr, "sparse_memory: invalid handle %d\n", handle);
+    exit(1);
+  }
+  return stores[handle];
+}
+
+static inline uint8_t read_byte(sparse_store_t *store, uint64_t address) {
+  uint8_t *page = find_page(store, address >> PAGE_BITS);
+  return page ? page[address & PAGE_MASK] : 0;
+}
+
+static inline void write_byte(sparse_store_t *store, uint64_t address,
+                              uint8_t value) {
+  touch_page(store, address >> PAGE_BITS)[address & PAGE_MASK] = value;
+}
+
+/******************************************************************************
+ * Image loaders
+ *****************************************************************************/
+
+static uint64_t get_le(const uint8_t *bytes, unsigned size) {
+  uint64_t value = 0;
+  unsigned i;
+  for(i=0; i<size; i++)
+    value |= (uint64_t)bytes[i] << (8*i);
+  return value;
+}
+
+static long load_elf(sparse_store_t *store, const char *file_name, FILE *file) {
+  uint8_t  header[64];
+  uint8_t  program_header[56];
+  int      is_64;
+  uint64_t ph_offset, ph_size, ph_count, i, j;
+  long     loaded = 0;
+
+  if(fread(header, 1, sizeof(header), file) < 52)
+    goto truncated;
+
+  is_64 = header[4] == 2;
+  if(header[5] != 1) {
+    fprintf(stderr, "sparse_memory: %s: only little endian ELF files are "
+            "supported\n", file_name);
+    return -1;
+  }
+
+  ph_offset = is_64 ? get_le(&header[32], 8) : get_le(&header[28], 4);
+  ph_size   = is_64 ? get_le(&header[54], 2) : get_le(&header[42], 2);
+  ph_count  = is_64 ? get_le(&header[56], 2) : get_le(&header[44], 2);
+  if(ph_size > sizeof(program_header))
+    ph_size = sizeof(program_header);
+
+  for(i=0; i<ph_count; i++) {
+    uint64_t type, offset, address, file_size, memory_size;
+    long     next;
+
+    if(fseek(file, (long)(ph_offset + i*(is_64 ? 56 : 32)), SEEK_SET) ||
+       fread(program_header, 1, ph_size, file) != ph_size)
+      goto truncated;
+
+    type = get_le(&program_header[0], 4);
+    if(type != 1) // PT_LOAD
+      continue;
+    if(is_64) {
+      offset      = get_le(&program_header[8],  8);
+      address     = get_le(&program_header[24], 8); // p_paddr
+      file_size   = get_le(&program_header[32], 8);
+      memory_size = get_le(&program_header[40], 8);
+    }
+    else {
+      offset      = get_le(&program_header[4],  4);
+      address     = get_le(&program_header[12], 4); // p_paddr
+      file_size   = get_le(&program_header[16], 4);
+      memory_size = get_le(&program_header[20], 4);
+    }
+
+    if(fseek(file, (long)offset, SEEK_SET))
+      goto truncated;
+    for(j=0; j<file_size; j++) {
+      next = fgetc(file);
+      if(next == EOF)
+        goto truncated;
+      write_byte(store, address + j, (uint8_t)next);
+    }
+    // .bss only needs clearing where pages already exist
+    for(; j<memory_size; j++) {
+      if(find_page(store, (address + j) >> PAGE_BITS))
+        write_byte(store, address + j, 0);
+    }
+    loaded += (long)memory_size;
+  }
+  return loaded;
+
+truncated:
+  fprintf(stderr, "sparse_memory: %s: truncated ELF file\n", file_name);
+  return -1;
+}
+
+static int hex_digit(int c) {
+  if(c >= '0' && c <= '9') return c - '0';
+  if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if(c == 'x' || c == 'X' || c == 'z' || c == 'Z') return 0; // unknown as 0
+  return -1;
+}
+
+// Reads the next whitespace separated token, skipping // and /* */ comments.
+static int next_token(FILE *file, char *token, size_t size) {
+  size_t length = 0;
+  int    c;
+
+  for(;;) {
+    c = fgetc(file);
+    if(c == EOF)
+      return 0;
+    if(c == '/') {
+      int n = fgetc(file);
+      if(n == '/') {
+        while((c = fgetc(file)) != EOF && c != '\n');
+        continue;
+      }
+      if(n == '*') {
+        int previous = 0;
+        while((c = fgetc(file)) != EOF && !(previous == '*' && c == '/'))
+          previous = c;
+        continue;
+      }
+      ungetc(n, file);
+    }
+    if(c != ' ' && c != '\t' && c != '\r' && c != '\n')
+      break;
+  }
+
+  do {
+    if(length + 1 < size)
+      token[length++] = (char)c;
+    c = fgetc(file);
+  } while(c != EOF && c != ' ' && c != '\t' && c != '\r' && c != '\n');
+  token[length] = '\0';
+  return 1;
+}
+
+static long load_vmh(sparse_store_t *store, const char *file_name, FILE *file,
+                     unsigned vmh_word_bytes, int lane) {
+  char     token[1024];
+  uint64_t word_address = 0;
+  long     loaded = 0;
+
+  while(next_token(file, token, sizeof(token))) {
+    if(token[0] == '@') {
+      word_address = strtoull(&token[1], NULL, 16);
+      continue;
+    }
+
+    {
+      // Digits are consumed from the right so words wider than 64 bits work
+      uint64_t base = lane >= 0 ?
+                      word_address*store->word_bytes + (uint64_t)lane :
+                      word_address*vmh_word_bytes;
+      unsigned bytes = lane >= 0 ? 1 : vmh_word_bytes;
+      int      digit_index = (int)strlen(token) - 1;
+      unsigned byte;
+
+      for(byte=0; byte<bytes; byte++) {
+        unsigned value = 0, shift = 0;
+        while(digit_index >= 0 && shift < 8) {
+          int digit;
+          if(token[digit_index] == '_') {
+            digit_index--;
+            continue;
+          }
+          digit = hex_digit(token[digit_index--]);
+          if(digit < 0) {
+            fprintf(stderr, "sparse_memory: %s: bad token '%s'\n", file_name,
+                    token);
+            return -1;
+          }
+          value |= (unsigned)digit << shift;
+          shift += 4;
+        }
+        write_byte(store, base + byte, (uint8_t)value);
+      }
+      loaded += bytes;
+      word_address++;
+    }
+  }
+  return loaded;
+}
+
+/******************************************************************************
+ * DPI interface
+ *****************************************************************************/
+
+int sparse_memory_open(const char *name, int word_bits) {
+  sparse_store_t *store = calloc(1, sizeof(sparse_store_t));
+  sparse_store_t **grown = realloc(stores, (num_stores + 1)*sizeof(*stores));
+
+  if(!store || !grown) {
+    fprintf(stderr, "sparse_memory: out of host memory\n");
+    exit(1);
+  }
+  stores = grown;
+
+  store->name       = strdup(name ? name : "");
+  store->word_bytes = (unsigned)(word_bits + 7)/8;
+  store->num_slots  = INITIAL_SLOTS;
+  store->slots      = calloc(INITIAL_SLOTS, sizeof(page_slot_t));
+  if(!store->name || !store->slots) {
+    fprintf(stderr, "sparse_memory: out of host memory\n");
+    exit(1);
+  }
+  stores[num_stores] = store;
+  return num_stores++;
+}
+
+// Returns 32 bits of word index, starting at bit 32*chunk.
+unsigned int sparse_memory_read(int handle, uint64_t index, int chunk) {
+  sparse_store_t *store   = get_store(handle);
+  uint64_t        address = index*store->word_bytes + 4*(unsigned)chunk;
+  unsigned        offset  = (unsigned)(address & PAGE_MASK);
+  unsigned        value   = 0;
+  unsigned        i;
+
+  if(offset + 4 <= PAGE_SIZE) {
+    uint8_t *page = find_page(store, address >> PAGE_BITS);
+    if(!page)
+      return 0;
+    for(i=0; i<4; i++)
+      value |= (unsigned)page[offset + i] << (8*i);
+  }
+  else {
+    for(i=0; i<4; i++)
+      value |= (unsigned)read_byte(store, address + i) << (8*i);
+  }
+  return value;
+}
+
+// Writes the bytes of data selected by byte_mask[3:0] to 32 bits of word
+// index, starting at bit 32*chunk. Bytes past the end of the word are dropped.
+void sparse_memory_write(int handle, uint64_t index, int chunk,
+                         unsigned int data, unsigned int byte_mask) {
+  sparse_store_t *store = get_store(handle);
+  unsigned        first = 4*(unsigned)chunk;
+  unsigned        i;
+
+  for(i=0; i<4 && first + i < store->word_bytes; i++) {
+    if(byte_mask & (1u << i))
+      write_byte(store, index*store->word_bytes + first + i,
+                 (uint8_t)(data >> (8*i)));
+  }
+}
+
+/* Loads an ELF file or a $readmemh style text file into the store and
+ * returns the number of bytes loaded, or -1 on error.
+ *  - vmh_word_bytes is the width of each hex word in the file. 0 selects the
+ *    word size of the memory, which matches $readmemh into the same array.
+ *    Other widths let one image feed memories of any width, e.g. the 32-bit
+ *    program images into a 64-bit memory.
+ *  - A lane >= 0 loads byte lane files: every hex word is one byte that goes
+ *    to byte lane of the memory word, like $readmemh into one BRAM_byte of a
+ *    byte enable memory.
+ */
+long long sparse_memory_load(int handle, const char *file_name,
+                             int vmh_word_bytes, int lane) {
+  sparse_store_t *store = get_store(handle);
+  FILE          *file  = fopen(file_name, "rb");
+  uint8_t        magic[4];
+  long           loaded;
+
+  if(!file) {
+    fprintf(stderr, "sparse_memory: could not open %s\n", file_name);
+    return -1;
+  }
+
+  if(lane < 0 && fread(magic, 1, 4, file) == 4 &&
+     magic[0] == 0x7f && magic[1] == 'E' && magic[2] == 'L' && magic[3] == 'F') {
+    rewind(file);
+    loaded = load_elf(store, file_name, file);
+  }
+  else {
+    rewind(file);
+    loaded = load_vmh(store, file_name, file, vmh_word_bytes > 0 ?
+                      (unsigned)vmh_word_bytes : store->word_bytes, lane);
+  }
+  fclose(file);
+  return loaded;
+}
+
+// Number of 4 KiB pages allocated by the store.
+long long sparse_memory_pages(int handle) {
+  return (long long)get_store(handle)->num_pages;
+}
@@ -0,0 +1,130 @@
+/** @module : sparse_memory
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Included inside the memory modules built with +define+SPARSE_MEMORY.
+ *    Replaces their storage array with a DPI-C sparse store (sparse_memory.c)
+ *    so the memory depth costs no host memory until it is written.
+ *  - The including module must define DATA_WIDTH.
+ *  - sparse_read/sparse_write access one DATA_WIDTH word. sparse_version
+ *    changes on every write so combinational read ports can be sensitive to
+ *    it. sparse_store writes without changing sparse_version, for memories
+ *    that update it with a nonblocking assignment.
+ *  - Test benches load programs with the load_image task of the instance,
+ *    for example DUT.memory.memory.load_image(PROGRAM, 4). ELF files are
+ *    detected automatically. For $readmemh files the second argument is the
+ *    width of the hex words in bytes, 0 for the width of the memory.
+ */
+
+import "DPI-C" function int sparse_memory_open(input string name,
+                                               input int word_bits);
+import "DPI-C" function int unsigned sparse_memory_read(input int handle,
+                                                        input longint unsigned index,
+                                                        input int chunk);
+import "DPI-C" function void sparse_memory_write(input int handle,
+                                                 input longint unsigned index,
+                                                 input int chunk,
+                                                 input int unsigned data,
+                                                 input int unsigned byte_mask);
+import "DPI-C" function longint sparse_memory_load(input int handle,
+                                                   input string file_name,
+                                                   input int vmh_word_bytes,
+                                                   input int lane);
+import "DPI-C" function longint sparse_memory_pages(input int handle);
+
+localparam SPARSE_CHUNKS = (DATA_WIDTH + 31)/32;
+
+integer sparse_handle = -1;
+reg [31:0] sparse_version = 32'd0;
+
+// The store is opened on first use so no initial block ordering is needed.
+function integer sparse_get_handle;
+  input dummy;
+  begin
+    if(sparse_handle < 0)
+      sparse_handle = sparse_memory_open($sformatf("%m"), DATA_WIDTH);
+    sparse_get_handle = sparse_handle;
+  end
+endfunction
+
+function [DATA_WIDTH-1:0] sparse_read;
+  input [63:0] index;
+  reg [32*SPARSE_CHUNKS-1:0] data;
+  integer c;
+  begin
+    for(c=0; c<SPARSE_CHUNKS; c=c+1)
+      data[32*c +: 32] = sparse_memory_read(sparse_get_handle(1'b0), index, c);
+    sparse_read = data[DATA_WIDTH-1:0];
+  end
+endfunction
+
+task sparse_store;
+  input [63:0] index;
+  input [DATA_WIDTH-1:0] data;
+  input [(DATA_WIDTH+7)/8-1:0] byte_enable;
+  reg [32*SPARSE_CHUNKS-1:0] wide_data;
+  reg [4*SPARSE_CHUNKS-1:0]  wide_enable;
+  integer c;
+  begin
+    wide_data   = data;
+    wide_enable = byte_enable;
+    for(c=0; c<SPARSE_CHUNKS; c=c+1) begin
+      if(|wide_enable[4*c +: 4])
+        sparse_memory_write(sparse_get_handle(1'b0), index, c,
+                            wide_data[32*c +: 32], wide_enable[4*c +: 4]);
+    end
+  end
+endtask
+
+task sparse_write;
+  input [63:0] index;
+  input [DATA_WIDTH-1:0] data;
+  input [(DATA_WIDTH+7)/8-1:0] byte_enable;
+  begin
+    sparse_store(index, data, byte_enable);
+    sparse_version = sparse_version + 32'd1;
+  end
+endtask
+
+// lane >= 0 loads a byte lane file, see sparse_memory_load in sparse_memory.c
+task sparse_load;
+  input string file_name;
+  input integer vmh_word_bytes;
+  input integer lane;
+  longint loaded;
+  begin
+    loaded = sparse_memory_load(sparse_get_handle(1'b0), file_name, vmh_word_bytes,
+                                lane);
+    if(loaded < 0)
+      $display("%m: could not load %0s", file_name);
+    sparse_version = sparse_version + 32'd1;
+  end
+endtask
+
+task load_image;
+  input [8*256-1:0] file_name;
+  input integer vmh_word_bytes;
+  begin
+    sparse_load($sformatf("%0s", file_name), vmh_word_bytes, -1);
+  end
+endtask
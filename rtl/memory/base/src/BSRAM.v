@@ -51,6 +51,26 @@ input  [ADDR_WIDTH-1:0] writeAddress;
 input  [DATA_WIDTH-1:0] writeData;
 input  scan;
 
+`ifdef SPARSE_MEMORY
+`include "sparse_memory.vh"
+
+reg  [DATA_WIDTH-1:0] readData;
+
+always @(readEnable or readAddress or writeEnable or writeAddress or writeData or
+         sparse_version) begin
+  readData = (readEnable & writeEnable & (readAddress == writeAddress)) ?
+             writeData   : readEnable  ? sparse_read(readAddress) : 0;
+end
+
+// The read port sees the write with the nonblocking updates of the clock
+// edge, like the nonblocking array write below.
+always@(posedge clock) begin : RAM_WRITE
+  if(writeEnable) begin
+    sparse_store(writeAddress, writeData, {(DATA_WIDTH+7)/8{1'b1}});
+    sparse_version <= sparse_version + 32'd1;
+  end
+end
+`else
 wire [DATA_WIDTH-1:0] readData;
 reg  [DATA_WIDTH-1:0] sram [0:MEM_DEPTH-1];
 
@@ -61,6 +81,7 @@ always@(posedge clock) begin : RAM_WRITE
   if(writeEnable)
     sram[writeAddress] <= writeData;
 end
+`endif
 
 reg [31: 0] cycles;
 always @ (posedge clock) begin
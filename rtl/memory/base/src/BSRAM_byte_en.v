@@ -42,6 +42,33 @@ module BSRAM_byte_en #(
 localparam MEM_DEPTH = 1 << ADDR_WIDTH;
 localparam NUM_BYTES = DATA_WIDTH/8;
 
+`ifdef SPARSE_MEMORY
+// One sparse store holds all byte lanes so programs load as whole words.
+`include "sparse_memory.vh"
+
+reg  [DATA_WIDTH-1:0] readData_r;
+
+integer b;
+always @(readEnable or readAddress or writeEnable or writeByteEnable or
+         writeAddress or writeData or sparse_version) begin
+  readData_r = readEnable ? sparse_read(readAddress) : 0;
+  for(b=0; b<NUM_BYTES; b=b+1) begin
+    if(readEnable & writeEnable & writeByteEnable[b] & (readAddress == writeAddress))
+      readData_r[8*b +: 8] = writeData[8*b +: 8];
+  end
+end
+
+assign readData = readData_r;
+
+// The read port sees the write with the nonblocking updates of the clock
+// edge, like the byte arrays below.
+always@(posedge clock) begin
+  if(writeEnable) begin
+    sparse_store(writeAddress, writeData, writeByteEnable);
+    sparse_version <= sparse_version + 32'd1;
+  end
+end
+`else
 genvar i;
 generate
 for(i=0; i<NUM_BYTES; i=i+1) begin : BYTE_LOOP
@@ -63,6 +90,7 @@ for(i=0; i<NUM_BYTES; i=i+1) begin : BYTE_LOOP
 
 end
 endgenerate
+`endif
 
 reg [31: 0] cycles;
 always @ (posedge clock) begin
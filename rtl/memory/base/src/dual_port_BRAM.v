@@ -53,12 +53,37 @@ localparam RAM_DEPTH = 1 << ADDR_WIDTH;
 
 reg [DATA_WIDTH-1:0] readData_r_1;
 reg [DATA_WIDTH-1:0] readData_r_2;
-reg [DATA_WIDTH-1:0] ram [0:RAM_DEPTH-1];
 
 wire valid_writeEnable_2;
 
 assign valid_writeEnable_2 =  writeEnable_2 & ~(writeEnable_1 & (address_1 == address_2));
 
+`ifdef SPARSE_MEMORY
+`include "sparse_memory.vh"
+
+initial begin
+  if(INIT_FILE != "")
+    sparse_load($sformatf("%0s", INIT_FILE), 0, -1);
+end
+
+// Port 1
+always@(posedge clock) begin
+  if(writeEnable_1)
+    sparse_write(address_1, writeData_1, {(DATA_WIDTH+7)/8{1'b1}});
+  if(readEnable_1)
+    readData_1 <= sparse_read(address_1);
+end
+
+// port 2
+always@(posedge clock)begin
+  if(valid_writeEnable_2)
+    sparse_write(address_2, writeData_2, {(DATA_WIDTH+7)/8{1'b1}});
+  if(readEnable_2)
+    readData_2 <= sparse_read(address_2);
+end
+`else
+reg [DATA_WIDTH-1:0] ram [0:RAM_DEPTH-1];
+
 initial begin
   if(INIT_FILE != "")
     $readmemh(INIT_FILE, ram);
@@ -82,6 +107,7 @@ always@(posedge clock)begin
   if(readEnable_2)
     readData_2 <= ram[address_2];
 end
+`endif
 
 reg [31: 0] cycles;
 always @ (negedge clock) begin
@@ -54,6 +54,46 @@ localparam MEM_DEPTH = 1 << ADDR_WIDTH;
 localparam NUM_BYTES = DATA_WIDTH/8;
 
 
+`ifdef SPARSE_MEMORY
+// One sparse store holds all byte lanes so programs load as whole words. The
+// lane files of INIT_FILE_BASE are still accepted.
+`include "sparse_memory.vh"
+
+reg [DATA_WIDTH-1:0] readData_r_1;
+reg [DATA_WIDTH-1:0] readData_r_2;
+
+wire [NUM_BYTES-1:0] valid_writeByteEnable_2;
+
+assign valid_writeByteEnable_2 = writeByteEnable_2 &
+                                 ~({NUM_BYTES{writeEnable_1 & (address_1 == address_2)}} &
+                                   writeByteEnable_1);
+
+assign readData_1 = readData_r_1;
+assign readData_2 = readData_r_2;
+
+integer lane;
+initial begin
+  if(INIT_FILE_BASE != "")
+    for(lane=0; lane<NUM_BYTES; lane=lane+1)
+      sparse_load($sformatf("%0d%0s", lane, INIT_FILE_BASE), 1, lane);
+end
+
+// Port 1
+always@(posedge clock) begin
+  if(writeEnable_1)
+    sparse_write(address_1, writeData_1, writeByteEnable_1);
+  if(readEnable_1)
+    readData_r_1 <= sparse_read(address_1);
+end
+
+// Port 2
+always@(posedge clock)begin
+  if(writeEnable_2 & (|valid_writeByteEnable_2))
+    sparse_write(address_2, writeData_2, valid_writeByteEnable_2);
+  if(readEnable_2)
+    readData_r_2 <= sparse_read(address_2);
+end
+`else
 genvar i;
 generate
 for(i=0; i<NUM_BYTES; i=i+1) begin : BYTE_LOOP
@@ -122,6 +162,7 @@ end
 
 
 endgenerate
+`endif
 
 reg [31: 0] cycles;
 always @ (negedge clock) begin
@@ -20,14 +20,44 @@
  *  THE SOFTWARE.
  */
 
+/** Module description
+ * --------------------
+ *  - Connects the fetch and memory stages of a core to its instruction and
+ *    data memories or caches.
+ *  - With TCM_ADDRESS_BITS > 0 a tightly coupled memory (TCM) of
+ *    2**TCM_ADDRESS_BITS bytes is mapped at TCM_BASE. Fetches and data
+ *    accesses in that window go to a dual port BRAM scratchpad private to the
+ *    core instead of the cache hierarchy. TCM reads are valid the cycle after
+ *    the request and the TCM is always ready, so the latency does not depend
+ *    on the program or the other cores. TCM contents are not coherent and
+ *    are never written back.
+ *  - TCM_BASE must be aligned to the TCM size. TCM_INIT_FILE_BASE is the base
+ *    name of the byte lane files written by vmh_byte_split.py.
+ *  - A TCM read is only issued when no cache read of the same port is
+ *    waiting for its data, so responses return in program order. With
+ *    TCM_ADDRESS_BITS = 0 the module is a pass-through.
+ *  - FETCH_WIDTH is the width of the fetch data. Cores that fetch more than
+ *    one word at a time (seven_stage_dual_core) set it to a multiple of
+ *    DATA_WIDTH and need an instruction memory of the same width.
+ */
+
 module memory_interface #(
-  parameter DATA_WIDTH   = 32,
-  parameter ADDRESS_BITS = 32
+  parameter CORE               = 0,
+  parameter DATA_WIDTH         = 32,
+  parameter ADDRESS_BITS       = 32,
+  parameter FETCH_WIDTH        = DATA_WIDTH,
+  parameter TCM_ADDRESS_BITS   = 0,
+  parameter TCM_BASE           = 32'h00080000,
+  parameter TCM_INIT_FILE_BASE = "",
+  parameter SCAN_CYCLES_MIN    = 0,
+  parameter SCAN_CYCLES_MAX    = 1000
 )(
+  input  clock,
+  input  reset,
   //fetch stage interface
   input  fetch_read,
   input  [ADDRESS_BITS-1:0] fetch_address_out,
-  output [DATA_WIDTH-1  :0] fetch_data_in,
+  output [FETCH_WIDTH-1 :0] fetch_data_in,
   output [ADDRESS_BITS-1:0] fetch_address_in,
   output fetch_valid,
   output fetch_ready,
@@ -42,7 +72,7 @@ module memory_interface #(
   output memory_valid,
   output memory_ready,
   //instruction memory/cache interface
-  input  [DATA_WIDTH-1  :0] i_mem_data_out,
+  input  [FETCH_WIDTH-1 :0] i_mem_data_out,
   input  [ADDRESS_BITS-1:0] i_mem_address_out,
   input  i_mem_valid,
   input  i_mem_ready,
@@ -62,21 +92,127 @@ module memory_interface #(
   input scan
 );
 
-assign fetch_data_in     = i_mem_data_out;
-assign fetch_address_in  = i_mem_address_out;
-assign fetch_valid       = i_mem_valid;
-assign fetch_ready       = i_mem_ready;
+generate
+if(TCM_ADDRESS_BITS > 0) begin : TCM
+  wire tcm_fetch;
+  wire tcm_data;
+  wire tcm_i_read;
+  wire tcm_d_read;
+  wire tcm_d_write;
+  wire [FETCH_WIDTH-1 :0] tcm_i_data_out;
+  wire [ADDRESS_BITS-1:0] tcm_i_address_out;
+  wire tcm_i_valid;
+  wire [DATA_WIDTH-1  :0] tcm_d_data_out;
+  wire [ADDRESS_BITS-1:0] tcm_d_address_out;
+  wire tcm_d_valid;
+
+  // Set while a cache read has not returned its data
+  reg i_pending;
+  reg d_pending;
+
+  wire i_in_order;
+  wire d_in_order;
+
+  assign tcm_fetch = (fetch_address_out  >> TCM_ADDRESS_BITS) == (TCM_BASE >> TCM_ADDRESS_BITS);
+  assign tcm_data  = (memory_address_out >> TCM_ADDRESS_BITS) == (TCM_BASE >> TCM_ADDRESS_BITS);
+
+  assign i_in_order = ~i_pending | i_mem_valid;
+  assign d_in_order = ~d_pending | d_mem_valid;
+
+  assign tcm_i_read  = fetch_read   &  tcm_fetch & i_mem_ready & i_in_order;
+  assign tcm_d_read  = memory_read  &  tcm_data  & d_mem_ready & d_in_order;
+  assign tcm_d_write = memory_write &  tcm_data  & d_mem_ready & d_in_order;
+
+  assign i_mem_read  = fetch_read   & ~tcm_fetch;
+  assign d_mem_read  = memory_read  & ~tcm_data;
+  assign d_mem_write = memory_write & ~tcm_data;
+
+  always @(posedge clock) begin
+    if(reset) begin
+      i_pending <= 1'b0;
+      d_pending <= 1'b0;
+    end
+    else begin
+      i_pending <= (i_mem_read & i_mem_ready) | (i_pending & ~i_mem_valid);
+      d_pending <= (d_mem_read & d_mem_ready) | (d_pending & ~d_mem_valid);
+    end
+  end
+
+  dual_port_BRAM_memory_subsystem #(
+    .DATA_WIDTH(DATA_WIDTH),
+    .ADDRESS_BITS(ADDRESS_BITS),
+    .FETCH_WIDTH(FETCH_WIDTH),
+    .MEM_ADDRESS_BITS(TCM_ADDRESS_BITS),
+    .INIT_FILE_BASE(TCM_INIT_FILE_BASE),
+    .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+    .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+  ) tcm (
+    .clock(clock),
+    .reset(reset),
+    //instruction memory
+    .i_mem_read(tcm_i_read),
+    .i_mem_address_in(fetch_address_out),
+    .i_mem_data_out(tcm_i_data_out),
+    .i_mem_address_out(tcm_i_address_out),
+    .i_mem_valid(tcm_i_valid),
+    .i_mem_ready(),
+    //data memory
+    .d_mem_read(tcm_d_read),
+    .d_mem_write(tcm_d_write),
+    .d_mem_byte_en(memory_byte_en),
+    .d_mem_address_in(memory_address_out),
+    .d_mem_data_in(memory_data_out),
+    .d_mem_data_out(tcm_d_data_out),
+    .d_mem_address_out(tcm_d_address_out),
+    .d_mem_valid(tcm_d_valid),
+    .d_mem_ready(),
+    //scan signal
+    .scan(scan)
+  );
+
+  assign fetch_data_in     = tcm_i_valid ? tcm_i_data_out    : i_mem_data_out;
+  assign fetch_address_in  = tcm_i_valid ? tcm_i_address_out : i_mem_address_out;
+  assign fetch_valid       = i_mem_valid | tcm_i_valid;
+  assign fetch_ready       = i_mem_ready & i_in_order;
+
+  assign memory_data_in    = tcm_d_valid ? tcm_d_data_out    : d_mem_data_out;
+  assign memory_address_in = tcm_d_valid ? tcm_d_address_out : d_mem_address_out;
+  assign memory_valid      = d_mem_valid | tcm_d_valid;
+  assign memory_ready      = d_mem_ready & d_in_order;
+
+  reg [31: 0] cycles;
+  always @ (negedge clock) begin
+    cycles <= reset? 0 : cycles + 1;
+    if (scan & ((cycles >=  SCAN_CYCLES_MIN) & (cycles <= SCAN_CYCLES_MAX)))begin
+      $display ("------ Core %d Memory Interface TCM - Current Cycle %d ----------", CORE, cycles);
+      $display ("| TCM Fetch    [%b]", tcm_i_read);
+      $display ("| TCM Read     [%b]", tcm_d_read);
+      $display ("| TCM Write    [%b]", tcm_d_write);
+      $display ("| I Pending    [%b]", i_pending);
+      $display ("| D Pending    [%b]", d_pending);
+      $display ("----------------------------------------------------------------------");
+    end
+  end
+end
+else begin : NO_TCM
+  assign fetch_data_in     = i_mem_data_out;
+  assign fetch_address_in  = i_mem_address_out;
+  assign fetch_valid       = i_mem_valid;
+  assign fetch_ready       = i_mem_ready;
+
+  assign memory_data_in    = d_mem_data_out;
+  assign memory_address_in = d_mem_address_out;
+  assign memory_valid      = d_mem_valid;
+  assign memory_ready      = d_mem_ready;
 
-assign memory_data_in    = d_mem_data_out;
-assign memory_address_in = d_mem_address_out;
-assign memory_valid      = d_mem_valid;
-assign memory_ready      = d_mem_ready;
+  assign i_mem_read        = fetch_read;
+  assign d_mem_read        = memory_read;
+  assign d_mem_write       = memory_write;
+end
+endgenerate
 
-assign i_mem_read        = fetch_read;
 assign i_mem_address_in  = fetch_address_out;
 
-assign d_mem_read        = memory_read;
-assign d_mem_write       = memory_write;
 assign d_mem_byte_en     = memory_byte_en;
 assign d_mem_address_in  = memory_address_out;
 assign d_mem_data_in     = memory_data_out;
@@ -49,8 +49,6 @@ output reg [DATA_WIDTH-1:0] readData_1 // data_out1 => readData_2
 localparam RAM_DEPTH = 1 << INDEX_BITS;
 //localparam NUM_BYTES = DATA_WIDTH/8; // added to match dpBbe
 
-reg [DATA_WIDTH-1:0] ram [0:RAM_DEPTH-1];
-
 wire port0_we;
 
 assign port0_we = writeEnable_0 & ~(writeEnable_1 & (address_0 == address_1)); // If both ports
@@ -59,6 +57,28 @@ assign port0_we = writeEnable_0 & ~(writeEnable_1 & (address_0 == address_1)); /
                                                          // port1 gets
                                                          // priority.
 
+`ifdef SPARSE_MEMORY
+`include "sparse_memory.vh"
+
+// Both ports read before either writes, like the nonblocking array writes
+// below.
+always@(posedge clock)begin
+  readData_0 <= port0_we      ? writeData_0 : sparse_read(address_0);
+  readData_1 <= writeEnable_1 ? writeData_1 : sparse_read(address_1);
+  if(port0_we)
+    sparse_write(address_0, writeData_0, {(DATA_WIDTH+7)/8{1'b1}});
+  if(writeEnable_1)
+    sparse_write(address_1, writeData_1, {(DATA_WIDTH+7)/8{1'b1}});
+end
+
+initial begin
+  if(PROGRAM != "")begin
+    sparse_load($sformatf("%0s", PROGRAM), 0, -1);
+  end
+end
+`else
+reg [DATA_WIDTH-1:0] ram [0:RAM_DEPTH-1];
+
 // port A
 always@(posedge clock)begin
   if(port0_we) begin
@@ -88,6 +108,7 @@ initial begin
     $readmemh(PROGRAM, ram);
   end
 end
+`endif
 
 endmodule
 
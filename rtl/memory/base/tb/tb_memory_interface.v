@@ -103,6 +103,8 @@ memory_interface #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS)
 ) DUT (
+  .clock(1'b0),
+  .reset(1'b1),
   .fetch_read(fetch_read),
   .fetch_address_out(fetch_address_out),
   .fetch_data_in(fetch_data_in),
@@ -0,0 +1,242 @@
+/** @module : tb_memory_interface_tcm
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_memory_interface_tcm();
+
+parameter DATA_WIDTH       = 32;
+parameter ADDRESS_BITS     = 32;
+parameter TCM_ADDRESS_BITS = 10;
+parameter TCM_BASE         = 32'h00080000;
+
+reg  clock;
+reg  reset;
+//fetch stage interface
+reg  fetch_read;
+reg  [ADDRESS_BITS-1:0] fetch_address_out;
+wire [DATA_WIDTH-1  :0] fetch_data_in;
+wire [ADDRESS_BITS-1:0] fetch_address_in;
+wire fetch_valid;
+wire fetch_ready;
+//memory stage interface
+reg  memory_read;
+reg  memory_write;
+reg  [DATA_WIDTH/8-1:0] memory_byte_en;
+reg  [ADDRESS_BITS-1:0] memory_address_out;
+reg  [DATA_WIDTH-1  :0] memory_data_out;
+wire [DATA_WIDTH-1  :0] memory_data_in;
+wire [ADDRESS_BITS-1:0] memory_address_in;
+wire memory_valid;
+wire memory_ready;
+//instruction memory/cache interface
+reg  [DATA_WIDTH-1  :0] i_mem_data_out;
+reg  [ADDRESS_BITS-1:0] i_mem_address_out;
+reg  i_mem_valid;
+reg  i_mem_ready;
+wire i_mem_read;
+wire [ADDRESS_BITS-1:0] i_mem_address_in;
+//data memory/cache interface
+reg  [DATA_WIDTH-1  :0] d_mem_data_out;
+reg  [ADDRESS_BITS-1:0] d_mem_address_out;
+reg  d_mem_valid;
+reg  d_mem_ready;
+wire d_mem_read;
+wire d_mem_write;
+wire [DATA_WIDTH/8-1:0] d_mem_byte_en;
+wire [ADDRESS_BITS-1:0] d_mem_address_in;
+wire [DATA_WIDTH-1  :0] d_mem_data_in;
+
+reg scan;
+
+memory_interface #(
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .TCM_ADDRESS_BITS(TCM_ADDRESS_BITS),
+  .TCM_BASE(TCM_BASE)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .fetch_read(fetch_read),
+  .fetch_address_out(fetch_address_out),
+  .fetch_data_in(fetch_data_in),
+  .fetch_address_in(fetch_address_in),
+  .fetch_valid(fetch_valid),
+  .fetch_ready(fetch_ready),
+  .memory_read(memory_read),
+  .memory_write(memory_write),
+  .memory_byte_en(memory_byte_en),
+  .memory_address_out(memory_address_out),
+  .memory_data_out(memory_data_out),
+  .memory_data_in(memory_data_in),
+  .memory_address_in(memory_address_in),
+  .memory_valid(memory_valid),
+  .memory_ready(memory_ready),
+  .i_mem_data_out(i_mem_data_out),
+  .i_mem_address_out(i_mem_address_out),
+  .i_mem_valid(i_mem_valid),
+  .i_mem_ready(i_mem_ready),
+  .i_mem_read(i_mem_read),
+  .i_mem_address_in(i_mem_address_in),
+  .d_mem_data_out(d_mem_data_out),
+  .d_mem_address_out(d_mem_address_out),
+  .d_mem_valid(d_mem_valid),
+  .d_mem_ready(d_mem_ready),
+  .d_mem_read(d_mem_read),
+  .d_mem_write(d_mem_write),
+  .d_mem_byte_en(d_mem_byte_en),
+  .d_mem_address_in(d_mem_address_in),
+  .d_mem_data_in(d_mem_data_in),
+  .scan(scan)
+);
+
+//generate clock
+always #1 clock = ~clock;
+
+task fail;
+  input [8*40-1:0] reason;
+  begin
+    $display("%0s", reason);
+    $display("\ntb_memory_interface_tcm --> Test Failed!\n\n");
+    $stop;
+  end
+endtask
+
+task idle;
+  begin
+    fetch_read   <= 1'b0;
+    memory_read  <= 1'b0;
+    memory_write <= 1'b0;
+  end
+endtask
+
+initial begin
+  clock              = 1'b1;
+  reset              = 1'b1;
+  scan               = 1'b0;
+  fetch_read         = 1'b0;
+  fetch_address_out  = 0;
+  memory_read        = 1'b0;
+  memory_write       = 1'b0;
+  memory_byte_en     = 4'b1111;
+  memory_address_out = 0;
+  memory_data_out    = 0;
+  i_mem_data_out     = 32'h11111111;
+  i_mem_address_out  = 0;
+  i_mem_valid        = 1'b0;
+  i_mem_ready        = 1'b1;
+  d_mem_data_out     = 32'h22222222;
+  d_mem_address_out  = 0;
+  d_mem_valid        = 1'b0;
+  d_mem_ready        = 1'b1;
+
+  repeat(3) @(posedge clock);
+  reset <= 1'b0;
+
+  // Store to the TCM does not reach the data cache
+  @(posedge clock) begin
+    memory_write       <= 1'b1;
+    memory_address_out <= TCM_BASE + 32'h10;
+    memory_data_out    <= 32'hDEADBEEF;
+  end
+  @(negedge clock);
+  if(d_mem_write | ~memory_ready) fail("TCM store reached the cache");
+
+  // Byte store to the same word
+  @(posedge clock) begin
+    memory_byte_en  <= 4'b0001;
+    memory_data_out <= 32'h000000A5;
+  end
+  @(posedge clock) begin
+    idle;
+    memory_byte_en  <= 4'b1111;
+  end
+
+  // Load from the TCM is valid the next cycle
+  @(posedge clock) begin
+    memory_read        <= 1'b1;
+    memory_address_out <= TCM_BASE + 32'h10;
+  end
+  @(negedge clock);
+  if(d_mem_read) fail("TCM load reached the cache");
+  @(posedge clock) idle;
+  @(negedge clock);
+  if(~memory_valid | (memory_data_in != 32'hDEADBEA5) |
+     (memory_address_in != TCM_BASE + 32'h10))
+    fail("TCM load returned wrong data");
+
+  // Fetch port reads the same storage
+  @(posedge clock) begin
+    fetch_read        <= 1'b1;
+    fetch_address_out <= TCM_BASE + 32'h10;
+  end
+  @(negedge clock);
+  if(i_mem_read) fail("TCM fetch reached the cache");
+  @(posedge clock) idle;
+  @(negedge clock);
+  if(~fetch_valid | (fetch_data_in != 32'hDEADBEA5))
+    fail("TCM fetch returned wrong data");
+
+  // Accesses outside the window go to the caches
+  @(posedge clock) begin
+    fetch_read         <= 1'b1;
+    fetch_address_out  <= TCM_BASE - 32'h4;
+    memory_read        <= 1'b1;
+    memory_address_out <= TCM_BASE + (1 << TCM_ADDRESS_BITS);
+  end
+  @(negedge clock);
+  if(~i_mem_read | ~d_mem_read) fail("Cache access was routed to the TCM");
+  @(posedge clock) idle;
+
+  // The cache read above is still pending, so a TCM load has to wait
+  @(posedge clock) begin
+    memory_read        <= 1'b1;
+    memory_address_out <= TCM_BASE + 32'h10;
+  end
+  @(negedge clock);
+  if(memory_ready) fail("TCM load passed a pending cache load");
+  @(posedge clock) begin
+    d_mem_valid       <= 1'b1;
+    d_mem_address_out <= TCM_BASE + (1 << TCM_ADDRESS_BITS);
+  end
+  @(negedge clock);
+  if(~memory_ready | ~memory_valid | (memory_data_in != 32'h22222222))
+    fail("Cache load did not complete");
+  @(posedge clock) begin
+    idle;
+    d_mem_valid <= 1'b0;
+  end
+  @(negedge clock);
+  if(~memory_valid | (memory_data_in != 32'hDEADBEA5))
+    fail("TCM load after cache load failed");
+
+  #20;
+  $display("\ntb_memory_interface_tcm --> Test Passed!\n\n");
+  $stop;
+end
+
+//timeout
+initial begin
+  #500;
+  $display("\ntb_memory_interface_tcm --> Test Failed!\n\n");
+  $stop;
+end
+
+endmodule
@@ -0,0 +1,191 @@
+/** @module : tb_sparse_memory
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Tests the SPARSE_MEMORY build of dual_port_BRAM_byte_en with an address
+ *    space that could not be allocated as an array, and loading a program
+ *    image into a memory wider than the image words.
+ *  - Needs +define+SPARSE_MEMORY, see rtl/memory/base/README. Without it the
+ *    test bench only reports that it was skipped.
+ */
+
+module tb_sparse_memory();
+
+parameter CORE = 0;
+parameter DATA_WIDTH = 64;
+parameter ADDR_WIDTH = 44;
+parameter PROGRAM = "./binaries/gcd1536.vmh";
+
+`ifdef SPARSE_MEMORY
+reg  clock;
+reg  reset;
+
+// Port
+reg  readEnable_1;
+reg  writeEnable_1;
+reg  [DATA_WIDTH/8-1:0] writeByteEnable_1;
+reg  [ADDR_WIDTH-1:0] address_1;
+reg  [DATA_WIDTH-1:0] writeData_1;
+wire [DATA_WIDTH-1:0] readData_1;
+
+// Port 2
+reg  readEnable_2;
+reg  writeEnable_2;
+reg  [DATA_WIDTH/8-1:0] writeByteEnable_2;
+reg  [ADDR_WIDTH-1:0] address_2;
+reg  [DATA_WIDTH-1:0] writeData_2;
+wire [DATA_WIDTH-1:0] readData_2;
+
+reg scan;
+
+dual_port_BRAM_byte_en #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDR_WIDTH(ADDR_WIDTH)
+) uut (
+  .clock(clock),
+  .reset(reset),
+
+  // Port
+  .readEnable_1(readEnable_1),
+  .writeEnable_1(writeEnable_1),
+  .writeByteEnable_1(writeByteEnable_1),
+  .address_1(address_1),
+  .writeData_1(writeData_1),
+  .readData_1(readData_1),
+
+  // Port 2
+  .readEnable_2(readEnable_2),
+  .writeEnable_2(writeEnable_2),
+  .writeByteEnable_2(writeByteEnable_2),
+  .address_2(address_2),
+  .writeData_2(writeData_2),
+  .readData_2(readData_2),
+
+  .scan(scan)
+);
+
+always #5 clock = ~clock;
+
+initial begin
+  clock = 1'b1;
+  reset = 1'b1;
+  readEnable_1 = 1'b0;
+  writeEnable_1 = 1'b0;
+  writeByteEnable_1 = 8'hFF;
+  address_1 = 0;
+  writeData_1 = 0;
+  readEnable_2 = 1'b0;
+  writeEnable_2 = 1'b0;
+  writeByteEnable_2 = 8'hFF;
+  address_2 = 0;
+  writeData_2 = 0;
+  scan = 0;
+
+  // The 32-bit program words are paired into 64-bit memory words
+  uut.load_image(PROGRAM, 4);
+
+  repeat (1) @ (posedge clock);
+  reset = 1'b0;
+
+  // Read the first program words
+  readEnable_1 = 1'b1;
+  address_1    = 1;
+  readEnable_2 = 1'b1;
+  address_2    = 2;
+
+  repeat (1) @ (posedge clock);
+  #1 // Delay to ensure readData is checked after it is latched on the posedge clock
+  if( readData_1 != 64'h0040006F_00000013 |
+      readData_2 != 64'h00000093_00000013 ) begin
+    $display("\nError: Unexpected program data!");
+    $display("rd1: %h\nrd2: %h", readData_1, readData_2);
+    $display("\ntb_sparse_memory --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Byte writes to both ends of the address space
+  writeEnable_1     = 1'b1;
+  writeByteEnable_1 = 8'h0F;
+  address_1         = {ADDR_WIDTH{1'b1}};
+  writeData_1       = 64'h11111111_22222222;
+  writeEnable_2     = 1'b1;
+  writeByteEnable_2 = 8'hF0;
+  address_2         = {1'b1, {ADDR_WIDTH-1{1'b0}}};
+  writeData_2       = 64'h33333333_44444444;
+
+  repeat (1) @ (posedge clock);
+  #1 // Delay to ensure readData is checked after it is latched on the posedge clock
+  if( readData_1 != 64'h00000000_22222222 |
+      readData_2 != 64'h33333333_00000000 ) begin
+    $display("\nError: Unexpected read data during byte write!");
+    $display("rd1: %h\nrd2: %h", readData_1, readData_2);
+    $display("\ntb_sparse_memory --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Same address on both ports, port 1 keeps the bytes it writes
+  writeEnable_1     = 1'b1;
+  writeByteEnable_1 = 8'h03;
+  address_1         = 7;
+  writeData_1       = 64'hAAAAAAAA_AAAAAAAA;
+  writeEnable_2     = 1'b1;
+  writeByteEnable_2 = 8'h0F;
+  address_2         = 7;
+  writeData_2       = 64'hBBBBBBBB_BBBBBBBB;
+
+  repeat (1) @ (posedge clock);
+  writeEnable_1 = 1'b0;
+  writeEnable_2 = 1'b0;
+  address_1     = {ADDR_WIDTH{1'b1}};
+
+  repeat (1) @ (posedge clock);
+  #1 // Delay to ensure readData is checked after it is latched on the posedge clock
+  if( readData_1 != 64'h00000000_22222222 |
+      readData_2 != 64'h00000000_BBBBAAAA ) begin
+    $display("\nError: Unexpected read data after byte writes!");
+    $display("rd1: %h\nrd2: %h", readData_1, readData_2);
+    $display("\ntb_sparse_memory --> Test Failed!\n\n");
+    $stop();
+  end
+
+  // Only the program page (which also holds word 7) and the two far pages
+  // are allocated
+  if(uut.sparse_memory_pages(uut.sparse_handle) != 3) begin
+    $display("\nError: Unexpected number of allocated pages!");
+    $display("\ntb_sparse_memory --> Test Failed!\n\n");
+    $stop();
+  end
+
+  $display("\ntb_sparse_memory --> Test Passed!\n\n");
+  $stop();
+
+end
+`else
+initial begin
+  $display("\ntb_sparse_memory --> Skipped, compile with +define+SPARSE_MEMORY\n\n");
+  $stop();
+end
+`endif
+
+endmodule
@@ -26,7 +26,10 @@ parameter CACHE_OFFSET_BITS =  2, //max offset bits from cache side
           DATA_WIDTH        = 32,
           ADDRESS_WIDTH     = 32,
           MSG_BITS          =  4,
-          MAX_OFFSET_BITS   =  3
+          MAX_OFFSET_BITS   =  3,
+          // 1: a R_REQ is answered with a word beat and then the line, see
+          // lx_bus_interface
+          CRITICAL_WORD_FIRST = 0
 )(
 clock, 
 reset,
@@ -134,6 +137,7 @@ reg [MAX_OFFSET_BITS:0] block_counter;
 reg [MAX_OFFSET_BITS:0] word_counter;
 
 reg current_owner; /*0-cache; 1-snooper*/ //what owns the bus interface.
+reg word_sent;
 reg [MSG_BITS-1:0] curr_msg;
 reg [ADDRESS_WIDTH-1:0] curr_address;
 reg [DATA_WIDTH-1:0] curr_data [CACHE_WORDS-1:0];
@@ -174,7 +178,8 @@ assign wider_line = cache_offset > BUS_OFFSET_BITS;
 
 assign cache_req = (cache_msg_in == R_REQ)    | (cache_msg_in == WB_REQ)   |
                    (cache_msg_in == FLUSH)    | (cache_msg_in == FLUSH_S)  |
-                   (cache_msg_in == WS_BCAST) | (cache_msg_in == RFO_BCAST);
+                   (cache_msg_in == WS_BCAST) | (cache_msg_in == RFO_BCAST) |
+                   (cache_msg_in == WB_CLEAN);
 
 assign snoop_req = (snoop_msg_in == C_WB)     | (snoop_msg_in == C_FLUSH) |
                    (snoop_msg_in == EN_ACCESS);
@@ -211,6 +216,7 @@ always @(posedge clock)begin
     block_counter       <= {(MAX_OFFSET_BITS+1){1'b0}};
     word_counter        <= {(MAX_OFFSET_BITS+1){1'b0}};
     current_owner       <= 1'b0;
+    word_sent           <= 1'b0;
     for(j=0; j<CACHE_WORDS; j=j+1)begin
       r_cache_data_out[j] <= {DATA_WIDTH{1'b0}};
       r_snoop_data_out[j] <= {DATA_WIDTH{1'b0}};
@@ -249,6 +255,7 @@ always @(posedge clock)begin
             curr_data[j] <= cache_data_in[j*DATA_WIDTH +: DATA_WIDTH];
           end
           current_owner  <= 1'b0;
+          word_sent      <= 1'b0;
           state          <= CACHE_REQ;
         end
         else
@@ -268,6 +275,13 @@ always @(posedge clock)begin
           r_snoop_address_out <= curr_address;
           state               <= WAIT_FOR_SNOOP;
         end
+        else if(snoop_msg_in == NO_REQ)begin
+        /*The snooper dropped the EN_ACCESS to snoop a REQ_FLUSH.*/
+          r_bus_msg_out     <= NO_REQ;
+          r_bus_address_out <= {ADDRESS_WIDTH{1'b0}};
+          current_owner     <= 1'b0;
+          state             <= IDLE;
+        end
         else
           state <= SN_WAIT_FOR_READY;
       end
@@ -364,7 +378,7 @@ always @(posedge clock)begin
       end
       WAIT_RESP:begin
         if((curr_msg == WB_REQ) | (curr_msg == FLUSH) | 
-        (curr_msg == FLUSH_S))begin
+        (curr_msg == FLUSH_S) | (curr_msg == WB_CLEAN))begin
           if(bus_msg_in == MEM_RESP)begin
             r_bus_msg_out     <= NO_REQ;
             r_bus_address_out <= {ADDRESS_WIDTH{1'b0}};
@@ -394,8 +408,23 @@ always @(posedge clock)begin
             state <= WAIT_RESP;
         end
         else begin
-          if((bus_msg_in == MEM_RESP) | (bus_msg_in == MEM_RESP_S))begin
+          if(CRITICAL_WORD_FIRST & (curr_msg == R_REQ) & ~word_sent &
+          ((bus_msg_in == MEM_RESP) | (bus_msg_in == MEM_RESP_S)))begin
+          /*Word beat. Pass the requested word to the cache and keep the
+          * request on the bus until the line arrives.*/
+            r_cache_msg_out     <= bus_msg_in;
+            r_cache_address_out <= curr_address;
+            for(j=0; j<CACHE_WORDS; j=j+1)begin
+              r_cache_data_out[j] <= (j == (curr_address & (CACHE_WORDS-1))) ?
+                                     w_bus_data_in[curr_address & (BUS_WORDS-1)]
+                                     : {DATA_WIDTH{1'b0}};
+            end
+            word_sent <= 1'b1;
+          end
+          else if((bus_msg_in == MEM_RESP) | (bus_msg_in == MEM_RESP_S))begin
             if(wider_line)begin
+              if(CRITICAL_WORD_FIRST)
+                r_cache_msg_out <= NO_REQ; //end the word beat
               for(j=0; j<BUS_WORDS; j=j+1)begin
                 r_cache_data_out[j] <= w_bus_data_in[j];
               end
@@ -413,6 +442,8 @@ always @(posedge clock)begin
               state <= WAIT_FOR_CACHE;
             end
           end
+          else if(CRITICAL_WORD_FIRST)
+            r_cache_msg_out <= NO_REQ;
         end
       end
       TRANSFER:begin
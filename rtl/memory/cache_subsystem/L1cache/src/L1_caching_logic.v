@@ -30,11 +30,15 @@
  *    replacement.
  *  - Signals for port 1 of the cache_memory module are exposed so that the
  *    coherence related updates can be performed by the bus/noc interface.
+ *  - An optional victim cache holds lines evicted from the cache memory. A
+ *    miss that hits in the victim cache swaps the two lines without a bus
+ *    transaction. Its snoop port is exposed next to port 1.
  *
  *  Sub modules
  *  -----------
    *  cache_memory
    *  cache_controller
+   *  victim_cache
  *
  *  Parameters
  *  ----------
@@ -43,6 +47,12 @@
    *    - CUSTOM: User specified protocol implemented by the user.
    *  REPLACEMENT_MODE: Select replacement policy
    *    - 0: LRU (default)
+   *  VICTIM_ENTRIES: Number of victim cache entries, 0 (default) removes the
+   *    victim cache.
+   *  CLEAN_WRITEBACK: 1 writes back evicted clean lines with WB_CLEAN
+   *    instead of dropping them. Used with an exclusive L2 cache.
+   *  CRITICAL_WORD_FIRST: 1 lets load misses request their word, which
+   *    arrives before the line, see cache_controller.
 */
 
 
@@ -59,12 +69,17 @@ parameter STATUS_BITS        =  2,
           COHERENCE_PROTOCOL = "MESI",
           CORE               =  0,
           CACHE_NO           =  0,
+          VICTIM_ENTRIES     =  0,
+          CLEAN_WRITEBACK    =  0,
+          CRITICAL_WORD_FIRST = 0,
           //Use default value in module instantiation for following parameters
           CACHE_WORDS        = 1 << CACHE_OFFSET_BITS,
           CACHE_WIDTH        = DATA_WIDTH * CACHE_WORDS,
           TAG_BITS           = ADDRESS_BITS - INDEX_BITS - CACHE_OFFSET_BITS,
           WAY_BITS           = (NUMBER_OF_WAYS > 1) ? log2(NUMBER_OF_WAYS) : 1,
-          SBITS              = COHERENCE_BITS + STATUS_BITS
+          SBITS              = COHERENCE_BITS + STATUS_BITS,
+          LINE_BITS          = ADDRESS_BITS - CACHE_OFFSET_BITS,
+          SLOT_BITS          = (VICTIM_ENTRIES > 1) ? log2(VICTIM_ENTRIES) : 1
 
 )(
 // interface with the core
@@ -92,6 +107,12 @@ output [COHERENCE_BITS-1:0] port1_coh_bits,
 output [STATUS_BITS-1   :0] port1_status_bits,
 output port1_hit,
 
+// victim cache snoop interface, looked up with port1_tag and port1_index
+input  port1_victim_write, port1_victim_invalidate,
+output [CACHE_WIDTH-1   :0] port1_victim_read_data,
+output [STATUS_BITS-1   :0] port1_victim_status_bits,
+output port1_victim_hit,
+
 // interface for cache_controller <-> bus_interface
 input  [MSG_BITS-1:    0] mem2cache_msg,
 input  [CACHE_WIDTH-1: 0] mem2cache_data,
@@ -139,10 +160,19 @@ wire [STATUS_BITS-1   :0] mem_status_bits0, mem_status_bits1;
 wire mem_hit0, mem_hit1;
 wire mem_read0, mem_read1, mem_write0, mem_write1;
 wire mem_invalidate0, mem_invalidate1;
+wire victim_hit0, victim_write0, victim_invalidate0, victim_snoop_modify;
+wire [LINE_BITS-1     :0] victim_line0, victim_write_line0, victim_replace_line;
+wire [SLOT_BITS-1     :0] victim_matched_slot0, victim_slot_select0;
+wire [SLOT_BITS-1     :0] victim_replace_slot;
+wire [SBITS-1         :0] victim_meta_out0, victim_metadata0;
+wire [SBITS-1         :0] victim_replace_meta;
+wire [CACHE_WIDTH-1   :0] victim_data_out0, victim_data_in0, victim_replace_data;
 
 
 // Assignments
 assign snoop_action = port1_read | port1_write | port1_invalidate;
+assign victim_snoop_modify = (VICTIM_ENTRIES > 0) & (port1_victim_write |
+                             port1_victim_invalidate);
 
 assign mem_read0       = ctrl_read0;
 assign mem_write0      = ctrl_write0;
@@ -186,7 +216,10 @@ cache_controller #(
   .INDEX_BITS(INDEX_BITS),
   .MSG_BITS(MSG_BITS),
   .CORE(0),
-  .CACHE_NO(0)
+  .CACHE_NO(0),
+  .VICTIM_ENTRIES(VICTIM_ENTRIES),
+  .CLEAN_WRITEBACK(CLEAN_WRITEBACK),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) controller (
   .clock(clock), 
   .reset(reset),
@@ -236,7 +269,23 @@ cache_controller #(
 
   .snoop_address({port1_tag, port1_index, {CACHE_OFFSET_BITS{1'b0}}}),
   .snoop_read(port1_read),
-  .snoop_modify(port1_write | port1_invalidate)
+  .snoop_modify(port1_write | port1_invalidate | victim_snoop_modify),
+
+  .victim_hit(victim_hit0),
+  .victim_slot(victim_matched_slot0),
+  .victim_meta(victim_meta_out0),
+  .victim_data_in(victim_data_out0),
+  .victim_replace_slot(victim_replace_slot),
+  .victim_replace_line(victim_replace_line),
+  .victim_replace_meta(victim_replace_meta),
+  .victim_replace_data(victim_replace_data),
+  .victim_line(victim_line0),
+  .victim_write(victim_write0),
+  .victim_invalidate(victim_invalidate0),
+  .victim_slot_select(victim_slot_select0),
+  .victim_write_line(victim_write_line0),
+  .victim_meta_data(victim_metadata0),
+  .victim_data_out(victim_data_in0)
 );
 
 
@@ -288,4 +337,60 @@ cache_memory #(
   .report(report)
 );
 
+
+// Instantiate victim cache
+generate
+  if(VICTIM_ENTRIES > 0)begin: VICTIM
+    victim_cache #(
+      .STATUS_BITS(STATUS_BITS),
+      .COHERENCE_BITS(COHERENCE_BITS),
+      .OFFSET_BITS(CACHE_OFFSET_BITS),
+      .DATA_WIDTH(DATA_WIDTH),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .ENTRIES(VICTIM_ENTRIES)
+    ) victims (
+      .clock(clock),
+      .reset(i_reset),
+      //port 0
+      .line0(victim_line0),
+      .write0(victim_write0),
+      .invalidate0(victim_invalidate0),
+      .slot_select0(victim_slot_select0),
+      .write_line0(victim_write_line0),
+      .meta_data0(victim_metadata0),
+      .data_in0(victim_data_in0),
+      .matched_slot0(victim_matched_slot0),
+      .meta_out0(victim_meta_out0),
+      .data_out0(victim_data_out0),
+      .hit0(victim_hit0),
+      .replace_slot(victim_replace_slot),
+      .replace_line(victim_replace_line),
+      .replace_meta(victim_replace_meta),
+      .replace_data(victim_replace_data),
+      //port 1
+      .line1({port1_tag, port1_index}),
+      .write1(port1_victim_write),
+      .invalidate1(port1_victim_invalidate),
+      .meta_data1(port1_metadata),
+      .data_out1(port1_victim_read_data),
+      .coh_bits1(),
+      .status_bits1(port1_victim_status_bits),
+      .hit1(port1_victim_hit)
+    );
+  end
+  else begin: NO_VICTIM
+    assign victim_hit0              = 1'b0;
+    assign victim_matched_slot0     = {SLOT_BITS{1'b0}};
+    assign victim_meta_out0         = {SBITS{1'b0}};
+    assign victim_data_out0         = {CACHE_WIDTH{1'b0}};
+    assign victim_replace_slot      = {SLOT_BITS{1'b0}};
+    assign victim_replace_line      = {LINE_BITS{1'b0}};
+    assign victim_replace_meta      = {SBITS{1'b0}};
+    assign victim_replace_data      = {CACHE_WIDTH{1'b0}};
+    assign port1_victim_read_data   = {CACHE_WIDTH{1'b0}};
+    assign port1_victim_status_bits = {STATUS_BITS{1'b0}};
+    assign port1_victim_hit         = 1'b0;
+  end
+endgenerate
+
 endmodule
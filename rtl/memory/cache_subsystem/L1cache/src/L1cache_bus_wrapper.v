@@ -24,6 +24,12 @@
 * --------------------
  *  - Wrapper module for L1 cache.
  *  - Uses the bus interface on the memory side.
+ *  - VICTIM_ENTRIES > 0 adds a victim cache with that many entries. Its
+ *    snoop port connects the caching logic to the snooper.
+ *  - CLEAN_WRITEBACK = 1 writes back evicted clean lines with WB_CLEAN, see
+ *    L1_caching_logic.
+ *  - CRITICAL_WORD_FIRST = 1 restarts load misses on a word beat that comes
+ *    before the line. The Lx cache on the bus needs the same setting.
  *
  *  Sub modules
  *  -----------
@@ -46,6 +52,9 @@ parameter STATUS_BITS        =  2,
           COHERENCE_PROTOCOL = "MESI",
           CORE               =  0,
           CACHE_NO           =  0,
+          VICTIM_ENTRIES     =  0,
+          CLEAN_WRITEBACK    =  0,
+          CRITICAL_WORD_FIRST = 0,
           //Use default value in module instantiation for following parameters
           CACHE_WORDS        = 1 << CACHE_OFFSET_BITS,
           BUS_WORDS          = 1 << BUS_OFFSET_BITS,
@@ -114,6 +123,9 @@ wire [TAG_BITS-1      :0] port1_tag;
 wire [SBITS-1         :0] port1_metadata;
 wire [CACHE_WIDTH-1   :0] port1_write_data;
 wire [WAY_BITS-1      :0] port1_way_select;
+wire [CACHE_WIDTH-1   :0] port1_victim_read_data;
+wire [STATUS_BITS-1   :0] port1_victim_status_bits;
+wire port1_victim_hit, port1_victim_write, port1_victim_invalidate;
 
 
 //assignments
@@ -133,7 +145,10 @@ L1_caching_logic #(
   .REPLACEMENT_MODE(REPLACEMENT_MODE),
   .COHERENCE_PROTOCOL(COHERENCE_PROTOCOL),
   .CORE(CORE),
-  .CACHE_NO(CACHE_NO)
+  .CACHE_NO(CACHE_NO),
+  .VICTIM_ENTRIES(VICTIM_ENTRIES),
+  .CLEAN_WRITEBACK(CLEAN_WRITEBACK),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) cache (
 // interface with the core
   .clock(clock), 
@@ -164,6 +179,11 @@ L1_caching_logic #(
   .port1_coh_bits(port1_coh_bits),
   .port1_status_bits(port1_status_bits),
   .port1_hit(port1_hit),
+  .port1_victim_write(port1_victim_write),
+  .port1_victim_invalidate(port1_victim_invalidate),
+  .port1_victim_read_data(port1_victim_read_data),
+  .port1_victim_status_bits(port1_victim_status_bits),
+  .port1_victim_hit(port1_victim_hit),
 // interface for cache_controller <-> bus_interface
   .mem2cache_msg(intf2cache_msg),
   .mem2cache_data(intf2cache_data),
@@ -189,7 +209,9 @@ cache_bus_interface #(
   .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
   .COHERENCE_PROTOCOL(COHERENCE_PROTOCOL),
   .CORE(CORE),
-  .CACHE_NO(CACHE_NO)
+  .CACHE_NO(CACHE_NO),
+  .VICTIM_ENTRIES(VICTIM_ENTRIES),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) bus_interface (
   .clock(clock),
   .reset(reset),
@@ -225,7 +247,13 @@ cache_bus_interface #(
   .port1_tag(port1_tag),
   .port1_metadata(port1_metadata),
   .port1_write_data(port1_write_data),
-  .port1_way_select(port1_way_select)
+  .port1_way_select(port1_way_select),
+//interface with victim cache
+  .port1_victim_read_data(port1_victim_read_data),
+  .port1_victim_status_bits(port1_victim_status_bits),
+  .port1_victim_hit(port1_victim_hit),
+  .port1_victim_write(port1_victim_write),
+  .port1_victim_invalidate(port1_victim_invalidate)
 );
 
 endmodule
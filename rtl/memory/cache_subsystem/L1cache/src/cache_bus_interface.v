@@ -37,6 +37,10 @@
    *  COHERENCE_PROTOCOL: Select the coherence protocol
    *    - MESI, MSI, CUSTOM (default is MESI)
    *    - CUSTOM: User specified protocol implemented by the user.
+   *  VICTIM_ENTRIES: Number of victim cache entries of the L1 cache. The
+   *    snooper searches the victim cache when it is not 0.
+   *  CRITICAL_WORD_FIRST: 1 passes the word beat of a R_REQ response to the
+   *    cache before the line.
 */
 
 
@@ -54,6 +58,8 @@ parameter STATUS_BITS        =  2,
           COHERENCE_PROTOCOL = "MESI",
           CORE               =  0,
           CACHE_NO           =  0,
+          VICTIM_ENTRIES     =  0,
+          CRITICAL_WORD_FIRST = 0,
           //Use default value in module instantiation for following parameters
           CACHE_WORDS        = 1 << CACHE_OFFSET_BITS,
           CACHE_WIDTH        = DATA_WIDTH * CACHE_WORDS,
@@ -96,7 +102,13 @@ output [INDEX_BITS-1    :0] port1_index,
 output [TAG_BITS-1      :0] port1_tag,
 output [SBITS-1         :0] port1_metadata,
 output [CACHE_WIDTH-1   :0] port1_write_data,
-output [WAY_BITS-1      :0] port1_way_select
+output [WAY_BITS-1      :0] port1_way_select,
+
+//interface with victim cache
+input  [CACHE_WIDTH-1   :0] port1_victim_read_data,
+input  [STATUS_BITS-1   :0] port1_victim_status_bits,
+input  port1_victim_hit,
+output port1_victim_write, port1_victim_invalidate
 );
 
 //define the log2 function
@@ -130,7 +142,8 @@ snooper #(
   .COHERENCE_BITS(COHERENCE_BITS),
   .STATUS_BITS(STATUS_BITS),
   .NUMBER_OF_WAYS(NUMBER_OF_WAYS),
-  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+  .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
+  .VICTIM_ENTRIES(VICTIM_ENTRIES)
 ) snooper (
   .clock(clock),
   .reset(i_reset),
@@ -147,6 +160,11 @@ snooper #(
   .meta_data(port1_metadata),
   .data_out(port1_write_data),
   .way_select(port1_way_select),
+  .victim_data_in(port1_victim_read_data),
+  .victim_status_bits(port1_victim_status_bits),
+  .victim_hit(port1_victim_hit),
+  .victim_write(port1_victim_write),
+  .victim_invalidate(port1_victim_invalidate),
   
   .intf_msg(intf2snooper_msg),
   .intf_address(intf2snooper_addr),
@@ -170,7 +188,8 @@ L1_bus_interface #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_WIDTH(ADDRESS_BITS),
   .MSG_BITS(MSG_BITS),
-  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+  .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) bus_interface (
   .clock(clock), 
   .reset(i_reset),
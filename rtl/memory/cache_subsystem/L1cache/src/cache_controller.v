@@ -30,7 +30,10 @@ parameter STATUS_BITS           =  2,
           INDEX_BITS            =  8,
           MSG_BITS              =  4,
           CORE                  =  0,
-          CACHE_NO              =  0
+          CACHE_NO              =  0,
+          VICTIM_ENTRIES        =  0,
+          CLEAN_WRITEBACK       =  0,
+          CRITICAL_WORD_FIRST   =  0
 )(
 clock, reset,
 read, write, invalidate, flush,
@@ -76,7 +79,23 @@ cache2mem_address,
 
 snoop_address,
 snoop_read,
-snoop_modify
+snoop_modify,
+
+victim_hit,
+victim_slot,
+victim_meta,
+victim_data_in,
+victim_replace_slot,
+victim_replace_line,
+victim_replace_meta,
+victim_replace_data,
+victim_line,
+victim_write,
+victim_invalidate,
+victim_slot_select,
+victim_write_line,
+victim_meta_data,
+victim_data_out
 );
 
 //define the log2 function
@@ -96,23 +115,28 @@ localparam SBITS       = COHERENCE_BITS + STATUS_BITS;
 localparam TAG_BITS    = ADDRESS_BITS - OFFSET_BITS - INDEX_BITS;
 localparam WAY_BITS    = (NUMBER_OF_WAYS > 1) ? log2(NUMBER_OF_WAYS) : 1;
 localparam CACHE_DEPTH = 1 << INDEX_BITS;
-
-
-localparam IDLE            = 4'd0,
-           RESET           = 4'd1,
-           WAIT_FOR_ACCESS = 4'd2,
-           CACHE_ACCESS    = 4'd3,
-           READ_STATE      = 4'd4,
-           WRITE_BACK      = 4'd5,
-           WAIT            = 4'd6,
-           UPDATE          = 4'd7,
-           WB_WAIT         = 4'd8,
-           SRV_FLUSH_REQ   = 4'd9,
-           WAIT_FLUSH_REQ  = 4'd10,
-           SRV_INVLD_REQ   = 4'd11,
-           WAIT_INVLD_REQ  = 4'd12,
-           WAIT_WS_ENABLE  = 4'd13,
-           REACCESS        = 4'd14;
+localparam LINE_BITS   = ADDRESS_BITS - OFFSET_BITS;
+localparam VICTIM      = VICTIM_ENTRIES > 0;
+localparam SLOT_BITS   = (VICTIM_ENTRIES > 1) ? log2(VICTIM_ENTRIES) : 1;
+
+
+localparam IDLE            = 5'd0,
+           RESET           = 5'd1,
+           WAIT_FOR_ACCESS = 5'd2,
+           CACHE_ACCESS    = 5'd3,
+           READ_STATE      = 5'd4,
+           WRITE_BACK      = 5'd5,
+           WAIT            = 5'd6,
+           UPDATE          = 5'd7,
+           WB_WAIT         = 5'd8,
+           SRV_FLUSH_REQ   = 5'd9,
+           WAIT_FLUSH_REQ  = 5'd10,
+           SRV_INVLD_REQ   = 5'd11,
+           WAIT_INVLD_REQ  = 5'd12,
+           WAIT_WS_ENABLE  = 5'd13,
+           REACCESS        = 5'd14,
+           VICTIM_SWAP     = 5'd15,
+           VICTIM_EVICT    = 5'd16;
 
 // Define INCLUDE_FILE  to point to /includes/params.h. The path should be
 // relative to your simulation/sysnthesis directory. You can add the macro
@@ -169,11 +193,27 @@ input  [ADDRESS_BITS-1:0] snoop_address;
 input  snoop_read;    //snooper is reading data
 input  snoop_modify; //snooper is modifying data
 
+//interface with victim cache
+input  victim_hit;
+input  [SLOT_BITS-1  :0] victim_slot;
+input  [SBITS-1      :0] victim_meta;
+input  [CACHE_WIDTH-1:0] victim_data_in;
+input  [SLOT_BITS-1  :0] victim_replace_slot;
+input  [LINE_BITS-1  :0] victim_replace_line;
+input  [SBITS-1      :0] victim_replace_meta;
+input  [CACHE_WIDTH-1:0] victim_replace_data;
+output [LINE_BITS-1  :0] victim_line;
+output victim_write, victim_invalidate;
+output [SLOT_BITS-1  :0] victim_slot_select;
+output [LINE_BITS-1  :0] victim_write_line;
+output [SBITS-1      :0] victim_meta_data;
+output [CACHE_WIDTH-1:0] victim_data_out;
+
 
 genvar i, byte;
 integer j, k;
 
-reg [3:0] state;
+reg [4:0] state;
 reg [INDEX_BITS-1:0]   reset_counter;
 reg [ADDRESS_BITS-1:0] REQ1_address, REQ2_address;
 reg [DATA_WIDTH-1:0]   REQ1_data   , REQ2_data;
@@ -191,6 +231,11 @@ reg [MSG_BITS-1:0] r_transaction;
 reg [TAG_BITS-1:0] r_tag_out;
 reg [COHERENCE_BITS-1:0] r_coh_bits_from_mem;
 reg reaccess_delay;
+reg [SBITS-1:0] r_evict_meta;
+reg r_snoop_modify;
+reg [SLOT_BITS-1:0] r_victim_wb_slot;
+reg [LINE_BITS-1:0] r_victim_wb_line;
+reg restarted;
 
 wire request, REQ2;
 wire [(ADDRESS_BITS-OFFSET_BITS)-1:0] addr_line, sn_addr_line, wb_addr_line;
@@ -202,6 +247,9 @@ wire [DATA_WIDTH-1:0] line_out_words [CACHE_WORDS-1:0];
 wire stall;
 wire [OFFSET_BITS-1:0] zero_offset;
 wire dirty0;
+wire snoop_busy, swap_now, evict_now, victim_replace_dirty, victim_replace_wb;
+wire fill_arrived, early_restart, fill_ready;
+wire [DATA_WIDTH-1:0] fill_words [CACHE_WORDS-1:0];
 
 //REQ1 and REQ2 addresses shifted to remove the byte offset
 wire [ADDRESS_BITS-1:0] REQ1_word_addr, REQ2_word_addr;
@@ -231,12 +279,39 @@ assign address_tag   = address_shifted[ADDRESS_BITS-1 -: TAG_BITS];
 assign REQ1_offset   = REQ1_word_addr[0 +: OFFSET_BITS];
 assign zero_offset   = 0;
 
+// A snoop that is reading, modifying or just modified the cache. Victim cache
+// swaps and evictions wait for it, the line read in CACHE_ACCESS may be stale.
+assign snoop_busy = snoop_read | snoop_modify | r_snoop_modify;
+assign victim_replace_dirty = victim_replace_meta[SBITS-1] &
+                              victim_replace_meta[SBITS-2];
+// With CLEAN_WRITEBACK valid clean lines are written back too (WB_CLEAN), so
+// an exclusive L2 can keep them.
+assign victim_replace_wb    = victim_replace_meta[SBITS-1] &
+                              (victim_replace_meta[SBITS-2] | CLEAN_WRITEBACK);
+assign swap_now   = VICTIM & (state == VICTIM_SWAP) & victim_hit & ~snoop_busy;
+assign evict_now  = VICTIM & (state == VICTIM_EVICT) & ~snoop_busy &
+                    ~victim_replace_wb;
+
+// Early restart: with CRITICAL_WORD_FIRST loads request their word, which
+// arrives in a beat before the line. The core goes on meanwhile and the next
+// request waits in REQ2. The line is written in UPDATE. Requests behind the
+// load, including ones to the same line, are served after the write. Without
+// CRITICAL_WORD_FIRST loads are answered in UPDATE.
+assign fill_arrived  = (state == WAIT) & ((mem2cache_msg == MEM_RESP) |
+                       (mem2cache_msg == MEM_RESP_S)) & ~(~restarted &
+                       snoop_modify & (sn_addr_line == REQ1_line));
+assign early_restart = CRITICAL_WORD_FIRST & fill_arrived & REQ1_read &
+                       ~restarted;
+assign fill_ready    = (state == WAIT) & restarted & ~REQ2 & ~flush &
+                       ~invalidate;
+
 assign stall = ((REQ1_index == REQ2_index     ) & REQ2 & REQ1_write)    |
                ((REQ1_index == address_index  ) & REQ1_write & request & ready);
 
 generate
   for(i=0; i<CACHE_WORDS; i=i+1)begin: LINEWORDS
     assign line_out_words[i] = data_in0[i*DATA_WIDTH +: DATA_WIDTH];
+    assign fill_words[i]     = mem2cache_data[i*DATA_WIDTH +: DATA_WIDTH];
   end
 endgenerate
 
@@ -272,9 +347,15 @@ always @(posedge clock)begin
     r_cache2mem_msg     <= NO_REQ;
     r_coh_bits_from_mem <= 2'b00;
     reaccess_delay      <= 1'b0;
+    r_evict_meta        <= {SBITS{1'b0}};
+    r_snoop_modify      <= 1'b0;
+    r_victim_wb_slot    <= {SLOT_BITS{1'b0}};
+    r_victim_wb_line    <= {LINE_BITS{1'b0}};
+    restarted           <= 1'b0;
     state               <= RESET;
   end
   else begin
+    r_snoop_modify <= snoop_modify;
     case(state)
       RESET:begin
         if(reset_counter < CACHE_DEPTH-1)begin
@@ -314,6 +395,7 @@ always @(posedge clock)begin
         r_matched_way <= matched_way0;
         r_tag_out     <= tag_in0;
         r_dirty_bit   <= dirty0;
+        r_evict_meta  <= {status_bits0, coh_bits0};
         if((snoop_modify|snoop_read) & REQ1_write)begin
           REQ2_address    <= REQ2 ? REQ2_address    : address;
           REQ2_data       <= REQ2 ? REQ2_data       : data_in;
@@ -404,24 +486,63 @@ always @(posedge clock)begin
           REQ2_address    <= REQ2 ? REQ2_address    : address;
           REQ2_data       <= REQ2 ? REQ2_data       : data_in;
           REQ2_w_byte_en  <= REQ2 ? REQ2_w_byte_en  : w_byte_en;
-          if(REQ1_flush)begin
+          if(VICTIM & snoop_busy & (victim_hit | (status_bits0[STATUS_BITS-1] &
+             ~REQ1_flush & ~REQ1_invalidate)))begin
+            state <= REACCESS;
+          end
+          else if(VICTIM & victim_hit)begin
+            state <= VICTIM_SWAP;
+          end
+          else if(REQ1_flush)begin
             state <= SRV_FLUSH_REQ;
           end
           else if(REQ1_invalidate)begin
             state <= SRV_INVLD_REQ;
           end
+          else if(VICTIM)begin
+            state <= status_bits0[STATUS_BITS-1] ? VICTIM_EVICT : READ_STATE;
+          end
           else begin
-            state <= dirty0 ? WRITE_BACK : READ_STATE;
+            state <= (dirty0 | (CLEAN_WRITEBACK & status_bits0[STATUS_BITS-1]))
+                   ? WRITE_BACK : READ_STATE;
           end
         end
       end
+      VICTIM_SWAP:begin
+        // swap_now exchanges the missing line in the victim cache with the
+        // line it replaces in the L1 cache. The access is retried either way.
+        state <= REACCESS;
+      end
+      VICTIM_EVICT:begin
+        if(snoop_busy)begin
+          state <= REACCESS;
+        end
+        else if(victim_replace_wb)begin
+          // Make room by writing back the modified line in the victim cache.
+          // The access is retried after the write back.
+          r_victim_wb_slot    <= victim_replace_slot;
+          r_victim_wb_line    <= victim_replace_line;
+          r_cache2mem_msg     <= victim_replace_dirty ? WB_REQ : WB_CLEAN;
+          r_cache2mem_address <= {victim_replace_line, zero_offset};
+          for(j=0; j<CACHE_WORDS; j=j+1)begin
+            r_cache2mem_data[j] <= victim_replace_data[j*DATA_WIDTH +: DATA_WIDTH];
+          end
+          state               <= WB_WAIT;
+        end
+        else begin
+          // evict_now moves the replaced line to the victim cache
+          state <= READ_STATE;
+        end
+      end
       READ_STATE:begin
         if(snoop_modify & (sn_addr_line == REQ1_line))begin
           state <= REACCESS;
         end
         else begin
           r_cache2mem_msg     <= REQ1_write ? RFO_BCAST : R_REQ;
-          r_cache2mem_address <= (REQ1_word_addr >> OFFSET_BITS) << OFFSET_BITS;
+          r_cache2mem_address <= (CRITICAL_WORD_FIRST & ~REQ1_write) ?
+                                 REQ1_word_addr :
+                                 (REQ1_word_addr >> OFFSET_BITS) << OFFSET_BITS;
           for(j=0; j<CACHE_WORDS; j=j+1)begin
             r_cache2mem_data[j] <= {DATA_WIDTH{1'b0}};
           end
@@ -429,14 +550,27 @@ always @(posedge clock)begin
         end
       end
       WAIT:begin
-        if(snoop_modify & (sn_addr_line == REQ1_line))begin
+        if(fill_ready & (read | write))begin
+          REQ2_read       <= read;
+          REQ2_write      <= write;
+          REQ2_address    <= address;
+          REQ2_data       <= data_in;
+          REQ2_w_byte_en  <= w_byte_en;
+        end
+        if(snoop_modify & (sn_addr_line == REQ1_line) & ~restarted)begin
           r_cache2mem_msg     <= NO_REQ;
           r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
           state               <= REACCESS;
         end
+        else if(early_restart)begin
+          // Word beat. The bus stays held until the line follows.
+          restarted <= 1'b1;
+          state     <= WAIT;
+        end
         else if((mem2cache_msg == MEM_RESP) | mem2cache_msg == MEM_RESP_S)begin
           r_cache2mem_msg     <= NO_REQ;
           r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
+          restarted           <= 1'b0;
           state               <= UPDATE;
           for(j=0; j<CACHE_WORDS; j=j+1)begin
             r_words_from_mem[j] <= mem2cache_data[j*DATA_WIDTH +: DATA_WIDTH];
@@ -448,7 +582,9 @@ always @(posedge clock)begin
         end
       end
       UPDATE:begin
-        if(snoop_modify & (sn_addr_line == REQ1_line))
+        // Loads got their word already, a retry would answer them again
+        if(snoop_modify & (sn_addr_line == REQ1_line) &
+           ~(CRITICAL_WORD_FIRST & REQ1_read))
           state <= REACCESS;
         else
           state <= WAIT_FOR_ACCESS;
@@ -489,7 +625,7 @@ always @(posedge clock)begin
           state <= REACCESS;
         end
         else begin
-          r_cache2mem_msg     <= WB_REQ;
+          r_cache2mem_msg     <= r_dirty_bit ? WB_REQ : WB_CLEAN;
           r_cache2mem_address <= {r_tag_out, REQ1_index, zero_offset};
           for(j=0; j<CACHE_WORDS; j=j+1)begin
             r_cache2mem_data[j] <= r_line_out[j];
@@ -498,7 +634,8 @@ always @(posedge clock)begin
         end
       end
       WB_WAIT:begin
-        if(snoop_modify & (snoop_index == REQ1_index))begin
+        if(snoop_modify & (VICTIM ? (sn_addr_line == r_victim_wb_line) :
+                                    (snoop_index == REQ1_index)))begin
           r_cache2mem_msg     <= NO_REQ;
           r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
           for(j=0; j<CACHE_WORDS; j=j+1)begin
@@ -512,7 +649,7 @@ always @(posedge clock)begin
           for(j=0; j<CACHE_WORDS; j=j+1)begin
             r_cache2mem_data[j] <= {DATA_WIDTH{1'b0}};
           end
-          state               <= READ_STATE;
+          state               <= VICTIM ? REACCESS : READ_STATE;
         end
         else
           state <= WB_WAIT;
@@ -631,10 +768,12 @@ assign read0 = (((state == IDLE) | (state == CACHE_ACCESS)) & request) |
                (state == WAIT_FOR_ACCESS) | (state == REACCESS);
 
 assign write0 = (state == RESET) | (state == UPDATE) |
-                ((state == WAIT_WS_ENABLE) & (mem2cache_msg == EN_ACCESS));
+                ((state == WAIT_WS_ENABLE) & (mem2cache_msg == EN_ACCESS)) |
+                swap_now;
 
-assign invalidate0 = (mem2cache_msg == MEM_RESP) & ((state == WB_WAIT) |
-                     (state == WAIT_FLUSH_REQ) | (state == WAIT_INVLD_REQ));
+assign invalidate0 = ((mem2cache_msg == MEM_RESP) & (((state == WB_WAIT) &
+                     ~VICTIM) | (state == WAIT_FLUSH_REQ) |
+                     (state == WAIT_INVLD_REQ))) | evict_now;
 
 
 assign tag0 = (state == WAIT_FOR_ACCESS) ? REQ2_tag :
@@ -647,12 +786,14 @@ assign index0 = (state == RESET) ? reset_counter        :
                 address_index : REQ1_index;
 
 
-assign meta_data0 = REQ1_write ? 4'b1110 : {2'b10, r_coh_bits_from_mem};
+assign meta_data0 = (state == VICTIM_SWAP) ? victim_meta :
+                    REQ1_write ? 4'b1110 : {2'b10, r_coh_bits_from_mem};
 
 generate
   for(i=0; i<CACHE_WORDS; i=i+1)begin: DATAOUT0
     for(byte=0; byte<(DATA_WIDTH/8); byte=byte+1) begin: BYTE_LOOP
       assign data_out0[(i*DATA_WIDTH)+(byte*8) +: 8] =
+        (state == VICTIM_SWAP) ? victim_data_in[(i*DATA_WIDTH)+(byte*8) +: 8] :
         REQ1_write & REQ1_w_byte_en[byte] & (i == REQ1_offset) ? REQ1_data[byte*8 +: 8] :
         (state == WAIT_WS_ENABLE) ? r_line_out[i][byte*8 +: 8] : r_words_from_mem[i][byte*8 +: 8];
     end
@@ -679,6 +820,24 @@ endgenerate
 assign way_select1 = matched_way0;
 assign i_reset = reset | (state == RESET);
 
+// Swaps put the replaced L1 line in the slot of the missing line, evictions
+// use the replacement slot and write backs free the written back slot.
+assign victim_line        = REQ1_line;
+assign victim_write       = (swap_now & r_evict_meta[SBITS-1]) | evict_now;
+assign victim_invalidate  = (swap_now & ~r_evict_meta[SBITS-1]) | (VICTIM &
+                            (state == WB_WAIT) & (mem2cache_msg == MEM_RESP));
+assign victim_slot_select = (state == WB_WAIT) ? r_victim_wb_slot :
+                            (state == VICTIM_SWAP) ? victim_slot :
+                            victim_replace_slot;
+assign victim_write_line  = {r_tag_out, REQ1_index};
+assign victim_meta_data   = r_evict_meta;
+
+generate
+  for(i=0; i<CACHE_WORDS; i=i+1)begin: VICTIM_DATA
+    assign victim_data_out[i*DATA_WIDTH +: DATA_WIDTH] = r_line_out[i];
+  end
+endgenerate
+
 assign cache2mem_address = r_cache2mem_address;
 generate
   for(i=0; i<CACHE_WORDS; i=i+1)begin: DATA2MEM
@@ -692,23 +851,27 @@ generate
   if(OFFSET_BITS>0)begin
     assign data_out = (state == CACHE_ACCESS) & hit0 & REQ1_read ?
                       line_out_words[REQ1_offset]
-                    : (state == UPDATE) & REQ1_read ?
+                    : early_restart ? fill_words[REQ1_offset]
+                    : ~CRITICAL_WORD_FIRST & (state == UPDATE) & REQ1_read ?
                       r_words_from_mem[REQ1_offset]
                     : {DATA_WIDTH{1'b0}};
   end
   else begin
     assign data_out = (state == CACHE_ACCESS) & hit0 &
                       REQ1_read ? line_out_words[0]
-                    : (state == UPDATE) & REQ1_read ?
+                    : early_restart ? fill_words[0]
+                    : ~CRITICAL_WORD_FIRST & (state == UPDATE) & REQ1_read ?
                       r_words_from_mem[0]
                     : {DATA_WIDTH{1'b0}};
   end
 endgenerate
 
-assign valid = (((state==CACHE_ACCESS) & hit0) | (state == UPDATE)) & REQ1_read;
+assign valid = ((((state==CACHE_ACCESS) & hit0) | (~CRITICAL_WORD_FIRST &
+               (state == UPDATE))) & REQ1_read) | early_restart;
 
-assign ready = ((state == IDLE) & ~flush & ~invalidate & ~(snoop_modify &
-               (address_index == snoop_index))) | ((state == CACHE_ACCESS) &
+assign ready = fill_ready | ((state == IDLE) & ~flush & ~invalidate &
+               ~(snoop_modify & (address_index == snoop_index))) |
+               ((state == CACHE_ACCESS) &
                ~REQ1_flush & ~REQ1_invalidate & ~REQ2 & ~((snoop_modify |
                snoop_read | (coh_bits0 == SHARED) | (REQ1_index == address_index))
                & REQ1_write) & ~((address_index == snoop_index) & snoop_modify)
@@ -30,7 +30,8 @@ parameter CACHE_OFFSET_BITS =  2, //max offset bits from cache side
           COHERENCE_BITS    =  2,
           STATUS_BITS       =  2,
           NUMBER_OF_WAYS    =  4,
-	        MAX_OFFSET_BITS   =  2
+	        MAX_OFFSET_BITS   =  2,
+          VICTIM_ENTRIES    =  0
 )(
 clock,
 reset,
@@ -59,7 +60,13 @@ bus_msg,
 bus_address,
 req_ready,
 bus_master,
-curr_offset
+curr_offset,
+
+victim_data_in,
+victim_status_bits,
+victim_hit,
+victim_write,
+victim_invalidate
 );
 
 //define the log2 function
@@ -106,6 +113,12 @@ output [SBITS-1         :0] meta_data;
 output [CACHE_WIDTH-1   :0] data_out;
 output [WAY_BITS-1      :0] way_select;
 
+//interface to victim cache, looked up with the same index and tag
+input  [CACHE_WIDTH-1   :0] victim_data_in;
+input  [STATUS_BITS-1   :0] victim_status_bits;
+input  victim_hit;
+output victim_write, victim_invalidate;
+
 //interface to L1 bus interface
 input  [MSG_BITS-1:      0] intf_msg;
 input  [ADDRESS_WIDTH-1: 0] intf_address;
@@ -132,6 +145,8 @@ wire [MAX_OFFSET_BITS  :0] ratio;
 wire wider_transfer, wider_line;
 wire read_req, write_req, flush_req, mflush_req;
 wire dirty;
+wire victim_found, hit_any;
+wire [CACHE_WIDTH-1:0] line_data;
 
 
 reg [2:0] state;
@@ -150,15 +165,22 @@ reg [DATA_WIDTH-1:   0] r_transfer_words;
 reg [ADDRESS_WIDTH-1:0] address_counter;
 reg [MAX_OFFSET_BITS:0] line_counter, word_counter;
 reg [log2(MAX_OFFSET_BITS):0] r_curr_offset;
+reg r_victim_found;
+
 
+// Lines are either in the cache or in its victim cache, never in both
+assign victim_found = (VICTIM_ENTRIES > 0) & victim_hit & ~hit;
+assign hit_any      = hit | victim_found;
+assign line_data    = victim_found ? victim_data_in : data_in;
 
 generate
   for(i=0; i<CACHE_WORDS; i=i+1)begin: SPLIT_CACHE_DATA
-    assign w_cache_data[i] = data_in[i*DATA_WIDTH +: DATA_WIDTH];
+    assign w_cache_data[i] = line_data[i*DATA_WIDTH +: DATA_WIDTH];
   end
 endgenerate
 
-assign dirty = status_bits[STATUS_BITS-2];
+assign dirty = victim_found ? victim_status_bits[STATUS_BITS-2] :
+               status_bits[STATUS_BITS-2];
 
 assign offset_diff = (r_curr_offset > CACHE_OFFSET_BITS) ? 
                      (r_curr_offset - CACHE_OFFSET_BITS) : 0;
@@ -176,8 +198,10 @@ assign flush_req  = (bus_msg == FLUSH_S) & ~bus_master & ~req_ready;
 
 //assign outputs
 assign read = r_read;
-assign write = r_write;
-assign invalidate = r_invalidate;
+assign write = r_write & ~r_victim_found;
+assign invalidate = r_invalidate & ~r_victim_found;
+assign victim_write = r_write & r_victim_found;
+assign victim_invalidate = r_invalidate & r_victim_found;
 assign index = r_index;
 assign tag = r_tag;
 assign meta_data = r_meta_data;
@@ -219,6 +243,7 @@ always @(posedge clock)begin
     r_bus_msg       <= NO_REQ;
     line_counter    <= {(MAX_OFFSET_BITS+1){1'b0}};
     word_counter    <= {MAX_OFFSET_BITS{1'b0}};
+    r_victim_found  <= 1'b0;
     state           <= IDLE;
   end
   else begin
@@ -249,10 +274,11 @@ always @(posedge clock)begin
         for(j=0; j<CACHE_WORDS; j=j+1)begin
           r_snoop_data[j] <= w_cache_data[j];
         end
-        r_way_select <= matched_way;
+        r_way_select   <= matched_way;
+        r_victim_found <= victim_found;
         case(r_bus_msg)
           R_REQ:begin
-            if(hit)begin
+            if(hit_any)begin
               if(dirty)begin
                 r_snoop_msg     <= C_WB;
                 r_snoop_address <= address_counter;
@@ -287,7 +313,7 @@ always @(posedge clock)begin
             end
           end
           RFO_BCAST:begin
-            if(hit)begin
+            if(hit_any)begin
               if(line_counter == ratio)begin
                 r_read          <= 1'b0;
                 r_invalidate    <= 1'b1;
@@ -318,7 +344,7 @@ always @(posedge clock)begin
             end
           end
           WS_BCAST:begin
-            if(hit)begin
+            if(hit_any)begin
               if(line_counter == ratio)begin
                 r_read          <= 1'b0;
                 r_invalidate    <= 1'b1;
@@ -349,7 +375,7 @@ always @(posedge clock)begin
             end
           end
           FLUSH_S:begin
-            if(hit)begin
+            if(hit_any)begin
               if(dirty)begin
                 r_snoop_msg     <= C_FLUSH;
                 r_snoop_address <= address_counter;
@@ -389,7 +415,7 @@ always @(posedge clock)begin
             end
           end
           REQ_FLUSH:begin
-            if(hit)begin
+            if(hit_any)begin
               if(dirty)begin
                 r_snoop_msg     <= C_FLUSH;
                 r_snoop_address <= address_counter;
@@ -435,7 +461,10 @@ always @(posedge clock)begin
       end
       WAIT_FOR_RESP:begin
         r_invalidate <= 1'b0;
-        if(intf_msg == REQ_FLUSH)begin
+        /*A REQ_FLUSH from the Lx cache took the bus before this broadcast was
+        * acknowledged. Drop the EN_ACCESS and snoop the REQ_FLUSH.*/
+        if((intf_msg == REQ_FLUSH) | (mflush_req & (r_bus_msg != REQ_FLUSH) &
+        (r_snoop_msg == EN_ACCESS)))begin
           r_snoop_msg       <= NO_REQ;
           r_snoop_address   <= {ADDRESS_WIDTH{1'b0}};
           for(j=0; j<CACHE_WORDS; j=j+1)begin
@@ -0,0 +1,173 @@
+/** @module : victim_cache
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+* --------------------
+ *  - Small fully associative buffer for lines evicted from an L1 cache.
+ *  - Entries keep the data, line address, status bits and coherence bits of
+ *    the evicted line, so modified lines do not need a write back to stay
+ *    coherent. Lines are exclusive between the L1 cache and this buffer.
+ *  - Port 0 is used by the cache controller. It looks up the missing line,
+ *    swaps lines with the L1 cache, inserts evicted lines and invalidates
+ *    written back entries. write0 and invalidate0 update the entry selected by
+ *    slot_select0.
+ *  - Port 1 is used by the snooper. It looks up the snooped line and updates
+ *    the meta data of or invalidates the matching entry.
+ *  - replace_* describe the entry used for the next insertion: the first
+ *    invalid entry, or a round robin pointer when all entries are valid.
+ *  - Lookups are combinational.
+*/
+
+module victim_cache #(
+parameter STATUS_BITS    =  2,
+          COHERENCE_BITS =  2,
+          OFFSET_BITS    =  2,
+          DATA_WIDTH     = 32,
+          ADDRESS_BITS   = 32,
+          ENTRIES        =  4,
+          //Use default value in module instantiation for following parameters
+          CACHE_WORDS    = 1 << OFFSET_BITS,
+          CACHE_WIDTH    = DATA_WIDTH * CACHE_WORDS,
+          LINE_BITS      = ADDRESS_BITS - OFFSET_BITS,
+          SBITS          = COHERENCE_BITS + STATUS_BITS,
+          SLOT_BITS      = (ENTRIES > 1) ? log2(ENTRIES) : 1
+)(
+input  clock,
+input  reset,
+//port 0
+input  [LINE_BITS-1  :0] line0,
+input  write0,
+input  invalidate0,
+input  [SLOT_BITS-1  :0] slot_select0,
+input  [LINE_BITS-1  :0] write_line0,
+input  [SBITS-1      :0] meta_data0,
+input  [CACHE_WIDTH-1:0] data_in0,
+output [SLOT_BITS-1  :0] matched_slot0,
+output [SBITS-1      :0] meta_out0,
+output [CACHE_WIDTH-1:0] data_out0,
+output hit0,
+output [SLOT_BITS-1  :0] replace_slot,
+output [LINE_BITS-1  :0] replace_line,
+output [SBITS-1      :0] replace_meta,
+output [CACHE_WIDTH-1:0] replace_data,
+//port 1
+input  [LINE_BITS-1     :0] line1,
+input  write1,
+input  invalidate1,
+input  [SBITS-1         :0] meta_data1,
+output [CACHE_WIDTH-1   :0] data_out1,
+output [COHERENCE_BITS-1:0] coh_bits1,
+output [STATUS_BITS-1   :0] status_bits1,
+output hit1
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+integer j;
+
+reg [LINE_BITS-1  :0] lines [ENTRIES-1:0];
+reg [SBITS-1      :0] metas [ENTRIES-1:0];
+reg [CACHE_WIDTH-1:0] datas [ENTRIES-1:0];
+reg [SLOT_BITS-1  :0] next_insert;
+
+reg [SLOT_BITS-1  :0] match0, match1, empty_slot;
+reg found0, found1, found_empty;
+
+// Lookups. Lines are never held by more than one entry.
+always @(*) begin
+  match0      = {SLOT_BITS{1'b0}};
+  match1      = {SLOT_BITS{1'b0}};
+  empty_slot  = {SLOT_BITS{1'b0}};
+  found0      = 1'b0;
+  found1      = 1'b0;
+  found_empty = 1'b0;
+  for(j=ENTRIES-1; j>=0; j=j-1) begin
+    if(metas[j][SBITS-1] & (lines[j] == line0)) begin
+      match0 = j;
+      found0 = 1'b1;
+    end
+    if(metas[j][SBITS-1] & (lines[j] == line1)) begin
+      match1 = j;
+      found1 = 1'b1;
+    end
+    if(~metas[j][SBITS-1]) begin
+      empty_slot  = j;
+      found_empty = 1'b1;
+    end
+  end
+end
+
+assign hit0          = found0;
+assign matched_slot0 = match0;
+assign meta_out0     = metas[match0];
+assign data_out0     = datas[match0];
+
+assign replace_slot = found_empty ? empty_slot : next_insert;
+assign replace_line = lines[replace_slot];
+assign replace_meta = metas[replace_slot];
+assign replace_data = datas[replace_slot];
+
+assign hit1         = found1;
+assign data_out1    = found1 ? datas[match1] : {CACHE_WIDTH{1'b0}};
+assign coh_bits1    = found1 ? metas[match1][0 +: COHERENCE_BITS] :
+                      {COHERENCE_BITS{1'b0}};
+assign status_bits1 = found1 ? metas[match1][SBITS-1 -: STATUS_BITS] :
+                      {STATUS_BITS{1'b0}};
+
+always @(posedge clock) begin
+  if(reset) begin
+    next_insert <= {SLOT_BITS{1'b0}};
+    for(j=0; j<ENTRIES; j=j+1) begin
+      lines[j] <= {LINE_BITS{1'b0}};
+      metas[j] <= {SBITS{1'b0}};
+      datas[j] <= {CACHE_WIDTH{1'b0}};
+    end
+  end
+  else begin
+    if(found1 & invalidate1)
+      metas[match1] <= {SBITS{1'b0}};
+    else if(found1 & write1)
+      metas[match1] <= meta_data1;
+
+    if(invalidate0) begin
+      metas[slot_select0] <= {SBITS{1'b0}};
+    end
+    else if(write0) begin
+      lines[slot_select0] <= write_line0;
+      metas[slot_select0] <= meta_data0;
+      datas[slot_select0] <= data_in0;
+      if(slot_select0 == next_insert)
+        next_insert <= (next_insert == ENTRIES-1) ? {SLOT_BITS{1'b0}} :
+                       next_insert + 1;
+    end
+  end
+end
+
+endmodule
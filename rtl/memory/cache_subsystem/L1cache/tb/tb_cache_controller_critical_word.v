@@ -0,0 +1,411 @@
+/** @module : tb_cache_controller_critical_word
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+// Early restart with CRITICAL_WORD_FIRST: a load miss gets its word from the
+// word beat, and loads and stores to the line that is still on its way are
+// served once the line is written.
+module tb_cache_controller_critical_word();
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+parameter STATUS_BITS           =  2,
+          COHERENCE_BITS        =  2,
+          OFFSET_BITS           =  2,
+          DATA_WIDTH            = 32,
+          NUMBER_OF_WAYS        =  4,
+          ADDRESS_BITS          = 32,
+          INDEX_BITS            =  6,
+          MSG_BITS              =  4,
+          CORE                  =  0,
+          CACHE_NO              =  0;
+
+
+localparam CACHE_WORDS = 1 << OFFSET_BITS; //number of words in one line.
+localparam CACHE_WIDTH = DATA_WIDTH*CACHE_WORDS;
+localparam SBITS       = COHERENCE_BITS + STATUS_BITS;
+localparam TAG_BITS    = ADDRESS_BITS - OFFSET_BITS - INDEX_BITS;
+localparam WAY_BITS    = (NUMBER_OF_WAYS > 1) ? log2(NUMBER_OF_WAYS) : 1;
+
+localparam IDLE            = 4'd0,
+           WAIT            = 4'd6,
+           UPDATE          = 4'd7;
+
+`include `INCLUDE_FILE
+
+
+reg  clock, reset;
+reg  read, write;
+reg  [ADDRESS_BITS-1:0] address;
+reg  [DATA_WIDTH-1:  0] data_in;
+wire [DATA_WIDTH-1:  0] data_out;
+wire [ADDRESS_BITS-1:0] out_address;
+wire ready;
+wire valid;
+
+//interface with cache memory
+wire [CACHE_WIDTH-1   :0] data_in0;
+wire [TAG_BITS-1      :0] tag_in0;
+wire [WAY_BITS-1      :0] matched_way0;
+wire [COHERENCE_BITS-1:0] coh_bits0;
+wire [STATUS_BITS-1   :0] status_bits0;
+wire hit0;
+wire read0, write0, invalidate0;
+wire [INDEX_BITS-1    :0] index0;
+wire [TAG_BITS-1      :0] tag0;
+wire [SBITS-1         :0] meta_data0;
+wire [CACHE_WIDTH-1   :0] data_out0;
+wire [WAY_BITS-1      :0] way_select0;
+
+wire read1, write1, invalidate1;
+wire [INDEX_BITS-1    :0] index1;
+wire [TAG_BITS-1      :0] tag1;
+wire [SBITS-1         :0] meta_data1;
+wire [CACHE_WIDTH-1   :0] data_out1;
+wire [WAY_BITS-1      :0] way_select1;
+wire i_reset;
+
+//interface with bus interface
+reg  [MSG_BITS-1:    0] mem2cache_msg;
+reg  [CACHE_WIDTH-1: 0] mem2cache_data;
+reg  [ADDRESS_BITS-1:0] mem2cache_address;
+wire [MSG_BITS-1:    0] cache2mem_msg;
+wire [CACHE_WIDTH-1: 0] cache2mem_data;
+wire [ADDRESS_BITS-1:0] cache2mem_address;
+
+// valid responses seen
+reg [31:0] responses;
+
+
+//instantiate DUT
+cache_controller #(
+  .STATUS_BITS(STATUS_BITS),
+  .COHERENCE_BITS(COHERENCE_BITS),
+  .OFFSET_BITS(OFFSET_BITS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .NUMBER_OF_WAYS(NUMBER_OF_WAYS),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .INDEX_BITS(INDEX_BITS),
+  .MSG_BITS(MSG_BITS),
+  .CORE(CORE),
+  .CACHE_NO(CACHE_NO),
+  .CRITICAL_WORD_FIRST(1)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .read(read),
+  .write(write),
+  .invalidate(1'b0),
+  .flush(1'b0),
+  .w_byte_en(4'b1111),
+  .address(address),
+  .data_in(data_in),
+  .report(1'b0),
+  .data_out(data_out),
+  .out_address(out_address),
+  .ready(ready),
+  .valid(valid),
+
+  .data_in0(data_in0),
+  .tag_in0(tag_in0),
+  .matched_way0(matched_way0),
+  .coh_bits0(coh_bits0),
+  .status_bits0(status_bits0),
+  .hit0(hit0),
+  .read0(read0),
+  .write0(write0),
+  .invalidate0(invalidate0),
+  .index0(index0),
+  .tag0(tag0),
+  .meta_data0(meta_data0),
+  .data_out0(data_out0),
+  .way_select0(way_select0),
+  .read1(read1),
+  .write1(write1),
+  .invalidate1(invalidate1),
+  .index1(index1),
+  .tag1(tag1),
+  .meta_data1(meta_data1),
+  .data_out1(data_out1),
+  .way_select1(way_select1),
+  .i_reset(i_reset),
+
+  .mem2cache_msg(mem2cache_msg),
+  .mem2cache_data(mem2cache_data),
+  .mem2cache_address(mem2cache_address),
+  .cache2mem_msg(cache2mem_msg),
+  .cache2mem_data(cache2mem_data),
+  .cache2mem_address(cache2mem_address),
+
+  .snoop_address({ADDRESS_BITS{1'b0}}),
+  .snoop_read(1'b0),
+  .snoop_modify(1'b0)
+);
+
+// The cache memory answers the lookups of the controller
+cache_memory #(
+  .STATUS_BITS(STATUS_BITS),
+  .COHERENCE_BITS(COHERENCE_BITS),
+  .OFFSET_BITS(OFFSET_BITS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .NUMBER_OF_WAYS(NUMBER_OF_WAYS),
+  .REPLACEMENT_MODE(1'b0),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .INDEX_BITS(INDEX_BITS),
+  .READ_DURING_WRITE("OLD_DATA")
+) memory (
+  .clock(clock),
+  .reset(i_reset),
+  .read0(read0),
+  .write0(write0),
+  .invalidate0(invalidate0),
+  .index0(index0),
+  .tag0(tag0),
+  .meta_data0(meta_data0),
+  .data_in0(data_out0),
+  .way_select0(way_select0),
+  .data_out0(data_in0),
+  .tag_out0(tag_in0),
+  .matched_way0(matched_way0),
+  .coh_bits0(coh_bits0),
+  .status_bits0(status_bits0),
+  .hit0(hit0),
+  .read1(read1),
+  .write1(write1),
+  .invalidate1(invalidate1),
+  .index1(index1),
+  .tag1(tag1),
+  .meta_data1(meta_data1),
+  .data_in1(data_out1),
+  .way_select1(way_select1),
+  .data_out1(),
+  .tag_out1(),
+  .matched_way1(),
+  .coh_bits1(),
+  .status_bits1(),
+  .hit1(),
+  .report(1'b0)
+);
+
+
+// cycle counter
+reg [31:0] cycles;
+always @(posedge clock)begin
+  cycles <= cycles + 32'd1;
+end
+
+//clock generator
+always
+  #1 clock = ~clock;
+
+
+// test vectors
+initial begin
+  cycles            = 0;
+  clock             = 0;
+  reset             = 0;
+  read              = 0;
+  write             = 0;
+  address           = 0;
+  data_in           = 0;
+  mem2cache_msg     = 0;
+  mem2cache_data    = 0;
+  mem2cache_address = 0;
+
+  repeat(1) @(posedge clock);
+  @(posedge clock) reset <= 1;
+  repeat(10) @(posedge clock);
+  @(posedge clock) reset <= 0;
+  wait(DUT.state == IDLE);
+  repeat(2) @(posedge clock);
+
+  // Load miss to word 2 of line 0x1230
+  @(posedge clock)begin
+    read    <= 1;
+    address <= 32'h00001238;
+  end
+  @(posedge clock)begin
+    read    <= 0;
+    address <= 32'h00000000;
+  end
+
+  wait(cache2mem_msg == R_REQ);
+  @(negedge clock);
+  if(cache2mem_address != (32'h00001238 >> 2))begin
+    $display("\nError: R_REQ for word %h, expected the requested word %h!",
+      cache2mem_address, 32'h00001238 >> 2);
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+  repeat(3) @(posedge clock);
+
+  // Word beat, the requested word in its lane
+  @(posedge clock)begin
+    mem2cache_msg     <= MEM_RESP;
+    mem2cache_address <= 32'h00001238 >> 2;
+    mem2cache_data    <= 128'h00000000_cafe0002_00000000_00000000;
+  end
+  @(negedge clock);
+  if(~valid | (data_out != 32'hcafe0002) | (out_address != 32'h00001238))begin
+    $display("\nError: No early restart on the word beat (valid:%b data:%h)!",
+      valid, data_out);
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+  @(posedge clock)begin
+    mem2cache_msg     <= NO_REQ;
+    mem2cache_address <= 32'h00000000;
+    mem2cache_data    <= 128'd0;
+  end
+
+  // The core goes on: a store and a load to the line in flight
+  @(negedge clock);
+  if(~ready | (DUT.state != WAIT))begin
+    $display("\nError: Cache not ready while the line is in flight!");
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+  @(posedge clock)begin
+    write   <= 1;
+    address <= 32'h00001230;
+    data_in <= 32'h11111111;
+  end
+  @(posedge clock)begin
+    write   <= 0;
+    read    <= 1;
+    address <= 32'h00001234;
+    data_in <= 32'h00000000;
+  end
+  @(negedge clock);
+  if(ready)begin
+    $display("\nError: Cache takes a third request while the line is in flight!");
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+  repeat(2) @(posedge clock);
+
+  // The line follows
+  @(posedge clock)begin
+    mem2cache_msg     <= MEM_RESP;
+    mem2cache_address <= 32'h00001230 >> 2;
+    mem2cache_data    <= 128'ha0000003_cafe0002_a0000001_a0000000;
+  end
+  @(negedge clock);
+  if(valid)begin
+    $display("\nError: The load was answered again with the line!");
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+  @(posedge clock)begin
+    mem2cache_msg     <= NO_REQ;
+    mem2cache_address <= 32'h00000000;
+    mem2cache_data    <= 128'd0;
+  end
+
+  // The load waits until the store is done
+  wait(ready);
+  @(posedge clock)begin
+    read    <= 0;
+    address <= 32'h00000000;
+  end
+  wait(valid);
+  @(negedge clock);
+  if((data_out != 32'ha0000001) | (out_address != 32'h00001234))begin
+    $display("\nError: Load of the filled line returned %h from %h!", data_out,
+      out_address);
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+
+  // The stored word and the critical word are in the line
+  wait(ready);
+  @(posedge clock)begin
+    read    <= 1;
+    address <= 32'h00001230;
+  end
+  @(posedge clock)begin
+    read    <= 0;
+    address <= 32'h00000000;
+  end
+  wait(valid);
+  @(negedge clock);
+  if(data_out != 32'h11111111)begin
+    $display("\nError: Store to the line in flight lost, read %h!", data_out);
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+  wait(ready);
+  @(posedge clock)begin
+    read    <= 1;
+    address <= 32'h00001238;
+  end
+  @(posedge clock)begin
+    read    <= 0;
+    address <= 32'h00000000;
+  end
+  wait(valid);
+  @(negedge clock);
+  if(data_out != 32'hcafe0002)begin
+    $display("\nError: Critical word read back as %h!", data_out);
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+  @(negedge clock);
+  if((responses != 4) | (cache2mem_msg != NO_REQ))begin
+    $display("\nError: %0d responses, expected 4!", responses);
+    $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+    $stop;
+  end
+
+  #10;
+  $display("\ntb_cache_controller_critical_word --> Test Passed!\n\n");
+  $stop();
+end
+
+//timeout
+initial begin
+  #2000;
+  $display("\ntb_cache_controller_critical_word --> Test Failed!\n\n");
+  $stop;
+end
+
+
+//count and print values returned by the cache
+always @(posedge clock)begin
+  if(reset)
+    responses <= 0;
+  else if(valid)begin
+    responses <= responses + 1;
+    $display("%0d> Data word returned:%h | Address:%h", cycles-1, data_out,
+      out_address);
+  end
+end
+
+
+endmodule
@@ -0,0 +1,210 @@
+/** @module : tb_victim_cache
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_victim_cache();
+
+task print_state;
+  begin
+    $display("Line0         :%h", line0);
+    $display("Hit0          :%b", hit0);
+    $display("Matched slot0 :%0d", matched_slot0);
+    $display("Meta out0     :%b", meta_out0);
+    $display("Replace slot  :%0d", replace_slot);
+    $display("Replace meta  :%b", replace_meta);
+    $display("Line1         :%h", line1);
+    $display("Hit1          :%b", hit1);
+    $display("Status bits1  :%b", status_bits1);
+    $display("Coh bits1     :%b", coh_bits1);
+  end
+endtask
+
+parameter STATUS_BITS    =  2;
+parameter COHERENCE_BITS =  2;
+parameter OFFSET_BITS    =  2;
+parameter DATA_WIDTH     = 32;
+parameter ADDRESS_BITS   = 32;
+parameter ENTRIES        =  2;
+
+localparam CACHE_WIDTH = DATA_WIDTH << OFFSET_BITS;
+localparam LINE_BITS   = ADDRESS_BITS - OFFSET_BITS;
+localparam SBITS       = STATUS_BITS + COHERENCE_BITS;
+
+reg clock;
+reg reset;
+reg [LINE_BITS-1  :0] line0;
+reg write0;
+reg invalidate0;
+reg slot_select0;
+reg [LINE_BITS-1  :0] write_line0;
+reg [SBITS-1      :0] meta_data0;
+reg [CACHE_WIDTH-1:0] data_in0;
+wire matched_slot0;
+wire [SBITS-1      :0] meta_out0;
+wire [CACHE_WIDTH-1:0] data_out0;
+wire hit0;
+wire replace_slot;
+wire [LINE_BITS-1  :0] replace_line;
+wire [SBITS-1      :0] replace_meta;
+wire [CACHE_WIDTH-1:0] replace_data;
+reg [LINE_BITS-1  :0] line1;
+reg write1;
+reg invalidate1;
+reg [SBITS-1      :0] meta_data1;
+wire [CACHE_WIDTH-1   :0] data_out1;
+wire [COHERENCE_BITS-1:0] coh_bits1;
+wire [STATUS_BITS-1   :0] status_bits1;
+wire hit1;
+
+// Instantiate DUT
+victim_cache #(
+  .STATUS_BITS(STATUS_BITS),
+  .COHERENCE_BITS(COHERENCE_BITS),
+  .OFFSET_BITS(OFFSET_BITS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .ENTRIES(ENTRIES)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .line0(line0),
+  .write0(write0),
+  .invalidate0(invalidate0),
+  .slot_select0(slot_select0),
+  .write_line0(write_line0),
+  .meta_data0(meta_data0),
+  .data_in0(data_in0),
+  .matched_slot0(matched_slot0),
+  .meta_out0(meta_out0),
+  .data_out0(data_out0),
+  .hit0(hit0),
+  .replace_slot(replace_slot),
+  .replace_line(replace_line),
+  .replace_meta(replace_meta),
+  .replace_data(replace_data),
+  .line1(line1),
+  .write1(write1),
+  .invalidate1(invalidate1),
+  .meta_data1(meta_data1),
+  .data_out1(data_out1),
+  .coh_bits1(coh_bits1),
+  .status_bits1(status_bits1),
+  .hit1(hit1)
+);
+
+// generate clock
+always #5 clock = ~clock;
+
+initial begin
+  clock       = 1'b1;
+  reset       = 1'b1;
+  line0       = 30'h10;
+  write0      = 1'b0;
+  invalidate0 = 1'b0;
+  slot_select0 = 1'b0;
+  write_line0 = 30'h0;
+  meta_data0  = 4'b0000;
+  data_in0    = {CACHE_WIDTH{1'b0}};
+  line1       = 30'h20;
+  write1      = 1'b0;
+  invalidate1 = 1'b0;
+  meta_data1  = 4'b0000;
+
+  #21;
+  reset = 1'b0;
+  #1;
+  if(hit0 | hit1 | (replace_slot != 0) | (replace_meta != 4'b0000))begin
+    $display("\ntb_victim_cache --> Test Failed!\n\n");
+    print_state();
+    $stop;
+  end
+
+  // Insert modified line 0x10 in the first empty slot
+  write0       = 1'b1;
+  slot_select0 = replace_slot;
+  write_line0  = 30'h10;
+  meta_data0   = 4'b1111;
+  data_in0     = 128'h44444444_33333333_22222222_11111111;
+  #10;
+  write0 = 1'b0;
+  #1;
+  if(~hit0 | (matched_slot0 != 0) | (meta_out0 != 4'b1111) |
+     (data_out0 != 128'h44444444_33333333_22222222_11111111) |
+     (replace_slot != 1))begin
+    $display("\ntb_victim_cache --> Test Failed!\n\n");
+    print_state();
+    $stop;
+  end
+
+  // Insert exclusive line 0x20. The buffer is full, the next replacement is
+  // the first insertion.
+  write0       = 1'b1;
+  slot_select0 = replace_slot;
+  write_line0  = 30'h20;
+  meta_data0   = 4'b1001;
+  data_in0     = 128'h88888888_77777777_66666666_55555555;
+  #10;
+  write0 = 1'b0;
+  #1;
+  if(~hit1 | (status_bits1 != 2'b10) | (coh_bits1 != 2'b01) |
+     (data_out1 != 128'h88888888_77777777_66666666_55555555) |
+     (replace_slot != 0) | (replace_line != 30'h10) |
+     (replace_meta != 4'b1111))begin
+    $display("\ntb_victim_cache --> Test Failed!\n\n");
+    print_state();
+    $stop;
+  end
+
+  // Snooper downgrades line 0x20 and invalidates line 0x10
+  write1     = 1'b1;
+  meta_data1 = 4'b1011;
+  #10;
+  write1      = 1'b0;
+  line1       = 30'h10;
+  invalidate1 = 1'b1;
+  #10;
+  invalidate1 = 1'b0;
+  line0       = 30'h20;
+  #1;
+  if(hit1 | ~hit0 | (matched_slot0 != 1) | (meta_out0 != 4'b1011) |
+     (replace_slot != 0) | (replace_meta != 4'b0000))begin
+    $display("\ntb_victim_cache --> Test Failed!\n\n");
+    print_state();
+    $stop;
+  end
+
+  // Controller invalidates the swapped out line 0x20
+  invalidate0  = 1'b1;
+  slot_select0 = 1'b1;
+  #10;
+  invalidate0 = 1'b0;
+  #1;
+  if(hit0)begin
+    $display("\ntb_victim_cache --> Test Failed!\n\n");
+    print_state();
+    $stop;
+  end
+
+  $display("\ntb_victim_cache --> Test Passed!\n\n");
+  $stop;
+end
+
+endmodule
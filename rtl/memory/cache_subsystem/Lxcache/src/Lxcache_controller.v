@@ -50,6 +50,21 @@
     *  MEM_SIDE: Indicate the type of coherence mechanism on the memory side.
     *     - DIR  : Directory based coherence
     *     - SNOOP: Snooping on a shared bus
+    *  EXCLUSION: Victim cache style (exclusive) last level cache. Requires
+    *     INCLUSION = 0 and LAST_LEVEL = 1, and L(x-1) caches that write back
+    *     clean lines with WB_CLEAN.
+    *     - Line fills for the L(x-1) caches are not allocated.
+    *     - Lines written back by the L(x-1) caches (WB_REQ, WB_CLEAN, C_WB)
+    *       are allocated. A dirty victim is written back first.
+    *     - A read hit moves a clean line up and invalidates it. Dirty lines
+    *       stay because the L(x-1) copy is clean. Read responses are always
+    *       shared because clean copies may still be in other L(x-1) caches.
+    *     - RFO_BCAST and WS_BCAST hits invalidate the line. The writing
+    *       L(x-1) cache owns the only copy afterwards.
+    *  CRITICAL_WORD_FIRST: Every R_REQ is answered with two responses, a beat
+    *     with the requested word followed by the line. Misses forward the
+    *     word beat of the memory side as soon as it arrives. Requires
+    *     LAST_LEVEL = 1 and a main_memory_interface with the same setting.
   *
   *  I/O ports
   *  ---------
@@ -69,6 +84,8 @@ parameter STATUS_BITS      = 3, // Valid bit + Dirty bit + include
           MSG_BITS         = 4,
           LAST_LEVEL       = 0,
           MEM_SIDE         = "DIR",
+          EXCLUSION        = 0,
+          CRITICAL_WORD_FIRST = 0,
           //Do not modify this parameter unless you undestand the memory subsystem
 		      //latencies clearly
 		      REISSUE_COUNT    = 1000,
@@ -142,7 +159,8 @@ localparam IDLE           = 4'd0,
            FLUSH_WAIT     = 4'd10,
            WAIT_WS_ENABLE = 4'd11,
            RESET          = 4'd12,
-           BACKOFF        = 4'd13;
+           BACKOFF        = 4'd13,
+           RESPOND_LINE   = 4'd14; //line after the word beat of a hit
 
 `include `INCLUDE_FILE
 
@@ -170,6 +188,7 @@ reg [ADDRESS_BITS-1:0] recall_address;
 reg recall_invalidate;
 reg own_flush_req;
 reg [ADDRESS_BITS-1:0] own_flush_req_addr;
+reg word_sent;
 
 
 wire request, mem_request, mem_response;
@@ -179,6 +198,10 @@ wire [DATA_WIDTH-1:0] w_read_data [CACHE_WORDS-1:0];
 wire [DATA_WIDTH-1:0] w_mem_data  [CACHE_WORDS-1:0];
 wire collision;
 wire response_address_match;
+wire [ADDRESS_BITS-1:0] fill_address;
+wire allocate_wb;
+wire [MBITS-1:0] allocate_meta;
+wire [MSG_BITS-1:0] allocate_resp;
 
 
 //assignments
@@ -189,7 +212,7 @@ assign coh_request = (msg_in == C_WB) | (msg_in == C_FLUSH);
 assign request = (msg_in == WB_REQ   ) | (msg_in == R_REQ)    |
                  (msg_in == RFO_BCAST) | (msg_in == FLUSH)    |
                  (msg_in == EN_ACCESS) | (msg_in == WS_BCAST) |
-                 coh_request           ;
+                 (msg_in == WB_CLEAN ) | coh_request          ;
 
 assign mem_request = (mem2cache_msg == REQ_FLUSH) | (mem2cache_msg == FwdGetS);
 
@@ -202,6 +225,20 @@ assign mem_response = (mem2cache_msg == MEM_RESP) | (mem2cache_msg == MEM_C_RESP
 assign collision = (r_address[ADDRESS_BITS-1:OFFSET_BITS] == mem_intf_address
                    [ADDRESS_BITS-1:OFFSET_BITS]) & mem_intf_address_valid;
 
+/*Line fills of the last level keep the offset of the requested L(x-1) line,
+* so the main memory interface reads that part of the line first. Other levels
+* request aligned lines because bus interfaces use the offset bits.*/
+assign fill_address = LAST_LEVEL ? r_address :
+                      {r_address[ADDRESS_BITS-1:OFFSET_BITS], {OFFSET_BITS{1'b0}}};
+
+/*An exclusive cache allocates the lines written back by the L(x-1) caches
+* when they miss. The victim way is the matched way of the miss.*/
+assign allocate_wb   = EXCLUSION & ~r_hit & ((r_msg == WB_REQ) |
+                       (r_msg == WB_CLEAN) | (r_msg == C_WB));
+assign allocate_meta = (r_msg == WB_CLEAN) ? {3'b100, EXCLUSIVE} :
+                       {3'b110, MODIFIED};
+assign allocate_resp = (r_msg == C_WB) ? MEM_C_RESP : MEM_RESP;
+
 generate
   for(i=0; i<CACHE_WORDS; i=i+1)begin:SEPARATE_INPUTS
     assign w_data_in[i]   = data_in[i*DATA_WIDTH +: DATA_WIDTH];
@@ -237,6 +274,7 @@ always @(posedge clock)begin
     recall_address        <= {ADDRESS_BITS{1'b0}};
     own_flush_req         <= 1'b0;
     own_flush_req_addr    <= {ADDRESS_BITS{1'b0}};
+    word_sent             <= 1'b0;
     for(j=0; j<CACHE_WORDS; j=j+1)begin
       r_data[j]           <= {DATA_WIDTH{1'b0}};
       r_data_out[j]       <= {DATA_WIDTH{1'b0}};
@@ -308,26 +346,61 @@ always @(posedge clock)begin
       SERVING:begin
         if(collision)
           state <= BACKOFF;
+        else if(allocate_wb)begin
+          if(r_valid & r_dirty)begin
+          /*Write back the victim first. r_data0 keeps the line to allocate.*/
+            r_cache2mem_msg     <= WB_REQ;
+            r_cache2mem_address <= {r_tag, r_address[OFFSET_BITS +: 
+                                   INDEX_BITS], {OFFSET_BITS{1'b0}}};
+            for(j=0; j<CACHE_WORDS; j=j+1)begin
+              r_data[j]  <= r_data_out[j];
+              r_data0[j] <= r_data[j];
+            end
+            state               <= WRITE_BACK;
+          end
+          else begin
+            write         <= 1'b1;
+            r_tag_out     <= r_address[ADDRESS_BITS-1 -: TAG_BITS];
+            r_way_select  <= r_matched_way;
+            r_meta_data   <= allocate_meta;
+            r_msg_out     <= allocate_resp;
+            for(j=0; j<CACHE_WORDS; j=j+1)begin
+              r_data0[j] <= r_data[j];
+            end
+            state         <= RESPOND;
+          end
+        end
         else begin
           case(r_msg)
             R_REQ:begin
               if(r_hit)begin
-                r_msg_out    <= (r_include | r_coh_bits == SHARED) ? MEM_RESP_S 
-                              : MEM_RESP;
-                write        <= 1'b1;
+                r_msg_out    <= (EXCLUSION | r_include | r_coh_bits == SHARED) ?
+                                MEM_RESP_S : MEM_RESP;
+                /*An exclusive cache moves clean lines up.*/
+                write        <= (EXCLUSION == 0) | r_dirty;
+                invalidate   <= EXCLUSION & ~r_dirty;
                 r_tag_out    <= r_tag;
                 r_way_select <= r_matched_way;
-                r_meta_data  <= {1'b1, r_dirty, 1'b1, r_coh_bits};
+                r_meta_data  <= {1'b1, r_dirty, (EXCLUSION == 0), r_coh_bits};
                 for(j=0; j<CACHE_WORDS; j=j+1)begin
                   r_data[j]  <= r_data_out[j];
                   r_data0[j] <= r_data_out[j];
                 end
-                state <= RESPOND;
+                /*The response is held one more cycle to send the line after
+                * the word beat.*/
+                state <= CRITICAL_WORD_FIRST ? RESPOND_LINE : RESPOND;
+              end
+              else if(EXCLUSION)begin
+              /*Line fills are not allocated.*/
+                r_cache2mem_msg     <= r_msg;
+                r_cache2mem_address <= fill_address;
+                state               <= READ_WAIT;
               end
               else begin
                 if(r_include)begin
                   r_msg_out                             <= REQ_FLUSH;
-                  r_address[ADDRESS_BITS-1 -: TAG_BITS] <= r_tag;
+                  r_address                             <= {r_tag,
+                      r_address[OFFSET_BITS +: INDEX_BITS], {OFFSET_BITS{1'b0}}};
                   own_flush_req                         <= 1'b1;
                   own_flush_req_addr                    <= {r_tag, 
                   r_address[OFFSET_BITS +: INDEX_BITS], {OFFSET_BITS{1'b0}}};
@@ -351,8 +424,7 @@ always @(posedge clock)begin
                   end
                   else begin //not a valid line
                     r_cache2mem_msg     <= R_REQ;
-                    r_cache2mem_address <= {r_address[ADDRESS_BITS-1:OFFSET_BITS], 
-                                           {OFFSET_BITS{1'b0}}};
+                    r_cache2mem_address <= fill_address;
                     state               <= READ_WAIT;
                   end
                 end
@@ -362,7 +434,16 @@ always @(posedge clock)begin
               if(r_hit)begin
               /*line can already be in another Lx cache. Action depends on the
               * line's coherence state.*/
-                if(r_coh_bits == MODIFIED | r_coh_bits == EXCLUSIVE)begin
+                if(EXCLUSION)begin
+                /*The snoopers invalidated the other L(x-1) copies. The
+                * requester writes back the modified line later.*/
+                  r_msg_out    <= MEM_RESP;
+                  invalidate   <= 1'b1;
+                  r_tag_out    <= r_tag;
+                  r_way_select <= r_matched_way;
+                  state        <= RESPOND;
+                end
+                else if(r_coh_bits == MODIFIED | r_coh_bits == EXCLUSIVE)begin
                   r_msg_out    <= MEM_RESP;
                   write        <= 1'b1;
                   r_tag_out    <= r_tag;
@@ -381,10 +462,17 @@ always @(posedge clock)begin
                   state               <= WAIT_WS_ENABLE;
                 end
               end
+              else if(EXCLUSION)begin
+              /*Line fills are not allocated.*/
+                r_cache2mem_msg     <= r_msg;
+                r_cache2mem_address <= fill_address;
+                state               <= READ_WAIT;
+              end
               else begin
                 if(r_include)begin
                   r_msg_out                             <= REQ_FLUSH;
-                  r_address[ADDRESS_BITS-1 -: TAG_BITS] <= r_tag;
+                  r_address                             <= {r_tag,
+                      r_address[OFFSET_BITS +: INDEX_BITS], {OFFSET_BITS{1'b0}}};
                   own_flush_req                         <= 1'b1;
                   own_flush_req_addr                    <= {r_tag, 
                       r_address[OFFSET_BITS +: INDEX_BITS], {OFFSET_BITS{1'b0}}};
@@ -408,8 +496,7 @@ always @(posedge clock)begin
                   end
                   else begin
                     r_cache2mem_msg     <= RFO_BCAST;
-                    r_cache2mem_address <= {r_address[ADDRESS_BITS-1:OFFSET_BITS], 
-                                           {OFFSET_BITS{1'b0}}};
+                    r_cache2mem_address <= fill_address;
                     state               <= READ_WAIT;
                   end
                 end
@@ -440,6 +527,11 @@ always @(posedge clock)begin
                 state               <= WRITE_BACK;
               end
             end
+            WB_CLEAN:begin
+            /*Misses are allocated above. A hit already has the same data.*/
+              r_msg_out <= MEM_RESP;
+              state     <= RESPOND;
+            end
             FLUSH:begin
               /*No checking for hit because both inclusive and non-inclusive 
               * behavior does the same here. Since the L1 cache issuing the
@@ -512,6 +604,9 @@ always @(posedge clock)begin
                 r_cache2mem_msg     <= C_FLUSH;
                 r_cache2mem_address <= {r_address[ADDRESS_BITS-1 : OFFSET_BITS], 
                                        {OFFSET_BITS{1'b0}}};
+                for(j=0; j<CACHE_WORDS; j=j+1)begin
+                  r_data[j]         <= r_data_out[j];
+                end
                 invalidate          <= 1'b1;
                 r_tag_out           <= r_tag;
                 r_way_select        <= r_matched_way;
@@ -527,6 +622,13 @@ always @(posedge clock)begin
                 state               <= RESPOND;
                 /*interface cannot be busy. Handling request from interface.*/
               end
+              else begin
+              /*Line was evicted after the interface checked for the hit.*/
+                r_cache2mem_msg     <= EN_ACCESS;
+                r_cache2mem_address <= {r_address[ADDRESS_BITS-1 : OFFSET_BITS], 
+                                       {OFFSET_BITS{1'b0}}};
+                state               <= RESPOND;
+              end
             end
             FwdGetS:begin
               if(r_include)begin
@@ -560,7 +662,7 @@ always @(posedge clock)begin
                 r_cache2mem_msg     <= EN_ACCESS;
                 r_cache2mem_address <= {r_address[ADDRESS_BITS-1 : OFFSET_BITS], 
                                        {OFFSET_BITS{1'b0}}};
-                write               <= 1'b1;
+                write               <= r_hit; //matched way is the victim on a miss
                 r_tag_out           <= r_tag;
                 r_way_select        <= r_matched_way;
                 r_meta_data         <= r_hit ? {3'b100, SHARED} : {3'b000, INVALID};
@@ -581,6 +683,13 @@ always @(posedge clock)begin
                   r_data[j]         <= r_data_out[j];
                 end
                 invalidate          <= recall_invalidate;
+                /*A recall for FwdGetS keeps a clean shared copy. The data is
+                * written back to the memory side with the C_FLUSH.*/
+                write               <= ~recall_invalidate & r_hit;
+                r_meta_data         <= {3'b100, SHARED};
+                for(j=0; j<CACHE_WORDS; j=j+1)begin
+                  r_data0[j]        <= r_data_out[j];
+                end
                 r_tag_out           <= r_tag;
                 r_way_select        <= r_matched_way;
                 r_msg_out           <= MEM_RESP; //This response is required by the 
@@ -612,7 +721,15 @@ always @(posedge clock)begin
               end
             end
             WS_BCAST:begin
-              if(r_hit)begin //inclusive cache
+              if(r_hit & EXCLUSION)begin
+              /*The writer owns the only copy after the upgrade.*/
+                r_msg_out    <= EN_ACCESS;
+                invalidate   <= 1'b1;
+                r_tag_out    <= r_tag;
+                r_way_select <= r_matched_way;
+                state        <= RESPOND;
+              end
+              else if(r_hit)begin //inclusive cache
                 if(r_coh_bits == MODIFIED)begin
                   r_msg_out    <= EN_ACCESS;
                   state        <= RESPOND;  
@@ -636,10 +753,10 @@ always @(posedge clock)begin
                 end
               end
               else begin
-              /*Exclusive cache behavior not fully supported. Review and update in 
-              * later iteration.*/
+              /*Not cached here. RESPOND clears EN_ACCESS after the interface
+              * read it.*/
                 r_msg_out <= EN_ACCESS;
-                state     <= IDLE;
+                state     <= RESPOND;
               end
             end
             default:begin
@@ -654,6 +771,17 @@ always @(posedge clock)begin
           r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
           state               <= IDLE;
         end
+        else if(allocate_wb & (mem2cache_msg == MEM_RESP))begin
+        /*Victim written back. Allocate the line kept in r_data0.*/
+          r_cache2mem_msg     <= NO_REQ;
+          r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
+          write               <= 1'b1;
+          r_tag_out           <= r_address[ADDRESS_BITS-1 -: TAG_BITS];
+          r_way_select        <= r_matched_way;
+          r_meta_data         <= allocate_meta;
+          r_msg_out           <= allocate_resp;
+          state               <= RESPOND;
+        end
         else if(mem2cache_msg == MEM_RESP)begin
           r_cache2mem_msg     <= NO_REQ;
           r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
@@ -671,16 +799,26 @@ always @(posedge clock)begin
       READ_STATE:begin
         invalidate          <= 1'b0;
         r_cache2mem_msg     <= r_msg; //R_REQ or RFO_BCAST
-        r_cache2mem_address <= {r_address[ADDRESS_BITS-1:OFFSET_BITS],
-                               {OFFSET_BITS{1'b0}}};
+        r_cache2mem_address <= fill_address;
         state               <= READ_WAIT;
       end
       READ_WAIT:begin
         if(mem_request)begin
           r_cache2mem_msg     <= NO_REQ;
           r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
+          word_sent           <= 1'b0;
           state               <= IDLE;
         end
+        else if(CRITICAL_WORD_FIRST & (r_msg == R_REQ) & ~word_sent &
+        (mem2cache_msg == MEM_RESP | mem2cache_msg == MEM_RESP_S))begin
+        /*Word beat. Pass it on and keep waiting for the line.*/
+          for(j=0; j<CACHE_WORDS; j=j+1)begin
+            r_data_out[j] <= w_mem_data[j];
+          end
+          r_msg_out           <= EXCLUSION ? MEM_RESP_S : mem2cache_msg;
+          word_sent           <= 1'b1;
+          state               <= READ_WAIT;
+        end
         else if(mem2cache_msg == MEM_RESP | mem2cache_msg == MEM_RESP_S)begin
           for(j=0; j<CACHE_WORDS; j=j+1)begin
             r_data[j]     <= w_mem_data[j];
@@ -694,17 +832,21 @@ always @(posedge clock)begin
           /*If the line is fetched by a RFO_BCAST message, set the coherence
           * state to MODIFIED because the L(x-1) cache will modify it 
           * immediately.*/
-          write               <= 1'b1;
+          write               <= (EXCLUSION == 0);
           r_cache2mem_msg     <= NO_REQ;
           r_cache2mem_address <= {ADDRESS_BITS{1'b0}};
-          r_msg_out           <= mem2cache_msg;
+          r_msg_out           <= (EXCLUSION & (r_msg == R_REQ)) ? MEM_RESP_S :
+                                 mem2cache_msg;
           for(j=0; j<CACHE_WORDS; j=j+1)begin
             r_data0[j] <= w_mem_data[j];
           end
+          word_sent           <= 1'b0;
           state               <= RESPOND;
         end
-        else
-          state <= READ_WAIT;
+        else begin
+          r_msg_out           <= word_sent ? NO_REQ : r_msg_out;
+          state               <= READ_WAIT;
+        end
       end
       EVICT_WAIT:begin
         if(mem_request)begin
@@ -761,6 +903,11 @@ always @(posedge clock)begin
         else
           state <= WAIT_WS_ENABLE;
       end
+      RESPOND_LINE:begin
+        write                 <= 1'b0;
+        invalidate            <= 1'b0;
+        state                 <= RESPOND;
+      end
       RESPOND:begin
         write                 <= 1'b0;
         invalidate            <= 1'b0;
@@ -51,6 +51,10 @@ parameter STATUS_BITS         = 3, // Valid bit + Dirty bit + include
           MSG_BITS            = 4,
           LAST_LEVEL          = 1,
           MEM_SIDE            = "SNOOP",
+          EXCLUSION           = 0, //victim cache style last level, see
+                                   //Lxcache_controller
+          CRITICAL_WORD_FIRST = 0, //word beat before the line, see
+                                   //Lxcache_controller
           //Use default value in module instantiation for following parameters
           CACHE_WORDS         = 1 << CACHE_OFFSET_BITS,
           CACHE_WIDTH         = DATA_WIDTH * CACHE_WORDS,
@@ -148,7 +152,9 @@ Lxcache_controller #(
   .INDEX_BITS(INDEX_BITS),
   .MSG_BITS(MSG_BITS),
   .LAST_LEVEL(LAST_LEVEL),
-  .MEM_SIDE(MEM_SIDE)
+  .MEM_SIDE(MEM_SIDE),
+  .EXCLUSION(EXCLUSION),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) controller (
   .clock(clock),
   .reset(reset),
@@ -197,7 +203,8 @@ lx_bus_interface #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_WIDTH(ADDRESS_BITS),
   .MSG_BITS(MSG_BITS),
-  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+  .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) bus_intf (
   .clock(clock),
   .reset(reset),
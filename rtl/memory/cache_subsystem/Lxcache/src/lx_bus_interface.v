@@ -32,6 +32,9 @@
  *  ----------
    *  MAX_OFFSET_BITS: Offset bits corresponding to the widest cache lines in
    *  the caches connected to the shared bus.
+   *  CRITICAL_WORD_FIRST: R_REQ addresses carry the requested word. The Lx
+   *  cache answers with a word beat and then the line, and both go out on
+   *  the bus. The L(x-1) lines must not be wider than the Lx lines.
 **/
 
 
@@ -41,7 +44,8 @@ parameter CACHE_OFFSET_BITS =  2, //max offset bits from cache side
           DATA_WIDTH        = 32,
           ADDRESS_WIDTH     = 32,
           MSG_BITS          =  4,
-          MAX_OFFSET_BITS   =  3
+          MAX_OFFSET_BITS   =  3,
+          CRITICAL_WORD_FIRST = 0
 )(
 clock,
 reset,
@@ -95,7 +99,8 @@ localparam IDLE            = 4'd0 ,
            WAIT_FOR_RESP   = 4'd7 ,
            WAIT_BUS_CLEAR  = 4'd8 ,
            WAIT_FLUSH_RESP = 4'd9 , 
-           GET_BUS         = 4'd10;
+           GET_BUS         = 4'd10,
+           WORD_BEAT       = 4'd11;
 
 `include `INCLUDE_FILE
 
@@ -138,6 +143,7 @@ reg [DATA_WIDTH-1:0] curr_data [MAX_WORDS-1:0];
 reg [MAX_OFFSET_BITS-1:0] r_req_offset;
 
 reg shared_line;
+reg word_sent, line_ready;
 
 reg flush_active;
 reg [ADDRESS_WIDTH-1:0] flush_address;
@@ -182,14 +188,16 @@ generate
 endgenerate
 
 assign cache_req = (bus_msg_in == R_REQ) | (bus_msg_in == WB_REQ   ) |
-                   (bus_msg_in == FLUSH) | (bus_msg_in == RFO_BCAST) ;
+                   (bus_msg_in == FLUSH) | (bus_msg_in == RFO_BCAST) |
+                   (bus_msg_in == WB_CLEAN);
 
 assign upgrade_req = (bus_msg_in == WS_BCAST);
 
 assign coh_req     = (bus_msg_in == C_WB) | (bus_msg_in == C_FLUSH);
 
 assign read_req    = (bus_msg_in == R_REQ) | (bus_msg_in == RFO_BCAST);
-assign receive_req = (bus_msg_in == WB_REQ) | (bus_msg_in == FLUSH) | coh_req;
+assign receive_req = (bus_msg_in == WB_REQ) | (bus_msg_in == FLUSH) |
+                     (bus_msg_in == WB_CLEAN) | coh_req;
 
 
 /*FSM*/
@@ -206,6 +214,8 @@ always @(posedge clock)begin
     curr_offset         <= {CACHE_OFFSET_BITS{1'b0}};
     r_req_offset        <= {MAX_OFFSET_BITS{1'b0}};
 	  shared_line         <= 1'b0;
+    word_sent           <= 1'b0;
+    line_ready          <= 1'b0;
     flush_active        <= 1'b0;
     flush_address       <= {ADDRESS_WIDTH{1'b0}};
     pending_requests    <= 1'b0;
@@ -239,8 +249,12 @@ always @(posedge clock)begin
         else if((cache_req & req_ready) | coh_req | upgrade_req)begin
           curr_msg        <= bus_msg_in;
           curr_address    <= bus_address_in;
-          curr_offset     <= bus_address_in[0 +: CACHE_OFFSET_BITS];
+          /*The requested line starts the part of the Lx line to send back.*/
+          curr_offset     <= CRITICAL_WORD_FIRST ? (bus_address_in >> req_offset)
+                             << req_offset : bus_address_in;
           r_req_offset    <= req_offset;
+          word_sent       <= 1'b0;
+          line_ready      <= 1'b0;
           if(receive_req)begin
             block_counter <= 1;
             word_counter  <= 0;
@@ -387,12 +401,27 @@ always @(posedge clock)begin
       SEND_ADDR:begin
         pending_requests    <= 1'b0;
         r_cache_msg_out     <= curr_msg;
-        r_cache_address_out <= ((curr_address >> CACHE_OFFSET_BITS) <<
-                               CACHE_OFFSET_BITS) + word_counter;
+        /*Requests for a part of the line keep its offset. The last level
+        * reads that part from memory first.*/
+        r_cache_address_out <= curr_address + word_counter;
         state               <= READ_DATA;
       end
       READ_DATA:begin
-        if((cache_msg_in == MEM_RESP) | (cache_msg_in == MEM_RESP_S))begin
+        if(CRITICAL_WORD_FIRST & (curr_msg == R_REQ) & ~word_sent &
+        ((cache_msg_in == MEM_RESP) | (cache_msg_in == MEM_RESP_S)))begin
+        /*Word beat. The requested word goes out in its lane of the bus.*/
+          r_cache_msg_out   <= NO_REQ;
+          r_bus_msg_out     <= cache_msg_in;
+          r_bus_address_out <= curr_address;
+          for(j=0; j<BUS_WORDS; j=j+1)begin
+            r_bus_data_out[j] <= (j == (curr_address & (BUS_WORDS-1))) ?
+                                 w_cache_data_in[curr_address & (CACHE_WORDS-1)]
+                                 : {DATA_WIDTH{1'b0}};
+          end
+          word_sent         <= 1'b1;
+          state             <= WORD_BEAT;
+        end
+        else if((cache_msg_in == MEM_RESP) | (cache_msg_in == MEM_RESP_S))begin
           r_cache_msg_out <= NO_REQ;
           for(j=0; j<CACHE_WORDS; j=j+1)begin
             curr_data[word_counter + j] <= w_cache_data_in[j];
@@ -400,7 +429,11 @@ always @(posedge clock)begin
           if((block_counter == cache2req_ratio) | cache_wt_req)begin
             block_counter     <= 0;
             word_counter      <= curr_offset;
-            r_bus_msg_out     <= (shared_line | (cache_msg_in == MEM_RESP_S)) ? 			                                                MEM_RESP_S : MEM_RESP; 
+            /*After a word beat the bus is already ours. TRANSFER sends the
+            * response with the first block.*/
+            r_bus_msg_out     <= word_sent ? NO_REQ :
+                                 (shared_line | (cache_msg_in == MEM_RESP_S)) ? 			                                                MEM_RESP_S : MEM_RESP; 
+            shared_line       <= shared_line | (cache_msg_in == MEM_RESP_S);
             r_bus_address_out <= curr_address;
             state             <= TRANSFER;
           end
@@ -457,11 +490,42 @@ always @(posedge clock)begin
 		      for(j=0; j<BUS_WORDS; j=j+1)begin
             r_bus_data_out[j] <= curr_data[word_counter + j];
           end
+          if(word_sent & (block_counter == 0))
+            r_bus_msg_out <= shared_line ? MEM_RESP_S : MEM_RESP;
           block_counter <= block_counter + 1;
           word_counter  <= word_counter + BUS_WORDS;
           state         <= TRANSFER;
         end
       end
+      WORD_BEAT:begin
+      /*The bus controller hands over the bus one cycle after the first
+      * response. Hold the word beat until it is on the bus and keep the line
+      * if it arrives meanwhile.*/
+        if((cache_msg_in == MEM_RESP) | (cache_msg_in == MEM_RESP_S))begin
+          for(j=0; j<CACHE_WORDS; j=j+1)begin
+            curr_data[j] <= w_cache_data_in[j];
+          end
+          shared_line <= shared_line | (cache_msg_in == MEM_RESP_S);
+          line_ready  <= 1'b1;
+        end
+        if(bus_msg_in == r_bus_msg_out)begin
+          r_bus_msg_out     <= NO_REQ;
+          r_bus_address_out <= {ADDRESS_WIDTH{1'b0}};
+          for(j=0; j<BUS_WORDS; j=j+1)begin
+            r_bus_data_out[j] <= {DATA_WIDTH{1'b0}};
+          end
+          if(line_ready | (cache_msg_in == MEM_RESP) |
+          (cache_msg_in == MEM_RESP_S))begin
+            block_counter   <= 0;
+            word_counter    <= curr_offset;
+            state           <= TRANSFER;
+          end
+          else
+            state           <= READ_DATA;
+        end
+        else
+          state <= WORD_BEAT;
+      end
       WAIT_BUS_CLEAR:begin
         if(bus_msg_in == NO_REQ)begin
           if(flush_active)begin
@@ -0,0 +1,223 @@
+/** @module : lx_snoop_interface
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+* --------------------
+ *  - Memory side interface which connects an Lx cache to a shared bus with
+ *    a snooping coherence protocol, for example the bus between cluster L2
+ *    caches and a shared L3 cache.
+ *  - The Lx cache behaves like an L1 cache on this bus. Its requests are put
+ *    on the bus by L1_bus_interface and lx_snooper answers the requests of the
+ *    other caches on the bus.
+ *  - Use with an Lx cache configured with LAST_LEVEL = 0 and
+ *    MEM_SIDE = "SNOOP". Lines on the bus must be as wide as the Lx cache
+ *    lines.
+ *
+ *  Sub modules
+ *  -----------
+   *  lx_snooper - handles cache coherence
+   *  L1_bus_interface - handles communication with the bus
+*/
+
+
+module lx_snoop_interface #(
+parameter STATUS_BITS        =  3,
+          COHERENCE_BITS     =  2,
+          CACHE_OFFSET_BITS  =  2,
+          DATA_WIDTH         = 32,
+          NUMBER_OF_WAYS     =  4,
+          ADDRESS_BITS       = 32,
+          INDEX_BITS         =  8,
+          MSG_BITS           =  4,
+          BUS_OFFSET_BITS    =  2,
+          MAX_OFFSET_BITS    =  2,
+          //Use default value in module instantiation for following parameters
+          CACHE_WORDS        = 1 << CACHE_OFFSET_BITS,
+          CACHE_WIDTH        = DATA_WIDTH * CACHE_WORDS,
+          BUS_WORDS          = 1 << BUS_OFFSET_BITS,
+          BUS_WIDTH          = BUS_WORDS * DATA_WIDTH,
+          WAY_BITS           = (NUMBER_OF_WAYS > 1) ? log2(NUMBER_OF_WAYS) : 1,
+          TAG_BITS           = ADDRESS_BITS - INDEX_BITS - CACHE_OFFSET_BITS,
+          SBITS              = COHERENCE_BITS + STATUS_BITS
+)(
+input  clock, reset,
+//interface with the shared bus
+input  [MSG_BITS-1           :0] bus_msg_in,
+input  [ADDRESS_BITS-1       :0] bus_address_in,
+input  [BUS_WIDTH-1          :0] bus_data_in,
+input  bus_master,
+input  req_ready,
+output [MSG_BITS-1           :0] bus_msg_out,
+output [ADDRESS_BITS-1       :0] bus_address_out,
+output [BUS_WIDTH-1          :0] bus_data_out,
+output [log2(MAX_OFFSET_BITS):0] active_offset,
+
+//interface with the Lx cache controller
+input  [MSG_BITS-1           :0] cache2mem_msg,
+input  [ADDRESS_BITS-1       :0] cache2mem_address,
+input  [CACHE_WIDTH-1        :0] cache2mem_data,
+output [MSG_BITS-1           :0] mem2cache_msg,
+output [ADDRESS_BITS-1       :0] mem2cache_address,
+output [CACHE_WIDTH-1        :0] mem2cache_data,
+output mem_intf_busy,
+output [ADDRESS_BITS-1       :0] mem_intf_address,
+output mem_intf_address_valid,
+
+//interface with cache memory
+input  [CACHE_WIDTH-1   :0] port1_read_data,
+input  [WAY_BITS-1      :0] port1_matched_way,
+input  [COHERENCE_BITS-1:0] port1_coh_bits,
+input  [STATUS_BITS-1   :0] port1_status_bits,
+input  port1_hit,
+output port1_read, port1_write, port1_invalidate,
+output [INDEX_BITS-1    :0] port1_index,
+output [TAG_BITS-1      :0] port1_tag,
+output [SBITS-1         :0] port1_metadata,
+output [CACHE_WIDTH-1   :0] port1_write_data,
+output [WAY_BITS-1      :0] port1_way_select
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+`include `INCLUDE_FILE
+
+//Internal signals
+wire [MSG_BITS-1    :0] snooper2intf_msg, intf2snooper_msg;
+wire [ADDRESS_BITS-1:0] snooper2intf_addr, intf2snooper_addr;
+wire [CACHE_WIDTH-1 :0] snooper2intf_data, intf2snooper_data;
+wire [MSG_BITS-1    :0] snooper2cache_msg, intf2cache_msg;
+wire [ADDRESS_BITS-1:0] snooper2cache_addr, intf2cache_addr;
+wire [log2(CACHE_OFFSET_BITS):0] cache_offset_bits_wire;
+
+// Assign parameter to wire of appropriate width
+assign cache_offset_bits_wire = CACHE_OFFSET_BITS[log2(CACHE_OFFSET_BITS):0];
+
+/*Requests from the snooper are held until the controller responds. The bus
+* interface cannot have a response for the controller at the same time
+* because the snooper only acts when another cache or the shared cache below
+* owns the bus.*/
+assign mem2cache_msg     = (snooper2cache_msg != NO_REQ) ? snooper2cache_msg
+                         : intf2cache_msg;
+assign mem2cache_address = (snooper2cache_msg != NO_REQ) ? snooper2cache_addr
+                         : intf2cache_addr;
+assign mem_intf_busy     = (snooper2cache_msg != NO_REQ);
+
+//The snooper never modifies the cache memory. The controller does.
+assign port1_write      = 1'b0;
+assign port1_invalidate = 1'b0;
+assign port1_metadata   = {SBITS{1'b0}};
+assign port1_write_data = {CACHE_WIDTH{1'b0}};
+assign port1_way_select = {WAY_BITS{1'b0}};
+
+
+//Instantiate snooper
+lx_snooper #(
+  .CACHE_OFFSET_BITS(CACHE_OFFSET_BITS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_WIDTH(ADDRESS_BITS),
+  .MSG_BITS(MSG_BITS),
+  .INDEX_BITS(INDEX_BITS),
+  .COHERENCE_BITS(COHERENCE_BITS),
+  .STATUS_BITS(STATUS_BITS),
+  .NUMBER_OF_WAYS(NUMBER_OF_WAYS)
+) snooper (
+  .clock(clock),
+  .reset(reset),
+  .matched_way(port1_matched_way),
+  .coh_bits(port1_coh_bits),
+  .status_bits(port1_status_bits),
+  .hit(port1_hit),
+  .read(port1_read),
+  .index(port1_index),
+  .tag(port1_tag),
+
+  .cache2mem_msg(cache2mem_msg),
+  .cache2mem_address(cache2mem_address),
+  .cache2mem_data(cache2mem_data),
+  .snoop2cache_msg(snooper2cache_msg),
+  .snoop2cache_address(snooper2cache_addr),
+  .snoop_address(mem_intf_address),
+  .snoop_address_valid(mem_intf_address_valid),
+
+  .intf_msg(intf2snooper_msg),
+  .intf_address(intf2snooper_addr),
+  .intf_data(intf2snooper_data),
+  .snoop_msg(snooper2intf_msg),
+  .snoop_out_address(snooper2intf_addr),
+  .snoop_data(snooper2intf_data),
+
+  .bus_msg(bus_msg_in),
+  .bus_address(bus_address_in),
+  .req_ready(req_ready),
+  .bus_master(bus_master)
+);
+
+
+//Instantiate bus_interface
+L1_bus_interface #(
+  .CACHE_OFFSET_BITS(CACHE_OFFSET_BITS),
+  .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_WIDTH(ADDRESS_BITS),
+  .MSG_BITS(MSG_BITS),
+  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+) bus_interface (
+  .clock(clock),
+  .reset(reset),
+  .cache_offset(cache_offset_bits_wire),
+
+  .cache_msg_in(cache2mem_msg),
+  .cache_address_in(cache2mem_address),
+  .cache_data_in(cache2mem_data),
+  .cache_msg_out(intf2cache_msg),
+  .cache_address_out(intf2cache_addr),
+  .cache_data_out(mem2cache_data),
+
+  .snoop_msg_in(snooper2intf_msg),
+  .snoop_address_in(snooper2intf_addr),
+  .snoop_data_in(snooper2intf_data),
+  .snoop_msg_out(intf2snooper_msg),
+  .snoop_address_out(intf2snooper_addr),
+  .snoop_data_out(intf2snooper_data),
+
+  .bus_msg_in(bus_msg_in),
+  .bus_address_in(bus_address_in),
+  .bus_data_in(bus_data_in),
+  .bus_msg_out(bus_msg_out),
+  .bus_address_out(bus_address_out),
+  .bus_data_out(bus_data_out),
+  .active_offset(active_offset),
+
+  .bus_master(bus_master),
+  .req_ready(req_ready)
+);
+
+
+endmodule
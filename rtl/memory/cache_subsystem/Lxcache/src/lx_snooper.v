@@ -0,0 +1,288 @@
+/** @module : lx_snooper
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+* --------------------
+ *  - Snooper for an Lx cache that is not the last level of the coherence
+ *    domain and connects to a shared bus on the memory side (for example a
+ *    cluster L2 on the bus of a shared L3).
+ *  - Checks the tags of the Lx cache through port1 of the cache memory for
+ *    R_REQ, RFO_BCAST and WS_BCAST messages from other caches on the bus and
+ *    for REQ_FLUSH messages from the shared cache below.
+ *  - Misses and reads of SHARED lines are answered with EN_ACCESS without
+ *    involving the Lx cache controller.
+ *  - Other hits are forwarded to the Lx cache controller as FwdGetS (R_REQ)
+ *    or REQ_FLUSH (all other messages). The controller recalls the line from
+ *    the L(x-1) caches if needed and answers with C_FLUSH or EN_ACCESS. A
+ *    C_FLUSH is put on the bus as a coherence operation (C_WB for R_REQ).
+ *  - Lines on the memory side bus must be as wide as the lines of the Lx
+ *    cache.
+*/
+
+
+module lx_snooper #(
+parameter CACHE_OFFSET_BITS =  2,
+          DATA_WIDTH        = 32,
+          ADDRESS_WIDTH     = 32,
+          MSG_BITS          =  4,
+          INDEX_BITS        =  8,
+          COHERENCE_BITS    =  2,
+          STATUS_BITS       =  3,
+          NUMBER_OF_WAYS    =  4
+)(
+clock,
+reset,
+matched_way,
+coh_bits,
+status_bits,
+hit,
+read,
+index,
+tag,
+
+cache2mem_msg,
+cache2mem_address,
+cache2mem_data,
+snoop2cache_msg,
+snoop2cache_address,
+snoop_address,
+snoop_address_valid,
+
+intf_msg,
+intf_address,
+intf_data,
+snoop_msg,
+snoop_out_address,
+snoop_data,
+
+bus_msg,
+bus_address,
+req_ready,
+bus_master
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+localparam CACHE_WORDS = 1 << CACHE_OFFSET_BITS; //number of words in one line.
+localparam CACHE_WIDTH = DATA_WIDTH*CACHE_WORDS;
+localparam TAG_BITS    = ADDRESS_WIDTH - CACHE_OFFSET_BITS - INDEX_BITS;
+localparam WAY_BITS    = (NUMBER_OF_WAYS > 1) ? log2(NUMBER_OF_WAYS) : 1;
+
+localparam IDLE          = 3'd0,
+           START         = 3'd1,
+           READ_LINE     = 3'd2,
+           ACTION        = 3'd3,
+           CACHE_REQ     = 3'd4,
+           WAIT_FOR_RESP = 3'd5;
+
+`include `INCLUDE_FILE
+
+
+input clock, reset;
+//interface to cache memory (port1)
+input  [WAY_BITS-1      :0] matched_way;
+input  [COHERENCE_BITS-1:0] coh_bits;
+input  [STATUS_BITS-1   :0] status_bits;
+input  hit;
+output read;
+output [INDEX_BITS-1    :0] index;
+output [TAG_BITS-1      :0] tag;
+
+//interface to Lx cache controller
+input  [MSG_BITS-1     :0] cache2mem_msg;
+input  [ADDRESS_WIDTH-1:0] cache2mem_address;
+input  [CACHE_WIDTH-1  :0] cache2mem_data;
+output [MSG_BITS-1     :0] snoop2cache_msg;
+output [ADDRESS_WIDTH-1:0] snoop2cache_address;
+output [ADDRESS_WIDTH-1:0] snoop_address;
+output snoop_address_valid;
+
+//interface to bus interface
+input  [MSG_BITS-1     :0] intf_msg;
+input  [ADDRESS_WIDTH-1:0] intf_address;
+input  [CACHE_WIDTH-1  :0] intf_data;
+output [MSG_BITS-1     :0] snoop_msg;
+output [ADDRESS_WIDTH-1:0] snoop_out_address;
+output [CACHE_WIDTH-1  :0] snoop_data;
+
+//interface to the shared bus
+input  [MSG_BITS-1     :0] bus_msg;
+input  [ADDRESS_WIDTH-1:0] bus_address;
+input  req_ready;
+input  bus_master;
+
+
+//internal variables
+reg [2:0] state;
+reg r_read;
+reg [INDEX_BITS-1   :0] r_index;
+reg [TAG_BITS-1     :0] r_tag;
+reg [MSG_BITS-1     :0] r_bus_msg;
+reg [ADDRESS_WIDTH-1:0] r_bus_address;
+reg [MSG_BITS-1     :0] r_snoop2cache_msg;
+reg r_snoop_address_valid;
+reg [MSG_BITS-1     :0] r_snoop_msg;
+reg [ADDRESS_WIDTH-1:0] r_snoop_address;
+reg [CACHE_WIDTH-1  :0] r_snoop_data;
+
+wire read_req, write_req, mflush_req;
+wire [ADDRESS_WIDTH-1:0] line_address;
+
+
+assign read_req   = ((bus_msg == R_REQ) | (bus_msg == RFO_BCAST)) & ~bus_master
+                    & ~req_ready;
+assign write_req  = (bus_msg == WS_BCAST) & ~bus_master & ~req_ready;
+assign mflush_req = (bus_msg == REQ_FLUSH);
+
+assign line_address = {r_bus_address[ADDRESS_WIDTH-1:CACHE_OFFSET_BITS],
+                      {CACHE_OFFSET_BITS{1'b0}}};
+
+
+//assign outputs
+assign read  = r_read;
+assign index = r_index;
+assign tag   = r_tag;
+
+assign snoop2cache_msg     = r_snoop2cache_msg;
+assign snoop2cache_address = line_address;
+assign snoop_address       = line_address;
+assign snoop_address_valid = r_snoop_address_valid;
+
+assign snoop_msg         = r_snoop_msg;
+assign snoop_out_address = r_snoop_address;
+assign snoop_data        = r_snoop_data;
+
+
+//coherence FSM
+always @(posedge clock)begin
+  if(reset)begin
+    r_read                <= 1'b0;
+    r_index               <= {INDEX_BITS{1'b0}};
+    r_tag                 <= {TAG_BITS{1'b0}};
+    r_bus_msg             <= NO_REQ;
+    r_bus_address         <= {ADDRESS_WIDTH{1'b0}};
+    r_snoop2cache_msg     <= NO_REQ;
+    r_snoop_address_valid <= 1'b0;
+    r_snoop_msg           <= NO_REQ;
+    r_snoop_address       <= {ADDRESS_WIDTH{1'b0}};
+    r_snoop_data          <= {CACHE_WIDTH{1'b0}};
+    state                 <= IDLE;
+  end
+  else begin
+    case(state)
+      IDLE:begin
+        if(read_req | write_req | mflush_req)begin
+          r_bus_msg     <= bus_msg;
+          r_bus_address <= bus_address;
+          state         <= START;
+        end
+        else
+          state <= IDLE;
+      end
+      START:begin
+      /*Hold off the Lx cache controller from operating on the same line
+      * until the tag check is complete.*/
+        r_index               <= r_bus_address[CACHE_OFFSET_BITS +: INDEX_BITS];
+        r_tag                 <= r_bus_address[ADDRESS_WIDTH-1 -: TAG_BITS];
+        r_read                <= 1'b1;
+        r_snoop_address_valid <= 1'b1;
+        state                 <= READ_LINE;
+      end
+      READ_LINE:begin
+        state <= ACTION;
+      end
+      ACTION:begin
+        r_read                <= 1'b0;
+        r_snoop_address_valid <= 1'b0;
+        if(hit & ~((r_bus_msg == R_REQ) & (coh_bits == SHARED)))begin
+          r_snoop2cache_msg <= (r_bus_msg == R_REQ) ? FwdGetS : REQ_FLUSH;
+          state             <= CACHE_REQ;
+        end
+        else begin
+          r_snoop_msg     <= EN_ACCESS;
+          r_snoop_address <= r_bus_address;
+          state           <= WAIT_FOR_RESP;
+        end
+      end
+      CACHE_REQ:begin
+      /*The controller responds for a single cycle once the line has been
+      * recalled from the L(x-1) caches.*/
+        if(cache2mem_msg == C_FLUSH)begin
+          r_snoop2cache_msg <= NO_REQ;
+          r_snoop_msg       <= (r_bus_msg == R_REQ) ? C_WB : C_FLUSH;
+          r_snoop_address   <= cache2mem_address;
+          r_snoop_data      <= cache2mem_data;
+          state             <= WAIT_FOR_RESP;
+        end
+        else if(cache2mem_msg == EN_ACCESS)begin
+          r_snoop2cache_msg <= NO_REQ;
+          r_snoop_msg       <= EN_ACCESS;
+          r_snoop_address   <= r_bus_address;
+          state             <= WAIT_FOR_RESP;
+        end
+        else
+          state <= CACHE_REQ;
+      end
+      WAIT_FOR_RESP:begin
+        if(mflush_req & (r_bus_msg != REQ_FLUSH) & (r_snoop_msg == EN_ACCESS))begin
+        /*A REQ_FLUSH took the bus before this broadcast was acknowledged.
+        * Drop the EN_ACCESS and snoop the REQ_FLUSH.*/
+          r_snoop_msg     <= NO_REQ;
+          r_snoop_address <= {ADDRESS_WIDTH{1'b0}};
+          state           <= IDLE;
+        end
+        else if(intf_msg == MEM_RESP)begin
+        /*Coherence operation is complete. Release the bus.*/
+          r_snoop_msg     <= EN_ACCESS;
+          r_snoop_address <= r_bus_address;
+          r_snoop_data    <= {CACHE_WIDTH{1'b0}};
+          state           <= WAIT_FOR_RESP;
+        end
+        else if(req_ready)begin
+          r_snoop_msg     <= NO_REQ;
+          r_snoop_address <= {ADDRESS_WIDTH{1'b0}};
+          r_snoop_data    <= {CACHE_WIDTH{1'b0}};
+          state           <= IDLE;
+        end
+        else
+          state <= WAIT_FOR_RESP;
+      end
+      default:begin
+        r_read                <= 1'b0;
+        r_snoop2cache_msg     <= NO_REQ;
+        r_snoop_address_valid <= 1'b0;
+        r_snoop_msg           <= NO_REQ;
+        state                 <= IDLE;
+      end
+    endcase
+  end
+end
+
+endmodule
@@ -301,7 +301,7 @@ assign coh_bits0 = (COHERENCE_BITS < 1) ? 0 :
                    hit0 ? cohbits_out0[decoded_tag_match0] : 
                    cohbits_out0[replace_way];
 assign coh_bits1 = (COHERENCE_BITS < 1) ? 0 :
-                   hit1 ? cohbits_out1[decoded_tag_match0] : 0;
+                   hit1 ? cohbits_out1[decoded_tag_match1] : 0;
 
 assign status_bits0 = hit0 ? status_line0[decoded_tag_match0] : 
                       status_line0[replace_way];
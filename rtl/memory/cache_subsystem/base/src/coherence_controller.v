@@ -27,16 +27,34 @@
   *  - Receives the bus messages from all the caches connected including the
   *    shared cache at L(x) and L(x-1) caches sharing it. Uses these messages
   *    to determine which cache wins cache arbitration.
+  *  - Arbitration between the cache requests uses policy_arbiter. ARB_POLICY,
+  *    ARB_BANDWIDTH_WINDOW, ARB_BANDWIDTH_CAPS and ARB_REPEAT_HOLDOFF are
+  *    passed to its POLICY, BANDWIDTH_WINDOW, BANDWIDTH_CAPS and
+  *    REPEAT_HOLDOFF parameters. The request addresses are the tags used to
+  *    detect lines that ping-pong between caches. The default settings keep
+  *    the PACKET round robin arbitration.
+  *  - grant_count and wait_cycles of the arbiter count the bus grants and the
+  *    cycles each cache waited for the bus.
+  *  - A REQ_FLUSH from the Lx cache only counts the EN_ACCESS messages sent for
+  *    its address. Caches still holding EN_ACCESS for the broadcast it
+  *    preempted withdraw it and snoop the REQ_FLUSH.
 */
 
 module coherence_controller #(
-parameter MSG_BITS       = 4,
-          NUM_CACHES     = 4
+parameter MSG_BITS             = 4,
+          NUM_CACHES           = 4,
+          ADDRESS_BITS         = 32,
+          ARB_POLICY           = "PACKET",
+          ARB_BANDWIDTH_WINDOW = 0,
+          ARB_BANDWIDTH_CAPS   = {NUM_CACHES{32'd0}},
+          ARB_REPEAT_HOLDOFF   = 0
 )(
 clock, reset,
 cache2mem_msg,
+cache2mem_address,
 mem2controller_msg,
 bus_msg,
+bus_address,
 bus_control,
 bus_en,
 curr_master,
@@ -82,8 +100,10 @@ localparam IDLE            = 3'd0,
 
 input clock, reset;
 input [(NUM_CACHES*MSG_BITS)-1:0] cache2mem_msg;
+input [(NUM_CACHES*ADDRESS_BITS)-1:0] cache2mem_address;
 input [MSG_BITS-1:             0] mem2controller_msg;
 input [MSG_BITS-1:             0] bus_msg;
+input [ADDRESS_BITS-1:         0] bus_address;
 output reg [BUS_SIG_WIDTH-1:   0] bus_control;
 output reg bus_en;
 output reg req_ready;
@@ -103,6 +123,10 @@ wire [log2(NUM_CACHES)-1:0] coh_op_cache;
 wire [log2(next_pow2(NUM_CACHES))-1:0] temp_coh_op_cache;
 wire coh_op_valid;
 wire req_valid;
+wire req_accept;
+wire [NUM_CACHES-1      :0] req_served;
+wire [NUM_CACHES*32-1   :0] grant_count;
+wire [NUM_CACHES*32-1   :0] wait_cycles;
 
 reg [BUS_SIG_WIDTH-1:0] r_curr_master;
 reg [BUS_SIG_WIDTH-1:0] transaction_owner;
@@ -121,16 +145,30 @@ endgenerate
 
 
 // instantiate arbiter
-arbiter #(
+policy_arbiter #(
   .WIDTH(NUM_CACHES),
-  .ARB_TYPE("PACKET")
+  .POLICY(ARB_POLICY),
+  .TAG_BITS(ADDRESS_BITS),
+  .BANDWIDTH_WINDOW(ARB_BANDWIDTH_WINDOW),
+  .BANDWIDTH_CAPS(ARB_BANDWIDTH_CAPS),
+  .REPEAT_HOLDOFF(ARB_REPEAT_HOLDOFF),
+  .COUNTER_BITS(32)
 ) arbitrator (
-    .clock(clock), 
+    .clock(clock),
     .reset(reset),
     .requests(requests),
+    .request_tags(cache2mem_address),
+    .served(req_served),
+    .accept(req_accept),
     .grant(serve_next),
-	.valid(req_valid)
+    .valid(req_valid),
+    .grant_count(grant_count),
+    .wait_cycles(wait_cycles)
   );
+
+// A new transaction starts when IDLE picks the arbiter's grant
+assign req_accept = (state == IDLE) & (mem2controller_msg != REQ_FLUSH) &
+                    req_valid;
   
 // instantiate one-hot encoder
 one_hot_encoder #(.WIDTH(BUS_PORTS))
@@ -157,7 +195,8 @@ generate
   for(i=0; i<NUM_CACHES; i=i+1)begin : REQUESTS
     assign requests[i] = (w_msg_in[i] == R_REQ) | (w_msg_in[i] == WB_REQ  ) |
                          (w_msg_in[i] == FLUSH) | (w_msg_in[i] == WS_BCAST) |
-                         (w_msg_in[i] == RFO_BCAST);
+                         (w_msg_in[i] == RFO_BCAST) |
+                         (w_msg_in[i] == WB_CLEAN);
   end
 
 // track coherence messages from L1 caches
@@ -169,10 +208,17 @@ generate
       assign tr_coherence_op[i] = 1'b0;
   end
 
+// the transaction owner is being served until the controller is idle again
+  for(i=0; i<NUM_CACHES; i=i+1)begin : SERVED
+    assign req_served[i] = (state != IDLE) & (transaction_owner == i);
+  end
+
 //track enable access signals
   for(i=0; i<NUM_CACHES; i=i+1)begin: TR_EN
-    assign tr_en_access[i] = (w_msg_in[i] == EN_ACCESS) | 
-                            ((i == transaction_owner) & (bus_msg != REQ_FLUSH));
+    assign tr_en_access[i] = ((w_msg_in[i] == EN_ACCESS) & ((bus_msg != REQ_FLUSH) |
+                             (cache2mem_address[i*ADDRESS_BITS +: ADDRESS_BITS] ==
+                             bus_address))) |
+                             ((i == transaction_owner) & (bus_msg != REQ_FLUSH));
   end
 endgenerate
 
@@ -208,8 +254,8 @@ always @(posedge clock)begin
           transaction_owner   <= serve_next;
           r_curr_master_valid <= 1'b1;
           bus_en              <= 1'b1;
-          if((w_msg_in[serve_next] == WB_REQ) | (w_msg_in[serve_next] == FLUSH))
-          begin
+          if((w_msg_in[serve_next] == WB_REQ) | (w_msg_in[serve_next] == FLUSH) |
+          (w_msg_in[serve_next] == WB_CLEAN))begin
             req_ready <= 1'b1;
             state     <= WAIT_FOR_MEM;
           end
@@ -352,14 +398,16 @@ always @(posedge clock)begin
           bus_control         <= transaction_owner;
           bus_en              <= (transaction_owner != MEM_PORT) ? 1'b1 : 1'b0;
           req_ready           <= ((w_msg_in[transaction_owner] == WB_REQ) | 
-                                  (w_msg_in[transaction_owner] == FLUSH)) ?
+                                  (w_msg_in[transaction_owner] == FLUSH)  |
+                                  (w_msg_in[transaction_owner] == WB_CLEAN)) ?
                                   1'b1 : 1'b0;
           r_curr_master       <= transaction_owner;
           r_curr_master_valid <= 1'b1;
           state               <= (transaction_owner == MEM_PORT) | 
                                  (w_msg_in[transaction_owner] == NO_REQ)  ? IDLE 
                                : ((w_msg_in[transaction_owner] == WB_REQ) | 
-                                  (w_msg_in[transaction_owner] == FLUSH)) ?
+                                  (w_msg_in[transaction_owner] == FLUSH)  |
+                                  (w_msg_in[transaction_owner] == WB_CLEAN)) ?
                                  WAIT_FOR_MEM : WAIT_EN;
         end
         else 
@@ -76,8 +76,10 @@ coherence_controller #(
   .clock(clock), 
   .reset(reset),
   .cache2mem_msg(w_cache2mem_msg),
+  .cache2mem_address({NUM_CACHES*32{1'b0}}),
   .mem2controller_msg(mem2controller_msg),
   .bus_msg(bus_msg),
+  .bus_address(32'd0),
   .bus_control(bus_control),
   .bus_en(bus_en),
   .curr_master(curr_master),
@@ -0,0 +1,613 @@
+/** @module : three_level_cache_hierarchy
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+* --------------------
+ *  - Cache hierarchy with three levels of caches for clustered multi-core
+ *    processors.
+ *  - Cores are grouped into NUM_CLUSTERS clusters of CORES_PER_CLUSTER cores.
+ *    Each core has an instruction and a data L1 cache. The L1 caches of a
+ *    cluster share a snooping bus with a private L2 (Lx) cache.
+ *  - Cluster L2 caches connect to a shared inclusive L3 cache over a second
+ *    snooping bus through lx_snoop_interface, which keeps the clusters
+ *    coherent. Bus arbitration and snoop fan-out on each bus only grow with
+ *    the size of a cluster or the number of clusters.
+ *  - L3 cache directly connects to the main memory without a bus or NoC
+ *    interface on the memory side.
+ *  - Processor side ports follow the order used by two_level_cache_hierarchy
+ *    in seven_stage_multicore_top: ports 0 to NUM_CORES-1 are the instruction
+ *    caches and ports NUM_CORES to 2*NUM_CORES-1 the data caches of cores
+ *    0 to NUM_CORES-1. Core i belongs to cluster i/CORES_PER_CLUSTER.
+ *  - OFFSET_BITS_L1, NUMBER_OF_WAYS_L1 and INDEX_BITS_L1 have one entry per
+ *    L1 cache in processor side port order.
+ *  - OFFSET_BITS_L3 and L3_BUS_OFFSET_BITS must be equal to OFFSET_BITS_L2.
+ *    Other values stop the simulation.
+ *  - ARB_* parameters configure the arbitration of the cluster buses and the
+ *    L3 bus, see coherence_controller. ARB_BANDWIDTH_CAPS has one entry per
+ *    L1 cache in processor side port order. The L3 bus is not capped.
+ *  - VICTIM_ENTRIES_L1 has the number of victim cache entries of each L1
+ *    cache in processor side port order, 0 for no victim cache.
+**/
+
+
+
+module three_level_cache_hierarchy #(
+parameter STATUS_BITS_L1      = 2,
+          OFFSET_BITS_L1      = {2*NUM_CLUSTERS*CORES_PER_CLUSTER{32'd2}},
+          NUMBER_OF_WAYS_L1   = {2*NUM_CLUSTERS*CORES_PER_CLUSTER{32'd2}},
+          INDEX_BITS_L1       = {2*NUM_CLUSTERS*CORES_PER_CLUSTER{32'd5}},
+          REPLACEMENT_MODE_L1 = 1'b0,
+          STATUS_BITS_L2      = 3,
+          OFFSET_BITS_L2      = 2,
+          NUMBER_OF_WAYS_L2   = 4,
+          INDEX_BITS_L2       = 6,
+          REPLACEMENT_MODE_L2 = 1'b0,
+          L2_INCLUSION        = 1'b1,
+          STATUS_BITS_L3      = 3,
+          OFFSET_BITS_L3      = OFFSET_BITS_L2,
+          NUMBER_OF_WAYS_L3   = 8,
+          INDEX_BITS_L3       = 8,
+          REPLACEMENT_MODE_L3 = 1'b0,
+          COHERENCE_BITS      = 2,
+          DATA_WIDTH          = 32,
+          ADDRESS_BITS        = 32,
+          MSG_BITS            = 4,
+          NUM_CLUSTERS        = 2,
+          CORES_PER_CLUSTER   = 2,
+          BUS_OFFSET_BITS     = 2, //cluster buses
+          MAX_OFFSET_BITS     = 2, //cluster buses
+          L3_BUS_OFFSET_BITS  = OFFSET_BITS_L2,
+          VICTIM_ENTRIES_L1   = {2*NUM_CLUSTERS*CORES_PER_CLUSTER{32'd0}},
+          ARB_POLICY           = "PACKET",
+          ARB_BANDWIDTH_WINDOW = 0,
+          ARB_BANDWIDTH_CAPS   = {2*NUM_CLUSTERS*CORES_PER_CLUSTER{32'd0}},
+          ARB_REPEAT_HOLDOFF   = 0,
+          //Use default value in module instantiation for following parameters
+          NUM_CORES           = NUM_CLUSTERS*CORES_PER_CLUSTER,
+          NUM_L1_CACHES       = 2*NUM_CORES,
+          L3_WORDS            = 1 << OFFSET_BITS_L3,
+          L3_WIDTH            = L3_WORDS*DATA_WIDTH,
+          L3_TAG_BITS         = ADDRESS_BITS - OFFSET_BITS_L3 - INDEX_BITS_L3,
+          L3_WAY_BITS         = (NUMBER_OF_WAYS_L3 > 1) ? log2(NUMBER_OF_WAYS_L3) : 1,
+          L3_MBITS            = COHERENCE_BITS + STATUS_BITS_L3
+)(
+input  clock,
+input  reset,
+//interface with processor pipelines
+input  [NUM_L1_CACHES-1:0] read, write, invalidate, flush,
+input  [NUM_L1_CACHES*DATA_WIDTH/8-1:0] w_byte_en,
+input  [NUM_L1_CACHES*ADDRESS_BITS-1:0] address,
+input  [NUM_L1_CACHES*DATA_WIDTH-1  :0] data_in,
+output [NUM_L1_CACHES*ADDRESS_BITS-1:0] out_address,
+output [NUM_L1_CACHES*DATA_WIDTH-1  :0] data_out,
+output [NUM_L1_CACHES-1:0] valid, ready,
+//interface with memory side interface
+input  [MSG_BITS-1    :0]     mem2cachehier_msg,
+input  [ADDRESS_BITS-1:0] mem2cachehier_address,
+input  [L3_WIDTH-1    :0]    mem2cachehier_data,
+input  mem_intf_busy,
+input  [ADDRESS_BITS-1:0] mem_intf_address,
+input  mem_intf_address_valid,
+output [MSG_BITS-1    :0]     cachehier2mem_msg,
+output [ADDRESS_BITS-1:0] cachehier2mem_address,
+output [L3_WIDTH-1    :0]    cachehier2mem_data,
+//interface for memory side interface to access L3 cache memory
+input  port1_read, port1_write, port1_invalidate,
+input  [INDEX_BITS_L3-1 :0] port1_index,
+input  [L3_TAG_BITS-1   :0] port1_tag,
+input  [L3_MBITS-1      :0] port1_metadata,
+input  [L3_WIDTH-1      :0] port1_write_data,
+input  [L3_WAY_BITS-1   :0] port1_way_select,
+output [L3_WIDTH-1      :0] port1_read_data,
+output [L3_WAY_BITS-1   :0] port1_matched_way,
+output [COHERENCE_BITS-1:0] port1_coh_bits,
+output [STATUS_BITS_L3-1:0] port1_status_bits,
+output port1_hit,
+
+input scan
+);
+
+//Define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for(log2=0; value>0; log2=log2+1)
+    value = value>>1;
+  end
+endfunction
+
+// Define INCLUDE_FILE  to point to /includes/params.h. The path should be
+// relative to your simulation/sysnthesis directory. You can add the macro
+// when compiling this file in modelsim by adding the following argument to the
+// vlog command that compiles this module:
+// +define+INCLUDE_FILE="../../../includes/params.h"
+`include `INCLUDE_FILE
+
+// Bandwidth caps of the cluster bus ports, in cluster bus port order
+function [2*CORES_PER_CLUSTER*32-1:0] cluster_caps;
+input integer cluster;
+integer port, core;
+begin
+  cluster_caps = {2*CORES_PER_CLUSTER*32{1'b0}};
+  for(port=0; port<2*CORES_PER_CLUSTER; port=port+1)begin
+    core = cluster*CORES_PER_CLUSTER + (port % CORES_PER_CLUSTER);
+    if(port < CORES_PER_CLUSTER)
+      cluster_caps[port*32 +: 32] = ARB_BANDWIDTH_CAPS[core*32 +: 32];
+    else
+      cluster_caps[port*32 +: 32] = ARB_BANDWIDTH_CAPS[(NUM_CORES+core)*32 +: 32];
+  end
+end
+endfunction
+
+localparam L1_PER_CLUSTER = 2*CORES_PER_CLUSTER;
+localparam BUS_WORDS      = 1 << BUS_OFFSET_BITS;
+localparam BUS_WIDTH      = BUS_WORDS*DATA_WIDTH;
+localparam BUS_PORTS      = L1_PER_CLUSTER + 1;
+localparam BUS_SIG_WIDTH  = log2(BUS_PORTS);
+localparam WIDTH_BITS     = log2(MAX_OFFSET_BITS) + 1;
+
+localparam L2_WORDS       = 1 << OFFSET_BITS_L2;
+localparam L2_WIDTH       = L2_WORDS*DATA_WIDTH;
+localparam L2_TAG_BITS    = ADDRESS_BITS - OFFSET_BITS_L2 - INDEX_BITS_L2;
+localparam L2_WAY_BITS    = (NUMBER_OF_WAYS_L2 > 1) ? log2(NUMBER_OF_WAYS_L2) : 1;
+localparam L2_MBITS       = COHERENCE_BITS + STATUS_BITS_L2;
+
+localparam L3_BUS_WORDS      = 1 << L3_BUS_OFFSET_BITS;
+localparam L3_BUS_WIDTH      = L3_BUS_WORDS*DATA_WIDTH;
+localparam L3_BUS_PORTS      = NUM_CLUSTERS + 1;
+localparam L3_BUS_SIG_WIDTH  = log2(L3_BUS_PORTS);
+localparam L3_MAX_OFFSET     = OFFSET_BITS_L2;
+localparam L3_WIDTH_BITS     = log2(L3_MAX_OFFSET) + 1;
+
+
+
+//internal signals
+genvar i, k;
+
+
+// The L3 bus carries whole L2 lines and the L3 keeps the L2 line size
+generate
+  if((OFFSET_BITS_L3 != OFFSET_BITS_L2) |
+     (L3_BUS_OFFSET_BITS != OFFSET_BITS_L2))begin : UNSUPPORTED_L3_OFFSET
+    initial begin
+      $display("%m: OFFSET_BITS_L3 and L3_BUS_OFFSET_BITS must be equal to OFFSET_BITS_L2");
+      $finish;
+    end
+  end
+endgenerate
+
+//L3 bus signals
+wire [NUM_CLUSTERS*MSG_BITS-1     :0] l2tobus_msg;
+wire [NUM_CLUSTERS*ADDRESS_BITS-1 :0] l2tobus_address;
+wire [NUM_CLUSTERS*L3_BUS_WIDTH-1 :0] l2tobus_data;
+wire [NUM_CLUSTERS*L3_WIDTH_BITS-1:0] l2tobus_offset;
+
+wire [MSG_BITS-1     :0] l3tobus_msg;
+wire [ADDRESS_BITS-1 :0] l3tobus_address;
+wire [L3_BUS_WIDTH-1 :0] l3tobus_data;
+wire [L3_WIDTH_BITS-1:0] l3tobus_offset;
+
+wire [MSG_BITS-1        :0] l3_bus_msg;
+wire [ADDRESS_BITS-1    :0] l3_bus_address;
+wire [L3_BUS_WIDTH-1    :0] l3_bus_data;
+wire [L3_WIDTH_BITS-1   :0] l3_req_offset;
+wire [L3_BUS_PORTS-1    :0] l3_bus_master;
+wire [L3_BUS_SIG_WIDTH-1:0] l3_bus_ctrl;
+wire l3_req_ready;
+wire l3_bus_en;
+
+
+//Instantiate clusters
+generate
+  for(k=0; k<NUM_CLUSTERS; k=k+1)begin: CLUSTER
+    wire [L1_PER_CLUSTER*MSG_BITS-1    :0] l1tobus_msg;
+    wire [L1_PER_CLUSTER*ADDRESS_BITS-1:0] l1tobus_address;
+    wire [L1_PER_CLUSTER*BUS_WIDTH-1   :0] l1tobus_data;
+    wire [L1_PER_CLUSTER*WIDTH_BITS-1  :0] l1tobus_offset;
+
+    wire [MSG_BITS-1    :0] l2tobus_msg_c;
+    wire [ADDRESS_BITS-1:0] l2tobus_address_c;
+    wire [BUS_WIDTH-1   :0] l2tobus_data_c;
+    wire [WIDTH_BITS-1  :0] l2tobus_offset_c;
+
+    wire [MSG_BITS-1     :0] bus_msg;
+    wire [ADDRESS_BITS-1 :0] bus_address;
+    wire [BUS_WIDTH-1    :0] bus_data;
+    wire [WIDTH_BITS-1   :0] req_offset;
+    wire [BUS_PORTS-1    :0] bus_master;
+    wire [BUS_SIG_WIDTH-1:0] bus_ctrl;
+    wire req_ready;
+    wire bus_en;
+
+    //L2 to memory side interface signals
+    wire [MSG_BITS-1    :0] l2tointf_msg, intftol2_msg;
+    wire [ADDRESS_BITS-1:0] l2tointf_address, intftol2_address;
+    wire [L2_WIDTH-1    :0] l2tointf_data, intftol2_data;
+    wire intf_busy;
+    wire [ADDRESS_BITS-1:0] intf_address;
+    wire intf_address_valid;
+
+    wire l2_port1_read, l2_port1_write, l2_port1_invalidate;
+    wire [INDEX_BITS_L2-1 :0] l2_port1_index;
+    wire [L2_TAG_BITS-1   :0] l2_port1_tag;
+    wire [L2_MBITS-1      :0] l2_port1_metadata;
+    wire [L2_WIDTH-1      :0] l2_port1_write_data;
+    wire [L2_WAY_BITS-1   :0] l2_port1_way_select;
+    wire [L2_WIDTH-1      :0] l2_port1_read_data;
+    wire [L2_WAY_BITS-1   :0] l2_port1_matched_way;
+    wire [COHERENCE_BITS-1:0] l2_port1_coh_bits;
+    wire [STATUS_BITS_L2-1:0] l2_port1_status_bits;
+    wire l2_port1_hit;
+
+    //Instantiate L1 caches
+    for(i=0; i<L1_PER_CLUSTER; i=i+1)begin: L1INST
+      /*Instruction caches of the cluster first, then its data caches.*/
+      localparam CORE = k*CORES_PER_CLUSTER + (i % CORES_PER_CLUSTER);
+      localparam PORT = (i < CORES_PER_CLUSTER) ? CORE : NUM_CORES + CORE;
+
+      L1cache_bus_wrapper #(
+        .STATUS_BITS(STATUS_BITS_L1),
+        .COHERENCE_BITS(COHERENCE_BITS),
+        .CACHE_OFFSET_BITS(OFFSET_BITS_L1[PORT*32 +: 32]),
+        .DATA_WIDTH(DATA_WIDTH),
+        .NUMBER_OF_WAYS(NUMBER_OF_WAYS_L1[PORT*32 +: 32]),
+        .ADDRESS_BITS(ADDRESS_BITS),
+        .INDEX_BITS(INDEX_BITS_L1[PORT*32 +: 32]),
+        .MSG_BITS(MSG_BITS),
+        .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
+        .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
+        .REPLACEMENT_MODE(REPLACEMENT_MODE_L1),
+        .CORE(CORE),
+        .CACHE_NO(PORT),
+        .VICTIM_ENTRIES(VICTIM_ENTRIES_L1[PORT*32 +: 32])
+      ) L1CACHE (
+        .clock(clock),
+        .reset(reset),
+        //processor interface
+        .read(read[PORT]),
+        .write(write[PORT]),
+        .w_byte_en(w_byte_en[PORT*DATA_WIDTH/8 +: DATA_WIDTH/8]),
+        .invalidate(invalidate[PORT]),
+        .flush(flush[PORT]),
+        .address(address[PORT*ADDRESS_BITS +: ADDRESS_BITS]),
+        .data_in(data_in[PORT*DATA_WIDTH +: DATA_WIDTH]),
+        .report(scan),
+        .data_out(data_out[PORT*DATA_WIDTH +: DATA_WIDTH]),
+        .out_address(out_address[PORT*ADDRESS_BITS +: ADDRESS_BITS]),
+        .ready(ready[PORT]),
+        .valid(valid[PORT]),
+        //bus interface
+        .bus_msg_in(bus_msg),
+        .bus_address_in(bus_address),
+        .bus_data_in(bus_data),
+        .bus_msg_out(l1tobus_msg[i*MSG_BITS +: MSG_BITS]),
+        .bus_address_out(l1tobus_address[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .bus_data_out(l1tobus_data[i*BUS_WIDTH +: BUS_WIDTH]),
+        .active_offset(l1tobus_offset[i*WIDTH_BITS +: WIDTH_BITS]),
+        .bus_master(bus_master[i]),
+        .req_ready(req_ready),
+        .curr_offset(req_offset)
+      );
+    end
+
+
+    //Instantiate cluster buses
+    mux_bus #(
+      .WIDTH(MSG_BITS),
+      .NUM_PORTS(BUS_PORTS)
+    ) msg_bus (
+      .data_in({l2tobus_msg_c, l1tobus_msg}),
+      .enable_port(bus_ctrl),
+      .valid_enable(bus_en),
+      .data_out(bus_msg)
+    );
+
+    mux_bus #(
+      .WIDTH(ADDRESS_BITS),
+      .NUM_PORTS(BUS_PORTS)
+    ) address_bus (
+      .data_in({l2tobus_address_c, l1tobus_address}),
+      .enable_port(bus_ctrl),
+      .valid_enable(bus_en),
+      .data_out(bus_address)
+    );
+
+    mux_bus #(
+      .WIDTH(BUS_WIDTH),
+      .NUM_PORTS(BUS_PORTS)
+    ) data_bus (
+      .data_in({l2tobus_data_c, l1tobus_data}),
+      .enable_port(bus_ctrl),
+      .valid_enable(bus_en),
+      .data_out(bus_data)
+    );
+
+    mux_bus #(
+      .WIDTH(WIDTH_BITS),
+      .NUM_PORTS(BUS_PORTS)
+    ) offset_bus (
+      .data_in({l2tobus_offset_c, l1tobus_offset}),
+      .enable_port(bus_ctrl),
+      .valid_enable(bus_en),
+      .data_out(req_offset)
+    );
+
+
+    //Instantiate cluster bus controller
+    coherence_controller #(
+      .MSG_BITS(MSG_BITS),
+      .NUM_CACHES(L1_PER_CLUSTER),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .ARB_POLICY(ARB_POLICY),
+      .ARB_BANDWIDTH_WINDOW(ARB_BANDWIDTH_WINDOW),
+      .ARB_BANDWIDTH_CAPS(cluster_caps(k)),
+      .ARB_REPEAT_HOLDOFF(ARB_REPEAT_HOLDOFF)
+    ) bus_controller (
+      .clock(clock),
+      .reset(reset),
+      .cache2mem_msg(l1tobus_msg),
+      .cache2mem_address(l1tobus_address),
+      .mem2controller_msg(l2tobus_msg_c),
+      .bus_msg(bus_msg),
+      .bus_address(bus_address),
+      .bus_control(bus_ctrl),
+      .bus_en(bus_en),
+      .curr_master(bus_master),
+      .req_ready(req_ready)
+    );
+
+
+    //Instantiate the cluster L2 cache
+    Lxcache_wrapper #(
+      .STATUS_BITS(STATUS_BITS_L2),
+      .INCLUSION(L2_INCLUSION),
+      .COHERENCE_BITS(COHERENCE_BITS),
+      .CACHE_OFFSET_BITS(OFFSET_BITS_L2),
+      .DATA_WIDTH(DATA_WIDTH),
+      .NUMBER_OF_WAYS(NUMBER_OF_WAYS_L2),
+      .REPLACEMENT_MODE(REPLACEMENT_MODE_L2),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .INDEX_BITS(INDEX_BITS_L2),
+      .MSG_BITS(MSG_BITS),
+      .LAST_LEVEL(1'b0),
+      .MEM_SIDE("SNOOP"),
+      .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
+      .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+    ) l2cache (
+      .clock(clock),
+      .reset(reset),
+
+      .bus_msg_in(bus_msg),
+      .bus_address_in(bus_address),
+      .bus_data_in(bus_data),
+      .req_ready(req_ready),
+      .req_offset(req_offset),
+      .bus_msg_out(l2tobus_msg_c),
+      .bus_address_out(l2tobus_address_c),
+      .bus_data_out(l2tobus_data_c),
+      .active_offset(l2tobus_offset_c),
+
+      .mem2cache_msg(intftol2_msg),
+      .mem2cache_address(intftol2_address),
+      .mem2cache_data(intftol2_data),
+      .mem_intf_busy(intf_busy),
+      .mem_intf_address(intf_address),
+      .mem_intf_address_valid(intf_address_valid),
+      .cache2mem_msg(l2tointf_msg),
+      .cache2mem_address(l2tointf_address),
+      .cache2mem_data(l2tointf_data),
+
+      .port1_read(l2_port1_read),
+      .port1_write(l2_port1_write),
+      .port1_invalidate(l2_port1_invalidate),
+      .port1_index(l2_port1_index),
+      .port1_tag(l2_port1_tag),
+      .port1_metadata(l2_port1_metadata),
+      .port1_write_data(l2_port1_write_data),
+      .port1_way_select(l2_port1_way_select),
+      .port1_read_data(l2_port1_read_data),
+      .port1_matched_way(l2_port1_matched_way),
+      .port1_coh_bits(l2_port1_coh_bits),
+      .port1_status_bits(l2_port1_status_bits),
+      .port1_hit(l2_port1_hit),
+
+      .scan(scan)
+    );
+
+
+    //Instantiate the L2 interface to the L3 bus
+    lx_snoop_interface #(
+      .STATUS_BITS(STATUS_BITS_L2),
+      .COHERENCE_BITS(COHERENCE_BITS),
+      .CACHE_OFFSET_BITS(OFFSET_BITS_L2),
+      .DATA_WIDTH(DATA_WIDTH),
+      .NUMBER_OF_WAYS(NUMBER_OF_WAYS_L2),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .INDEX_BITS(INDEX_BITS_L2),
+      .MSG_BITS(MSG_BITS),
+      .BUS_OFFSET_BITS(L3_BUS_OFFSET_BITS),
+      .MAX_OFFSET_BITS(L3_MAX_OFFSET)
+    ) l2_intf (
+      .clock(clock),
+      .reset(reset),
+
+      .bus_msg_in(l3_bus_msg),
+      .bus_address_in(l3_bus_address),
+      .bus_data_in(l3_bus_data),
+      .bus_master(l3_bus_master[k]),
+      .req_ready(l3_req_ready),
+      .bus_msg_out(l2tobus_msg[k*MSG_BITS +: MSG_BITS]),
+      .bus_address_out(l2tobus_address[k*ADDRESS_BITS +: ADDRESS_BITS]),
+      .bus_data_out(l2tobus_data[k*L3_BUS_WIDTH +: L3_BUS_WIDTH]),
+      .active_offset(l2tobus_offset[k*L3_WIDTH_BITS +: L3_WIDTH_BITS]),
+
+      .cache2mem_msg(l2tointf_msg),
+      .cache2mem_address(l2tointf_address),
+      .cache2mem_data(l2tointf_data),
+      .mem2cache_msg(intftol2_msg),
+      .mem2cache_address(intftol2_address),
+      .mem2cache_data(intftol2_data),
+      .mem_intf_busy(intf_busy),
+      .mem_intf_address(intf_address),
+      .mem_intf_address_valid(intf_address_valid),
+
+      .port1_read_data(l2_port1_read_data),
+      .port1_matched_way(l2_port1_matched_way),
+      .port1_coh_bits(l2_port1_coh_bits),
+      .port1_status_bits(l2_port1_status_bits),
+      .port1_hit(l2_port1_hit),
+      .port1_read(l2_port1_read),
+      .port1_write(l2_port1_write),
+      .port1_invalidate(l2_port1_invalidate),
+      .port1_index(l2_port1_index),
+      .port1_tag(l2_port1_tag),
+      .port1_metadata(l2_port1_metadata),
+      .port1_write_data(l2_port1_write_data),
+      .port1_way_select(l2_port1_way_select)
+    );
+  end
+endgenerate
+
+
+//Instantiate L3 bus
+mux_bus #(
+  .WIDTH(MSG_BITS),
+  .NUM_PORTS(L3_BUS_PORTS)
+) l3_msg_bus (
+  .data_in({l3tobus_msg, l2tobus_msg}),
+  .enable_port(l3_bus_ctrl),
+  .valid_enable(l3_bus_en),
+  .data_out(l3_bus_msg)
+);
+
+mux_bus #(
+  .WIDTH(ADDRESS_BITS),
+  .NUM_PORTS(L3_BUS_PORTS)
+) l3_address_bus (
+  .data_in({l3tobus_address, l2tobus_address}),
+  .enable_port(l3_bus_ctrl),
+  .valid_enable(l3_bus_en),
+  .data_out(l3_bus_address)
+);
+
+mux_bus #(
+  .WIDTH(L3_BUS_WIDTH),
+  .NUM_PORTS(L3_BUS_PORTS)
+) l3_data_bus (
+  .data_in({l3tobus_data, l2tobus_data}),
+  .enable_port(l3_bus_ctrl),
+  .valid_enable(l3_bus_en),
+  .data_out(l3_bus_data)
+);
+
+mux_bus #(
+  .WIDTH(L3_WIDTH_BITS),
+  .NUM_PORTS(L3_BUS_PORTS)
+) l3_offset_bus (
+  .data_in({l3tobus_offset, l2tobus_offset}),
+  .enable_port(l3_bus_ctrl),
+  .valid_enable(l3_bus_en),
+  .data_out(l3_req_offset)
+);
+
+
+//Instantiate L3 bus controller
+coherence_controller #(
+  .MSG_BITS(MSG_BITS),
+  .NUM_CACHES(NUM_CLUSTERS),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .ARB_POLICY(ARB_POLICY),
+  .ARB_REPEAT_HOLDOFF(ARB_REPEAT_HOLDOFF)
+) l3_bus_controller (
+  .clock(clock),
+  .reset(reset),
+  .cache2mem_msg(l2tobus_msg),
+  .cache2mem_address(l2tobus_address),
+  .mem2controller_msg(l3tobus_msg),
+  .bus_msg(l3_bus_msg),
+  .bus_address(l3_bus_address),
+  .bus_control(l3_bus_ctrl),
+  .bus_en(l3_bus_en),
+  .curr_master(l3_bus_master),
+  .req_ready(l3_req_ready)
+);
+
+
+//Instantiate the L3 cache
+Lxcache_wrapper #(
+  .STATUS_BITS(STATUS_BITS_L3),
+  .INCLUSION(1'b1),
+  .COHERENCE_BITS(COHERENCE_BITS),
+  .CACHE_OFFSET_BITS(OFFSET_BITS_L3),
+  .DATA_WIDTH(DATA_WIDTH),
+  .NUMBER_OF_WAYS(NUMBER_OF_WAYS_L3),
+  .REPLACEMENT_MODE(REPLACEMENT_MODE_L3),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .INDEX_BITS(INDEX_BITS_L3),
+  .MSG_BITS(MSG_BITS),
+  .LAST_LEVEL(1'b1),
+  .MEM_SIDE("SNOOP"),
+  .BUS_OFFSET_BITS(L3_BUS_OFFSET_BITS),
+  .MAX_OFFSET_BITS(L3_MAX_OFFSET)
+) l3cache (
+  .clock(clock),
+  .reset(reset),
+
+  .bus_msg_in(l3_bus_msg),
+  .bus_address_in(l3_bus_address),
+  .bus_data_in(l3_bus_data),
+  .req_ready(l3_req_ready),
+  .req_offset(l3_req_offset),
+  .bus_msg_out(l3tobus_msg),
+  .bus_address_out(l3tobus_address),
+  .bus_data_out(l3tobus_data),
+  .active_offset(l3tobus_offset),
+
+  .mem2cache_msg(mem2cachehier_msg),
+  .mem2cache_address(mem2cachehier_address),
+  .mem2cache_data(mem2cachehier_data),
+  .mem_intf_busy(mem_intf_busy),
+  .mem_intf_address(mem_intf_address),
+  .mem_intf_address_valid(mem_intf_address_valid),
+  .cache2mem_msg(cachehier2mem_msg),
+  .cache2mem_address(cachehier2mem_address),
+  .cache2mem_data(cachehier2mem_data),
+
+  .port1_read(port1_read),
+  .port1_write(port1_write),
+  .port1_invalidate(port1_invalidate),
+  .port1_index(port1_index),
+  .port1_tag(port1_tag),
+  .port1_metadata(port1_metadata),
+  .port1_write_data(port1_write_data),
+  .port1_way_select(port1_way_select),
+  .port1_read_data(port1_read_data),
+  .port1_matched_way(port1_matched_way),
+  .port1_coh_bits(port1_coh_bits),
+  .port1_status_bits(port1_status_bits),
+  .port1_hit(port1_hit),
+
+  .scan(scan)
+);
+
+endmodule
@@ -27,6 +27,16 @@
  *    a shared bus.
  *  - L2 cache directly connects to the main memory without a bus or NoC
  *    interface on the memory side.
+ *  - ARB_* parameters configure the bus arbitration, see
+ *    coherence_controller. ARB_BANDWIDTH_CAPS has one entry per L1 cache.
+ *  - VICTIM_ENTRIES_L1 has the number of victim cache entries of each L1
+ *    cache, 0 for no victim cache.
+ *  - L2_EXCLUSION = 1 makes the L2 an exclusive (victim) cache of the L1
+ *    caches, see Lxcache_controller. L1 fills are not allocated in the L2 and
+ *    the L1 caches write back clean lines as well. Requires L2_INCLUSION = 0.
+ *  - CRITICAL_WORD_FIRST = 1 answers L1 load misses with the requested word
+ *    first, then the line. The main memory interface needs the same setting.
+ *    The L1 lines must not be wider than the L2 lines.
 **/
 
 
@@ -43,6 +53,8 @@ parameter STATUS_BITS_L1      = 2,
           INDEX_BITS_L2       = 6,
           REPLACEMENT_MODE_L2 = 1'b0,
           L2_INCLUSION        = 1'b1,
+          L2_EXCLUSION        = 1'b0,
+          CRITICAL_WORD_FIRST = 0,
           COHERENCE_BITS      = 2,
           DATA_WIDTH          = 32,
           ADDRESS_BITS        = 32,
@@ -50,6 +62,11 @@ parameter STATUS_BITS_L1      = 2,
           NUM_L1_CACHES       = 4,
           BUS_OFFSET_BITS     = 2,
           MAX_OFFSET_BITS     = 2,
+          VICTIM_ENTRIES_L1   = {NUM_L1_CACHES{32'd0}},
+          ARB_POLICY           = "PACKET",
+          ARB_BANDWIDTH_WINDOW = 0,
+          ARB_BANDWIDTH_CAPS   = {NUM_L1_CACHES{32'd0}},
+          ARB_REPEAT_HOLDOFF   = 0,
           //Use default value in module instantiation for following parameters
           L2_WORDS            = 1 << OFFSET_BITS_L2,
           L2_WIDTH            = L2_WORDS*DATA_WIDTH,
@@ -192,7 +209,10 @@ generate
       .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
       .REPLACEMENT_MODE(REPLACEMENT_MODE_L1),
       .CORE(i/2),
-      .CACHE_NO(i)
+      .CACHE_NO(i),
+      .VICTIM_ENTRIES(VICTIM_ENTRIES_L1[i*32 +: 32]),
+      .CLEAN_WRITEBACK(L2_EXCLUSION),
+      .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
     ) L1CACHE (
       .clock(clock),
       .reset(reset),
@@ -270,13 +290,20 @@ mux_bus #(
 //Instantiate bus controller
 coherence_controller #(
   .MSG_BITS(MSG_BITS),
-  .NUM_CACHES(NUM_L1_CACHES)
+  .NUM_CACHES(NUM_L1_CACHES),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .ARB_POLICY(ARB_POLICY),
+  .ARB_BANDWIDTH_WINDOW(ARB_BANDWIDTH_WINDOW),
+  .ARB_BANDWIDTH_CAPS(ARB_BANDWIDTH_CAPS),
+  .ARB_REPEAT_HOLDOFF(ARB_REPEAT_HOLDOFF)
 ) bus_controller (
   .clock(clock),
   .reset(reset),
   .cache2mem_msg(l1tobus_msg),
+  .cache2mem_address(l1tobus_address),
   .mem2controller_msg(l2tobus_msg),
   .bus_msg(bus_msg),
+  .bus_address(bus_address),
   .bus_control(bus_ctrl),
   .bus_en(bus_en),
   .curr_master(bus_master),
@@ -299,7 +326,9 @@ Lxcache_wrapper #(
   .LAST_LEVEL(1'b1),
   .MEM_SIDE("SNOOP"),
   .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
-  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+  .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
+  .EXCLUSION(L2_EXCLUSION),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) l2cache (
   .clock(clock),
   .reset(reset),
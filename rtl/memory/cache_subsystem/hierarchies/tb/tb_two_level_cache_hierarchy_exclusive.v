@@ -0,0 +1,397 @@
+/** @module : tb_two_level_cache_hierarchy_exclusive
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+module tb_two_level_cache_hierarchy_exclusive();
+
+//Define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for(log2=0; value>0; log2=log2+1)
+    value = value>>1;
+  end
+endfunction
+
+parameter STATUS_BITS_L1      = 2,
+          OFFSET_BITS_L1      = {32'd2, 32'd2, 32'd2, 32'd2},
+          NUMBER_OF_WAYS_L1   = {32'd2, 32'd2, 32'd2, 32'd2},
+          INDEX_BITS_L1       = {32'd2, 32'd2, 32'd2, 32'd2},
+          REPLACEMENT_MODE_L1 = 1'b0,
+          STATUS_BITS_L2      = 3,
+          OFFSET_BITS_L2      = 2,
+          NUMBER_OF_WAYS_L2   = 4,
+          INDEX_BITS_L2       = 6,
+          REPLACEMENT_MODE_L2 = 1'b0,
+          L2_INCLUSION        = 1'b0,
+          L2_EXCLUSION        = 1'b1,
+          COHERENCE_BITS      = 2,
+          DATA_WIDTH          = 32,
+          ADDRESS_BITS        = 32,
+          MSG_BITS            = 4,
+          NUM_L1_CACHES       = 4,
+          BUS_OFFSET_BITS     = 2,
+          MAX_OFFSET_BITS     = 2,
+          //Use default value in module instantiation for following parameters
+          L2_WORDS            = 1 << OFFSET_BITS_L2,
+          L2_WIDTH            = L2_WORDS*DATA_WIDTH,
+          L2_TAG_BITS         = ADDRESS_BITS - OFFSET_BITS_L2 - INDEX_BITS_L2,
+          L2_WAY_BITS         = (NUMBER_OF_WAYS_L2 > 1) ? log2(NUMBER_OF_WAYS_L2) : 1,
+          L2_MBITS            = COHERENCE_BITS + STATUS_BITS_L2;
+
+localparam BUS_WORDS     = 1 << BUS_OFFSET_BITS;
+localparam BUS_WIDTH     = BUS_WORDS*DATA_WIDTH;
+localparam BUS_PORTS     = NUM_L1_CACHES + 1;
+localparam MEM_PORT      = BUS_PORTS - 1;
+localparam BUS_SIG_WIDTH = log2(BUS_PORTS);
+localparam WIDTH_BITS    = log2(MAX_OFFSET_BITS) + 1;
+
+// Define INCLUDE_FILE  to point to /includes/params.h. The path should be
+// relative to your simulation/sysnthesis directory. You can add the macro
+// when compiling this file in modelsim by adding the following argument to the
+// vlog command that compiles this module:
+// +define+INCLUDE_FILE="../../../includes/params.h"
+`include `INCLUDE_FILE
+
+
+reg  clock;
+reg  reset;
+//interface with processor pipelines
+reg  [NUM_L1_CACHES-1:0] read, write;
+reg  [NUM_L1_CACHES*DATA_WIDTH/8-1:0] w_byte_en;
+reg  [ADDRESS_BITS-1:0] address_s [NUM_L1_CACHES-1:0];
+wire [NUM_L1_CACHES*ADDRESS_BITS-1:0] address;
+reg  [DATA_WIDTH-1  :0] data_in_s [NUM_L1_CACHES-1:0];
+wire [NUM_L1_CACHES*DATA_WIDTH-1  :0] data_in;
+wire [ADDRESS_BITS-1:0] out_address_s [NUM_L1_CACHES-1:0];
+wire [NUM_L1_CACHES*ADDRESS_BITS-1:0] out_address;
+wire [DATA_WIDTH-1  :0] data_out_s [NUM_L1_CACHES-1:0];
+wire [NUM_L1_CACHES*DATA_WIDTH-1  :0] data_out;
+wire [NUM_L1_CACHES-1:0] valid, ready;
+//interface with memory side interface
+reg  [MSG_BITS-1    :0]     mem2cachehier_msg;
+reg  [ADDRESS_BITS-1:0] mem2cachehier_address;
+reg  [L2_WIDTH-1    :0]    mem2cachehier_data;
+reg  mem_intf_busy;
+reg  [ADDRESS_BITS-1:0] mem_intf_address;
+reg  mem_intf_address_valid;
+wire [MSG_BITS-1    :0]     cachehier2mem_msg;
+wire [ADDRESS_BITS-1:0] cachehier2mem_address;
+wire [L2_WIDTH-1    :0]    cachehier2mem_data;
+//interface for memory side interface to access cache memory
+reg  port1_read, port1_write, port1_invalidate;
+reg  [INDEX_BITS_L2-1 :0] port1_index;
+reg  [L2_TAG_BITS-1   :0] port1_tag;
+reg  [L2_MBITS-1      :0] port1_metadata;
+reg  [L2_WIDTH-1      :0] port1_write_data;
+reg  [L2_WAY_BITS-1   :0] port1_way_select;
+wire [L2_WIDTH-1      :0] port1_read_data;
+wire [L2_WAY_BITS-1   :0] port1_matched_way;
+wire [COHERENCE_BITS-1:0] port1_coh_bits;
+wire [STATUS_BITS_L2-1:0] port1_status_bits;
+wire port1_hit;
+
+reg  scan;
+
+//combine and split signals
+genvar j;
+generate
+  for(j=0; j<NUM_L1_CACHES; j=j+1)begin
+    assign address[j*ADDRESS_BITS +: ADDRESS_BITS] = address_s[j];
+    assign data_in[j*DATA_WIDTH   +: DATA_WIDTH  ] = data_in_s[j];
+  end
+  for(j=0; j<NUM_L1_CACHES; j=j+1)begin
+    assign data_out_s[j]    = data_out   [j*DATA_WIDTH   +: DATA_WIDTH  ];
+    assign out_address_s[j] = out_address[j*ADDRESS_BITS +: ADDRESS_BITS];
+  end
+endgenerate
+
+//Instantiate DUT
+two_level_cache_hierarchy #(
+  .STATUS_BITS_L1(STATUS_BITS_L1),
+  .OFFSET_BITS_L1(OFFSET_BITS_L1),
+  .NUMBER_OF_WAYS_L1(NUMBER_OF_WAYS_L1),
+  .INDEX_BITS_L1(INDEX_BITS_L1),
+  .REPLACEMENT_MODE_L1(REPLACEMENT_MODE_L1),
+  .STATUS_BITS_L2(STATUS_BITS_L2),
+  .OFFSET_BITS_L2(OFFSET_BITS_L2),
+  .NUMBER_OF_WAYS_L2(NUMBER_OF_WAYS_L2),
+  .INDEX_BITS_L2(INDEX_BITS_L2),
+  .REPLACEMENT_MODE_L2(REPLACEMENT_MODE_L2),
+  .L2_INCLUSION(L2_INCLUSION),
+  .L2_EXCLUSION(L2_EXCLUSION),
+  .COHERENCE_BITS(COHERENCE_BITS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .MSG_BITS(MSG_BITS),
+  .NUM_L1_CACHES(NUM_L1_CACHES),
+  .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
+  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  //interface with processor pipelines
+  .read(read),
+  .write(write),
+  .invalidate({4'b0000}),
+  .flush({4'b0000}),
+  .w_byte_en(w_byte_en),
+  .address(address),
+  .data_in(data_in),
+  .out_address(out_address),
+  .data_out(data_out),
+  .valid(valid),
+  .ready(ready),
+  //interface with memory side interface
+  .mem2cachehier_msg(mem2cachehier_msg),
+  .mem2cachehier_address(mem2cachehier_address),
+  .mem2cachehier_data(mem2cachehier_data),
+  .mem_intf_busy(mem_intf_busy),
+  .mem_intf_address(mem_intf_address),
+  .mem_intf_address_valid(mem_intf_address_valid),
+  .cachehier2mem_msg(cachehier2mem_msg),
+  .cachehier2mem_address(cachehier2mem_address),
+  .cachehier2mem_data(cachehier2mem_data),
+  //interface for memory side interface to access cache memory
+  .port1_read(port1_read),
+  .port1_write(port1_write),
+  .port1_invalidate(port1_invalidate),
+  .port1_index(port1_index),
+  .port1_tag(port1_tag),
+  .port1_metadata(port1_metadata),
+  .port1_write_data(port1_write_data),
+  .port1_way_select(port1_way_select),
+  .port1_read_data(port1_read_data),
+  .port1_matched_way(port1_matched_way),
+  .port1_coh_bits(port1_coh_bits),
+  .port1_status_bits(port1_status_bits),
+  .port1_hit(port1_hit),
+  
+  .scan(scan)
+);
+
+integer i;
+
+//clock signal
+always #1 clock = ~clock;
+
+//cycle counter
+reg [31:0] cycles;
+always @(posedge clock)begin
+  cycles <= cycles + 1;
+end
+
+
+/*Main memory model. Word k of a line holds 32'h10000000 plus its word
+* address. Writes are acknowledged and dropped.*/
+integer mem_reads, mem_writes, k;
+always @(posedge clock)begin
+  if(reset)begin
+    mem2cachehier_msg     <= NO_REQ;
+    mem2cachehier_address <= 32'd0;
+    mem2cachehier_data    <= 128'h0;
+    mem_reads             <= 0;
+    mem_writes            <= 0;
+  end
+  else if(((cachehier2mem_msg == R_REQ) | (cachehier2mem_msg == RFO_BCAST) |
+  (cachehier2mem_msg == WB_REQ)) & (mem2cachehier_msg == NO_REQ))begin
+    mem2cachehier_msg     <= MEM_RESP;
+    mem2cachehier_address <= cachehier2mem_address;
+    for(k=0; k<L2_WORDS; k=k+1)begin
+      mem2cachehier_data[k*DATA_WIDTH +: DATA_WIDTH] <= 32'h10000000 +
+        ((cachehier2mem_address >> OFFSET_BITS_L2) << OFFSET_BITS_L2) + k;
+    end
+    if(cachehier2mem_msg == WB_REQ)
+      mem_writes <= mem_writes + 1;
+    else
+      mem_reads  <= mem_reads + 1;
+  end
+  else begin
+    mem2cachehier_msg     <= NO_REQ;
+    mem2cachehier_address <= 32'd0;
+    mem2cachehier_data    <= 128'h0;
+  end
+end
+
+task access;
+  input integer cache;
+  input is_write;
+  input [ADDRESS_BITS-1:0] byte_address;
+  input [DATA_WIDTH-1:0]   data;
+  begin
+    wait(ready[cache]);
+    @(posedge clock)begin
+      read[cache]      <= ~is_write;
+      write[cache]     <= is_write;
+      address_s[cache] <= byte_address;
+      data_in_s[cache] <= data;
+    end
+    @(posedge clock)begin
+      read[cache]      <= 1'b0;
+      write[cache]     <= 1'b0;
+      address_s[cache] <= 32'd0;
+      data_in_s[cache] <= 32'd0;
+    end
+    if(~is_write)begin
+      //an early restart word is valid in the cycle it arrives, check it once
+      //the cycle settled
+      wait(valid[cache]);
+      @(negedge clock);
+      if(data_out_s[cache] != data)begin
+        $display("Error! L1 cache %0d read %h from %h, expected %h.", cache,
+                 data_out_s[cache], byte_address, data);
+        $display("\ntb_two_level_cache_hierarchy_exclusive --> Test Failed!\n\n");
+        $stop;
+      end
+    end
+    else begin
+      @(posedge clock);
+      wait(ready[cache]);
+    end
+  end
+endtask
+
+task expect_mem_reads;
+  input integer expected;
+  begin
+    if(mem_reads != expected)begin
+      $display("Error! %0d main memory reads, expected %0d.", mem_reads, expected);
+      $display("\ntb_two_level_cache_hierarchy_exclusive --> Test Failed!\n\n");
+      $stop;
+    end
+  end
+endtask
+
+//looks the line up in the L2 through port1
+task expect_l2;
+  input [ADDRESS_BITS-1:0] byte_address;
+  input expected;
+  begin
+    @(posedge clock)begin
+      port1_read  <= 1'b1;
+      port1_index <= (byte_address >> 2) >> OFFSET_BITS_L2;
+      port1_tag   <= (byte_address >> 2) >> (OFFSET_BITS_L2 + INDEX_BITS_L2);
+    end
+    @(posedge clock)begin
+      port1_read  <= 1'b0;
+      port1_index <= {INDEX_BITS_L2{1'b0}};
+      port1_tag   <= {L2_TAG_BITS{1'b0}};
+    end
+    @(negedge clock);
+    if(port1_hit != expected)begin
+      $display("Error! L2 hit for %h is %b, expected %b.", byte_address,
+               port1_hit, expected);
+      $display("\ntb_two_level_cache_hierarchy_exclusive --> Test Failed!\n\n");
+      $stop;
+    end
+  end
+endtask
+
+initial begin
+  clock     = 1'b0;
+  reset     = 1'b0;
+  cycles    = 0;
+  w_byte_en = {NUM_L1_CACHES*(DATA_WIDTH/8){1'b1}};
+  for(i=0; i<NUM_L1_CACHES; i=i+1)begin
+    address_s[i]  = 32'd0;
+    data_in_s[i]  = 32'd0;
+    read[i]       = 1'b0;
+    write[i]      = 1'b0;
+  end
+  mem_intf_busy          = 0;
+  mem_intf_address       = 32'd0;
+  mem_intf_address_valid = 0;
+
+  port1_read       = 1'b0;
+  port1_write      = 1'b0;
+  port1_invalidate = 1'b0;
+  port1_index      = {INDEX_BITS_L2{1'b0}};
+  port1_tag        = {L2_TAG_BITS{1'b0}};
+  port1_metadata   = {L2_MBITS{1'b0}};
+  port1_write_data = 128'h0;
+  port1_way_select = {L2_WAY_BITS{1'b0}};
+
+  scan = 1'b0;
+
+  //reset
+  repeat(1) @(posedge clock);
+  @(posedge clock) reset <= 1;
+  repeat(3) @(posedge clock);
+  @(posedge clock) reset <= 0;
+
+  //wait for the L1 and L2 caches to finish their reset sequences
+  wait(DUT.L1INST[0].L1CACHE.cache.controller.state == 4'd0 &
+       DUT.l2cache.controller.state == 4'd0);
+  $display("%0d> caches finished reset sequence", cycles-1);
+
+  //Lines A (0x100), B (0x140) and C (0x180) map to the same 2-way L1 set.
+  //Line fills from memory are not allocated in the L2.
+  access(0, 1'b0, 32'h00000104, 32'h10000041);
+  access(0, 1'b0, 32'h00000140, 32'h10000050);
+  expect_mem_reads(2);
+  expect_l2(32'h00000100, 1'b0);
+
+  //C evicts the clean line A from L1 cache 0 into the L2 with WB_CLEAN
+  access(0, 1'b0, 32'h00000188, 32'h10000062);
+  expect_mem_reads(3);
+  expect_l2(32'h00000100, 1'b1);
+
+  //L1 cache 1 reads A from the L2. The L2 copy moves up.
+  access(1, 1'b0, 32'h0000010c, 32'h10000043);
+  expect_mem_reads(3);
+  expect_l2(32'h00000100, 1'b0);
+  $display("%0d> clean victim served by the L2", cycles-1);
+
+  //L1 cache 1 writes A. The shared line is upgraded with WS_BCAST.
+  access(1, 1'b1, 32'h00000100, 32'hcafe0001);
+
+  //L1 cache 0 reads A. L1 cache 1 writes the line back with C_WB, the L2
+  //allocates it and keeps the dirty copy.
+  access(0, 1'b0, 32'h00000100, 32'hcafe0001);
+  expect_mem_reads(3);
+  expect_l2(32'h00000100, 1'b1);
+
+  //B and C evict A from L1 cache 0 again. The L2 copy is still valid.
+  access(0, 1'b0, 32'h00000144, 32'h10000051);
+  access(0, 1'b0, 32'h00000184, 32'h10000061);
+  access(2, 1'b0, 32'h00000100, 32'hcafe0001);
+  access(2, 1'b0, 32'h00000108, 32'h10000042);
+  expect_mem_reads(3);
+  //only clean lines move up, the dirty copy stays in the L2
+  expect_l2(32'h00000100, 1'b1);
+  $display("%0d> %0d main memory reads, %0d writes", cycles-1, mem_reads,
+           mem_writes);
+
+  //Test passed
+  #20;
+  $display("\ntb_two_level_cache_hierarchy_exclusive --> Test Passed!\n\n");
+  $stop;
+end
+
+//timeout
+initial begin
+  #5000;
+  $display("Error! Timeout.");
+  $display("\ntb_two_level_cache_hierarchy_exclusive --> Test Failed!\n\n");
+  $stop;
+end
+
+endmodule
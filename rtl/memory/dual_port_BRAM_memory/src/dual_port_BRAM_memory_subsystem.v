@@ -20,9 +20,21 @@
  *  THE SOFTWARE.
  */
 
+/** Module description
+ * --------------------
+ *  - Instruction and data memory in one dual port byte enabled BRAM. Both
+ *    ports are always ready and return data the cycle after the request.
+ *  - FETCH_WIDTH is the width of i_mem_data_out. With FETCH_WIDTH larger than
+ *    DATA_WIDTH each memory row holds FETCH_WIDTH/DATA_WIDTH words, a fetch
+ *    returns the aligned row and the data port accesses the word of the row
+ *    selected by the address. INIT_FILE_BASE files must then be split into
+ *    FETCH_WIDTH/8 byte lanes.
+ */
+
 module dual_port_BRAM_memory_subsystem #(
   parameter DATA_WIDTH       = 32,
   parameter ADDRESS_BITS     = 32,
+  parameter FETCH_WIDTH      = DATA_WIDTH,
   parameter MEM_ADDRESS_BITS = 12,
   parameter INIT_FILE_BASE   = "",
   parameter SCAN_CYCLES_MIN  = 0,
@@ -33,7 +45,7 @@ module dual_port_BRAM_memory_subsystem #(
   //instruction memory
   input      i_mem_read,
   input      [ADDRESS_BITS-1:0] i_mem_address_in,
-  output     [DATA_WIDTH-1  :0] i_mem_data_out,
+  output     [FETCH_WIDTH-1 :0] i_mem_data_out,
   output reg [ADDRESS_BITS-1:0] i_mem_address_out,
   output reg i_mem_valid,
   output     i_mem_ready,
@@ -62,12 +74,29 @@ end
 endfunction
 
 
-localparam NUM_BYTES = DATA_WIDTH/8;
+localparam NUM_BYTES       = DATA_WIDTH/8;
+localparam FETCH_BYTES     = FETCH_WIDTH/8;
+localparam WORDS_PER_FETCH = FETCH_WIDTH/DATA_WIDTH;
+
+// Position of the data port word in the memory row
+wire [ADDRESS_BITS-1:0] d_word_in;
+wire [ADDRESS_BITS-1:0] d_word_out;
+
+wire [FETCH_BYTES-1:0] d_row_byte_en;
+wire [FETCH_WIDTH-1:0] d_row_data_in;
+wire [FETCH_WIDTH-1:0] d_row_data_out;
+
+assign d_word_in  = (d_mem_address_in  >> log2(NUM_BYTES)) & (WORDS_PER_FETCH-1);
+assign d_word_out = (d_mem_address_out >> log2(NUM_BYTES)) & (WORDS_PER_FETCH-1);
+
+assign d_row_byte_en  = d_mem_byte_en << (d_word_in * NUM_BYTES);
+assign d_row_data_in  = {WORDS_PER_FETCH{d_mem_data_in}};
+assign d_mem_data_out = d_row_data_out >> (d_word_out * DATA_WIDTH);
 
 dual_port_BRAM_byte_en #(
   .CORE(0),
-  .DATA_WIDTH(DATA_WIDTH),
-  .ADDR_WIDTH(MEM_ADDRESS_BITS-log2(NUM_BYTES)),
+  .DATA_WIDTH(FETCH_WIDTH),
+  .ADDR_WIDTH(MEM_ADDRESS_BITS-log2(FETCH_BYTES)),
   .INIT_FILE_BASE(INIT_FILE_BASE),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
@@ -77,17 +106,17 @@ dual_port_BRAM_byte_en #(
   // Port // instruction fetch
   .readEnable_1(i_mem_read),
   .writeEnable_1(1'b0),
-  .writeByteEnable_1({NUM_BYTES{1'b0}}),
-  .address_1(i_mem_address_in[MEM_ADDRESS_BITS-1:log2(NUM_BYTES)]),
-  .writeData_1({DATA_WIDTH{1'b0}}),
+  .writeByteEnable_1({FETCH_BYTES{1'b0}}),
+  .address_1(i_mem_address_in[MEM_ADDRESS_BITS-1:log2(FETCH_BYTES)]),
+  .writeData_1({FETCH_WIDTH{1'b0}}),
   .readData_1(i_mem_data_out),
   // Port 2 // data memory operations
   .readEnable_2(d_mem_read),
   .writeEnable_2(d_mem_write),
-  .writeByteEnable_2(d_mem_byte_en),
-  .address_2(d_mem_address_in[MEM_ADDRESS_BITS-1:log2(NUM_BYTES)]),
-  .writeData_2(d_mem_data_in),
-  .readData_2(d_mem_data_out),
+  .writeByteEnable_2(d_row_byte_en),
+  .address_2(d_mem_address_in[MEM_ADDRESS_BITS-1:log2(FETCH_BYTES)]),
+  .writeData_2(d_row_data_in),
+  .readData_2(d_row_data_out),
   // scan signal
   .scan(scan)
 );
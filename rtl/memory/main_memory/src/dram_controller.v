@@ -0,0 +1,479 @@
+/** @module : dram_controller
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Timing model of a DRAM controller for main_memory (TIMING_MODEL =
+ *    "DRAM"). It schedules the R_REQ/WB_REQ word requests of the memory ports
+ *    and drives the storage port of main_memory. It holds no data.
+ *  - Word addresses map to {row, bank, column}. The low COLUMN_BITS select
+ *    the column, so a row holds 2^COLUMN_BITS words and consecutive rows are
+ *    interleaved over NUM_BANKS banks.
+ *  - Every bank keeps its last row open (OPEN_PAGE = 1) or closes it after
+ *    each access (OPEN_PAGE = 0). An access to the open row takes T_CAS
+ *    cycles, an access to a closed bank T_RCD + T_CAS cycles and an access
+ *    to another row T_RP + T_RCD + T_CAS cycles. A bank accepts a new row
+ *    command once the previous activate finished. Column commands to an open
+ *    row are pipelined, one per cycle.
+ *  - Up to QUEUE_DEPTH requests wait in a queue. Banks work in parallel and
+ *    the scheduler issues one request per cycle with FR-FCFS: row hits
+ *    first, then the oldest request. Requests that waited 2^AGE_BITS-1
+ *    cycles win over row hits. A request is not issued before older queued
+ *    requests to the same address, or the same burst with BURST_READS = 1,
+ *    completed.
+ *  - Writes are posted. WB_REQ is answered with MEM_RESP the cycle after it
+ *    enters the queue and written to storage when its access completes, so
+ *    following reads can overlap or pass it. Reads are answered when their
+ *    access completed.
+ *  - A column access returns a burst of BURST_WORDS aligned words, the
+ *    requested word first and the others wrapping around it, one per cycle.
+ *    With BURST_READS = 0 every word is requested on its own and a read of a
+ *    word of the last burst of its bank only waits for that word to arrive.
+ *    With BURST_READS = 1 one R_REQ returns the whole burst as BURST_WORDS
+ *    MEM_RESP beats on consecutive cycles, each with the address of its word.
+ *    main_memory_interface uses these with its BURST_READS parameter.
+ *  - Storage is read in the cycle before the response. Only one access
+ *    completes per cycle, which models the shared data bus.
+ *  - row_hits, row_misses, row_conflicts and burst_hits count the issued
+ *    accesses by kind for performance studies.
+ */
+
+module dram_controller #(
+  parameter DATA_WIDTH    = 32,
+  parameter ADDRESS_WIDTH = 32,
+  parameter MSG_BITS      = 4,
+  parameter NUM_PORTS     = 1,
+  parameter NUM_BANKS     = 4,
+  parameter COLUMN_BITS   = 8,
+  parameter BURST_WORDS   = 4,
+  parameter BURST_READS   = 0,
+  parameter QUEUE_DEPTH   = 4,
+  parameter T_RCD         = 4,
+  parameter T_CAS         = 4,
+  parameter T_RP          = 4,
+  parameter OPEN_PAGE     = 1,
+  parameter AGE_BITS      = 8,
+  parameter COUNTER_BITS  = 32
+) (
+  input clock,
+  input reset,
+  input [NUM_PORTS*MSG_BITS-1:0] msg_in,
+  input [NUM_PORTS*ADDRESS_WIDTH-1:0] address,
+  input [NUM_PORTS*DATA_WIDTH-1:0] data_in,
+  output [NUM_PORTS*MSG_BITS-1:0] msg_out,
+  output [NUM_PORTS*ADDRESS_WIDTH-1:0] address_out,
+  output [NUM_PORTS-1:0] data_select,
+  output [ADDRESS_WIDTH-1:0] mem_address,
+  output [DATA_WIDTH-1:0] mem_data,
+  output mem_write
+);
+
+//define the log2 function
+function integer log2;
+input integer value;
+begin
+  value = value-1;
+  for (log2=0; value>0; log2=log2+1)
+    value = value >> 1;
+end
+endfunction
+
+localparam BANK_BITS   = NUM_BANKS > 1 ? log2(NUM_BANKS) : 1;
+localparam ROW_SHIFT   = COLUMN_BITS + log2(NUM_BANKS);
+localparam BURST_SHIFT = log2(BURST_WORDS);
+localparam BEAT_BITS   = log2(BURST_WORDS) + 1;
+localparam QUEUE_BITS  = QUEUE_DEPTH > 1 ? log2(QUEUE_DEPTH) : 1;
+localparam PORT_BITS   = NUM_PORTS > 1 ? log2(NUM_PORTS) : 1;
+localparam TIMER_BITS  = log2(T_RP + T_RCD + T_CAS + BURST_WORDS + 1) + 1;
+localparam KEY_BITS    = AGE_BITS + 2;
+
+// Define INCLUDE_FILE  to point to /includes/params.h. The path should be
+// relative to your simulation/sysnthesis directory. You can add the macro
+// when compiling this file in modelsim by adding the following argument to the
+// vlog command that compiles this module:
+// +define+INCLUDE_FILE="../../../includes/params.h"
+`include `INCLUDE_FILE
+
+function [BANK_BITS-1:0] bank_of;
+  input [ADDRESS_WIDTH-1:0] word_address;
+  begin
+    bank_of = NUM_BANKS > 1 ? word_address[COLUMN_BITS +: BANK_BITS] : 0;
+  end
+endfunction
+
+function [ADDRESS_WIDTH-1:0] row_of;
+  input [ADDRESS_WIDTH-1:0] word_address;
+  begin
+    row_of = word_address >> ROW_SHIFT;
+  end
+endfunction
+
+// Next word of the burst, wrapping at the burst boundary
+function [ADDRESS_WIDTH-1:0] next_beat;
+  input [ADDRESS_WIDTH-1:0] word_address;
+  begin
+    next_beat = ((word_address >> BURST_SHIFT) << BURST_SHIFT) |
+                ((word_address + 1) & (BURST_WORDS-1));
+  end
+endfunction
+
+genvar i;
+integer j;
+// One loop variable per combinational block
+integer a, s, c, d;
+
+// Request queue
+reg [QUEUE_DEPTH-1:0]   q_valid;
+reg [QUEUE_DEPTH-1:0]   q_issued;
+reg [QUEUE_DEPTH-1:0]   q_write;
+reg [PORT_BITS-1:0]     q_port    [QUEUE_DEPTH-1:0];
+reg [ADDRESS_WIDTH-1:0] q_address [QUEUE_DEPTH-1:0];
+reg [DATA_WIDTH-1:0]    q_data    [QUEUE_DEPTH-1:0];
+reg [AGE_BITS-1:0]      q_age     [QUEUE_DEPTH-1:0];
+reg [TIMER_BITS-1:0]    q_timer   [QUEUE_DEPTH-1:0];
+// Older entries to the same address this entry waits for
+reg [QUEUE_DEPTH-1:0]   q_depends [QUEUE_DEPTH-1:0];
+
+// Banks
+reg [NUM_BANKS-1:0]     row_open;
+reg [ADDRESS_WIDTH-1:0] open_row    [NUM_BANKS-1:0];
+reg [TIMER_BITS-1:0]    bank_timer  [NUM_BANKS-1:0];
+reg [NUM_BANKS-1:0]     burst_valid;
+reg [ADDRESS_WIDTH-1:0] burst_first [NUM_BANKS-1:0];
+reg [TIMER_BITS-1:0]    burst_wait  [NUM_BANKS-1:0];
+reg [BEAT_BITS-1:0]     burst_beats [NUM_BANKS-1:0];
+
+// Ports and data bus
+reg [NUM_PORTS-1:0]     port_busy;
+reg [MSG_BITS-1:0]      r_msg_out     [NUM_PORTS-1:0];
+reg [ADDRESS_WIDTH-1:0] r_address_out [NUM_PORTS-1:0];
+reg [NUM_PORTS-1:0]     r_data_select;
+reg [PORT_BITS-1:0]     accept_next;
+reg [BEAT_BITS-1:0]     beats_left;
+reg [PORT_BITS-1:0]     beat_port;
+reg [ADDRESS_WIDTH-1:0] beat_address;
+
+reg [COUNTER_BITS-1:0] row_hits;
+reg [COUNTER_BITS-1:0] row_misses;
+reg [COUNTER_BITS-1:0] row_conflicts;
+reg [COUNTER_BITS-1:0] burst_hits;
+
+// Scheduler decisions
+reg                   free_found;
+reg [QUEUE_BITS-1:0]  free_slot;
+reg                   accept_found;
+reg [PORT_BITS-1:0]   accept_port;
+reg                   issue_found;
+reg [QUEUE_BITS-1:0]  issue_slot;
+reg [KEY_BITS-1:0]    issue_key;
+reg                   complete_found;
+reg [QUEUE_BITS-1:0]  complete_slot;
+reg [QUEUE_DEPTH-1:0] same_address;
+integer p;
+
+wire [MSG_BITS-1:0]      w_msg_in     [NUM_PORTS-1:0];
+wire [ADDRESS_WIDTH-1:0] w_address_in [NUM_PORTS-1:0];
+wire [DATA_WIDTH-1:0]    w_data_in    [NUM_PORTS-1:0];
+wire [NUM_PORTS-1:0]     port_request;
+
+wire [BANK_BITS-1:0]  e_bank      [QUEUE_DEPTH-1:0];
+wire [BEAT_BITS-1:0]  e_beat      [QUEUE_DEPTH-1:0];
+wire [KEY_BITS-1:0]   e_key       [QUEUE_DEPTH-1:0];
+wire [QUEUE_DEPTH-1:0] e_row_hit;
+wire [QUEUE_DEPTH-1:0] e_burst_hit;
+wire [QUEUE_DEPTH-1:0] e_ready;
+wire [QUEUE_DEPTH-1:0] e_done;
+
+wire [BANK_BITS-1:0]     s_bank;
+wire [ADDRESS_WIDTH-1:0] s_row;
+wire [BEAT_BITS-1:0]     s_beat;
+wire [TIMER_BITS-1:0]    s_burst_latency;
+wire [TIMER_BITS-1:0]    s_latency;
+wire                     bus_free;
+
+generate
+  for(i=0; i<NUM_PORTS; i=i+1) begin : PORTS
+    assign w_msg_in[i]     = msg_in[i*MSG_BITS +: MSG_BITS];
+    assign w_address_in[i] = address[i*ADDRESS_WIDTH +: ADDRESS_WIDTH];
+    assign w_data_in[i]    = data_in[i*DATA_WIDTH +: DATA_WIDTH];
+
+    // The request of the previous response is still on the inputs while
+    // MEM_RESP is driven.
+    assign port_request[i] = ((w_msg_in[i] == R_REQ) | (w_msg_in[i] == WB_REQ)) &
+                             ~port_busy[i] & (r_msg_out[i] != MEM_RESP);
+
+    assign msg_out[i*MSG_BITS +: MSG_BITS]              = r_msg_out[i];
+    assign address_out[i*ADDRESS_WIDTH +: ADDRESS_WIDTH] = r_address_out[i];
+  end
+
+  for(i=0; i<QUEUE_DEPTH; i=i+1) begin : ENTRIES
+    assign e_bank[i]      = bank_of(q_address[i]);
+    assign e_row_hit[i]   = row_open[e_bank[i]] &
+                            (open_row[e_bank[i]] == row_of(q_address[i]));
+    assign e_burst_hit[i] = ~q_write[i] & burst_valid[e_bank[i]] &
+                            ((burst_first[e_bank[i]] >> BURST_SHIFT) ==
+                             (q_address[i] >> BURST_SHIFT));
+    // Position of the word in the burst of its bank
+    assign e_beat[i]      = (q_address[i] - burst_first[e_bank[i]]) & (BURST_WORDS-1);
+    assign e_ready[i]     = q_valid[i] & ~q_issued[i] & ~|q_depends[i] &
+                            (e_burst_hit[i] | (bank_timer[e_bank[i]] == 0));
+    assign e_key[i]       = {&q_age[i], e_row_hit[i] | e_burst_hit[i], q_age[i]};
+    assign e_done[i]      = q_valid[i] & q_issued[i] & (q_timer[i] == 0);
+  end
+endgenerate
+
+// Free queue slot and the next port to accept, round robin
+always @(*) begin
+  free_found = 1'b0;
+  free_slot  = {QUEUE_BITS{1'b0}};
+  for(a=QUEUE_DEPTH-1; a>=0; a=a-1) begin
+    if(~q_valid[a]) begin
+      free_found = 1'b1;
+      free_slot  = a;
+    end
+  end
+
+  accept_found = 1'b0;
+  accept_port  = {PORT_BITS{1'b0}};
+  for(a=0; a<NUM_PORTS; a=a+1) begin
+    p = (accept_next + a) % NUM_PORTS;
+    if(~accept_found & port_request[p]) begin
+      accept_found = 1'b1;
+      accept_port  = p;
+    end
+  end
+  accept_found = accept_found & free_found;
+end
+
+// FR-FCFS: starving requests, then row hits, then the oldest request. The
+// lowest slot wins ties.
+always @(*) begin
+  issue_found = 1'b0;
+  issue_slot  = {QUEUE_BITS{1'b0}};
+  issue_key   = {KEY_BITS{1'b0}};
+  for(s=0; s<QUEUE_DEPTH; s=s+1) begin
+    if(e_ready[s] & (~issue_found | (e_key[s] > issue_key))) begin
+      issue_found = 1'b1;
+      issue_slot  = s;
+      issue_key   = e_key[s];
+    end
+  end
+end
+
+// Oldest completed access gets the data bus when no burst is on it
+assign bus_free = (beats_left == 0);
+
+always @(*) begin
+  complete_found = 1'b0;
+  complete_slot  = {QUEUE_BITS{1'b0}};
+  for(c=0; c<QUEUE_DEPTH; c=c+1) begin
+    if(bus_free & e_done[c] & (~complete_found | (q_age[c] > q_age[complete_slot]))) begin
+      complete_found = 1'b1;
+      complete_slot  = c;
+    end
+  end
+end
+
+// Queued requests an accepted request has to wait for. Burst reads touch
+// every word of their burst.
+always @(*) begin
+  for(d=0; d<QUEUE_DEPTH; d=d+1) begin
+    same_address[d] = q_valid[d] & ~(complete_found & (complete_slot == d)) &
+                      (BURST_READS ? ((q_address[d] >> BURST_SHIFT) ==
+                                      (w_address_in[accept_port] >> BURST_SHIFT)) :
+                                     (q_address[d] == w_address_in[accept_port]));
+  end
+end
+
+// Latency of the access issued this cycle
+assign s_bank   = e_bank[issue_slot];
+assign s_row    = row_of(q_address[issue_slot]);
+assign s_beat   = e_beat[issue_slot];
+
+assign s_burst_latency = burst_wait[s_bank] +
+                         ((s_beat > burst_beats[s_bank]) ? s_beat - burst_beats[s_bank] : 0);
+
+assign s_latency = e_burst_hit[issue_slot] ?
+                     ((s_burst_latency == 0) ? 1 : s_burst_latency) :
+                   e_row_hit[issue_slot] ? T_CAS :
+                   row_open[s_bank]      ? T_RP + T_RCD + T_CAS :
+                                           T_RCD + T_CAS;
+
+// Storage port: a completed access or the next beat of a burst
+assign mem_address = ~bus_free       ? beat_address :
+                     complete_found ? q_address[complete_slot] :
+                                      {ADDRESS_WIDTH{1'b0}};
+assign mem_data    = complete_found ? q_data[complete_slot] : {DATA_WIDTH{1'b0}};
+assign mem_write   = complete_found & q_write[complete_slot];
+
+assign data_select = r_data_select;
+
+always @(posedge clock) begin
+  if(reset) begin
+    q_valid       <= {QUEUE_DEPTH{1'b0}};
+    q_issued      <= {QUEUE_DEPTH{1'b0}};
+    q_write       <= {QUEUE_DEPTH{1'b0}};
+    row_open      <= {NUM_BANKS{1'b0}};
+    burst_valid   <= {NUM_BANKS{1'b0}};
+    port_busy     <= {NUM_PORTS{1'b0}};
+    r_data_select <= {NUM_PORTS{1'b0}};
+    accept_next   <= {PORT_BITS{1'b0}};
+    beats_left    <= {BEAT_BITS{1'b0}};
+    beat_port     <= {PORT_BITS{1'b0}};
+    beat_address  <= {ADDRESS_WIDTH{1'b0}};
+    row_hits      <= {COUNTER_BITS{1'b0}};
+    row_misses    <= {COUNTER_BITS{1'b0}};
+    row_conflicts <= {COUNTER_BITS{1'b0}};
+    burst_hits    <= {COUNTER_BITS{1'b0}};
+    for(j=0; j<QUEUE_DEPTH; j=j+1) begin
+      q_port[j]    <= {PORT_BITS{1'b0}};
+      q_address[j] <= {ADDRESS_WIDTH{1'b0}};
+      q_data[j]    <= {DATA_WIDTH{1'b0}};
+      q_age[j]     <= {AGE_BITS{1'b0}};
+      q_timer[j]   <= {TIMER_BITS{1'b0}};
+      q_depends[j] <= {QUEUE_DEPTH{1'b0}};
+    end
+    for(j=0; j<NUM_BANKS; j=j+1) begin
+      open_row[j]    <= {ADDRESS_WIDTH{1'b0}};
+      bank_timer[j]  <= {TIMER_BITS{1'b0}};
+      burst_first[j] <= {ADDRESS_WIDTH{1'b0}};
+      burst_wait[j]  <= {TIMER_BITS{1'b0}};
+      burst_beats[j] <= {BEAT_BITS{1'b0}};
+    end
+    for(j=0; j<NUM_PORTS; j=j+1) begin
+      r_msg_out[j]     <= NO_REQ;
+      r_address_out[j] <= {ADDRESS_WIDTH{1'b0}};
+    end
+  end
+  else begin
+    r_data_select <= {NUM_PORTS{1'b0}};
+    for(j=0; j<NUM_PORTS; j=j+1) begin
+      r_msg_out[j]     <= NO_REQ;
+      r_address_out[j] <= {ADDRESS_WIDTH{1'b0}};
+    end
+
+    for(j=0; j<QUEUE_DEPTH; j=j+1) begin
+      if(q_valid[j] & ~&q_age[j])
+        q_age[j] <= q_age[j] + 1;
+      if(q_issued[j] & (q_timer[j] != 0))
+        q_timer[j] <= q_timer[j] - 1;
+    end
+
+    for(j=0; j<NUM_BANKS; j=j+1) begin
+      if(bank_timer[j] != 0)
+        bank_timer[j] <= bank_timer[j] - 1;
+      if(burst_wait[j] != 0)
+        burst_wait[j] <= burst_wait[j] - 1;
+      else if(burst_beats[j] < BURST_WORDS)
+        burst_beats[j] <= burst_beats[j] + 1;
+    end
+
+    // Remaining beats of a burst read
+    if(~bus_free) begin
+      r_msg_out[beat_port]     <= MEM_RESP;
+      r_address_out[beat_port] <= beat_address;
+      r_data_select[beat_port] <= 1'b1;
+      beat_address             <= next_beat(beat_address);
+      beats_left               <= beats_left - 1;
+      if(beats_left == 1)
+        port_busy[beat_port] <= 1'b0;
+    end
+
+    if(complete_found) begin
+      q_valid[complete_slot]  <= 1'b0;
+      q_issued[complete_slot] <= 1'b0;
+      for(j=0; j<QUEUE_DEPTH; j=j+1)
+        q_depends[j][complete_slot] <= 1'b0;
+      if(~q_write[complete_slot]) begin
+        r_msg_out[q_port[complete_slot]]     <= MEM_RESP;
+        r_address_out[q_port[complete_slot]] <= q_address[complete_slot];
+        r_data_select[q_port[complete_slot]] <= 1'b1;
+        if(BURST_READS & (BURST_WORDS > 1)) begin
+          beats_left   <= BURST_WORDS-1;
+          beat_port    <= q_port[complete_slot];
+          beat_address <= next_beat(q_address[complete_slot]);
+        end
+        else begin
+          port_busy[q_port[complete_slot]] <= 1'b0;
+        end
+      end
+    end
+
+    if(issue_found) begin
+      q_issued[issue_slot] <= 1'b1;
+      q_timer[issue_slot]  <= s_latency - 1;
+      if(e_burst_hit[issue_slot]) begin
+        burst_hits <= burst_hits + 1;
+      end
+      else begin
+        if(e_row_hit[issue_slot]) begin
+          row_hits <= row_hits + 1;
+        end
+        else if(row_open[s_bank]) begin
+          bank_timer[s_bank] <= T_RP + T_RCD - 1;
+          row_conflicts      <= row_conflicts + 1;
+        end
+        else begin
+          bank_timer[s_bank] <= T_RCD - 1;
+          row_misses         <= row_misses + 1;
+        end
+        row_open[s_bank] <= OPEN_PAGE ? 1'b1 : 1'b0;
+        open_row[s_bank] <= s_row;
+
+        // A read starts a new burst at its word. A write to the words of the
+        // last burst makes the burst stale.
+        if(~q_write[issue_slot]) begin
+          burst_valid[s_bank] <= 1'b1;
+          burst_first[s_bank] <= q_address[issue_slot];
+          burst_wait[s_bank]  <= s_latency - 1;
+          burst_beats[s_bank] <= {BEAT_BITS{1'b0}};
+        end
+        else if((burst_first[s_bank] >> BURST_SHIFT) ==
+                (q_address[issue_slot] >> BURST_SHIFT)) begin
+          burst_valid[s_bank] <= 1'b0;
+        end
+      end
+    end
+
+    if(accept_found) begin
+      q_valid[free_slot]   <= 1'b1;
+      q_issued[free_slot]  <= 1'b0;
+      q_write[free_slot]   <= (w_msg_in[accept_port] == WB_REQ);
+      q_port[free_slot]    <= accept_port;
+      q_address[free_slot] <= w_address_in[accept_port];
+      q_data[free_slot]    <= w_data_in[accept_port];
+      q_age[free_slot]     <= {AGE_BITS{1'b0}};
+      q_timer[free_slot]   <= {TIMER_BITS{1'b0}};
+      q_depends[free_slot] <= same_address;
+      accept_next          <= (accept_port == NUM_PORTS-1) ? 0 : accept_port + 1;
+      if(w_msg_in[accept_port] == WB_REQ) begin
+        r_msg_out[accept_port]     <= MEM_RESP;
+        r_address_out[accept_port] <= w_address_in[accept_port];
+      end
+      else begin
+        port_busy[accept_port] <= 1'b1;
+      end
+    end
+  end
+end
+
+endmodule
@@ -26,7 +26,19 @@ parameter DATA_WIDTH    = 32,
           MSG_BITS      = 4,
           INDEX_BITS    = 15,
           NUM_PORTS     = 1,
-          PROGRAM       = ""
+          PROGRAM       = "",
+          // "FIXED" serves one word request at a time. "DRAM" schedules the
+          // requests with the bank and row buffer model of dram_controller.
+          TIMING_MODEL     = "FIXED",
+          DRAM_BANKS       = 4,
+          DRAM_COLUMN_BITS = 8,
+          DRAM_BURST_WORDS = 4,
+          DRAM_BURST_READS = 0,
+          DRAM_QUEUE_DEPTH = 4,
+          DRAM_T_RCD       = 4,
+          DRAM_T_CAS       = 4,
+          DRAM_T_RP        = 4,
+          DRAM_OPEN_PAGE   = 1
 )(
 clock, reset,
 msg_in,
@@ -88,6 +100,12 @@ wire we0;
 wire [DATA_WIDTH-1 : 0]    data_in0;
 wire [ADDRESS_WIDTH-1 : 0] address0;
 wire [DATA_WIDTH-1 : 0]  data_out0, data_out1;
+wire [NUM_PORTS*MSG_BITS-1 : 0]      dram_msg_out;
+wire [NUM_PORTS*ADDRESS_WIDTH-1 : 0] dram_address_out;
+wire [NUM_PORTS-1 : 0]               dram_data_select;
+wire [ADDRESS_WIDTH-1 : 0]           dram_address;
+wire [DATA_WIDTH-1 : 0]              dram_data;
+wire dram_write;
 
 generate
   for(i=0;i<NUM_PORTS; i=i+1)begin : SPLIT_INPUTS
@@ -98,9 +116,12 @@ generate
   end
 endgenerate
 
-assign address0 = (state == SERVING) ? t_address : 0;
-assign data_in0 = (state == SERVING) ? t_data    : 0;
-assign we0      = (state == SERVING) & (t_msg == WB_REQ);
+assign address0 = (TIMING_MODEL == "DRAM") ? dram_address :
+                  (state == SERVING) ? t_address : 0;
+assign data_in0 = (TIMING_MODEL == "DRAM") ? dram_data :
+                  (state == SERVING) ? t_data    : 0;
+assign we0      = (TIMING_MODEL == "DRAM") ? dram_write :
+                  (state == SERVING) & (t_msg == WB_REQ);
 
 // Instantiate round-robin arbitrator
 generate if(NUM_PORTS > 1)
@@ -128,6 +149,47 @@ simple_dual_port_ram #(
 );
 
 
+// DRAM timing model. The FSM below keeps running but does not drive the
+// storage or the outputs.
+generate if(TIMING_MODEL == "DRAM") begin : DRAM
+  dram_controller #(
+    .DATA_WIDTH(DATA_WIDTH),
+    .ADDRESS_WIDTH(ADDRESS_WIDTH),
+    .MSG_BITS(MSG_BITS),
+    .NUM_PORTS(NUM_PORTS),
+    .NUM_BANKS(DRAM_BANKS),
+    .COLUMN_BITS(DRAM_COLUMN_BITS),
+    .BURST_WORDS(DRAM_BURST_WORDS),
+    .BURST_READS(DRAM_BURST_READS),
+    .QUEUE_DEPTH(DRAM_QUEUE_DEPTH),
+    .T_RCD(DRAM_T_RCD),
+    .T_CAS(DRAM_T_CAS),
+    .T_RP(DRAM_T_RP),
+    .OPEN_PAGE(DRAM_OPEN_PAGE)
+  ) controller (
+    .clock(clock),
+    .reset(reset),
+    .msg_in(msg_in),
+    .address(address),
+    .data_in(data_in),
+    .msg_out(dram_msg_out),
+    .address_out(dram_address_out),
+    .data_select(dram_data_select),
+    .mem_address(dram_address),
+    .mem_data(dram_data),
+    .mem_write(dram_write)
+  );
+end
+else begin : NO_DRAM
+  assign dram_msg_out     = {NUM_PORTS*MSG_BITS{1'b0}};
+  assign dram_address_out = {NUM_PORTS*ADDRESS_WIDTH{1'b0}};
+  assign dram_data_select = {NUM_PORTS{1'b0}};
+  assign dram_address     = {ADDRESS_WIDTH{1'b0}};
+  assign dram_data        = {DATA_WIDTH{1'b0}};
+  assign dram_write       = 1'b0;
+end
+endgenerate
+
 // controller FSM
 always @(posedge clock)begin
   if(reset)begin
@@ -179,9 +241,17 @@ end
 // Drive outputs
 generate
   for(i=0; i<NUM_PORTS; i=i+1)begin : OUTPUTS
-    assign w_data_out[i] = (i==serving) & (state==READ_OUT) ? data_out0 : 0;
-    assign msg_out[i*MSG_BITS +: MSG_BITS ]              =     t_msg_out[i];
-    assign address_out[i*ADDRESS_WIDTH +: ADDRESS_WIDTH] = t_address_out[i];
+    if(TIMING_MODEL == "DRAM") begin : DRAM_OUT
+      assign w_data_out[i] = dram_data_select[i] ? data_out0 : 0;
+      assign msg_out[i*MSG_BITS +: MSG_BITS ] = dram_msg_out[i*MSG_BITS +: MSG_BITS];
+      assign address_out[i*ADDRESS_WIDTH +: ADDRESS_WIDTH] =
+                                   dram_address_out[i*ADDRESS_WIDTH +: ADDRESS_WIDTH];
+    end
+    else begin : FIXED_OUT
+      assign w_data_out[i] = (i==serving) & (state==READ_OUT) ? data_out0 : 0;
+      assign msg_out[i*MSG_BITS +: MSG_BITS ]              =     t_msg_out[i];
+      assign address_out[i*ADDRESS_WIDTH +: ADDRESS_WIDTH] = t_address_out[i];
+    end
     assign data_out[i*DATA_WIDTH +: DATA_WIDTH]          =    w_data_out[i];
   end
 endgenerate
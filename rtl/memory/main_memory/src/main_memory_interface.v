@@ -24,7 +24,14 @@ module main_memory_interface #(
 parameter OFFSET_BITS    =  2,
           DATA_WIDTH     = 32,
           ADDRESS_WIDTH  = 32,
-          MSG_BITS       =  4
+          MSG_BITS       =  4,
+          // 1: one R_REQ per line, the memory answers with one MEM_RESP beat
+          // per word (main_memory with DRAM_BURST_READS = 1)
+          BURST_READS    =  0,
+          // 1: answer a R_REQ with a MEM_RESP beat of the requested word as
+          // soon as it is read, then with the line. Needs lines of more than
+          // one word.
+          CRITICAL_WORD_FIRST = 0
 )(
 clock, reset,
 
@@ -88,11 +95,14 @@ reg [DATA_WIDTH-1   :0] from_intf_data;
 reg [MSG_BITS-1     :0] from_intf_msg;
 reg [ADDRESS_WIDTH-1:0] from_intf_address;
 reg [OFFSET_BITS    :0] word_counter;
+reg word_beat;
 
 wire [DATA_WIDTH-1   :0] w_cache2intf_data [WORDS_PER_LINE-1:0];
 wire [MSG_BITS-1     :0] to_intf_msg;
 wire [ADDRESS_WIDTH-1:0] to_intf_address;
 wire [DATA_WIDTH-1   :0] to_intf_data;
+wire [ADDRESS_WIDTH-1:0] read_word;
+wire [ADDRESS_WIDTH-1:0] next_word;
 
 
 
@@ -107,6 +117,13 @@ assign to_intf_msg     = mem2interface_msg;
 assign to_intf_address = mem2interface_address;
 assign to_intf_data    = mem2interface_data;
 
+// Reads start at the requested word and wrap around the line. Burst beats
+// carry their address.
+assign read_word = BURST_READS ? to_intf_address   & (WORDS_PER_LINE-1) :
+                                 from_intf_address & (WORDS_PER_LINE-1);
+assign next_word = ((from_intf_address >> OFFSET_BITS) << OFFSET_BITS) |
+                   ((from_intf_address + 1) & (WORDS_PER_LINE-1));
+
 //assign outputs
 assign interface2cache_msg     = r_intf2cache_msg;
 assign interface2cache_address = r_intf2cache_address;
@@ -129,6 +146,7 @@ always @(posedge clock)begin
     from_intf_msg        <= NO_REQ;
     from_intf_address    <= 0;
     from_intf_data       <= 0;
+    word_beat            <= 1'b0;
     for(j=0; j<WORDS_PER_LINE; j=j+1)begin
       r_intf2cache_data[j] <= 0;
     end
@@ -139,9 +157,12 @@ always @(posedge clock)begin
       IDLE:begin
         if(cache2interface_msg == R_REQ | cache2interface_msg == RFO_BCAST)begin
           word_counter         <= 0;
+          word_beat            <= CRITICAL_WORD_FIRST &
+                                  (cache2interface_msg == R_REQ);
           from_intf_msg        <= R_REQ;
           from_intf_address    <= cache2interface_address;
-          r_intf2cache_address <= cache2interface_address;
+          r_intf2cache_address <= (cache2interface_address >> OFFSET_BITS) <<
+                                  OFFSET_BITS;
           state                <= READ_MEMORY;
         end
         else if((cache2interface_msg == FLUSH) | (cache2interface_msg == WB_REQ))
@@ -158,21 +179,37 @@ always @(posedge clock)begin
       end
       READ_MEMORY:begin
         if((to_intf_msg == MEM_RESP) & (word_counter < WORDS_PER_LINE-1))begin
-          r_intf2cache_data[word_counter] <= to_intf_data;
+          r_intf2cache_data[read_word]    <= to_intf_data;
           word_counter                    <= word_counter + 1;
-          from_intf_address               <= from_intf_address + 1;
+          from_intf_address               <= BURST_READS ? from_intf_address :
+                                             next_word;
           from_intf_msg                   <= R_REQ;
+          /*The first word (or burst beat) is the requested one. Send it on
+          * for one cycle while the rest of the line is read.*/
+          if(word_beat & (word_counter == 0))begin
+            r_intf2cache_msg              <= MEM_RESP;
+            r_intf2cache_address          <= from_intf_address;
+          end
+          else begin
+            r_intf2cache_msg              <= NO_REQ;
+            r_intf2cache_address          <= (from_intf_address >>
+                                             OFFSET_BITS) << OFFSET_BITS;
+          end
         end
         else if((to_intf_msg == MEM_RESP) &
         (word_counter == WORDS_PER_LINE-1))begin
-          r_intf2cache_data[word_counter] <= to_intf_data;
+          r_intf2cache_data[read_word]    <= to_intf_data;
           from_intf_address               <= 0;
           from_intf_msg                   <= NO_REQ;
           r_intf2cache_msg                <= MEM_RESP;
+          r_intf2cache_address            <= (from_intf_address >>
+                                             OFFSET_BITS) << OFFSET_BITS;
           state                           <= RESPOND;
         end
-        else
-          state <= READ_MEMORY;
+        else begin
+          r_intf2cache_msg                <= NO_REQ;
+          state                           <= READ_MEMORY;
+        end
       end
       WRITE_MEMORY:begin
         if((to_intf_msg == MEM_RESP) & (word_counter < WORDS_PER_LINE-1))begin
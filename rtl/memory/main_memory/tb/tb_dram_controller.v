@@ -0,0 +1,262 @@
+/** @module : tb_dram_controller
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+module tb_dram_controller();
+
+parameter DATA_WIDTH    = 32,
+          ADDRESS_WIDTH = 32,
+          MSG_BITS      = 4,
+          INDEX_BITS    = 10,
+          NUM_PORTS     = 2,
+          BANKS         = 2,
+          COLUMN_BITS   = 4,
+          BURST_WORDS   = 4,
+          T_RCD         = 3,
+          T_CAS         = 3,
+          T_RP          = 3;
+
+// Define INCLUDE_FILE  to point to /includes/params.h. The path should be
+// relative to your simulation/sysnthesis directory. You can add the macro
+// when compiling this file in modelsim by adding the following argument to the
+// vlog command that compiles this module:
+// +define+INCLUDE_FILE="../../../includes/params.h"
+`include `INCLUDE_FILE
+
+reg  clock, reset;
+reg  [NUM_PORTS*MSG_BITS-1 : 0]      msg_in;
+reg  [NUM_PORTS*ADDRESS_WIDTH-1 : 0] address;
+reg  [NUM_PORTS*DATA_WIDTH-1 : 0]    data_in;
+wire [NUM_PORTS*MSG_BITS-1 : 0]      msg_out;
+wire [NUM_PORTS*ADDRESS_WIDTH-1 : 0] address_out;
+wire [NUM_PORTS*DATA_WIDTH-1 : 0]    data_out;
+
+reg  [MSG_BITS-1 : 0]      burst_msg_in;
+reg  [ADDRESS_WIDTH-1 : 0] burst_address;
+wire [MSG_BITS-1 : 0]      burst_msg_out;
+wire [ADDRESS_WIDTH-1 : 0] burst_address_out;
+wire [DATA_WIDTH-1 : 0]    burst_data_out;
+
+// Word requests. Addresses map to {row, bank[4], column[3:0]}.
+main_memory #(
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_WIDTH(ADDRESS_WIDTH),
+  .MSG_BITS(MSG_BITS),
+  .INDEX_BITS(INDEX_BITS),
+  .NUM_PORTS(NUM_PORTS),
+  .TIMING_MODEL("DRAM"),
+  .DRAM_BANKS(BANKS),
+  .DRAM_COLUMN_BITS(COLUMN_BITS),
+  .DRAM_BURST_WORDS(BURST_WORDS),
+  .DRAM_BURST_READS(0),
+  .DRAM_T_RCD(T_RCD),
+  .DRAM_T_CAS(T_CAS),
+  .DRAM_T_RP(T_RP)
+) DUT (
+  clock,
+  reset,
+  msg_in,
+  address,
+  data_in,
+  msg_out,
+  address_out,
+  data_out
+);
+
+// Burst reads
+main_memory #(
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_WIDTH(ADDRESS_WIDTH),
+  .MSG_BITS(MSG_BITS),
+  .INDEX_BITS(INDEX_BITS),
+  .NUM_PORTS(1),
+  .TIMING_MODEL("DRAM"),
+  .DRAM_BANKS(BANKS),
+  .DRAM_COLUMN_BITS(COLUMN_BITS),
+  .DRAM_BURST_WORDS(BURST_WORDS),
+  .DRAM_BURST_READS(1),
+  .DRAM_T_RCD(T_RCD),
+  .DRAM_T_CAS(T_CAS),
+  .DRAM_T_RP(T_RP)
+) DUT_BURST (
+  clock,
+  reset,
+  burst_msg_in,
+  burst_address,
+  {DATA_WIDTH{1'b0}},
+  burst_msg_out,
+  burst_address_out,
+  burst_data_out
+);
+
+//generate clock
+always #1 clock = ~clock;
+
+task fail;
+  input [8*40-1:0] reason;
+  begin
+    $display("%0s", reason);
+    $display("\ntb_dram_controller --> Test Failed!\n\n");
+    $stop;
+  end
+endtask
+
+// Issues a request on a port and returns the cycles until MEM_RESP
+task automatic access;
+  input integer port;
+  input [MSG_BITS-1:0] msg;
+  input [ADDRESS_WIDTH-1:0] word_address;
+  input [DATA_WIDTH-1:0] write_data;
+  output [DATA_WIDTH-1:0] read_data;
+  output integer latency;
+  time start;
+  begin
+    @(posedge clock) begin
+      msg_in[port*MSG_BITS +: MSG_BITS]              <= msg;
+      address[port*ADDRESS_WIDTH +: ADDRESS_WIDTH]    <= word_address;
+      data_in[port*DATA_WIDTH +: DATA_WIDTH]          <= write_data;
+    end
+    start = $time;
+    @(negedge clock);
+    while(msg_out[port*MSG_BITS +: MSG_BITS] != MEM_RESP)
+      @(negedge clock);
+    latency   = ($time - start + 1)/2;
+    read_data = data_out[port*DATA_WIDTH +: DATA_WIDTH];
+    @(posedge clock) begin
+      msg_in[port*MSG_BITS +: MSG_BITS]              <= NO_REQ;
+      address[port*ADDRESS_WIDTH +: ADDRESS_WIDTH]    <= 0;
+      data_in[port*DATA_WIDTH +: DATA_WIDTH]          <= 0;
+    end
+  end
+endtask
+
+function [DATA_WIDTH-1:0] init_value;
+  input integer index;
+  begin
+    init_value = index*3 + 1;
+  end
+endfunction
+
+integer k;
+integer t_miss, t_burst, t_hit, t_conflict, t_write, t_0, t_1;
+reg [DATA_WIDTH-1:0] data_0, data_1;
+reg [ADDRESS_WIDTH-1:0] beat_address;
+
+initial begin
+  clock         = 0;
+  reset         = 0;
+  msg_in        = {NUM_PORTS{NO_REQ}};
+  address       = 0;
+  data_in       = 0;
+  burst_msg_in  = NO_REQ;
+  burst_address = 0;
+  for(k=0; k<128; k=k+1) begin
+    DUT.BRAM_inst.ram[k]       = init_value(k);
+    DUT_BURST.BRAM_inst.ram[k] = init_value(k);
+  end
+
+  repeat(1) @(posedge clock);
+  @(posedge clock) reset <= 1;
+  repeat(2) @(posedge clock);
+  @(posedge clock) reset <= 0;
+  repeat(2) @(posedge clock);
+
+  // Closed bank, word of the last burst, open row, other row
+  access(0, R_REQ, 0, 0, data_0, t_miss);
+  if(data_0 != init_value(0)) fail("Wrong data after row miss");
+  access(0, R_REQ, 1, 0, data_0, t_burst);
+  if(data_0 != init_value(1)) fail("Wrong data after burst hit");
+  access(0, R_REQ, 5, 0, data_0, t_hit);
+  if(data_0 != init_value(5)) fail("Wrong data after row hit");
+  access(0, R_REQ, 32, 0, data_0, t_conflict);
+  if(data_0 != init_value(32)) fail("Wrong data after row conflict");
+  $display("Latency miss:%0d burst:%0d hit:%0d conflict:%0d", t_miss, t_burst,
+           t_hit, t_conflict);
+  if(~((t_burst < t_hit) & (t_hit < t_miss) & (t_miss < t_conflict)))
+    fail("Latencies out of order");
+  if((DUT.DRAM.controller.row_misses != 1) | (DUT.DRAM.controller.burst_hits != 1) |
+     (DUT.DRAM.controller.row_hits != 1) | (DUT.DRAM.controller.row_conflicts != 1))
+    fail("Wrong access counters");
+
+  // Row conflicts in both banks overlap
+  fork
+    access(0, R_REQ, 64, 0, data_0, t_0);
+    access(1, R_REQ, 48, 0, data_1, t_1);
+  join
+  $display("Latency parallel conflicts:%0d %0d", t_0, t_1);
+  if((data_0 != init_value(64)) | (data_1 != init_value(48)))
+    fail("Wrong data of parallel reads");
+  if((t_0 >= t_conflict + 3) | (t_1 >= t_conflict + 3))
+    fail("Banks did not overlap");
+
+  // Posted write, then a read of the same word from the other port
+  access(0, WB_REQ, 100, 32'hCAFE, data_0, t_write);
+  if(t_write > 2) fail("Write was not posted");
+  access(1, R_REQ, 100, 0, data_1, t_1);
+  if(data_1 != 32'hCAFE) fail("Read passed an older write");
+
+  // Write and read race on two ports, the write enters the queue first
+  fork
+    access(0, WB_REQ, 101, 32'hBEEF, data_0, t_0);
+    begin
+      @(posedge clock);
+      access(1, R_REQ, 101, 0, data_1, t_1);
+    end
+  join
+  if(data_1 != 32'hBEEF) fail("Read passed a queued write");
+
+  // Burst read, critical word first
+  @(posedge clock) begin
+    burst_msg_in  <= R_REQ;
+    burst_address <= 6;
+  end
+  @(negedge clock);
+  while(burst_msg_out != MEM_RESP)
+    @(negedge clock);
+  beat_address = 6;
+  for(k=0; k<BURST_WORDS; k=k+1) begin
+    if(burst_msg_out != MEM_RESP) fail("Burst beats are not consecutive");
+    if(burst_address_out != beat_address) fail("Wrong beat order");
+    if(burst_data_out != init_value(beat_address)) fail("Wrong beat data");
+    beat_address = ((beat_address + 1) & (BURST_WORDS-1)) | (beat_address & ~(BURST_WORDS-1));
+    if(k < BURST_WORDS-1)
+      @(negedge clock);
+  end
+  @(posedge clock) begin
+    burst_msg_in  <= NO_REQ;
+    burst_address <= 0;
+  end
+  @(negedge clock);
+  if(burst_msg_out == MEM_RESP) fail("Burst is too long");
+
+  #20;
+  $display("\ntb_dram_controller --> Test Passed!\n\n");
+  $stop;
+end
+
+//timeout
+initial begin
+  #2000;
+  $display("\ntb_dram_controller --> Test Failed!\n\n");
+  $stop;
+end
+
+endmodule
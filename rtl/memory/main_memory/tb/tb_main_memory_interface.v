@@ -111,6 +111,19 @@ initial begin
     end
     wait((interface2cache_msg == MEM_RESP) & (interface2cache_address == 12'h324));
     @(posedge clock) cache2interface_msg = NO_REQ;
+
+    // Critical word first: the line is read starting at word 2
+    repeat(2)@(posedge clock);
+    @(posedge clock)begin
+        cache2interface_msg     = R_REQ;
+        cache2interface_address = 12'h10A;
+    end
+    wait((interface2cache_msg == MEM_RESP) & (interface2cache_address == 12'h108));
+    if(interface2cache_data != 32'hA3A2A1A0)begin
+        $display("\ntb_main_memory_interface --> Test Failed!\n\n");
+        $stop;
+    end
+    @(posedge clock) cache2interface_msg = NO_REQ;
 end
 
 //Main memory
@@ -201,6 +214,36 @@ initial begin
     end
     @(posedge clock) mem2interface_msg = NO_REQ;
 
+    wait((interface2mem_msg == R_REQ) & (interface2mem_address == 12'h10A));
+    @(posedge clock)begin
+        mem2interface_msg     = MEM_RESP;
+        mem2interface_data    = 8'hA2;
+        mem2interface_address = 12'h10A;
+    end
+    @(posedge clock) mem2interface_msg = NO_REQ;
+    wait((interface2mem_msg == R_REQ) & (interface2mem_address == 12'h10B));
+    @(posedge clock)begin
+        mem2interface_msg     = MEM_RESP;
+        mem2interface_data    = 8'hA3;
+        mem2interface_address = 12'h10B;
+    end
+    @(posedge clock) mem2interface_msg = NO_REQ;
+    wait((interface2mem_msg == R_REQ) & (interface2mem_address == 12'h108));
+    @(posedge clock)begin
+        mem2interface_msg     = MEM_RESP;
+        mem2interface_data    = 8'hA0;
+        mem2interface_address = 12'h108;
+    end
+    @(posedge clock) mem2interface_msg = NO_REQ;
+    wait((interface2mem_msg == R_REQ) & (interface2mem_address == 12'h109));
+    @(posedge clock)begin
+        mem2interface_msg     = MEM_RESP;
+        mem2interface_data    = 8'hA1;
+        mem2interface_address = 12'h109;
+    end
+    @(posedge clock) mem2interface_msg = NO_REQ;
+    wait(interface2cache_msg == MEM_RESP);
+
     #20;
     $display("\ntb_main_memory_interface --> Test Passed!\n\n");
     $stop;
@@ -208,7 +251,7 @@ end
 
 //timeout
 initial begin
-  #500;
+  #800;
   $display("\ntb_main_memory_interface --> Test Failed!\n\n");
   $stop;
 end
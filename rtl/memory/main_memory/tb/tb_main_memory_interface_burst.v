@@ -0,0 +1,205 @@
+/** @module : tb_main_memory_interface_burst
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+// Burst reads with CRITICAL_WORD_FIRST: the first beat of the burst is the
+// requested word and goes to the cache before the rest of the line.
+module tb_main_memory_interface_burst();
+
+parameter OFFSET_BITS           = 2,
+          DATA_WIDTH            = 8,
+          ADDRESS_WIDTH         = 12,
+          MSG_BITS              = 4;
+
+localparam WORDS_PER_LINE = 1 << OFFSET_BITS;
+localparam BUS_WIDTH      = DATA_WIDTH*WORDS_PER_LINE;
+
+`include `INCLUDE_FILE
+
+
+reg clock, reset;
+reg [MSG_BITS-1 : 0] cache2interface_msg;
+reg [ADDRESS_WIDTH-1 : 0] cache2interface_address;
+reg [BUS_WIDTH-1 : 0] cache2interface_data;
+
+wire [MSG_BITS-1 : 0] interface2cache_msg;
+wire [ADDRESS_WIDTH-1 : 0] interface2cache_address;
+wire [BUS_WIDTH-1 : 0] interface2cache_data;
+
+reg [MSG_BITS-1 : 0] mem2interface_msg;
+reg [ADDRESS_WIDTH-1 : 0] mem2interface_address;
+reg [DATA_WIDTH-1 : 0] mem2interface_data;
+
+wire [MSG_BITS-1 : 0] interface2mem_msg;
+wire [ADDRESS_WIDTH-1 : 0] interface2mem_address;
+wire [DATA_WIDTH-1 : 0] interface2mem_data;
+
+//generate clock
+always #1 clock = ~clock;
+
+//Instantiate main_memory_interface
+main_memory_interface #(
+  .OFFSET_BITS(OFFSET_BITS),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_WIDTH(ADDRESS_WIDTH),
+  .MSG_BITS(MSG_BITS),
+  .BURST_READS(1),
+  .CRITICAL_WORD_FIRST(1)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .cache2interface_msg(cache2interface_msg),
+  .cache2interface_address(cache2interface_address),
+  .cache2interface_data(cache2interface_data),
+  .interface2cache_msg(interface2cache_msg),
+  .interface2cache_address(interface2cache_address),
+  .interface2cache_data(interface2cache_data),
+  .mem2interface_msg(mem2interface_msg),
+  .mem2interface_address(mem2interface_address),
+  .mem2interface_data(mem2interface_data),
+  .interface2mem_msg(interface2mem_msg),
+  .interface2mem_address(interface2mem_address),
+  .interface2mem_data(interface2mem_data)
+);
+
+// processes
+//Global signals
+initial begin
+    clock = 1;
+    reset = 1;
+    repeat(4) @(posedge clock);
+    @(posedge clock) reset = 0;
+end
+
+// Last level cache
+initial begin
+    cache2interface_msg     = NO_REQ;
+    cache2interface_address = 0;
+    cache2interface_data    = 0;
+    wait(~reset);
+    @(posedge clock)begin
+        cache2interface_msg     = R_REQ;
+        cache2interface_address = 12'h10A;
+    end
+    // The word beat comes right after the first burst beat
+    wait(interface2cache_msg == MEM_RESP);
+    if((interface2cache_address != 12'h10A) |
+       (interface2cache_data[2*DATA_WIDTH +: DATA_WIDTH] != 8'hA2))begin
+        $display("\nError: First response is %h from %h, expected A2 from 10A!",
+            interface2cache_data, interface2cache_address);
+        $display("\ntb_main_memory_interface_burst --> Test Failed!\n\n");
+        $stop;
+    end
+    @(posedge clock);
+    @(negedge clock);
+    if(interface2cache_msg != NO_REQ)begin
+        $display("\nError: The word beat is longer than one cycle!");
+        $display("\ntb_main_memory_interface_burst --> Test Failed!\n\n");
+        $stop;
+    end
+    wait(interface2cache_msg == MEM_RESP);
+    if((interface2cache_address != 12'h108) |
+       (interface2cache_data != 32'hA3A2A1A0))begin
+        $display("\nError: Line %h from %h, expected A3A2A1A0 from 108!",
+            interface2cache_data, interface2cache_address);
+        $display("\ntb_main_memory_interface_burst --> Test Failed!\n\n");
+        $stop;
+    end
+    @(posedge clock) cache2interface_msg = NO_REQ;
+
+    // RFO_BCAST gets the line only
+    repeat(2)@(posedge clock);
+    @(posedge clock)begin
+        cache2interface_msg     = RFO_BCAST;
+        cache2interface_address = 12'h204;
+    end
+    wait(interface2cache_msg == MEM_RESP);
+    if((interface2cache_address != 12'h204) |
+       (interface2cache_data != 32'hB3B2B1B0))begin
+        $display("\nError: RFO line %h from %h, expected B3B2B1B0 from 204!",
+            interface2cache_data, interface2cache_address);
+        $display("\ntb_main_memory_interface_burst --> Test Failed!\n\n");
+        $stop;
+    end
+    @(posedge clock) cache2interface_msg = NO_REQ;
+
+    #20;
+    $display("\ntb_main_memory_interface_burst --> Test Passed!\n\n");
+    $stop;
+end
+
+//Main memory, one beat per cycle starting at the requested word
+initial begin
+    mem2interface_msg     = NO_REQ;
+    mem2interface_address = 0;
+    mem2interface_data    = 0;
+    wait((interface2mem_msg == R_REQ) & (interface2mem_address == 12'h10A));
+    repeat(2) @(posedge clock);
+    @(posedge clock)begin
+        mem2interface_msg     = MEM_RESP;
+        mem2interface_data    = 8'hA2;
+        mem2interface_address = 12'h10A;
+    end
+    @(posedge clock)begin
+        mem2interface_data    = 8'hA3;
+        mem2interface_address = 12'h10B;
+    end
+    @(posedge clock)begin
+        mem2interface_data    = 8'hA0;
+        mem2interface_address = 12'h108;
+    end
+    @(posedge clock)begin
+        mem2interface_data    = 8'hA1;
+        mem2interface_address = 12'h109;
+    end
+    @(posedge clock) mem2interface_msg = NO_REQ;
+
+    wait((interface2mem_msg == R_REQ) & (interface2mem_address == 12'h204));
+    repeat(2) @(posedge clock);
+    @(posedge clock)begin
+        mem2interface_msg     = MEM_RESP;
+        mem2interface_data    = 8'hB0;
+        mem2interface_address = 12'h204;
+    end
+    @(posedge clock)begin
+        mem2interface_data    = 8'hB1;
+        mem2interface_address = 12'h205;
+    end
+    @(posedge clock)begin
+        mem2interface_data    = 8'hB2;
+        mem2interface_address = 12'h206;
+    end
+    @(posedge clock)begin
+        mem2interface_data    = 8'hB3;
+        mem2interface_address = 12'h207;
+    end
+    @(posedge clock) mem2interface_msg = NO_REQ;
+end
+
+//timeout
+initial begin
+  #400;
+  $display("\ntb_main_memory_interface_burst --> Test Failed!\n\n");
+  $stop;
+end
+
+
+endmodule
@@ -26,7 +26,14 @@ module five_stage_cache_top #(
   parameter ADDRESS_BITS     = 32,
   parameter MEM_ADDRESS_BITS = 14,
   parameter SCAN_CYCLES_MIN  = 0,
-  parameter SCAN_CYCLES_MAX  = 1000
+  parameter SCAN_CYCLES_MAX  = 1000,
+  // Tightly coupled memory, see memory_interface. 0 removes the TCM.
+  parameter TCM_ADDRESS_BITS   = 0,
+  parameter TCM_BASE           = 32'h00080000,
+  parameter TCM_INIT_FILE_BASE = "",
+  // 1: load misses get the requested word from main memory ahead of the line,
+  // see two_level_cache_hierarchy
+  parameter CRITICAL_WORD_FIRST = 0
 ) (
   input clock,
   input reset,
@@ -128,9 +135,17 @@ five_stage_core #(
 );
 
 memory_interface #(
+  .CORE(CORE),
   .DATA_WIDTH(DATA_WIDTH),
-  .ADDRESS_BITS(ADDRESS_BITS)
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .TCM_ADDRESS_BITS(TCM_ADDRESS_BITS),
+  .TCM_BASE(TCM_BASE),
+  .TCM_INIT_FILE_BASE(TCM_INIT_FILE_BASE),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) mem_interface (
+  .clock(clock),
+  .reset(reset),
   //fetch stage interface
   .fetch_read(fetch_read),
   .fetch_address_out(fetch_address_out),
@@ -189,7 +204,8 @@ two_level_cache_hierarchy #(
   .MSG_BITS(4),
   .NUM_L1_CACHES(2),
   .BUS_OFFSET_BITS(2),
-  .MAX_OFFSET_BITS(2)
+  .MAX_OFFSET_BITS(2),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) cache_hier (
   .clock(clock),
   .reset(reset),
@@ -239,7 +255,8 @@ main_memory_interface #(
   .OFFSET_BITS(L2_OFFSET),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_WIDTH(ADDRESS_BITS),
-  .MSG_BITS(MSG_BITS)
+  .MSG_BITS(MSG_BITS),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) mem_intf (
   .clock(clock),
   .reset(reset),
@@ -115,6 +115,8 @@ memory_interface #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS)
 ) mem_interface (
+  .clock(clock),
+  .reset(reset),
   //fetch stage interface
   .fetch_read(fetch_read),
   .fetch_address_out(fetch_address_out),
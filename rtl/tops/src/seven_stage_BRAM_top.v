@@ -26,7 +26,13 @@ module seven_stage_BRAM_top #(
   parameter ADDRESS_BITS     = 32,
   parameter MEM_ADDRESS_BITS = 14,
   parameter SCAN_CYCLES_MIN  = 0,
-  parameter SCAN_CYCLES_MAX  = 1000
+  parameter SCAN_CYCLES_MAX  = 1000,
+  // 1 adds the C extension (16 bit instructions) to the core
+  parameter COMPRESSED       = 0,
+  // 1 adds the packed SIMD subset of the P extension, see packed_simd_unit
+  parameter P_EXTENSION      = 0,
+  // Words in the L0 loop buffer of the core, see loop_buffer. 0 removes it.
+  parameter LOOP_BUFFER_WORDS = 0
 ) (
   input clock,
   input reset,
@@ -81,6 +87,9 @@ seven_stage_core #(
   .RESET_PC(32'd0),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
+  .COMPRESSED(COMPRESSED),
+  .P_EXTENSION(P_EXTENSION),
+  .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) core (
@@ -112,6 +121,8 @@ memory_interface #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS)
 ) mem_interface (
+  .clock(clock),
+  .reset(reset),
   //fetch stage interface
   .fetch_read(fetch_read),
   .fetch_address_out(fetch_address_out),
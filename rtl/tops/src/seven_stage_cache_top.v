@@ -26,7 +26,20 @@ module seven_stage_cache_top #(
   parameter ADDRESS_BITS     = 32,
   parameter MEM_ADDRESS_BITS = 14,
   parameter SCAN_CYCLES_MIN  = 0,
-  parameter SCAN_CYCLES_MAX  = 1000
+  parameter SCAN_CYCLES_MAX  = 1000,
+  // 1 adds the C extension (16 bit instructions) to the core
+  parameter COMPRESSED       = 0,
+  // 1 adds the packed SIMD subset of the P extension, see packed_simd_unit
+  parameter P_EXTENSION      = 0,
+  // Words in the L0 loop buffer of the core, see loop_buffer. 0 removes it.
+  parameter LOOP_BUFFER_WORDS = 0,
+  // Tightly coupled memory, see memory_interface. 0 removes the TCM.
+  parameter TCM_ADDRESS_BITS   = 0,
+  parameter TCM_BASE           = 32'h00080000,
+  parameter TCM_INIT_FILE_BASE = "",
+  // 1: load misses get the requested word from main memory ahead of the line,
+  // see two_level_cache_hierarchy
+  parameter CRITICAL_WORD_FIRST = 0
 ) (
   input clock,
   input reset,
@@ -100,6 +113,9 @@ seven_stage_core #(
   .RESET_PC(32'd0),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
+  .COMPRESSED(COMPRESSED),
+  .P_EXTENSION(P_EXTENSION),
+  .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) core (
@@ -130,9 +146,17 @@ seven_stage_core #(
 );
 
 memory_interface #(
+  .CORE(CORE),
   .DATA_WIDTH(DATA_WIDTH),
-  .ADDRESS_BITS(ADDRESS_BITS)
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .TCM_ADDRESS_BITS(TCM_ADDRESS_BITS),
+  .TCM_BASE(TCM_BASE),
+  .TCM_INIT_FILE_BASE(TCM_INIT_FILE_BASE),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) mem_interface (
+  .clock(clock),
+  .reset(reset),
   //fetch stage interface
   .fetch_read(fetch_read),
   .fetch_address_out(fetch_address_out),
@@ -191,7 +215,8 @@ two_level_cache_hierarchy #(
   .MSG_BITS(4),
   .NUM_L1_CACHES(NUM_L1_CACHES),
   .BUS_OFFSET_BITS(2),
-  .MAX_OFFSET_BITS(2)
+  .MAX_OFFSET_BITS(2),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) cache_hier (
   .clock(clock),
   .reset(reset),
@@ -241,7 +266,8 @@ main_memory_interface #(
   .OFFSET_BITS(L2_OFFSET),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_WIDTH(ADDRESS_BITS),
-  .MSG_BITS(MSG_BITS)
+  .MSG_BITS(MSG_BITS),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) mem_intf (
   .clock(clock),
   .reset(reset),
@@ -27,18 +27,70 @@
  *  - Memory subsystem consists of a two level cache hierarchy and the main 
  *    memory.
  *  - Private L1 instruction caches and shared L2 cache.
+ *  - With NUM_CLUSTERS > 1 the cores are grouped into clusters with a three
+ *    level cache hierarchy instead: each cluster has its own bus and L2 cache
+ *    and the cluster L2 caches share an inclusive L3 cache.
+ *  - With SYNC_UNIT = 1, data accesses to the 4 KiB window at SYNC_BASE go to
+ *    the sync unit instead of the caches. It provides per-hart software
+ *    interrupts (MSIP) and hardware barriers, see sync_unit.v for the
+ *    register map.
  *
  *  Sub modules
  *  -----------
    *  seven_stage_core
+   *  seven_stage_priv_core
    *  memory_interface
+   *  sync_unit
    *  two_level_cache_hierarchy
+   *  three_level_cache_hierarchy
    *  main_memory_interface
    *  main_memory
  *
  *  Parameters
  *  ----------
-   *  NUM_CORES : Number of cores.
+   *  NUM_CORES    : Number of cores.
+   *  NUM_CLUSTERS : Number of core clusters. 1 selects the two level cache
+   *                 hierarchy. Larger values must divide NUM_CORES and select
+   *                 the three level cache hierarchy with NUM_CORES/NUM_CLUSTERS
+   *                 cores per cluster. Unsupported combinations with other
+   *                 parameters stop the simulation.
+   *  PRIV_CORES   : 1 instantiates seven_stage_priv_core instead of
+   *                 seven_stage_core. The MSIP bits of the sync unit (if
+   *                 present) drive the software interrupts of the cores, and
+   *                 WFI stops a core until one of its enabled interrupts is
+   *                 pending.
+   *  COMPRESSED   : 1 adds the C extension to seven_stage_core. Not
+   *                 supported with PRIV_CORES = 1.
+   *  P_EXTENSION  : 1 adds the packed SIMD subset of the P extension (see
+   *                 packed_simd_unit) to the cores. Used by both core types.
+   *  LOOP_BUFFER_WORDS : Words in the L0 loop buffer of each core (see
+   *                      loop_buffer). Loops that fit do not read the L1
+   *                      instruction cache. 0 removes it.
+   *  SYNC_UNIT    : 1 adds the sync unit. 0 (default) removes it and all
+   *                 data accesses go to the caches.
+   *  SYNC_BASE    : Base address of the 4 KiB sync unit window, 4 KiB
+   *                 aligned.
+   *  NUM_BARRIERS : Number of hardware barriers in the sync unit.
+   *  VICTIM_ENTRIES_L1 : Victim cache entries of each L1 cache, instruction
+   *                      caches first. 0 removes the victim cache.
+   *  L2_EXCLUSION : 1 makes the L2 exclusive of the L1 caches, see
+   *                 two_level_cache_hierarchy. Requires L2_INCLUSION = 0 and
+   *                 NUM_CLUSTERS = 1.
+   *  ARB_*        : Bus arbitration of the cache hierarchy, see
+   *                 coherence_controller. ARB_BANDWIDTH_CAPS has one entry
+   *                 per L1 cache, instruction caches first.
+   *  MEMORY_TIMING : "FIXED" or "DRAM", the TIMING_MODEL of main_memory.
+   *                  "DRAM" moves every line as one burst read.
+   *  DRAM_*       : Banks and timings of the DRAM model, see
+   *                 dram_controller.
+   *  CRITICAL_WORD_FIRST : 1 returns the requested word of a load miss from
+   *                        main memory ahead of the line, see
+   *                        two_level_cache_hierarchy. Requires
+   *                        NUM_CLUSTERS = 1.
+   *  TCM_*        : Tightly coupled memory of each core, see
+   *                 memory_interface. Every core has its own TCM at the same
+   *                 address and all TCMs start with the same contents.
+   *                 TCM_ADDRESS_BITS = 0 removes the TCMs.
 */
 
 module seven_stage_multicore_top #(
@@ -61,12 +113,43 @@ module seven_stage_multicore_top #(
   parameter INDEX_BITS_L2       = 6,
   parameter REPLACEMENT_MODE_L2 = 1'b0,
   parameter L2_INCLUSION        = 1'b1,
+  parameter L2_EXCLUSION        = 1'b0,
+  parameter NUM_CLUSTERS        = 1,
+  parameter OFFSET_BITS_L3      = OFFSET_BITS_L2,
+  parameter NUMBER_OF_WAYS_L3   = 8,
+  parameter INDEX_BITS_L3       = 8,
+  parameter REPLACEMENT_MODE_L3 = 1'b0,
+  parameter L3_BUS_OFFSET_BITS  = OFFSET_BITS_L2,
   parameter COHERENCE_BITS      = 2,
   parameter MSG_BITS            = 4,
   parameter BUS_OFFSET_BITS     = 2,
   parameter MAX_OFFSET_BITS     = 2,
+  parameter PRIV_CORES          = 0,
+  parameter COMPRESSED          = 0,
+  parameter P_EXTENSION         = 0,
+  parameter LOOP_BUFFER_WORDS   = 0,
+  parameter SYNC_UNIT           = 0,
+  parameter SYNC_BASE           = 32'h000F0000,
+  parameter NUM_BARRIERS        = 4,
+  parameter VICTIM_ENTRIES_L1   = {2*NUM_CORES{32'd0}},
+  parameter ARB_POLICY           = "PACKET",
+  parameter ARB_BANDWIDTH_WINDOW = 0,
+  parameter ARB_BANDWIDTH_CAPS   = {2*NUM_CORES{32'd0}},
+  parameter ARB_REPEAT_HOLDOFF   = 0,
+  parameter MEMORY_TIMING        = "FIXED",
+  parameter DRAM_BANKS           = 4,
+  parameter DRAM_QUEUE_DEPTH     = 4,
+  parameter DRAM_T_RCD           = 4,
+  parameter DRAM_T_CAS           = 4,
+  parameter DRAM_T_RP            = 4,
+  parameter DRAM_OPEN_PAGE       = 1,
+  parameter CRITICAL_WORD_FIRST  = 0,
+  parameter TCM_ADDRESS_BITS     = 0,
+  parameter TCM_BASE             = 32'h00080000,
+  parameter TCM_INIT_FILE_BASE   = "",
   //Use default value in module instantiation for following parameters
-  parameter NUM_L1_CACHES       = 2*NUM_CORES
+  parameter NUM_L1_CACHES       = 2*NUM_CORES,
+  parameter CORES_PER_CLUSTER   = NUM_CORES/NUM_CLUSTERS
 ) (
   input clock,
   input reset,
@@ -79,7 +162,23 @@ module seven_stage_multicore_top #(
   input scan
 );
 
-localparam L2_WIDTH  = DATA_WIDTH*(1 << OFFSET_BITS_L2);
+localparam LLC_OFFSET_BITS = (NUM_CLUSTERS > 1) ? OFFSET_BITS_L3 : OFFSET_BITS_L2;
+localparam LLC_WIDTH       = DATA_WIDTH*(1 << LLC_OFFSET_BITS);
+localparam DRAM_BURSTS     = (MEMORY_TIMING == "DRAM") ? 1 : 0;
+
+// The three level cache hierarchy checks its line sizes itself
+generate
+  if((NUM_CLUSTERS > 1) & ((NUM_CORES % NUM_CLUSTERS != 0) | L2_EXCLUSION |
+     CRITICAL_WORD_FIRST))begin : UNSUPPORTED_CLUSTERS
+    initial begin
+      $display("%m: NUM_CLUSTERS > 1 must divide NUM_CORES and does not support L2_EXCLUSION or CRITICAL_WORD_FIRST");
+      $finish;
+    end
+  end
+endgenerate
+
+localparam SYNC_ADDR_MIN = SYNC_BASE;
+localparam SYNC_ADDR_MAX = SYNC_BASE + 32'h00000FFF;
 
 //fetch stage interface
   wire [NUM_CORES-1:0] fetch_read;
@@ -115,13 +214,29 @@ localparam L2_WIDTH  = DATA_WIDTH*(1 << OFFSET_BITS_L2);
   wire [NUM_CORES*DATA_WIDTH/8-1:0] d_mem_byte_en;
   wire [NUM_CORES*ADDRESS_BITS-1:0] d_mem_address_in;
   wire [NUM_CORES*DATA_WIDTH-1:0] d_mem_data_in;
+//data cache interface
+  wire [NUM_CORES*DATA_WIDTH-1:0] cache_d_data_out;
+  wire [NUM_CORES*ADDRESS_BITS-1:0] cache_d_address_out;
+  wire [NUM_CORES-1:0] cache_d_valid;
+  wire [NUM_CORES-1:0] cache_d_ready;
+  wire [NUM_CORES-1:0] cache_d_read;
+  wire [NUM_CORES-1:0] cache_d_write;
+//sync unit interface
+  wire [NUM_CORES-1:0] sync_addr;
+  wire [NUM_CORES-1:0] sync_read;
+  wire [NUM_CORES-1:0] sync_write;
+  wire [NUM_CORES*DATA_WIDTH-1:0] sync_data_out;
+  wire [NUM_CORES*ADDRESS_BITS-1:0] sync_address_out;
+  wire [NUM_CORES-1:0] sync_valid;
+  wire [NUM_CORES-1:0] sync_ready;
+  wire [NUM_CORES-1:0] software_interrupt;
 //cache hierarchy to main memory interface signals
   wire [MSG_BITS-1    :0]     intf2cachehier_msg;
   wire [ADDRESS_BITS-1:0] intf2cachehier_address;
-  wire [L2_WIDTH-1    :0]    intf2cachehier_data;
+  wire [LLC_WIDTH-1   :0]    intf2cachehier_data;
   wire [MSG_BITS-1    :0]     cachehier2intf_msg;
   wire [ADDRESS_BITS-1:0] cachehier2intf_address;
-  wire [L2_WIDTH-1    :0]    cachehier2intf_data;
+  wire [LLC_WIDTH-1   :0]    cachehier2intf_data;
 //main memory interface to main memory signals
   wire [MSG_BITS-1    :0]     mem2intf_msg;
   wire [ADDRESS_BITS-1:0] mem2intf_address;
@@ -129,10 +244,6 @@ localparam L2_WIDTH  = DATA_WIDTH*(1 << OFFSET_BITS_L2);
   wire [MSG_BITS-1    :0]     intf2mem_msg;
   wire [ADDRESS_BITS-1:0] intf2mem_address;
   wire [DATA_WIDTH-1  :0]    intf2mem_data;
-//signals to memory mapped registers
-  wire [NUM_CORES-1   :0] w_mm_write;
-  wire [ADDRESS_BITS-1:0] w_mm_address [NUM_CORES-1:0];
-  wire [DATA_WIDTH-1  :0] w_mm_data [NUM_CORES-1:0];
 
 
 genvar i;
@@ -141,43 +252,113 @@ generate
     assign PC[i*ADDRESS_BITS +: ADDRESS_BITS] = 
                             fetch_address_in[i*ADDRESS_BITS +: ADDRESS_BITS];
 
-    seven_stage_core #(
+    if(PRIV_CORES) begin : PRIV
+      seven_stage_priv_core #(
+        .CORE(i),
+        .RESET_PC(i*16),
+        .DATA_WIDTH(DATA_WIDTH),
+        .ADDRESS_BITS(ADDRESS_BITS),
+        .P_EXTENSION(P_EXTENSION),
+        .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
+        .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+        .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+      ) core (
+        .clock(clock),
+        .reset(reset),
+        .start(start),
+        .program_address(program_address[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        //memory interface
+        .fetch_valid(fetch_valid[i +: 1]),
+        .fetch_ready(fetch_ready[i +: 1]),
+        .fetch_data_in(fetch_data_in[i*DATA_WIDTH +: DATA_WIDTH]),
+        .fetch_address_in(fetch_address_in[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .memory_valid(memory_valid[i +: 1]),
+        .memory_ready(memory_ready[i +: 1]),
+        .memory_data_in(memory_data_in[i*DATA_WIDTH +: DATA_WIDTH]),
+        .memory_address_in(memory_address_in[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .fetch_read(fetch_read[i +: 1]),
+        .fetch_address_out(fetch_address_out[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .memory_read(memory_read[i +: 1]),
+        .memory_write(memory_write[i +: 1]),
+        .memory_byte_en(memory_byte_en[i*DATA_WIDTH/8 +: DATA_WIDTH/8]),
+        .memory_address_out(memory_address_out[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .memory_data_out(memory_data_out[i*DATA_WIDTH +: DATA_WIDTH]),
+        // Interrupts
+        .m_ext_interrupt(1'b0),
+        .s_ext_interrupt(1'b0),
+        .software_interrupt(software_interrupt[i]),
+        .timer_interrupt(1'b0),
+        .i_mem_page_fault(1'b0),
+        .i_mem_access_fault(1'b0),
+        .d_mem_page_fault(1'b0),
+        .d_mem_access_fault(1'b0),
+        // Privilege CSRs for Virtual Memory
+        .PT_base_PPN(),
+        .ASID(),
+        .priv(),
+        .MPP(),
+        .MODE(),
+        .SUM(),
+        .MXR(),
+        .MPRV(),
+
+        .tlb_invalidate(),
+        .tlb_invalidate_mode(),
+
+        //scan signal
+        .scan(scan)
+      );
+    end
+    else begin : BASE
+      seven_stage_core #(
+        .CORE(i),
+        .RESET_PC(i*16),
+        .DATA_WIDTH(DATA_WIDTH),
+        .ADDRESS_BITS(ADDRESS_BITS),
+        .COMPRESSED(COMPRESSED),
+        .P_EXTENSION(P_EXTENSION),
+        .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
+        .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+        .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+      ) core (
+        .clock(clock),
+        .reset(reset),
+        .start(start),
+        .program_address(program_address[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        //memory interface
+        .fetch_valid(fetch_valid[i +: 1]),
+        .fetch_ready(fetch_ready[i +: 1]),
+        .fetch_data_in(fetch_data_in[i*DATA_WIDTH +: DATA_WIDTH]),
+        .fetch_address_in(fetch_address_in[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .memory_valid(memory_valid[i +: 1]),
+        .memory_ready(memory_ready[i +: 1]),
+        .memory_data_in(memory_data_in[i*DATA_WIDTH +: DATA_WIDTH]),
+        .memory_address_in(memory_address_in[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .fetch_read(fetch_read[i +: 1]),
+        .fetch_address_out(fetch_address_out[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .memory_read(memory_read[i +: 1]),
+        .memory_write(memory_write[i +: 1]),
+        .memory_byte_en(memory_byte_en[i*DATA_WIDTH/8 +: DATA_WIDTH/8]),
+        .memory_address_out(memory_address_out[i*ADDRESS_BITS +: ADDRESS_BITS]),
+        .memory_data_out(memory_data_out[i*DATA_WIDTH +: DATA_WIDTH]),
+        //scan signal
+        .scan(scan)
+      );
+    end
+    
+
+    memory_interface #(
       .CORE(i),
-      .RESET_PC(i*16),
       .DATA_WIDTH(DATA_WIDTH),
       .ADDRESS_BITS(ADDRESS_BITS),
+      .TCM_ADDRESS_BITS(TCM_ADDRESS_BITS),
+      .TCM_BASE(TCM_BASE),
+      .TCM_INIT_FILE_BASE(TCM_INIT_FILE_BASE),
       .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
       .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
-    ) core (
+    ) mem_interface (
       .clock(clock),
       .reset(reset),
-      .start(start),
-      .program_address(program_address[i*ADDRESS_BITS +: ADDRESS_BITS]),
-      //memory interface
-      .fetch_valid(fetch_valid[i +: 1]),
-      .fetch_ready(fetch_ready[i +: 1]),
-      .fetch_data_in(fetch_data_in[i*DATA_WIDTH +: DATA_WIDTH]),
-      .fetch_address_in(fetch_address_in[i*ADDRESS_BITS +: ADDRESS_BITS]),
-      .memory_valid(memory_valid[i +: 1]),
-      .memory_ready(memory_ready[i +: 1]),
-      .memory_data_in(memory_data_in[i*DATA_WIDTH +: DATA_WIDTH]),
-      .memory_address_in(memory_address_in[i*ADDRESS_BITS +: ADDRESS_BITS]),
-      .fetch_read(fetch_read[i +: 1]),
-      .fetch_address_out(fetch_address_out[i*ADDRESS_BITS +: ADDRESS_BITS]),
-      .memory_read(memory_read[i +: 1]),
-      .memory_write(memory_write[i +: 1]),
-      .memory_byte_en(memory_byte_en[i*DATA_WIDTH/8 +: DATA_WIDTH/8]),
-      .memory_address_out(memory_address_out[i*ADDRESS_BITS +: ADDRESS_BITS]),
-      .memory_data_out(memory_data_out[i*DATA_WIDTH +: DATA_WIDTH]),
-      //scan signal
-      .scan(scan)
-    );
-    
-
-    memory_interface #(
-      .DATA_WIDTH(DATA_WIDTH),
-      .ADDRESS_BITS(ADDRESS_BITS)
-    ) mem_interface (
       //fetch stage interface
       .fetch_read(fetch_read[i +: 1]),
       .fetch_address_out(fetch_address_out[i*ADDRESS_BITS +: ADDRESS_BITS]),
@@ -215,79 +396,220 @@ generate
     
       .scan(scan)
     );
+
+    // Route data accesses in the sync window to the sync unit. A request
+    // waits until both sides are ready so accesses stay in program order.
+    assign sync_addr[i] = SYNC_UNIT &
+                          (d_mem_address_in[i*ADDRESS_BITS +: ADDRESS_BITS] >= SYNC_ADDR_MIN) &
+                          (d_mem_address_in[i*ADDRESS_BITS +: ADDRESS_BITS] <= SYNC_ADDR_MAX);
+
+    assign sync_read[i]     = d_mem_read[i]  &  sync_addr[i] & cache_d_ready[i];
+    assign sync_write[i]    = d_mem_write[i] &  sync_addr[i] & cache_d_ready[i];
+    assign cache_d_read[i]  = d_mem_read[i]  & ~sync_addr[i] & sync_ready[i];
+    assign cache_d_write[i] = d_mem_write[i] & ~sync_addr[i] & sync_ready[i];
+
+    assign d_mem_ready[i] = cache_d_ready[i] & sync_ready[i];
+    assign d_mem_valid[i] = cache_d_valid[i] | sync_valid[i];
+    assign d_mem_data_out[i*DATA_WIDTH +: DATA_WIDTH] = sync_valid[i] ?
+                             sync_data_out[i*DATA_WIDTH +: DATA_WIDTH] :
+                             cache_d_data_out[i*DATA_WIDTH +: DATA_WIDTH];
+    assign d_mem_address_out[i*ADDRESS_BITS +: ADDRESS_BITS] = sync_valid[i] ?
+                             sync_address_out[i*ADDRESS_BITS +: ADDRESS_BITS] :
+                             cache_d_address_out[i*ADDRESS_BITS +: ADDRESS_BITS];
+  end
+endgenerate
+
+/*Sync unit*/
+generate
+  if(SYNC_UNIT) begin : SYNC
+    sync_unit #(
+      .NUM_HARTS(NUM_CORES),
+      .NUM_BARRIERS(NUM_BARRIERS),
+      .DATA_WIDTH(DATA_WIDTH),
+      .ADDRESS_BITS(ADDRESS_BITS)
+    ) sync (
+      .clock(clock),
+      .reset(reset),
+      .read(sync_read),
+      .write(sync_write),
+      .byte_en(d_mem_byte_en),
+      .address(d_mem_address_in),
+      .data_in(d_mem_data_in),
+      .data_out(sync_data_out),
+      .out_address(sync_address_out),
+      .valid(sync_valid),
+      .ready(sync_ready),
+      .software_interrupt(software_interrupt),
+      .barrier_wait()
+    );
+  end
+  else begin : NO_SYNC
+    assign sync_data_out      = {NUM_CORES*DATA_WIDTH{1'b0}};
+    assign sync_address_out   = {NUM_CORES*ADDRESS_BITS{1'b0}};
+    assign sync_valid         = {NUM_CORES{1'b0}};
+    assign sync_ready         = {NUM_CORES{1'b1}};
+    assign software_interrupt = {NUM_CORES{1'b0}};
   end
 endgenerate
 
 /*Cache hierarchy*/
-two_level_cache_hierarchy #(
-  .STATUS_BITS_L1(STATUS_BITS_L1),
-  .OFFSET_BITS_L1(OFFSET_BITS_L1),
-  .NUMBER_OF_WAYS_L1(NUMBER_OF_WAYS_L1),
-  .INDEX_BITS_L1(INDEX_BITS_L1),
-  .REPLACEMENT_MODE_L1(REPLACEMENT_MODE_L1),
-  .STATUS_BITS_L2(STATUS_BITS_L2),
-  .OFFSET_BITS_L2(OFFSET_BITS_L2),
-  .NUMBER_OF_WAYS_L2(NUMBER_OF_WAYS_L2),
-  .INDEX_BITS_L2(INDEX_BITS_L2),
-  .REPLACEMENT_MODE_L2(REPLACEMENT_MODE_L2),
-  .L2_INCLUSION(L2_INCLUSION),
-  .COHERENCE_BITS(COHERENCE_BITS),
-  .DATA_WIDTH(DATA_WIDTH),
-  .ADDRESS_BITS(ADDRESS_BITS),
-  .MSG_BITS(MSG_BITS),
-  .NUM_L1_CACHES(NUM_L1_CACHES),
-  .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
-  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
-) cache_hier (
-  .clock(clock),
-  .reset(reset),
-  //interface with processor pipelines
-  .read({d_mem_read, i_mem_read}),
-  .write({d_mem_write, {NUM_CORES{1'b0}}}),
-  .invalidate({2*NUM_CORES{1'b0}}),
-  .w_byte_en({d_mem_byte_en, {NUM_CORES*DATA_WIDTH/8{1'b0}}}),
-  .flush({2*NUM_CORES{1'b0}}),
-  .address({d_mem_address_in, i_mem_address_in}),
-  .data_in({d_mem_data_in, {NUM_CORES*DATA_WIDTH{1'b0}}}),
-  .data_out({d_mem_data_out, i_mem_data_out}),
-  .out_address({d_mem_address_out, i_mem_address_out}),
-  .ready({d_mem_ready, i_mem_ready}),
-  .valid({d_mem_valid, i_mem_valid}),
-  //interface with memory side interface
-  .mem2cachehier_msg(intf2cachehier_msg),
-  .mem2cachehier_address(intf2cachehier_address),
-  .mem2cachehier_data(intf2cachehier_data),
-  .cachehier2mem_msg(cachehier2intf_msg),
-  .cachehier2mem_address(cachehier2intf_address),
-  .cachehier2mem_data(cachehier2intf_data),
-  .mem_intf_busy(1'b0),
-  .mem_intf_address(32'd0),
-  .mem_intf_address_valid(1'b0),
-  //interface for memory side interface to access cache memory
-  .port1_read(1'b0),
-  .port1_write(1'b0),
-  .port1_invalidate(1'b0),
-  .port1_index(6'd0),
-  .port1_tag(24'b0),
-  .port1_metadata(5'b0),
-  .port1_write_data(128'd0),
-  .port1_way_select(2'd0),
-  .port1_read_data(),
-  .port1_matched_way(),
-  .port1_coh_bits(),
-  .port1_status_bits(),
-  .port1_hit(),
-  
-  .scan(scan)
-);
+generate
+  if(NUM_CLUSTERS == 1)begin : SINGLE_CLUSTER
+    two_level_cache_hierarchy #(
+      .STATUS_BITS_L1(STATUS_BITS_L1),
+      .OFFSET_BITS_L1(OFFSET_BITS_L1),
+      .NUMBER_OF_WAYS_L1(NUMBER_OF_WAYS_L1),
+      .INDEX_BITS_L1(INDEX_BITS_L1),
+      .REPLACEMENT_MODE_L1(REPLACEMENT_MODE_L1),
+      .STATUS_BITS_L2(STATUS_BITS_L2),
+      .OFFSET_BITS_L2(OFFSET_BITS_L2),
+      .NUMBER_OF_WAYS_L2(NUMBER_OF_WAYS_L2),
+      .INDEX_BITS_L2(INDEX_BITS_L2),
+      .REPLACEMENT_MODE_L2(REPLACEMENT_MODE_L2),
+      .L2_INCLUSION(L2_INCLUSION),
+      .L2_EXCLUSION(L2_EXCLUSION),
+      .COHERENCE_BITS(COHERENCE_BITS),
+      .DATA_WIDTH(DATA_WIDTH),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .MSG_BITS(MSG_BITS),
+      .NUM_L1_CACHES(NUM_L1_CACHES),
+      .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
+      .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
+      .VICTIM_ENTRIES_L1(VICTIM_ENTRIES_L1),
+      .ARB_POLICY(ARB_POLICY),
+      .ARB_BANDWIDTH_WINDOW(ARB_BANDWIDTH_WINDOW),
+      .ARB_BANDWIDTH_CAPS(ARB_BANDWIDTH_CAPS),
+      .ARB_REPEAT_HOLDOFF(ARB_REPEAT_HOLDOFF),
+      .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
+    ) cache_hier (
+      .clock(clock),
+      .reset(reset),
+      //interface with processor pipelines
+      .read({cache_d_read, i_mem_read}),
+      .write({cache_d_write, {NUM_CORES{1'b0}}}),
+      .invalidate({2*NUM_CORES{1'b0}}),
+      .w_byte_en({d_mem_byte_en, {NUM_CORES*DATA_WIDTH/8{1'b0}}}),
+      .flush({2*NUM_CORES{1'b0}}),
+      .address({d_mem_address_in, i_mem_address_in}),
+      .data_in({d_mem_data_in, {NUM_CORES*DATA_WIDTH{1'b0}}}),
+      .data_out({cache_d_data_out, i_mem_data_out}),
+      .out_address({cache_d_address_out, i_mem_address_out}),
+      .ready({cache_d_ready, i_mem_ready}),
+      .valid({cache_d_valid, i_mem_valid}),
+      //interface with memory side interface
+      .mem2cachehier_msg(intf2cachehier_msg),
+      .mem2cachehier_address(intf2cachehier_address),
+      .mem2cachehier_data(intf2cachehier_data),
+      .cachehier2mem_msg(cachehier2intf_msg),
+      .cachehier2mem_address(cachehier2intf_address),
+      .cachehier2mem_data(cachehier2intf_data),
+      .mem_intf_busy(1'b0),
+      .mem_intf_address(32'd0),
+      .mem_intf_address_valid(1'b0),
+      //interface for memory side interface to access cache memory
+      .port1_read(1'b0),
+      .port1_write(1'b0),
+      .port1_invalidate(1'b0),
+      .port1_index(6'd0),
+      .port1_tag(24'b0),
+      .port1_metadata(5'b0),
+      .port1_write_data(128'd0),
+      .port1_way_select(2'd0),
+      .port1_read_data(),
+      .port1_matched_way(),
+      .port1_coh_bits(),
+      .port1_status_bits(),
+      .port1_hit(),
+
+      .scan(scan)
+    );
+  end
+  else begin : CLUSTERED
+    three_level_cache_hierarchy #(
+      .STATUS_BITS_L1(STATUS_BITS_L1),
+      .OFFSET_BITS_L1(OFFSET_BITS_L1),
+      .NUMBER_OF_WAYS_L1(NUMBER_OF_WAYS_L1),
+      .INDEX_BITS_L1(INDEX_BITS_L1),
+      .REPLACEMENT_MODE_L1(REPLACEMENT_MODE_L1),
+      .STATUS_BITS_L2(STATUS_BITS_L2),
+      .OFFSET_BITS_L2(OFFSET_BITS_L2),
+      .NUMBER_OF_WAYS_L2(NUMBER_OF_WAYS_L2),
+      .INDEX_BITS_L2(INDEX_BITS_L2),
+      .REPLACEMENT_MODE_L2(REPLACEMENT_MODE_L2),
+      .L2_INCLUSION(L2_INCLUSION),
+      .STATUS_BITS_L3(3),
+      .OFFSET_BITS_L3(OFFSET_BITS_L3),
+      .NUMBER_OF_WAYS_L3(NUMBER_OF_WAYS_L3),
+      .INDEX_BITS_L3(INDEX_BITS_L3),
+      .REPLACEMENT_MODE_L3(REPLACEMENT_MODE_L3),
+      .COHERENCE_BITS(COHERENCE_BITS),
+      .DATA_WIDTH(DATA_WIDTH),
+      .ADDRESS_BITS(ADDRESS_BITS),
+      .MSG_BITS(MSG_BITS),
+      .NUM_CLUSTERS(NUM_CLUSTERS),
+      .CORES_PER_CLUSTER(CORES_PER_CLUSTER),
+      .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
+      .MAX_OFFSET_BITS(MAX_OFFSET_BITS),
+      .L3_BUS_OFFSET_BITS(L3_BUS_OFFSET_BITS),
+      .VICTIM_ENTRIES_L1(VICTIM_ENTRIES_L1),
+      .ARB_POLICY(ARB_POLICY),
+      .ARB_BANDWIDTH_WINDOW(ARB_BANDWIDTH_WINDOW),
+      .ARB_BANDWIDTH_CAPS(ARB_BANDWIDTH_CAPS),
+      .ARB_REPEAT_HOLDOFF(ARB_REPEAT_HOLDOFF)
+    ) cache_hier (
+      .clock(clock),
+      .reset(reset),
+      //interface with processor pipelines
+      .read({cache_d_read, i_mem_read}),
+      .write({cache_d_write, {NUM_CORES{1'b0}}}),
+      .invalidate({2*NUM_CORES{1'b0}}),
+      .w_byte_en({d_mem_byte_en, {NUM_CORES*DATA_WIDTH/8{1'b0}}}),
+      .flush({2*NUM_CORES{1'b0}}),
+      .address({d_mem_address_in, i_mem_address_in}),
+      .data_in({d_mem_data_in, {NUM_CORES*DATA_WIDTH{1'b0}}}),
+      .data_out({cache_d_data_out, i_mem_data_out}),
+      .out_address({cache_d_address_out, i_mem_address_out}),
+      .ready({cache_d_ready, i_mem_ready}),
+      .valid({cache_d_valid, i_mem_valid}),
+      //interface with memory side interface
+      .mem2cachehier_msg(intf2cachehier_msg),
+      .mem2cachehier_address(intf2cachehier_address),
+      .mem2cachehier_data(intf2cachehier_data),
+      .cachehier2mem_msg(cachehier2intf_msg),
+      .cachehier2mem_address(cachehier2intf_address),
+      .cachehier2mem_data(cachehier2intf_data),
+      .mem_intf_busy(1'b0),
+      .mem_intf_address({ADDRESS_BITS{1'b0}}),
+      .mem_intf_address_valid(1'b0),
+      //interface for memory side interface to access L3 cache memory
+      .port1_read(1'b0),
+      .port1_write(1'b0),
+      .port1_invalidate(1'b0),
+      .port1_index({INDEX_BITS_L3{1'b0}}),
+      .port1_tag({ADDRESS_BITS{1'b0}}),
+      .port1_metadata({(COHERENCE_BITS+3){1'b0}}),
+      .port1_write_data({LLC_WIDTH{1'b0}}),
+      .port1_way_select({NUMBER_OF_WAYS_L3{1'b0}}),
+      .port1_read_data(),
+      .port1_matched_way(),
+      .port1_coh_bits(),
+      .port1_status_bits(),
+      .port1_hit(),
+
+      .scan(scan)
+    );
+  end
+endgenerate
 
 
 /*Main memory interface*/
 main_memory_interface #(
-  .OFFSET_BITS(OFFSET_BITS_L2),
+  .OFFSET_BITS(LLC_OFFSET_BITS),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_WIDTH(ADDRESS_BITS),
-  .MSG_BITS(MSG_BITS)
+  .MSG_BITS(MSG_BITS),
+  .BURST_READS(DRAM_BURSTS),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) mem_intf (
   .clock(clock),
   .reset(reset),
@@ -313,7 +635,16 @@ main_memory #(
   .MSG_BITS(MSG_BITS),
   .INDEX_BITS(MEM_ADDRESS_BITS),
   .NUM_PORTS(1),
-  .PROGRAM(PROGRAM)
+  .PROGRAM(PROGRAM),
+  .TIMING_MODEL(MEMORY_TIMING),
+  .DRAM_BANKS(DRAM_BANKS),
+  .DRAM_BURST_WORDS(1 << LLC_OFFSET_BITS),
+  .DRAM_BURST_READS(DRAM_BURSTS),
+  .DRAM_QUEUE_DEPTH(DRAM_QUEUE_DEPTH),
+  .DRAM_T_RCD(DRAM_T_RCD),
+  .DRAM_T_CAS(DRAM_T_CAS),
+  .DRAM_T_RP(DRAM_T_RP),
+  .DRAM_OPEN_PAGE(DRAM_OPEN_PAGE)
 ) memory (
   .clock(clock),
   .reset(reset),
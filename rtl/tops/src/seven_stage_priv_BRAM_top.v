@@ -31,7 +31,9 @@ module seven_stage_priv_BRAM_top #(
   parameter UART_FIFO_SIZE   = 1024,
   parameter INIT_FILE_BASE   = "",
   parameter SCAN_CYCLES_MIN  = 0,
-  parameter SCAN_CYCLES_MAX  = 1000
+  parameter SCAN_CYCLES_MAX  = 1000,
+  // Words in the L0 loop buffer of the core, see loop_buffer. 0 removes it.
+  parameter LOOP_BUFFER_WORDS = 0
 ) (
   input clock,
   input reset,
@@ -167,6 +169,7 @@ seven_stage_priv_core #(
   .SATP_MODE_BITS(SATP_MODE_BITS),
   .ASID_BITS(ASID_BITS),
   .PPN_BITS(PPN_BITS),
+  .LOOP_BUFFER_WORDS(LOOP_BUFFER_WORDS),
   .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
   .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
 ) core (
@@ -220,6 +223,8 @@ memory_interface #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS)
 ) mem_interface (
+  .clock(clock),
+  .reset(reset),
   //fetch stage interface
   .fetch_read(fetch_read),
   .fetch_address_out(fetch_address_out),
@@ -26,7 +26,10 @@ module single_cycle_cache_top #(
   parameter ADDRESS_BITS     = 32,
   parameter MEM_ADDRESS_BITS = 14,
   parameter SCAN_CYCLES_MIN  = 0,
-  parameter SCAN_CYCLES_MAX  = 1000
+  parameter SCAN_CYCLES_MAX  = 1000,
+  // 1: load misses get the requested word from main memory ahead of the line,
+  // see two_level_cache_hierarchy
+  parameter CRITICAL_WORD_FIRST = 0
 ) (
   input clock,
   input reset,
@@ -131,6 +134,8 @@ memory_interface #(
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS)
 ) mem_interface (
+  .clock(clock),
+  .reset(reset),
   //fetch stage interface
   .fetch_read(fetch_read),
   .fetch_address_out(fetch_address_out),
@@ -188,7 +193,8 @@ two_level_cache_hierarchy #(
   .MSG_BITS(4),
   .NUM_L1_CACHES(2),
   .BUS_OFFSET_BITS(2),
-  .MAX_OFFSET_BITS(2)
+  .MAX_OFFSET_BITS(2),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) cache_hier (
   .clock(clock),
   .reset(reset),
@@ -238,7 +244,8 @@ main_memory_interface #(
   .OFFSET_BITS(L2_OFFSET),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_WIDTH(ADDRESS_BITS),
-  .MSG_BITS(MSG_BITS)
+  .MSG_BITS(MSG_BITS),
+  .CRITICAL_WORD_FIRST(CRITICAL_WORD_FIRST)
 ) mem_intf (
   .clock(clock),
   .reset(reset),
@@ -33,7 +33,11 @@
 
 // Redefine macros used in this file
 `define PROGRAM_BRAM_MEMORY dut.memory.memory.ram
+`ifdef DUAL_ISSUE
+`define REGISTER_FILE dut.core.ID.registers.register_file
+`else
 `define REGISTER_FILE dut.core.ID.base_decode.registers.register_file
+`endif
 `define CURRENT_PC dut.core.FI.PC_reg
 
 module tb_seven_stage_BRAM_top_factorial();
@@ -45,6 +49,11 @@ parameter MEM_ADDRESS_BITS = 14;
 parameter D_ADDRESS_BITS   = 14;
 parameter SCAN_CYCLES_MIN  = 0;
 parameter SCAN_CYCLES_MAX  = 1000;
+`ifdef DUAL_ISSUE
+parameter FETCH_WORDS      = 64/DATA_WIDTH;
+`else
+parameter FETCH_WORDS      = 1;
+`endif
 parameter PROGRAM          = "./binaries/factorial6140.vmh";
 parameter TEST_NAME        = "Factorial";
 parameter LOG_FILE         = "factorial_results.txt";
@@ -66,7 +75,11 @@ reg scan;
 reg [DATA_WIDTH-1:0] dummy_ram [2**MEM_ADDRESS_BITS-1:0];
 
 
+`ifdef DUAL_ISSUE
+seven_stage_dual_BRAM_top #(
+`else
 seven_stage_BRAM_top #(
+`endif
   .CORE(CORE),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
@@ -97,13 +110,15 @@ initial begin
   $readmemh(PROGRAM, dummy_ram);
 end
 
+// Each BRAM row holds the FETCH_WORDS words of one instruction fetch
 generate
-for(byte=0; byte<DATA_WIDTH/8; byte=byte+1) begin : BYTE_LOOP
+for(byte=0; byte<FETCH_WORDS*DATA_WIDTH/8; byte=byte+1) begin : BYTE_LOOP
   initial begin
     #1 // Wait for dummy ram to be initialzed
     // Copy dummy ram contents into each byte BRAM
-    for(x=0; x<2**MEM_ADDRESS_BITS; x=x+1) begin
-      dut.memory.memory.BYTE_LOOP[byte].ELSE_INIT.BRAM_byte.ram[x] = dummy_ram[x][8*byte +: 8];
+    for(x=0; x<2**MEM_ADDRESS_BITS/FETCH_WORDS; x=x+1) begin
+      dut.memory.memory.BYTE_LOOP[byte].ELSE_INIT.BRAM_byte.ram[x] =
+        dummy_ram[x*FETCH_WORDS + byte/(DATA_WIDTH/8)][8*(byte%(DATA_WIDTH/8)) +: 8];
     end
   end
 end
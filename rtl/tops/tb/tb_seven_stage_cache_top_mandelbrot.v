@@ -33,7 +33,11 @@
 
 // Redefine macros used in this file
 `define PROGRAM_BRAM_MEMORY dut.memory.BRAM_inst.ram
+`ifdef DUAL_ISSUE
+`define REGISTER_FILE dut.core.ID.registers.register_file
+`else
 `define REGISTER_FILE dut.core.ID.base_decode.registers.register_file
+`endif
 `define CURRENT_PC dut.core.FI.PC_reg
 
 module tb_seven_stage_cache_top_mandelbrot();
@@ -60,7 +64,11 @@ wire [ADDRESS_BITS-1:0] PC;
 
 reg scan;
 
+`ifdef DUAL_ISSUE
+seven_stage_dual_cache_top #(
+`else
 seven_stage_cache_top #(
+`endif
   .CORE(CORE),
   .DATA_WIDTH(DATA_WIDTH),
   .ADDRESS_BITS(ADDRESS_BITS),
@@ -77,6 +85,32 @@ seven_stage_cache_top #(
 );
 
 
+// Commit and pipeline occupancy trace. Enabled with +trace=<prefix>
+// The dual issue core has no trace ports.
+`ifndef DUAL_ISSUE
+seven_stage_trace_writer #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS)
+) trace_writer (
+  .clock(clock),
+  .reset(reset),
+  .trace_retire(dut.core.trace_retire),
+  .trace_PC(dut.core.trace_PC),
+  .trace_instruction(dut.core.trace_instruction),
+  .trace_reg_write(dut.core.trace_reg_write),
+  .trace_rd(dut.core.trace_rd),
+  .trace_rd_data(dut.core.trace_rd_data),
+  .trace_memory_access(dut.core.trace_memory_access),
+  .trace_store(dut.core.trace_store),
+  .trace_memory_address(dut.core.trace_memory_address),
+  .trace_stage_valid(dut.core.trace_stage_valid),
+  .trace_stall(dut.core.trace_stall),
+  .trace_flush(dut.core.trace_flush),
+  .trace_hazards(dut.core.trace_hazards)
+);
+`endif
+
 // Clock generator
 always #1 clock = ~clock;
 
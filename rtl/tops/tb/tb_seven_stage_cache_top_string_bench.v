@@ -0,0 +1,203 @@
+/** @module : tb_seven_stage_cache_top_string_bench
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+// Undefine macros used in this file
+`ifdef REGISTER_FILE
+  `undef REGISTER_FILE
+`endif
+`ifdef CURRENT_PC
+  `undef CURRENT_PC
+`endif
+`ifdef PROGRAM_BRAM_MEMORY
+  `undef PROGRAM_BRAM_MEMORY
+`endif
+
+// Redefine macros used in this file
+`define PROGRAM_BRAM_MEMORY dut.memory.BRAM_inst.ram
+`define REGISTER_FILE dut.core.ID.base_decode.registers.register_file
+`define CURRENT_PC dut.core.FI.PC_reg
+
+module tb_seven_stage_cache_top_string_bench();
+
+parameter CORE             = 0;
+parameter DATA_WIDTH       = 32;
+parameter ADDRESS_BITS     = 32;
+parameter MEM_ADDRESS_BITS = 14;
+parameter SCAN_CYCLES_MIN  = 0;
+parameter SCAN_CYCLES_MAX  = 1000;
+parameter PROGRAM          = "./binaries/string_bench.vmh";
+parameter TEST_NAME        = "String Routines";
+parameter LOG_FILE         = "string_bench_results.txt";
+
+genvar i;
+integer x;
+
+reg clock;
+reg reset;
+reg start;
+reg [ADDRESS_BITS-1:0] program_address;
+
+wire [ADDRESS_BITS-1:0] PC;
+
+reg scan;
+
+seven_stage_cache_top #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .MEM_ADDRESS_BITS(MEM_ADDRESS_BITS),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX)
+) dut (
+  .clock(clock),
+  .reset(reset),
+  .start(start),
+  .program_address(program_address),
+  .PC(PC),
+  .scan(scan)
+);
+
+
+// Commit and pipeline occupancy trace. Enabled with +trace=<prefix>
+seven_stage_trace_writer #(
+  .CORE(CORE),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS)
+) trace_writer (
+  .clock(clock),
+  .reset(reset),
+  .trace_retire(dut.core.trace_retire),
+  .trace_PC(dut.core.trace_PC),
+  .trace_instruction(dut.core.trace_instruction),
+  .trace_reg_write(dut.core.trace_reg_write),
+  .trace_rd(dut.core.trace_rd),
+  .trace_rd_data(dut.core.trace_rd_data),
+  .trace_memory_access(dut.core.trace_memory_access),
+  .trace_store(dut.core.trace_store),
+  .trace_memory_address(dut.core.trace_memory_address),
+  .trace_stage_valid(dut.core.trace_stage_valid),
+  .trace_stall(dut.core.trace_stall),
+  .trace_flush(dut.core.trace_flush),
+  .trace_hazards(dut.core.trace_hazards)
+);
+
+// Clock generator
+always #1 clock = ~clock;
+
+// Initialize program memory
+initial begin
+  for(x=0; x<2**MEM_ADDRESS_BITS; x=x+1) begin
+    dut.memory.BRAM_inst.ram[x] = 32'd0;
+  end
+  for(x=0; x<32; x=x+1) begin
+    `REGISTER_FILE[x] = 32'd0;
+  end
+  $readmemh(PROGRAM, dut.memory.BRAM_inst.ram);
+end
+
+
+// string_bench marks each phase with "addi zero, t0, <id>". t0 holds the bytes
+// the phase processes, id 0 ends the phase.
+function [8*6-1:0] phase_name;
+input [2:0] id;
+begin
+  case(id)
+    3'd1:    phase_name = "memcpy";
+    3'd2:    phase_name = "memset";
+    3'd3:    phase_name = "memcmp";
+    3'd4:    phase_name = "strlen";
+    3'd5:    phase_name = "strcpy";
+    default: phase_name = "?";
+  endcase
+end
+endfunction
+
+integer cycles;
+integer phase_start;
+integer phase_bytes;
+reg [2:0] phase_id;
+
+always @(posedge clock) begin
+  cycles <= reset ? 0 : cycles + 1;
+  if(~reset & dut.core.trace_retire & (dut.core.trace_instruction[19:0] == 20'h28013)) begin
+    if(dut.core.trace_instruction[31:20] != 12'd0) begin
+      phase_id    <= dut.core.trace_instruction[22:20];
+      phase_bytes <= `REGISTER_FILE[5];
+      phase_start <= cycles;
+    end
+    else begin
+      $display("%s: %0d bytes in %0d cycles, %0.3f bytes/cycle", phase_name(phase_id),
+               phase_bytes, cycles - phase_start, $itor(phase_bytes)/$itor(cycles - phase_start));
+    end
+  end
+end
+
+integer start_time;
+integer end_time;
+integer total_cycles;
+
+initial begin
+  clock  = 1;
+  reset  = 1;
+  scan = 0;
+  start = 0;
+  program_address = {ADDRESS_BITS{1'b0}};
+  #10
+
+  #1
+  reset = 0;
+  start = 1;
+  start_time = $time();
+  #1
+
+  start = 0;
+
+end
+
+always begin
+
+  // Check pass/fail condition every 1000 cycles so that check does not slow
+  // down simulation to much
+  #1
+  if(`CURRENT_PC == 32'h000002e0) begin
+    end_time = $time();
+    total_cycles = (end_time - start_time)/2;
+    #100 // Wait for pipeline to empty
+    $display("\nRun Time (cycles): %d", total_cycles);
+    if(`REGISTER_FILE[9] == 32'h000002ad) begin
+      $display("\ntb_seven_stage_cache_top (%s) --> Test Passed!\n\n", TEST_NAME);
+    end else begin
+      $display("Dumping reg file states:");
+      $display("Reg Index, Value");
+      for( x=0; x<32; x=x+1) begin
+        $display("%d: %h", x, `REGISTER_FILE[x]);
+      end
+      $display("");
+      $display("\ntb_seven_stage_cache_top (%s) --> Test Failed!\n\n", TEST_NAME);
+    end // pass/fail check
+
+    $stop();
+
+  end // pc check
+end // always
+
+endmodule
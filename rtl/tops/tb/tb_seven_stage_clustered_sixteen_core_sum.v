@@ -0,0 +1,197 @@
+/** @module : tb_seven_stage_clustered_sixteen_core_sum
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+// Sixteen cores in four clusters of four. Every core adds 1 to 10+core and
+// stores the sum in a shared array, where each cache line holds one core of
+// every cluster. Then every core waits for all sixteen sums and adds them up.
+// s2 holds the core's own sum and s1 the total, 2760.
+
+module tb_seven_stage_clustered_sixteen_core_sum();
+
+parameter PROGRAM             = "./binaries/sixteen_core_sum.vmh";
+parameter TEST_NAME           = "Sixteen Core Sum";
+
+parameter NUM_CORES           = 16;
+parameter NUM_CLUSTERS        = 4;
+parameter DATA_WIDTH          = 32;
+parameter ADDRESS_BITS        = 32;
+parameter MEM_ADDRESS_BITS    = 14;
+parameter SCAN_CYCLES_MIN     = 0;
+parameter SCAN_CYCLES_MAX     = 1000;
+// Cache hierarchy parameters
+parameter STATUS_BITS_L1      = 2;
+parameter OFFSET_BITS_L1      = {2*NUM_CORES{32'd2}};
+parameter NUMBER_OF_WAYS_L1   = {2*NUM_CORES{32'd2}};
+parameter INDEX_BITS_L1       = {2*NUM_CORES{32'd5}};
+parameter REPLACEMENT_MODE_L1 = 1'b0;
+parameter STATUS_BITS_L2      = 3;
+parameter OFFSET_BITS_L2      = 2;
+parameter NUMBER_OF_WAYS_L2   = 4;
+parameter INDEX_BITS_L2       = 6;
+parameter REPLACEMENT_MODE_L2 = 1'b0;
+parameter L2_INCLUSION        = 1'b1;
+parameter OFFSET_BITS_L3      = 2;
+parameter NUMBER_OF_WAYS_L3   = 8;
+parameter INDEX_BITS_L3       = 8;
+parameter REPLACEMENT_MODE_L3 = 1'b0;
+parameter L3_BUS_OFFSET_BITS  = 2;
+parameter COHERENCE_BITS      = 2;
+parameter MSG_BITS            = 4;
+parameter BUS_OFFSET_BITS     = 2;
+parameter MAX_OFFSET_BITS     = 2;
+
+parameter DONE_PC             = 32'h00000154;
+parameter EXPECTED_TOTAL      = 32'd2760;
+
+genvar i;
+integer x;
+
+reg clock;
+reg reset;
+reg start;
+reg [NUM_CORES*ADDRESS_BITS-1:0] program_address;
+
+wire [NUM_CORES*ADDRESS_BITS-1:0] PC;
+
+reg scan;
+
+// Instantiate DUT
+seven_stage_multicore_top #(
+  .NUM_CORES(NUM_CORES),
+  .DATA_WIDTH(DATA_WIDTH),
+  .ADDRESS_BITS(ADDRESS_BITS),
+  .MEM_ADDRESS_BITS(MEM_ADDRESS_BITS),
+  .PROGRAM(PROGRAM),
+  .SCAN_CYCLES_MIN(SCAN_CYCLES_MIN),
+  .SCAN_CYCLES_MAX(SCAN_CYCLES_MAX),
+  .STATUS_BITS_L1(STATUS_BITS_L1),
+  .OFFSET_BITS_L1(OFFSET_BITS_L1),
+  .NUMBER_OF_WAYS_L1(NUMBER_OF_WAYS_L1),
+  .INDEX_BITS_L1(INDEX_BITS_L1),
+  .REPLACEMENT_MODE_L1(REPLACEMENT_MODE_L1),
+  .STATUS_BITS_L2(STATUS_BITS_L2),
+  .OFFSET_BITS_L2(OFFSET_BITS_L2),
+  .NUMBER_OF_WAYS_L2(NUMBER_OF_WAYS_L2),
+  .INDEX_BITS_L2(INDEX_BITS_L2),
+  .REPLACEMENT_MODE_L2(REPLACEMENT_MODE_L2),
+  .L2_INCLUSION(L2_INCLUSION),
+  .NUM_CLUSTERS(NUM_CLUSTERS),
+  .OFFSET_BITS_L3(OFFSET_BITS_L3),
+  .NUMBER_OF_WAYS_L3(NUMBER_OF_WAYS_L3),
+  .INDEX_BITS_L3(INDEX_BITS_L3),
+  .REPLACEMENT_MODE_L3(REPLACEMENT_MODE_L3),
+  .L3_BUS_OFFSET_BITS(L3_BUS_OFFSET_BITS),
+  .COHERENCE_BITS(COHERENCE_BITS),
+  .MSG_BITS(MSG_BITS),
+  .BUS_OFFSET_BITS(BUS_OFFSET_BITS),
+  .MAX_OFFSET_BITS(MAX_OFFSET_BITS)
+) DUT (
+  .clock(clock),
+  .reset(reset),
+  .start(start),
+  .program_address(program_address),
+  .PC(PC),
+  .scan(scan)
+);
+
+// Clock generator
+always #1 clock = ~clock;
+
+// Initialize program memory
+initial begin
+  for(x=0; x<2**MEM_ADDRESS_BITS; x=x+1) begin
+    DUT.memory.BRAM_inst.ram[x] = 32'd0;
+  end
+  $readmemh(PROGRAM, DUT.memory.BRAM_inst.ram);
+end
+
+integer start_time;
+reg [NUM_CORES-1:0] finished;
+reg [NUM_CORES-1:0] passed;
+
+// Per core checks
+generate
+  for(i=0; i<NUM_CORES; i=i+1) begin : CHECK
+    integer total_cycles;
+
+    initial begin
+      for(x=0; x<32; x=x+1) begin
+        DUT.CORES[i].BASE.core.ID.base_decode.registers.register_file[x] = 32'd0;
+      end
+    end
+
+    // The fetch PC passes DONE_PC speculatively while the cores poll, so
+    // wait for the halt loop to retire.
+    always begin
+      #1
+      if(DUT.CORES[i].BASE.core.trace_retire &
+         (DUT.CORES[i].BASE.core.trace_PC == DONE_PC) & ~finished[i]) begin
+        total_cycles = ($time() - start_time)/10;
+        #100 // Wait for pipeline to empty
+        $display("\nCore %0d finished. Run Time (cycles): %d", i, total_cycles);
+        if((DUT.CORES[i].BASE.core.ID.base_decode.registers.register_file[9] ==
+            EXPECTED_TOTAL) &
+           (DUT.CORES[i].BASE.core.ID.base_decode.registers.register_file[18] ==
+            (10+i)*(11+i)/2)) begin
+          passed[i] = 1'b1;
+        end else begin
+          $display("Core %0d: s1 %0d (expected %0d), s2 %0d (expected %0d)", i,
+                   DUT.CORES[i].BASE.core.ID.base_decode.registers.register_file[9],
+                   EXPECTED_TOTAL,
+                   DUT.CORES[i].BASE.core.ID.base_decode.registers.register_file[18],
+                   (10+i)*(11+i)/2);
+        end
+        finished[i] = 1'b1;
+      end
+    end
+  end
+endgenerate
+
+initial begin
+  clock  = 1;
+  reset  = 1;
+  scan = 0;
+  start = 0;
+  program_address = {NUM_CORES*ADDRESS_BITS{1'b0}};
+  finished = {NUM_CORES{1'b0}};
+  passed   = {NUM_CORES{1'b0}};
+  #10
+
+  #1
+  reset = 0;
+  start = 1;
+  start_time = $time();
+  #1
+
+  start = 0;
+
+  wait(&finished);
+  if(&passed) begin
+    $display("\ntb_seven_stage_clustered_sixteen_core_sum --> Test Passed!\n\n");
+  end
+  else begin
+    $display("\ntb_seven_stage_clustered_sixteen_core_sum --> Test Failed!\n\n");
+  end
+  $stop();
+end
+
+endmodule
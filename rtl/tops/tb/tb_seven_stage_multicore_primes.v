@@ -48,17 +48,21 @@
 `ifdef PROGRAM_BRAM_MEMORY
   `undef PROGRAM_BRAM_MEMORY
 `endif
+`ifdef BUS_CONTROLLER
+  `undef BUS_CONTROLLER
+`endif
 
 // Redefine macros used in this file
 `define PROGRAM_BRAM_MEMORY DUT.memory.BRAM_inst.ram
-`define REGISTER_FILE0 DUT.CORES[0].core.ID.base_decode.registers.register_file
-`define REGISTER_FILE1 DUT.CORES[1].core.ID.base_decode.registers.register_file
-`define REGISTER_FILE2 DUT.CORES[2].core.ID.base_decode.registers.register_file
-`define REGISTER_FILE3 DUT.CORES[3].core.ID.base_decode.registers.register_file
-`define CURRENT_PC0 DUT.CORES[0].core.FI.PC_reg
-`define CURRENT_PC1 DUT.CORES[1].core.FI.PC_reg
-`define CURRENT_PC2 DUT.CORES[2].core.FI.PC_reg
-`define CURRENT_PC3 DUT.CORES[3].core.FI.PC_reg
+`define REGISTER_FILE0 DUT.CORES[0].BASE.core.ID.base_decode.registers.register_file
+`define REGISTER_FILE1 DUT.CORES[1].BASE.core.ID.base_decode.registers.register_file
+`define REGISTER_FILE2 DUT.CORES[2].BASE.core.ID.base_decode.registers.register_file
+`define REGISTER_FILE3 DUT.CORES[3].BASE.core.ID.base_decode.registers.register_file
+`define CURRENT_PC0 DUT.CORES[0].BASE.core.FI.PC_reg
+`define CURRENT_PC1 DUT.CORES[1].BASE.core.FI.PC_reg
+`define CURRENT_PC2 DUT.CORES[2].BASE.core.FI.PC_reg
+`define CURRENT_PC3 DUT.CORES[3].BASE.core.FI.PC_reg
+`define BUS_CONTROLLER DUT.SINGLE_CLUSTER.cache_hier.bus_controller
 
 module tb_seven_stage_multicore_primes();
 
@@ -134,6 +138,34 @@ seven_stage_multicore_top #(
 );
 
 
+// Commit and pipeline occupancy trace for each core. Enabled with
+// +trace=<prefix>
+generate
+  for(i=0; i<NUM_CORES; i=i+1) begin : TRACE
+    seven_stage_trace_writer #(
+      .CORE(i),
+      .DATA_WIDTH(DATA_WIDTH),
+      .ADDRESS_BITS(ADDRESS_BITS)
+    ) trace_writer (
+      .clock(clock),
+      .reset(reset),
+      .trace_retire(DUT.CORES[i].BASE.core.trace_retire),
+      .trace_PC(DUT.CORES[i].BASE.core.trace_PC),
+      .trace_instruction(DUT.CORES[i].BASE.core.trace_instruction),
+      .trace_reg_write(DUT.CORES[i].BASE.core.trace_reg_write),
+      .trace_rd(DUT.CORES[i].BASE.core.trace_rd),
+      .trace_rd_data(DUT.CORES[i].BASE.core.trace_rd_data),
+      .trace_memory_access(DUT.CORES[i].BASE.core.trace_memory_access),
+      .trace_store(DUT.CORES[i].BASE.core.trace_store),
+      .trace_memory_address(DUT.CORES[i].BASE.core.trace_memory_address),
+      .trace_stage_valid(DUT.CORES[i].BASE.core.trace_stage_valid),
+      .trace_stall(DUT.CORES[i].BASE.core.trace_stall),
+      .trace_flush(DUT.CORES[i].BASE.core.trace_flush),
+      .trace_hazards(DUT.CORES[i].BASE.core.trace_hazards)
+    );
+  end
+endgenerate
+
 // Clock generator
 always #1 clock = ~clock;
 
@@ -270,6 +302,11 @@ always begin
 
 
   if(finished_count == 4)begin
+    $display("\nL1 bus port, Grants, Wait cycles");
+    for( x=0; x<8; x=x+1) begin
+      $display("%d: %d %d", x, `BUS_CONTROLLER.grant_count[x*32 +: 32],
+               `BUS_CONTROLLER.wait_cycles[x*32 +: 32]);
+    end
     if(core1_passed & core0_passed & core2_passed & core3_passed)begin
       $display("\ntb_seven_stage_multicore_primes --> Test Passed!\n\n");
       $stop();
@@ -0,0 +1,71 @@
+/*=================================================================================
+ # malloc_bench.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+
+/*******************************************************************************
+ * Description: malloc/free churn for comparing libtrireme_malloc with the
+ * newlib malloc.
+ *
+ * NUM_OBJECTS small objects are kept alive. Every round frees and allocates
+ * every other object again with a different size, ROUNDS*NUM_OBJECTS/2
+ * allocations in total. The program returns 0x980 (default ROUNDS) with
+ * either allocator and 0 when an allocation fails. Build it with and without
+ * "trireme_gcc --trireme-malloc", or run
+ * software/helper_scripts/malloc_report.py for the code size and cycles per
+ * allocation of both on trireme_iss. In the compile_sim memory layout (512
+ * byte heap) only the --trireme-malloc build runs, the newlib malloc extends
+ * the heap in 4 KiB steps.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ROUNDS
+#define ROUNDS 32
+#endif
+#define NUM_OBJECTS 8
+
+static const unsigned char sizes[NUM_OBJECTS] = {8, 24, 12, 20, 4, 16, 28, 10};
+
+int main(void) {
+  unsigned char *objects[NUM_OBJECTS] = {0};
+  unsigned int checksum = 0;
+  int round, i;
+
+  for(round=0; round<ROUNDS; round++) {
+    for(i=round & 1; i<NUM_OBJECTS; i+=2) {
+      int size = sizes[(i + round) % NUM_OBJECTS];
+      free(objects[i]);
+      objects[i] = malloc(size);
+      if(objects[i] == NULL) {
+        return 0;
+      }
+      memset(objects[i], round + i, size);
+      checksum += objects[i][size-1];
+    }
+  }
+  for(i=0; i<NUM_OBJECTS; i++) {
+    free(objects[i]);
+  }
+  return checksum;
+}
@@ -0,0 +1,108 @@
+/*=================================================================================
+ # packed_mandelbrot.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+
+/*******************************************************************************
+ * Description: short_mandelbrot.c with the packed SIMD instructions of
+ * packed_simd_unit (seven stage cores built with P_EXTENSION = 1).
+ *
+ * Z is kept in one register, the real part in the bottom and the imaginary
+ * part in the top halfword (Q3.12). One iteration is three dual 16x16
+ * multiplies instead of five 32 bit mult() calls:
+ *   smdrs(z, z) = re*re - im*im
+ *   kmxda(z, z) = re*im + im*re
+ *   kmda(z, z)  = re*re + im*im (the magnitude)
+ * The points stay below 8.0 before they escape, so the results and the
+ * checksum match short_mandelbrot.c bit for bit.
+ *
+ * Build with "-Ilib" after "./build_bsp --build trireme_simd". Defining
+ * DESKTOP builds it with the C versions of the intrinsics on a desktop.
+*******************************************************************************/
+
+//#define DESKTOP 1
+
+#define EXPECTED_CHECKSUM 0x0018ba60 // max_iter = 3, 8x8
+#define H_RES 8
+#define V_RES 8
+#define MAX_ITER 3
+
+#define DELTA 0x00000400 //  20 integer points, 12 binary points 0.25
+#define FOUR 0x00004000
+#define X_START 0xFFFFE04F // -1.9807...
+#define Y_START 0x000011D0 // 1.125
+
+#ifdef DESKTOP
+#include <stdio.h>
+#endif /* DESKTOP */
+
+#include "trireme_simd.h"
+
+int main(void)
+{
+  unsigned int pixel_mag;
+  unsigned int checksum;
+  uintxlen_t z;
+  int c_re, c_im;
+  int re, im;
+
+  checksum = 0;
+
+  c_im = Y_START;
+  for( int i=0; i<V_RES; i++ ) {
+
+    c_re = X_START;
+    for( int j=0; j<H_RES; j++) {
+      z = 0;
+
+      for(int k=0; k<MAX_ITER; k++) {
+        // Zn1 = Zn^2 + C
+        re = ((int)__rv_smdrs(z, z) >> 12) + c_re;
+        im = ((int)__rv_kmxda(z, z) >> 12) + c_im;
+        z  = __rv_pkbb16((uintxlen_t)im, (uintxlen_t)re);
+
+        pixel_mag = (int)__rv_kmda(z, z) >> 12;
+        checksum += pixel_mag;
+        if(  pixel_mag > FOUR) {
+          break;
+        }
+      }
+
+      c_re += DELTA;
+    }
+    c_im -= DELTA;
+  }
+
+#ifdef DESKTOP
+  printf("Checksum Value: 0x%08x\n", checksum);
+  printf("Expected Value: 0x%08x\n", EXPECTED_CHECKSUM);
+#endif /* DESKTOP */
+
+  // Check Checksum
+  if(checksum == EXPECTED_CHECKSUM) {
+    return 2;
+  }
+  else {
+    return 1;
+  }
+
+}
@@ -0,0 +1,162 @@
+/*=================================================================================
+ # packed_pixels.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+
+/*******************************************************************************
+ * Description: 8 bit grayscale pixel kernels with and without the packed SIMD
+ * instructions of packed_simd_unit (seven stage cores with P_EXTENSION = 1).
+ *
+ * Every word holds 4 pixels. brighten() adds a constant with unsigned
+ * saturation, ukadd8 does 4 pixels per instruction. blend() mixes two images,
+ * out = b + ((a - b)*alpha >> 15), in 16 bit lanes: the even and odd bytes of
+ * a word are split into two registers of 2 lanes, multiplied with khm16 (a
+ * Q15 multiply) and merged again.
+ *
+ * PACKED_SIMD = 0 builds the same kernels with scalar code. Both versions
+ * give the same checksum, so the dynamic instruction counts of the two builds
+ * on trireme_iss show the saving, for example:
+ *   ./trireme_gcc ... -DPACKED_SIMD=0 applications/src/packed_pixels.c
+ *   ./trireme_gcc ... -DPACKED_SIMD=1 applications/src/packed_pixels.c
+ *   ./iss/trireme_iss packed_pixels.vmh
+ * Build with "-Ilib" after "./build_bsp --build trireme_simd". Defining
+ * DESKTOP builds it with the C versions of the intrinsics on a desktop.
+*******************************************************************************/
+
+//#define DESKTOP 1
+
+#ifndef PACKED_SIMD
+#define PACKED_SIMD 1
+#endif
+
+#define EXPECTED_CHECKSUM 0x43511d57
+#define NUM_WORDS 64 // 4 pixels per word
+#define BRIGHTNESS 0x30
+#define ALPHA 0xC0 // 0.75 of image a, 0 to 255
+
+#ifdef DESKTOP
+#include <stdio.h>
+#endif /* DESKTOP */
+
+#include "trireme_simd.h"
+
+unsigned int image_a[NUM_WORDS];
+unsigned int image_b[NUM_WORDS];
+unsigned int output[NUM_WORDS];
+
+void fill(unsigned int *image, unsigned int seed);
+void brighten(unsigned int *image, unsigned int brightness);
+void blend(unsigned int *a, unsigned int *b, unsigned int *out, int alpha);
+unsigned int checksum(unsigned int *image);
+
+int main(void)
+{
+  unsigned int sum;
+
+  fill(image_a, 0x1234);
+  fill(image_b, 0xBEEF);
+
+  brighten(image_a, BRIGHTNESS);
+  blend(image_a, image_b, output, ALPHA);
+  sum = checksum(output);
+
+#ifdef DESKTOP
+  printf("Checksum Value: 0x%08x\n", sum);
+  printf("Expected Value: 0x%08x\n", EXPECTED_CHECKSUM);
+#endif /* DESKTOP */
+
+  // Check Checksum
+  if(sum == EXPECTED_CHECKSUM) {
+    return 2;
+  }
+  else {
+    return 1;
+  }
+}
+
+// Linear congruential generator, no multiply so RV32I builds stay short
+void fill(unsigned int *image, unsigned int seed) {
+  for(int i=0; i<NUM_WORDS; i++) {
+    seed = (seed << 5) + seed + 0x3C6EF35F;
+    image[i] = seed ^ (seed >> 13);
+  }
+}
+
+#if PACKED_SIMD
+
+void brighten(unsigned int *image, unsigned int brightness) {
+  uintxlen_t offset = brightness * 0x01010101u;
+  for(int i=0; i<NUM_WORDS; i++) {
+    image[i] = __rv_ukadd8(image[i], offset);
+  }
+}
+
+void blend(unsigned int *a, unsigned int *b, unsigned int *out, int alpha) {
+  uintxlen_t scale = (unsigned int)(alpha << 7) * 0x00010001u; // Q15 in both lanes
+  for(int i=0; i<NUM_WORDS; i++) {
+    uintxlen_t a_even = a[i] & 0x00FF00FF;
+    uintxlen_t b_even = b[i] & 0x00FF00FF;
+    uintxlen_t a_odd  = __rv_srli16(a[i], 8);
+    uintxlen_t b_odd  = __rv_srli16(b[i], 8);
+    uintxlen_t even   = __rv_add16(b_even, __rv_khm16(__rv_sub16(a_even, b_even), scale));
+    uintxlen_t odd    = __rv_add16(b_odd,  __rv_khm16(__rv_sub16(a_odd,  b_odd),  scale));
+    out[i] = even | __rv_slli16(odd, 8);
+  }
+}
+
+#else
+
+void brighten(unsigned int *image, unsigned int brightness) {
+  for(int i=0; i<NUM_WORDS; i++) {
+    unsigned int word = 0;
+    for(int shift=0; shift<32; shift+=8) {
+      unsigned int pixel = ((image[i] >> shift) & 0xFF) + brightness;
+      if(pixel > 0xFF) pixel = 0xFF;
+      word |= pixel << shift;
+    }
+    image[i] = word;
+  }
+}
+
+void blend(unsigned int *a, unsigned int *b, unsigned int *out, int alpha) {
+  int scale = alpha << 7; // Q15
+  for(int i=0; i<NUM_WORDS; i++) {
+    unsigned int word = 0;
+    for(int shift=0; shift<32; shift+=8) {
+      int pixel_a = (a[i] >> shift) & 0xFF;
+      int pixel_b = (b[i] >> shift) & 0xFF;
+      int pixel   = pixel_b + (((pixel_a - pixel_b)*scale) >> 15);
+      word |= (unsigned int)pixel << shift;
+    }
+    out[i] = word;
+  }
+}
+
+#endif /* PACKED_SIMD */
+
+unsigned int checksum(unsigned int *image) {
+  unsigned int sum = 0;
+  for(int i=0; i<NUM_WORDS; i++) {
+    sum = (sum << 1) + (sum >> 31) + image[i];
+  }
+  return sum;
+}
@@ -0,0 +1,125 @@
+/*=================================================================================
+ # smp_malloc_test.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Cross hart free test of libtrireme_malloc with one arena per
+ * hart. Every hart allocates its own number and sizes of blocks (one of them
+ * a large block), then every hart frees the blocks of the previous hart and
+ * allocates blocks of the same sizes again. The frees must be counted for the
+ * allocating hart, and the freeing hart must reuse the blocks it freed
+ * without taking more heap. Every hart returns the number of harts that
+ * passed, so all harts return the hart count. Needs the statistics (STATS=1).
+ *
+ * Build the library with one arena per hart and run on 4 harts:
+ *   ./build_bsp --build trireme_smp
+ *   make -C bsp/trireme_malloc clean all MAX_HARTS=4
+ *   make -C bsp/trireme_malloc install lib_prefix=$PWD/lib
+ *   ./trireme_gcc applications/src/smp_malloc_test.c -Ilib -Wl,-ltrireme_smp \
+ *     --trireme-malloc --num-cores 4 --ram-size 32768 --stack-addr 28672 \
+ *     --heap-size 12288 -o smp_malloc_test --vmh @default_name
+ *   ./iss/trireme_iss --harts 4 --expect-s1 4,4,4,4 smp_malloc_test.vmh
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "trireme_smp.h"
+#include "trireme_malloc.h"
+
+#define NUM_BLOCKS 5
+
+// The last size is above the largest class (1024 bytes on RV32)
+static const unsigned short sizes[NUM_BLOCKS] = {4, 12, 40, 100, 1100};
+
+static unsigned char *blocks[SMP_MAX_HARTS][NUM_BLOCKS];
+static smp_reduction_t passed = SMP_REDUCTION_INITIALIZER;
+
+
+// Odd harts allocate one block less and every hart has other sizes
+static int block_count(int hart) {
+  return NUM_BLOCKS - (hart & 1);
+}
+
+static int block_size(int hart, int i) {
+  return sizes[i] + 24*hart;
+}
+
+
+static int check_stats(int hart, unsigned int allocations, unsigned int frees,
+                       unsigned int heap_bytes, unsigned int bytes_in_use) {
+  trireme_malloc_stats_t stats;
+
+  trireme_malloc_get_stats(hart, &stats);
+  return stats.allocations == allocations && stats.frees == frees &&
+         stats.failures == 0 && stats.heap_bytes == heap_bytes &&
+         stats.bytes_in_use == bytes_in_use &&
+         stats.peak_bytes_in_use >= heap_bytes;
+}
+
+
+int smp_main(void) {
+  int hart = smp_hart_id();
+  int previous = (hart + smp_num_harts() - 1) % smp_num_harts();
+  trireme_malloc_stats_t stats, previous_stats;
+  int pass = 1;
+  int i;
+
+  for(i=0; i<block_count(hart); i++) {
+    blocks[hart][i] = malloc(block_size(hart, i));
+    if(blocks[hart][i] == NULL) {
+      pass = 0;
+      break;
+    }
+    memset(blocks[hart][i], hart + 1, block_size(hart, i));
+  }
+  trireme_malloc_get_stats(hart, &stats);
+  pass = pass && stats.bytes_in_use == stats.heap_bytes;
+  smp_barrier();
+
+  // Free the blocks of the previous hart
+  for(i=0; pass && i<block_count(previous); i++) {
+    unsigned char *block = blocks[previous][i];
+    if(block == NULL || block[0] != previous + 1 ||
+       block[block_size(previous, i)-1] != previous + 1) {
+      pass = 0;
+    }
+    free(block);
+  }
+  smp_barrier();
+
+  // Every block was freed once, by the next hart
+  pass = pass && check_stats(hart, block_count(hart), block_count(hart),
+                             stats.heap_bytes, 0);
+  trireme_malloc_get_stats(previous, &previous_stats);
+  smp_barrier();
+
+  // The freed blocks of the previous hart are reused
+  for(i=0; pass && i<block_count(previous); i++) {
+    blocks[hart][i] = malloc(block_size(previous, i));
+    pass = blocks[hart][i] != NULL;
+  }
+  pass = pass && check_stats(hart, block_count(hart) + block_count(previous),
+                             block_count(hart), stats.heap_bytes,
+                             previous_stats.heap_bytes);
+
+  return smp_reduce_add(&passed, pass);
+}
@@ -0,0 +1,172 @@
+/*=================================================================================
+ # smp_mandelbrot.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Parallel version of short_mandelbrot.c built on
+ * libtrireme_smp. The rows of the image are split over all harts and the
+ * pixel magnitude checksums of the harts are added with a reduction. Every
+ * hart returns 2 if the checksum matches and 1 otherwise.
+ *
+ * The default 8x8 image with max_iter = 3 has the checksum of
+ * short_mandelbrot.c. Increase H_RES, V_RES and MAX_ITER to measure the
+ * speedup from 1 to 4 harts, the work per row grows with both.
+*******************************************************************************/
+
+#include "trireme_smp.h"
+
+#define EXPECTED_CHECKSUM 0x0018ba60 // max_iter = 3, 8x8
+#define H_RES 8
+#define V_RES 8
+#define MAX_ITER 3
+
+#define DELTA 0x00000400 //  20 integer points, 12 binary points 0.25
+#define FOUR 0x00004000
+#define X_START 0xFFFFE04F // -1.9807...
+#define Y_START 0x000011D0 // 1.125
+
+// Rows take different amounts of work, so harts take one row at a time.
+#define ROWS_PER_CHUNK 1
+
+
+struct complex_num {
+    int re;
+    int im;
+};
+typedef struct complex_num Complex_Num;
+
+void complex_add(Complex_Num *a, Complex_Num *b, Complex_Num *s);
+void complex_mult(Complex_Num *a, Complex_Num *b, Complex_Num *s);
+void complex_square(Complex_Num *a, Complex_Num*sq);
+void mandelbrot_iter(Complex_Num *Z, Complex_Num *C);
+int complex_magnitude(Complex_Num *a);
+unsigned int multu(unsigned int a, unsigned int b);
+int mult(int a, int b);
+
+static smp_loop_t row_loop = SMP_LOOP_INITIALIZER;
+static smp_reduction_t checksum_sum = SMP_REDUCTION_INITIALIZER;
+
+
+// arg points to the checksum of the calling hart.
+void mandelbrot_row(int row, void *arg)
+{
+  unsigned int *checksum = (unsigned int *)arg;
+  unsigned int pixel_mag;
+  Complex_Num Zn;
+  Complex_Num C;
+
+  C.im = Y_START - mult(row, DELTA);
+  C.re = X_START;
+  for( int j=0; j<H_RES; j++) {
+    Zn.re = 0;
+    Zn.im = 0;
+
+    for(int k=0; k<MAX_ITER; k++) {
+      mandelbrot_iter(&Zn, &C);
+      pixel_mag = complex_magnitude(&Zn);
+      *checksum += pixel_mag;
+      if(  pixel_mag > FOUR) {
+        break;
+      }
+    }
+    C.re += DELTA;
+  }
+}
+
+
+int smp_main(void)
+{
+  unsigned int checksum = 0;
+
+  smp_parallel_for(&row_loop, 0, V_RES, SMP_SCHEDULE_DYNAMIC, ROWS_PER_CHUNK,
+                   mandelbrot_row, &checksum);
+  checksum = (unsigned int)smp_reduce_add(&checksum_sum, (int)checksum);
+
+  // Check Checksum
+  if(checksum == EXPECTED_CHECKSUM) {
+    return 2;
+  }
+  else {
+    return 1;
+  }
+}
+
+void complex_add(Complex_Num *a, Complex_Num *b, Complex_Num *s) {
+  s->re = a->re + b->re;
+  s->im = a->im + b->im;
+
+}
+
+void complex_mult(Complex_Num *a, Complex_Num *b, Complex_Num *p) {
+  int reProduct32, imProduct32;
+
+  reProduct32 = mult(a->re, b->re) - mult(a->im, b->im);
+  imProduct32 = mult(a->re, b->im) + mult(a->im, a->re);
+  p->re = reProduct32 >> 12;
+  p->im = imProduct32 >> 12;
+}
+
+
+void complex_square(Complex_Num *a, Complex_Num *sq) {
+  complex_mult(a, a, sq);
+}
+
+// Zn1 = Zn^2 + C
+void mandelbrot_iter(Complex_Num *Z, Complex_Num *C) {
+    complex_square(Z, Z);
+    complex_add(Z, C, Z);
+
+}
+
+int complex_magnitude(Complex_Num *a) {
+  int mag32 = mult(a->re, a->re) + mult(a->im, a->im);
+  return mag32 >> 12;
+}
+
+unsigned int multu(unsigned int a, unsigned int b) {
+  unsigned int product;
+  product = 0;
+
+  for(int i=0; i<32; i++) {
+    if(0x00000001 & (a>>i) ) {
+      product = product + (b << i);
+    }
+  }
+  return product;
+}
+
+int mult(int a, int b) {
+  int product;
+  int sign_a, sign_b;
+  sign_a = a >> 31;
+  sign_b = b >> 31;
+
+  if(sign_a) a = (~a) + 1; // Flip sign
+  if(sign_b) b = (~b) + 1; // Flip sign
+
+  product = (signed int)multu( (unsigned int)a, (unsigned int)b );
+
+  if( sign_a^sign_b ) product = (~product) + 1; // Flip sign;
+
+  return product;
+
+}
@@ -0,0 +1,96 @@
+/*=================================================================================
+ # smp_prime_counter.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Parallel version of prime_number_counter.c built on
+ * libtrireme_smp. Counts the prime numbers from 0 to UPPER_BOUND on all harts
+ * and returns the count (25) on every hart. Larger numbers take longer to
+ * check, so the loop uses dynamic scheduling.
+ *
+ * Build for 1, 2 and 4 harts with the same source and compare the cycle
+ * counts, for example:
+ *   ./build_bsp --build trireme_smp
+ *   ./trireme_gcc applications/src/smp_prime_counter.c -Ilib -Wl,-ltrireme_smp \
+ *     --num-cores 4 --ram-size 16384 --stack-addr 8192 -o smp_primes \
+ *     --vmh @default_name
+*******************************************************************************/
+
+#include "trireme_smp.h"
+
+#define UPPER_BOUND 100
+#define CHUNK 4
+
+static smp_loop_t prime_loop = SMP_LOOP_INITIALIZER;
+static smp_reduction_t prime_count = SMP_REDUCTION_INITIALIZER;
+
+
+int getRemainder(int a, int b) {
+  int temp = 1;
+
+  while (b <= a) {
+    b <<= 1;
+    temp <<= 1;
+  }
+
+  while (temp > 1) {
+    b >>= 1;
+    temp >>= 1;
+
+    if (a >= b) {
+      a -= b;
+    }
+  }
+  return a;
+}
+
+
+int check_prime(int a){
+  if(a < 2){
+    return 0;
+  }
+  // i*i <= a without a multiply instruction: (i+1)^2 = i^2 + 2i + 1
+  for(int i=2, square=4; square<=a; square+=(i<<1)+1, i++){
+    if(getRemainder(a, i) == 0){
+      return 0;
+    }
+  }
+  return 1;
+}
+
+
+// arg points to the prime count of the calling hart.
+void count_prime(int number, void *arg){
+  if(check_prime(number)){
+    (*(int *)arg)++;
+  }
+}
+
+
+int smp_main(void){
+  int primes = 0;
+
+  smp_parallel_for(&prime_loop, 0, UPPER_BOUND+1, SMP_SCHEDULE_DYNAMIC, CHUNK,
+                   count_prime, &primes);
+
+  return smp_reduce_add(&prime_count, primes);
+}
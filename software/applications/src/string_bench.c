@@ -0,0 +1,103 @@
+/*=================================================================================
+ # string_bench.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+
+/*******************************************************************************
+ * Description: Throughput of the string routines of libnosys_trireme32
+ * (memcpy, memset, memcmp, strlen and strcpy, see bsp/trireme32).
+ *
+ * Each routine runs ITERATIONS times on BUFFER_BYTES byte buffers. Every
+ * phase is bracketed by BENCH_MARK, a "addi zero, t0, <id>" hint with the
+ * bytes of the phase in t0. tb_seven_stage_BRAM_top_string_bench and
+ * tb_seven_stage_cache_top_string_bench print the cycles and bytes per cycle
+ * of each phase (modelsim/binaries/string_bench.vmh is the same program).
+ * Build with -fno-builtin so GCC calls the library routines:
+ *   ./compile_sim string_bench -fno-builtin -O2 --heap-size 0
+ * Without "./build_bsp --build trireme32" the newlib versions are linked,
+ * compare the two builds on the RTL or on trireme_iss.
+*******************************************************************************/
+
+#include <string.h>
+
+#define EXPECTED_CHECKSUM 0x2ad
+#define BUFFER_BYTES 128 // 8 lines of the L1 data cache
+#define ITERATIONS 4
+
+#define BENCH_MARK(id, bytes) \
+  asm volatile("mv t0, %0\n\taddi zero, t0, %1" : : "r"(bytes), "i"(id) : "t0")
+
+#define BENCH_MEMCPY 1
+#define BENCH_MEMSET 2
+#define BENCH_MEMCMP 3
+#define BENCH_STRLEN 4
+#define BENCH_STRCPY 5
+
+char src[BUFFER_BYTES] __attribute__((aligned(16)));
+char dst[BUFFER_BYTES] __attribute__((aligned(16)));
+
+int main(void) {
+  unsigned int checksum = 0;
+  int i;
+
+  // "ABC...ZABC..." with a terminator in the last byte
+  for(i=0; i<BUFFER_BYTES-1; i++) {
+    src[i] = 'A' + i%26;
+  }
+  src[BUFFER_BYTES-1] = '\0';
+
+  BENCH_MARK(BENCH_MEMCPY, ITERATIONS*BUFFER_BYTES);
+  for(i=0; i<ITERATIONS; i++) {
+    memcpy(dst, src, BUFFER_BYTES);
+  }
+  BENCH_MARK(0, 0);
+  checksum += (unsigned char)dst[BUFFER_BYTES-2];
+
+  BENCH_MARK(BENCH_MEMSET, ITERATIONS*BUFFER_BYTES);
+  for(i=0; i<ITERATIONS; i++) {
+    memset(dst, i, BUFFER_BYTES);
+  }
+  BENCH_MARK(0, 0);
+  checksum += (unsigned char)dst[0];
+
+  memcpy(dst, src, BUFFER_BYTES);
+  BENCH_MARK(BENCH_MEMCMP, ITERATIONS*BUFFER_BYTES);
+  for(i=0; i<ITERATIONS; i++) {
+    checksum += memcmp(dst, src, BUFFER_BYTES);
+  }
+  BENCH_MARK(0, 0);
+
+  BENCH_MARK(BENCH_STRLEN, ITERATIONS*(BUFFER_BYTES-1));
+  for(i=0; i<ITERATIONS; i++) {
+    checksum += strlen(src);
+  }
+  BENCH_MARK(0, 0);
+
+  BENCH_MARK(BENCH_STRCPY, ITERATIONS*BUFFER_BYTES);
+  for(i=0; i<ITERATIONS; i++) {
+    strcpy(dst, src);
+  }
+  BENCH_MARK(0, 0);
+  checksum += (unsigned char)dst[BUFFER_BYTES-2];
+
+  return checksum == EXPECTED_CHECKSUM ? checksum : 0;
+}
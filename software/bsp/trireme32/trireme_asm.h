@@ -0,0 +1,69 @@
+/*=================================================================================
+ # trireme_asm.h
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Register width macros for the assembly routines of libnosys_trireme32.
+ *
+ * The same sources build for RV32I and RV64I. LINE_BYTES is the L1 line of
+ * the Trireme cache tops (4 words, OFFSET_BITS_L1 = 2), the bulk loops move
+ * one line per iteration.
+*******************************************************************************/
+
+#ifndef TRIREME_ASM_H
+#define TRIREME_ASM_H
+
+#if __riscv_xlen == 64
+#define REG_L ld
+#define REG_S sd
+#define SZREG 8
+#else
+#define REG_L lw
+#define REG_S sw
+#define SZREG 4
+#endif
+
+#define LINE_BYTES (4*SZREG)
+
+#define FUNCTION(name) \
+  .text;                \
+  .align 2;             \
+  .globl name;          \
+  .type name, @function; \
+name:
+
+#define END_FUNCTION(name) \
+  .size name, .-name
+
+// Repeats the byte in reg over the whole register, tmp is clobbered
+#if __riscv_xlen == 64
+#define REPLICATE_BYTE(reg, tmp) \
+  slli tmp, reg, 8;  or reg, reg, tmp; \
+  slli tmp, reg, 16; or reg, reg, tmp; \
+  slli tmp, reg, 32; or reg, reg, tmp
+#else
+#define REPLICATE_BYTE(reg, tmp) \
+  slli tmp, reg, 8;  or reg, reg, tmp; \
+  slli tmp, reg, 16; or reg, reg, tmp
+#endif
+
+#endif
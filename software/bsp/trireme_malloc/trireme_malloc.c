@@ -0,0 +1,356 @@
+/*=================================================================================
+ # trireme_malloc.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Size class allocator of libtrireme_malloc, see
+ * trireme_malloc.h.
+ *
+ * A block is a size_t header followed by the payload. The header holds the
+ * class of the block, or the block size for large blocks (always larger than
+ * MALLOC_NUM_CLASSES). With MALLOC_MAX_HARTS > 1 the low HART_BITS of the
+ * header hold the hart that allocated the block. Blocks start
+ * MALLOC_ALIGN - sizeof(size_t) bytes into an aligned unit and all block
+ * sizes are multiples of MALLOC_ALIGN, so every payload is aligned. Free
+ * blocks keep the free list link in the payload.
+ *
+ * A block freed by another hart goes to the free lists of the freeing hart,
+ * which may allocate it again. The statistics charge the free to the hart
+ * that allocated the block, but only the owning hart writes an arena, so the
+ * freeing hart counts it in its own remote_frees/remote_free_bytes entry for
+ * that hart.
+*******************************************************************************/
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <reent.h>
+#include "trireme_malloc.h"
+
+#define HEADER_BYTES    sizeof(size_t)
+#define LARGEST_BLOCK   (MALLOC_ALIGN << (MALLOC_NUM_CLASSES - 1))
+#define LARGE_CLASS     MALLOC_NUM_CLASSES
+
+#if MALLOC_MAX_HARTS > 16
+#error "MALLOC_MAX_HARTS must be at most 16"
+#endif
+
+#define HART_BITS (MALLOC_MAX_HARTS > 8 ? 4 : MALLOC_MAX_HARTS > 4 ? 3 : \
+                   MALLOC_MAX_HARTS > 2 ? 2 : MALLOC_MAX_HARTS > 1 ? 1 : 0)
+#define HART_MASK ((1u << HART_BITS) - 1)
+
+typedef struct free_block {
+  struct free_block *next;
+} free_block_t;
+
+typedef struct {
+  free_block_t *free_lists[MALLOC_NUM_CLASSES];
+  free_block_t *large_list;
+#if MALLOC_MAX_HARTS > 1
+  char *next;  // heap slice of the hart
+  char *limit;
+#endif
+#if MALLOC_STATS
+  trireme_malloc_stats_t stats;
+#if MALLOC_MAX_HARTS > 1
+  // Frees of blocks allocated by the other harts, by allocating hart
+  unsigned int remote_frees[MALLOC_MAX_HARTS];
+  unsigned int remote_free_bytes[MALLOC_MAX_HARTS];
+#endif
+#endif
+} __attribute__((aligned(MALLOC_CACHE_LINE_BYTES))) arena_t;
+
+static arena_t arenas[MALLOC_MAX_HARTS];
+
+void *_sbrk(int incr);
+
+// Bytes to skip at address so a block starting there has an aligned payload
+static inline size_t block_padding(char *address) {
+  return (MALLOC_ALIGN - HEADER_BYTES - (uintptr_t)address) & (MALLOC_ALIGN - 1);
+}
+
+#if MALLOC_MAX_HARTS > 1
+
+extern char end;       // Set by linker.
+extern char stack_end; // Set by linker.
+extern const int __trireme_num_harts __attribute__((weak));
+
+static size_t num_harts(void) {
+  size_t harts = &__trireme_num_harts ? __trireme_num_harts : 1;
+  return harts < MALLOC_MAX_HARTS ? harts : MALLOC_MAX_HARTS;
+}
+
+static arena_t *current_arena(void) {
+  size_t hart;
+  __asm__ volatile ("mv %0, tp" : "=r"(hart));
+  return hart < num_harts() ? &arenas[hart] : NULL;
+}
+
+static size_t *new_block(arena_t *arena, size_t bytes) {
+  char *block;
+  if(arena->limit == NULL) {
+    size_t slice = ((size_t)(&stack_end - &end) / num_harts()) & ~(MALLOC_ALIGN - 1);
+    arena->next  = &end + (size_t)(arena - arenas)*slice;
+    arena->limit = arena->next + slice;
+    arena->next += block_padding(arena->next);
+  }
+  if(arena->next > arena->limit || (size_t)(arena->limit - arena->next) < bytes) {
+    return NULL;
+  }
+  block = arena->next;
+  arena->next += bytes;
+  return (size_t *)block;
+}
+
+#else
+
+static arena_t *current_arena(void) {
+  return &arenas[0];
+}
+
+static size_t *new_block(arena_t *arena, size_t bytes) {
+  // Something else may have moved the break, align it every time
+  size_t padding = block_padding(_sbrk(0));
+  char *block;
+  (void)arena;
+  if(bytes > INT32_MAX - padding) {
+    return NULL;
+  }
+  block = _sbrk(bytes + padding);
+  if(block == (char *)-1) {
+    return NULL;
+  }
+  return (size_t *)(block + padding);
+}
+
+#endif
+
+static inline size_t block_kind(size_t header) {
+  return header >> HART_BITS;
+}
+
+static inline size_t block_hart(size_t header) {
+  return header & HART_MASK;
+}
+
+static inline size_t block_bytes(size_t header) {
+  size_t kind = block_kind(header);
+  return kind < LARGE_CLASS ? MALLOC_ALIGN << kind : kind;
+}
+
+#if MALLOC_STATS
+// Bytes in use by the blocks hart allocated, also counting remote frees
+static unsigned int arena_bytes_in_use(size_t hart) {
+  unsigned int bytes = arenas[hart].stats.bytes_in_use;
+#if MALLOC_MAX_HARTS > 1
+  for(size_t i=0; i<MALLOC_MAX_HARTS; i++) {
+    bytes -= arenas[i].remote_free_bytes[hart];
+  }
+#endif
+  return bytes;
+}
+#endif
+
+void *malloc(size_t size) {
+  arena_t *arena = current_arena();
+  free_block_t **list;
+  size_t *header;
+  size_t size_class = 0;
+  size_t bytes = MALLOC_ALIGN;
+
+  if(arena == NULL) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  if(size <= LARGEST_BLOCK - HEADER_BYTES) {
+    while(bytes - HEADER_BYTES < size) {
+      bytes <<= 1;
+      size_class++;
+    }
+    list = &arena->free_lists[size_class];
+  }
+  else {
+    // Large block, first fit
+    if(size > (SIZE_MAX >> HART_BITS) - HEADER_BYTES - MALLOC_ALIGN) {
+      goto fail;
+    }
+    bytes = (size + HEADER_BYTES + MALLOC_ALIGN - 1) & ~(MALLOC_ALIGN - 1);
+    size_class = LARGE_CLASS;
+    list = &arena->large_list;
+    while(*list && block_kind(((size_t *)*list)[-1]) < bytes) {
+      list = &(*list)->next;
+    }
+  }
+
+  if(*list) {
+    header = (size_t *)*list - 1;
+    *list = (*list)->next;
+    bytes = block_bytes(*header);
+  }
+  else {
+    header = new_block(arena, bytes);
+    if(header == NULL) {
+      goto fail;
+    }
+#if MALLOC_STATS
+    arena->stats.heap_bytes += bytes;
+#endif
+  }
+  // The block may come from another hart, take it over
+  *header = ((size_class == LARGE_CLASS ? bytes : size_class) << HART_BITS) |
+            (size_t)(arena - arenas);
+
+#if MALLOC_STATS
+  arena->stats.allocations++;
+  arena->stats.class_allocations[size_class]++;
+  arena->stats.bytes_in_use += bytes;
+  {
+    unsigned int in_use = arena_bytes_in_use(arena - arenas);
+    if(in_use > arena->stats.peak_bytes_in_use) {
+      arena->stats.peak_bytes_in_use = in_use;
+    }
+  }
+#endif
+  return header + 1;
+
+fail:
+#if MALLOC_STATS
+  arena->stats.failures++;
+#endif
+  errno = ENOMEM;
+  return NULL;
+}
+
+void free(void *ptr) {
+  arena_t *arena = current_arena();
+  free_block_t *block = ptr;
+  size_t header;
+
+  if(block == NULL || arena == NULL) {
+    return;
+  }
+  header = ((size_t *)block)[-1];
+  if(block_kind(header) < LARGE_CLASS) {
+    block->next = arena->free_lists[block_kind(header)];
+    arena->free_lists[block_kind(header)] = block;
+  }
+  else {
+    block->next = arena->large_list;
+    arena->large_list = block;
+  }
+#if MALLOC_STATS
+#if MALLOC_MAX_HARTS > 1
+  if(&arenas[block_hart(header)] != arena) {
+    arena->remote_frees[block_hart(header)]++;
+    arena->remote_free_bytes[block_hart(header)] += block_bytes(header);
+    return;
+  }
+#endif
+  arena->stats.frees++;
+  arena->stats.bytes_in_use -= block_bytes(header);
+#endif
+}
+
+void *calloc(size_t count, size_t size) {
+  void *ptr;
+  if(size != 0 && count > SIZE_MAX / size) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  ptr = malloc(count * size);
+  if(ptr) {
+    memset(ptr, 0, count * size);
+  }
+  return ptr;
+}
+
+void *realloc(void *ptr, size_t size) {
+  void *new_ptr;
+  size_t capacity;
+
+  if(ptr == NULL) {
+    return malloc(size);
+  }
+  if(size == 0) {
+    free(ptr);
+    return NULL;
+  }
+  capacity = block_bytes(((size_t *)ptr)[-1]) - HEADER_BYTES;
+  if(size <= capacity) {
+    return ptr;
+  }
+  new_ptr = malloc(size);
+  if(new_ptr) {
+    memcpy(new_ptr, ptr, capacity);
+    free(ptr);
+  }
+  return new_ptr;
+}
+
+// newlib calls the reentrant versions internally (stdio buffers, etc.)
+void *_malloc_r(struct _reent *reent, size_t size) {
+  (void)reent;
+  return malloc(size);
+}
+
+void _free_r(struct _reent *reent, void *ptr) {
+  (void)reent;
+  free(ptr);
+}
+
+void *_calloc_r(struct _reent *reent, size_t count, size_t size) {
+  (void)reent;
+  return calloc(count, size);
+}
+
+void *_realloc_r(struct _reent *reent, void *ptr, size_t size) {
+  (void)reent;
+  return realloc(ptr, size);
+}
+
+void trireme_malloc_get_stats(int hart, trireme_malloc_stats_t *stats) {
+  memset(stats, 0, sizeof(*stats));
+#if MALLOC_STATS
+  for(int i=0; i<MALLOC_MAX_HARTS; i++) {
+    const trireme_malloc_stats_t *arena = &arenas[i].stats;
+    if(hart >= 0 && hart != i) {
+      continue;
+    }
+    stats->allocations       += arena->allocations;
+    stats->frees             += arena->frees;
+    stats->failures          += arena->failures;
+    stats->heap_bytes        += arena->heap_bytes;
+    stats->bytes_in_use      += arena_bytes_in_use(i);
+    stats->peak_bytes_in_use += arena->peak_bytes_in_use;
+#if MALLOC_MAX_HARTS > 1
+    for(int j=0; j<MALLOC_MAX_HARTS; j++) {
+      stats->frees += arenas[j].remote_frees[i];
+    }
+#endif
+    for(int j=0; j<=MALLOC_NUM_CLASSES; j++) {
+      stats->class_allocations[j] += arena->class_allocations[j];
+    }
+  }
+#else
+  (void)hart;
+#endif
+}
@@ -0,0 +1,90 @@
+/*=================================================================================
+ # trireme_malloc.h
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: libtrireme_malloc, a small malloc for the tiny RAM targets.
+ *
+ * Requests are rounded up to power of two size classes of
+ * MALLOC_ALIGN << class bytes, one header word included. Every class has a
+ * free list, so malloc and free of a class block are O(1). Freed blocks stay
+ * in their class and are never split or merged. Requests larger than the
+ * largest class take a block sized to fit from a first fit list.
+ *
+ * With MALLOC_MAX_HARTS = 1 the heap grows with _sbrk of libnosys_trireme32.
+ * With MALLOC_MAX_HARTS > 1 every hart (id in tp, see trireme_smp.h) has an
+ * arena with its own free lists and a fixed slice of the heap between end and
+ * stack_end, split over __trireme_num_harts harts. The harts never share
+ * allocator state, so there are no locks. A block freed by another hart than
+ * the one that allocated it goes to the free lists of the freeing hart and is
+ * reused by that hart. The statistics still count the free for the hart that
+ * allocated the block.
+ *
+ * malloc, free, calloc, realloc and their newlib _r versions replace the
+ * newlib ones. Build and install with "./build_bsp --build trireme_malloc"
+ * and link with "trireme_gcc --trireme-malloc", add "-Ilib" to use the
+ * statistics. Programs must be compiled with the same MALLOC_NUM_CLASSES and
+ * MALLOC_MAX_HARTS as the library (Makefile variables NUM_CLASSES and
+ * MAX_HARTS).
+*******************************************************************************/
+
+#ifndef TRIREME_MALLOC_H
+#define TRIREME_MALLOC_H
+
+#include <stddef.h>
+
+#ifndef MALLOC_NUM_CLASSES
+#define MALLOC_NUM_CLASSES 8 // 8 to 1024 byte blocks on RV32
+#endif
+
+#ifndef MALLOC_MAX_HARTS
+#define MALLOC_MAX_HARTS 1
+#endif
+
+#ifndef MALLOC_CACHE_LINE_BYTES
+#define MALLOC_CACHE_LINE_BYTES 16 // 4 words, OFFSET_BITS_L1 = 2
+#endif
+
+#ifndef MALLOC_STATS
+#define MALLOC_STATS 1
+#endif
+
+// Alignment of the returned pointers and size of the smallest block
+#define MALLOC_ALIGN (2*sizeof(size_t))
+
+typedef struct {
+  unsigned int allocations;
+  unsigned int frees;
+  unsigned int failures;          // requests that returned NULL
+  unsigned int heap_bytes;        // taken from _sbrk or the heap slice
+  unsigned int bytes_in_use;      // allocated blocks, headers included
+  unsigned int peak_bytes_in_use;
+  unsigned int class_allocations[MALLOC_NUM_CLASSES + 1]; // last: large
+} trireme_malloc_stats_t;
+
+/* Copies the statistics of the arena of hart, or the sum over all arenas when
+ * hart is negative (peak_bytes_in_use is then the sum of the peaks). All zero
+ * when the library is built with MALLOC_STATS = 0.
+ */
+void trireme_malloc_get_stats(int hart, trireme_malloc_stats_t *stats);
+
+#endif
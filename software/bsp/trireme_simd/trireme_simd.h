@@ -0,0 +1,262 @@
+/*=================================================================================
+ # trireme_simd.h
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Intrinsics for the packed SIMD subset of the P extension in
+ * packed_simd_unit (seven stage cores built with P_EXTENSION = 1).
+ *
+ * The names follow the __rv_* intrinsics of the P extension draft. The
+ * upstream RISC-V GCC does not know the P instructions, so every intrinsic is
+ * a ".insn" directive with the OP-P opcode and the draft funct3/funct7
+ * encoding. Any binutils with .insn support assembles them, no -march change
+ * is needed.
+ *
+ * Values are uintxlen_t, a register with XLEN/16 halfword lanes (or XLEN/8
+ * byte lanes). The 32 bit lane operations (kmda, smds, pk*16, ...) work on the
+ * two halfwords of every 32 bit lane.
+ *
+ * Off target, or with TRIREME_SIMD_PORTABLE defined, the intrinsics are plain
+ * C with the semantics of packed_simd_unit and trireme_iss. This runs the same
+ * program on a desktop (TRIREME_SIMD_XLEN sets the lane count, default 32) or
+ * on a core without the P extension.
+ *
+ * Header only. "./build_bsp --build trireme_simd" copies it to the install
+ * directory, then compile with "-Ilib".
+*******************************************************************************/
+
+#ifndef TRIREME_SIMD_H
+#define TRIREME_SIMD_H
+
+#include <stdint.h>
+
+#ifndef TRIREME_SIMD_XLEN
+#ifdef __riscv_xlen
+#define TRIREME_SIMD_XLEN __riscv_xlen
+#else
+#define TRIREME_SIMD_XLEN 32
+#endif
+#endif
+
+#if TRIREME_SIMD_XLEN == 64
+typedef uint64_t uintxlen_t;
+#else
+typedef uint32_t uintxlen_t;
+#endif
+
+#if !defined(__riscv) && !defined(TRIREME_SIMD_PORTABLE)
+#define TRIREME_SIMD_PORTABLE 1
+#endif
+
+// funct3 and funct7 of the OP-P (0x77) encodings
+#define TRIREME_SIMD_LANE16 0
+#define TRIREME_SIMD_LANE32 1
+
+#ifdef TRIREME_SIMD_PORTABLE
+
+static inline int64_t trireme_simd_saturate(int64_t value, unsigned bits) {
+  const int64_t high = (1ll << (bits - 1)) - 1;
+  const int64_t low  = -high - 1;
+  return value > high ? high : value < low ? low : value;
+}
+
+static inline int64_t trireme_simd_signed(uint64_t value, unsigned bits) {
+  return (int64_t)(value << (64 - bits)) >> (64 - bits);
+}
+
+// C model of packed_simd_unit, constant folded for every intrinsic.
+static inline uintxlen_t trireme_simd_emulate(unsigned funct3, unsigned funct7,
+                                              unsigned rs2, uintxlen_t a,
+                                              uintxlen_t b) {
+  uint64_t value = 0;
+  unsigned lane;
+
+  if(funct3 == TRIREME_SIMD_LANE32) {
+    for(lane = 0; lane < TRIREME_SIMD_XLEN; lane += 32) {
+      const uint64_t wa = ((uint64_t)a >> lane) & 0xFFFFFFFF;
+      const uint64_t wb = ((uint64_t)b >> lane) & 0xFFFFFFFF;
+      const int64_t  al = trireme_simd_signed(wa, 16);
+      const int64_t  ah = trireme_simd_signed(wa >> 16, 16);
+      const int64_t  bl = trireme_simd_signed(wb, 16);
+      const int64_t  bh = trireme_simd_signed(wb >> 16, 16);
+      int64_t result;
+      switch(funct7) {
+        case 0x1C: result = trireme_simd_saturate(ah*bh + al*bl, 32); break;
+        case 0x1D: result = trireme_simd_saturate(ah*bl + al*bh, 32); break;
+        case 0x2C: result = ah*bh - al*bl; break;
+        case 0x34: result = al*bl - ah*bh; break;
+        case 0x3C: result = ah*bl - al*bh; break;
+        case 0x07: result = ((wa & 0xFFFF) << 16) | (wb & 0xFFFF); break;
+        case 0x0F: result = ((wa & 0xFFFF) << 16) | (wb >> 16); break;
+        case 0x17: result = (wa & 0xFFFF0000) | (wb >> 16); break;
+        case 0x1F: result = (wa & 0xFFFF0000) | (wb & 0xFFFF); break;
+        default:   result = 0; break;
+      }
+      value |= ((uint64_t)result & 0xFFFFFFFF) << lane;
+    }
+    return (uintxlen_t)value;
+  }
+
+  if(funct7 == 0x24 || funct7 == 0x25 || funct7 == 0x0C || funct7 == 0x0D ||
+     funct7 == 0x1C || funct7 == 0x1D) {
+    for(lane = 0; lane < TRIREME_SIMD_XLEN; lane += 8) {
+      const uint64_t ua = ((uint64_t)a >> lane) & 0xFF;
+      const uint64_t ub = ((uint64_t)b >> lane) & 0xFF;
+      const int64_t  sa = trireme_simd_signed(ua, 8);
+      const int64_t  sb = trireme_simd_signed(ub, 8);
+      int64_t result;
+      switch(funct7) {
+        case 0x24: result = sa + sb; break;
+        case 0x25: result = sa - sb; break;
+        case 0x0C: result = trireme_simd_saturate(sa + sb, 8); break;
+        case 0x0D: result = trireme_simd_saturate(sa - sb, 8); break;
+        case 0x1C: result = ua + ub > 0xFF ? 0xFF : (int64_t)(ua + ub); break;
+        default:   result = ua < ub ? 0 : (int64_t)(ua - ub); break;
+      }
+      value |= ((uint64_t)result & 0xFF) << lane;
+    }
+    return (uintxlen_t)value;
+  }
+
+  for(lane = 0; lane < TRIREME_SIMD_XLEN; lane += 16) {
+    const uint64_t ua = ((uint64_t)a >> lane) & 0xFFFF;
+    const uint64_t ub = ((uint64_t)b >> lane) & 0xFFFF;
+    const int64_t  sa = trireme_simd_signed(ua, 16);
+    const int64_t  sb = trireme_simd_signed(ub, 16);
+    const int      immediate = funct7 == 0x38 || funct7 == 0x39 || funct7 == 0x3A;
+    const unsigned shamt = immediate ? rs2 & 0xF : (unsigned)(ub & 0xF);
+    int64_t result;
+    switch(funct7) {
+      case 0x20: result = sa + sb; break;
+      case 0x21: result = sa - sb; break;
+      case 0x00: result = (sa + sb) >> 1; break;
+      case 0x01: result = (sa - sb) >> 1; break;
+      case 0x08: result = trireme_simd_saturate(sa + sb, 16); break;
+      case 0x09: result = trireme_simd_saturate(sa - sb, 16); break;
+      case 0x18: result = ua + ub > 0xFFFF ? 0xFFFF : (int64_t)(ua + ub); break;
+      case 0x19: result = ua < ub ? 0 : (int64_t)(ua - ub); break;
+      case 0x28: case 0x38: result = sa >> shamt; break;
+      case 0x29: case 0x39: result = (int64_t)(ua >> shamt); break;
+      case 0x2A: result = (int64_t)(ua << shamt); break;
+      case 0x32: result = trireme_simd_saturate(sa*(1 << shamt), 16); break;
+      case 0x3A: result = (rs2 & 0x10) ? trireme_simd_saturate(sa*(1 << shamt), 16)
+                                       : (int64_t)(ua << shamt);
+                 break;
+      case 0x26: result = ua == ub ? 0xFFFF : 0; break;
+      case 0x06: result = sa <  sb ? 0xFFFF : 0; break;
+      case 0x0E: result = sa <= sb ? 0xFFFF : 0; break;
+      case 0x16: result = ua <  ub ? 0xFFFF : 0; break;
+      case 0x1E: result = ua <= ub ? 0xFFFF : 0; break;
+      case 0x40: result = sa < sb ? sa : sb; break;
+      case 0x41: result = sa < sb ? sb : sa; break;
+      case 0x48: result = (int64_t)(ua < ub ? ua : ub); break;
+      case 0x49: result = (int64_t)(ua < ub ? ub : ua); break;
+      case 0x43: result = (ua == 0x8000 && ub == 0x8000) ? 0x7FFF : (sa*sb) >> 15; break;
+      default:   result = 0; break;
+    }
+    value |= ((uint64_t)result & 0xFFFF) << lane;
+  }
+  return (uintxlen_t)value;
+}
+
+#define TRIREME_SIMD_R(name, funct3, funct7)                                  \
+  static inline uintxlen_t __rv_##name(uintxlen_t a, uintxlen_t b) {          \
+    return trireme_simd_emulate(funct3, funct7, 0, a, b);                     \
+  }
+
+// Immediate shifts, imm is 0 to 15
+#define TRIREME_SIMD_I(funct7, a, imm) \
+  trireme_simd_emulate(TRIREME_SIMD_LANE16, funct7, (imm), (a), 0)
+
+#else
+
+#define TRIREME_SIMD_STRING(x) #x
+#define TRIREME_SIMD_R(name, funct3, funct7)                                  \
+  static inline uintxlen_t __rv_##name(uintxlen_t a, uintxlen_t b) {          \
+    uintxlen_t result;                                                        \
+    __asm__ (".insn r 0x77, " TRIREME_SIMD_STRING(funct3) ", "                \
+             TRIREME_SIMD_STRING(funct7) ", %0, %1, %2"                       \
+             : "=r"(result) : "r"(a), "r"(b));                                \
+    return result;                                                            \
+  }
+
+// Immediate shifts, imm is 0 to 15. The rs2 field holds the immediate, so the
+// I-type .insn form with funct7 in the top bits of the immediate is used.
+#define TRIREME_SIMD_I(funct7, a, imm) __extension__ ({                       \
+    uintxlen_t trireme_simd_result;                                           \
+    __asm__ (".insn i 0x77, 0, %0, %1, %2"                                    \
+             : "=r"(trireme_simd_result)                                      \
+             : "r"((uintxlen_t)(a)), "i"(((funct7) << 5) | (imm)));           \
+    trireme_simd_result;                                                      \
+  })
+
+#endif /* TRIREME_SIMD_PORTABLE */
+
+// 16 bit lanes
+TRIREME_SIMD_R(add16,    0, 0x20)
+TRIREME_SIMD_R(sub16,    0, 0x21)
+TRIREME_SIMD_R(radd16,   0, 0x00)
+TRIREME_SIMD_R(rsub16,   0, 0x01)
+TRIREME_SIMD_R(kadd16,   0, 0x08)
+TRIREME_SIMD_R(ksub16,   0, 0x09)
+TRIREME_SIMD_R(ukadd16,  0, 0x18)
+TRIREME_SIMD_R(uksub16,  0, 0x19)
+TRIREME_SIMD_R(sra16,    0, 0x28)
+TRIREME_SIMD_R(srl16,    0, 0x29)
+TRIREME_SIMD_R(sll16,    0, 0x2A)
+TRIREME_SIMD_R(ksll16,   0, 0x32)
+TRIREME_SIMD_R(cmpeq16,  0, 0x26)
+TRIREME_SIMD_R(scmplt16, 0, 0x06)
+TRIREME_SIMD_R(scmple16, 0, 0x0E)
+TRIREME_SIMD_R(ucmplt16, 0, 0x16)
+TRIREME_SIMD_R(ucmple16, 0, 0x1E)
+TRIREME_SIMD_R(smin16,   0, 0x40)
+TRIREME_SIMD_R(smax16,   0, 0x41)
+TRIREME_SIMD_R(umin16,   0, 0x48)
+TRIREME_SIMD_R(umax16,   0, 0x49)
+TRIREME_SIMD_R(khm16,    0, 0x43)
+
+#define __rv_srai16(a, imm)  TRIREME_SIMD_I(0x38, a, imm)
+#define __rv_srli16(a, imm)  TRIREME_SIMD_I(0x39, a, imm)
+#define __rv_slli16(a, imm)  TRIREME_SIMD_I(0x3A, a, imm)
+#define __rv_kslli16(a, imm) TRIREME_SIMD_I(0x3A, a, 0x10 | (imm))
+
+// 8 bit lanes
+TRIREME_SIMD_R(add8,     0, 0x24)
+TRIREME_SIMD_R(sub8,     0, 0x25)
+TRIREME_SIMD_R(kadd8,    0, 0x0C)
+TRIREME_SIMD_R(ksub8,    0, 0x0D)
+TRIREME_SIMD_R(ukadd8,   0, 0x1C)
+TRIREME_SIMD_R(uksub8,   0, 0x1D)
+
+// 32 bit lanes from two halfwords, bottom (b) is bits 15:0, top (t) 31:16
+TRIREME_SIMD_R(kmda,     1, 0x1C) // saturate(a.t*b.t + a.b*b.b)
+TRIREME_SIMD_R(kmxda,    1, 0x1D) // saturate(a.t*b.b + a.b*b.t)
+TRIREME_SIMD_R(smds,     1, 0x2C) // a.t*b.t - a.b*b.b
+TRIREME_SIMD_R(smdrs,    1, 0x34) // a.b*b.b - a.t*b.t
+TRIREME_SIMD_R(smxds,    1, 0x3C) // a.t*b.b - a.b*b.t
+TRIREME_SIMD_R(pkbb16,   1, 0x07) // {a.b, b.b}
+TRIREME_SIMD_R(pkbt16,   1, 0x0F) // {a.b, b.t}
+TRIREME_SIMD_R(pktt16,   1, 0x17) // {a.t, b.t}
+TRIREME_SIMD_R(pktb16,   1, 0x1F) // {a.t, b.b}
+
+#endif /* TRIREME_SIMD_H */
@@ -0,0 +1,52 @@
+/*=================================================================================
+ # smp_barrier.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Sense-reversing barriers of libtrireme_smp.
+*******************************************************************************/
+
+#include "trireme_smp.h"
+
+static smp_barrier_t smp_global_barrier = SMP_BARRIER_INITIALIZER;
+
+/* The last hart to arrive resets the count and flips the shared sense. The
+ * others spin on their cached copy of the sense, so waiting harts cause no bus
+ * traffic until the barrier opens.
+ */
+void smp_barrier_wait(smp_barrier_t *barrier) {
+  int me    = smp_hart_id();
+  int sense = !barrier->local_sense[me].value;
+
+  barrier->local_sense[me].value = sense;
+  if(smp_fetch_add(&barrier->lock, &barrier->count, 1) == smp_num_harts() - 1) {
+    barrier->count.value = 0;
+    barrier->sense.value = sense;
+  }
+  else {
+    while(barrier->sense.value != sense);
+  }
+}
+
+void smp_barrier(void) {
+  smp_barrier_wait(&smp_global_barrier);
+}
@@ -0,0 +1,93 @@
+/*=================================================================================
+ # smp_lock.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Spinlocks and atomic counters of libtrireme_smp.
+*******************************************************************************/
+
+#include "trireme_smp.h"
+
+#ifdef __riscv_atomic
+
+void smp_lock_acquire(smp_lock_t *lock) {
+  while(__atomic_exchange_n(&lock->locked.value, 1, __ATOMIC_ACQUIRE)) {
+    // spin on the cached copy until the owner releases the lock
+    while(lock->locked.value);
+  }
+}
+
+void smp_lock_release(smp_lock_t *lock) {
+  __atomic_store_n(&lock->locked.value, 0, __ATOMIC_RELEASE);
+}
+
+int smp_fetch_add(smp_lock_t *lock, smp_padded_int_t *counter, int value) {
+  (void)lock;
+  return __atomic_fetch_add(&counter->value, value, __ATOMIC_ACQ_REL);
+}
+
+#else
+
+// Lamport's bakery algorithm. Every hart only writes its own choosing and
+// number entries, so plain loads and stores are enough.
+void smp_lock_acquire(smp_lock_t *lock) {
+  int me    = smp_hart_id();
+  int harts = smp_num_harts();
+  int max   = 0;
+  int ticket;
+
+  lock->choosing[me].value = 1;
+  for(int j=0; j<harts; j++) {
+    int number = lock->number[j].value;
+    if(number > max)
+      max = number;
+  }
+  ticket = max + 1;
+  lock->number[me].value   = ticket;
+  lock->choosing[me].value = 0;
+
+  for(int j=0; j<harts; j++) {
+    if(j == me)
+      continue;
+    while(lock->choosing[j].value);
+    while(1) {
+      int number = lock->number[j].value;
+      if(number == 0 || number > ticket || (number == ticket && j > me))
+        break;
+    }
+  }
+}
+
+void smp_lock_release(smp_lock_t *lock) {
+  lock->number[smp_hart_id()].value = 0;
+}
+
+int smp_fetch_add(smp_lock_t *lock, smp_padded_int_t *counter, int value) {
+  int old;
+  smp_lock_acquire(lock);
+  old = counter->value;
+  counter->value = old + value;
+  smp_lock_release(lock);
+  return old;
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*=================================================================================
+ # smp_parallel_for.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Parallel loops of libtrireme_smp.
+*******************************************************************************/
+
+#include "trireme_smp.h"
+
+static void smp_static_for(int begin, int end, smp_loop_body_t body, void *arg) {
+  int me    = smp_hart_id();
+  int harts = smp_num_harts();
+  int total = end - begin;
+  int size  = total / harts;
+  int extra = total % harts;
+  // The first "extra" harts run one more iteration.
+  int start = begin + me*size + (me < extra ? me : extra);
+  int stop  = start + size + (me < extra ? 1 : 0);
+
+  for(int i=start; i<stop; i++)
+    body(i, arg);
+}
+
+static void smp_dynamic_for(smp_loop_t *loop, int begin, int end, int chunk,
+                            smp_loop_body_t body, void *arg) {
+  if(chunk < 1)
+    chunk = 1;
+  while(1) {
+    int start = begin + smp_fetch_add(&loop->lock, &loop->next, chunk);
+    int stop  = start + chunk;
+    if(start >= end)
+      break;
+    if(stop > end)
+      stop = end;
+    for(int i=start; i<stop; i++)
+      body(i, arg);
+  }
+  // Harts that get here take no more chunks, so the last one can reset the
+  // loop for the next use before the barrier releases the others.
+  if(smp_fetch_add(&loop->lock, &loop->done, 1) == smp_num_harts() - 1) {
+    loop->next.value = 0;
+    loop->done.value = 0;
+  }
+}
+
+void smp_parallel_for(smp_loop_t *loop, int begin, int end,
+                      smp_schedule_t schedule, int chunk,
+                      smp_loop_body_t body, void *arg) {
+  if(end > begin) {
+    if(schedule == SMP_SCHEDULE_DYNAMIC)
+      smp_dynamic_for(loop, begin, end, chunk, body, arg);
+    else
+      smp_static_for(begin, end, body, arg);
+  }
+  smp_barrier();
+}
@@ -0,0 +1,51 @@
+/*=================================================================================
+ # smp_start.c
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: Hart entry points for programs that define smp_main().
+*******************************************************************************/
+
+#include "trireme_smp.h"
+
+// trireme_gcc starts hart 0 in main() and hart N in hartN_main().
+int main(void) {
+  return smp_main();
+}
+
+#define SMP_HART_ENTRY(n) int hart##n##_main(void) { return smp_main(); }
+
+SMP_HART_ENTRY(1)
+SMP_HART_ENTRY(2)
+SMP_HART_ENTRY(3)
+SMP_HART_ENTRY(4)
+SMP_HART_ENTRY(5)
+SMP_HART_ENTRY(6)
+SMP_HART_ENTRY(7)
+SMP_HART_ENTRY(8)
+SMP_HART_ENTRY(9)
+SMP_HART_ENTRY(10)
+SMP_HART_ENTRY(11)
+SMP_HART_ENTRY(12)
+SMP_HART_ENTRY(13)
+SMP_HART_ENTRY(14)
+SMP_HART_ENTRY(15)
@@ -0,0 +1,193 @@
+/*=================================================================================
+ # trireme_smp.h
+ # Author: Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ #  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #  The above copyright notice and this permission notice shall be included in
+ #  all copies or substantial portions of the Software.
+
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ #  THE SOFTWARE.
+ ==================================================================================*/
+
+/*******************************************************************************
+ * Description: SMP runtime for programs built with trireme_gcc --num-cores N.
+ *
+ * Every hart runs smp_main(). Programs that define smp_main() instead of
+ * main() and hart<N>_main() get the entry points from this library. The hart
+ * entry code of trireme_gcc stores the hart id in tp and the hart count in
+ * __trireme_num_harts.
+ *
+ * Shared objects are padded to SMP_CACHE_LINE_BYTES so harts spinning on or
+ * updating different objects do not share a cache line. Locks and barriers use
+ * AMOs when the program is built for an ISA with the A extension and Lamport's
+ * bakery algorithm with plain loads and stores otherwise. The bakery fallback
+ * relies on the in-order cores and coherent caches of the Trireme multicore
+ * tops and has no fence instructions.
+ *
+ * Build and install with "./build_bsp --build trireme_smp", then link with
+ * "-Ilib -Wl,-ltrireme_smp". Programs must be compiled with the same
+ * SMP_CACHE_LINE_BYTES and SMP_MAX_HARTS as the library (Makefile variables
+ * CACHE_LINE_BYTES and MAX_HARTS).
+ *
+ * Objects are initialized statically (see the *_INITIALIZER macros). The
+ * memory image holds .data and .bss, so no start up code runs before the harts
+ * enter smp_main().
+*******************************************************************************/
+
+#ifndef TRIREME_SMP_H
+#define TRIREME_SMP_H
+
+#include <stdint.h>
+
+#ifndef SMP_CACHE_LINE_BYTES
+#define SMP_CACHE_LINE_BYTES 16 // 4 words, OFFSET_BITS_L1 = 2
+#endif
+
+#ifndef SMP_MAX_HARTS
+#define SMP_MAX_HARTS 16
+#endif
+
+#define SMP_ALIGNED __attribute__((aligned(SMP_CACHE_LINE_BYTES)))
+
+// One int on its own cache line.
+typedef struct {
+  volatile int value;
+} SMP_ALIGNED smp_padded_int_t;
+
+typedef struct {
+#ifdef __riscv_atomic
+  smp_padded_int_t locked;
+#else
+  smp_padded_int_t choosing[SMP_MAX_HARTS];
+  smp_padded_int_t number[SMP_MAX_HARTS];
+#endif
+} smp_lock_t;
+
+#define SMP_LOCK_INITIALIZER {}
+
+typedef struct {
+  smp_lock_t       lock;
+  smp_padded_int_t count;
+  smp_padded_int_t sense;
+  smp_padded_int_t local_sense[SMP_MAX_HARTS];
+} smp_barrier_t;
+
+#define SMP_BARRIER_INITIALIZER {}
+
+typedef enum {
+  SMP_SCHEDULE_STATIC,  // one contiguous block of iterations per hart
+  SMP_SCHEDULE_DYNAMIC  // harts take chunks from a shared counter
+} smp_schedule_t;
+
+// State of a dynamically scheduled loop. It can be reused by later loops.
+typedef struct {
+  smp_lock_t       lock;
+  smp_padded_int_t next;
+  smp_padded_int_t done;
+} smp_loop_t;
+
+#define SMP_LOOP_INITIALIZER {}
+
+// Per hart partial results, one cache line per hart.
+typedef struct {
+  smp_padded_int_t slot[SMP_MAX_HARTS];
+} smp_reduction_t;
+
+#define SMP_REDUCTION_INITIALIZER {}
+
+typedef void (*smp_loop_body_t)(int index, void *arg);
+
+extern const int __trireme_num_harts;
+
+static inline int smp_hart_id(void) {
+  int id;
+  __asm__ volatile ("mv %0, tp" : "=r"(id));
+  return id;
+}
+
+static inline int smp_num_harts(void) {
+  return __trireme_num_harts;
+}
+
+// Entry point of every hart. Defined by the program.
+int smp_main(void);
+
+void smp_lock_acquire(smp_lock_t *lock);
+void smp_lock_release(smp_lock_t *lock);
+
+// Atomically adds value to *counter and returns the previous value.
+int smp_fetch_add(smp_lock_t *lock, smp_padded_int_t *counter, int value);
+
+// Waits until all smp_num_harts() harts reached the barrier.
+void smp_barrier_wait(smp_barrier_t *barrier);
+// Waits on the barrier shared by smp_parallel_for and smp_reduce_add.
+void smp_barrier(void);
+
+/* Runs body(i, arg) for begin <= i < end, split over all harts. Every hart
+ * must call it with the same loop, range, schedule and chunk. arg may differ,
+ * for example to point to a partial result of the hart. chunk is the number
+ * of iterations a hart takes at a time with SMP_SCHEDULE_DYNAMIC (at least 1)
+ * and is ignored by SMP_SCHEDULE_STATIC. loop is only used by
+ * SMP_SCHEDULE_DYNAMIC and may be NULL otherwise. Returns after all harts
+ * finished the loop.
+ */
+void smp_parallel_for(smp_loop_t *loop, int begin, int end,
+                      smp_schedule_t schedule, int chunk,
+                      smp_loop_body_t body, void *arg);
+
+/* Adds the value of every hart and returns the sum on all harts. Every hart
+ * must call it.
+ */
+int smp_reduce_add(smp_reduction_t *reduction, int value);
+
+/* Sync unit of seven_stage_multicore_top (rtl/io/sync), present with
+ * SYNC_UNIT = 1. SMP_SYNC_BASE must match SYNC_BASE of the top. The hardware
+ * barriers include all harts unless their mask is changed. smp_send_ipi and
+ * smp_wfi need the privileged cores (PRIV_CORES = 1).
+ */
+#ifndef SMP_SYNC_BASE
+#define SMP_SYNC_BASE 0x000F0000
+#endif
+
+#define SMP_SYNC_MSIP(hart)         (SMP_SYNC_BASE + 4*(hart))
+#define SMP_SYNC_BARRIER_MASK(b)    (SMP_SYNC_BASE + 0x100 + 16*(b))
+#define SMP_SYNC_BARRIER_ARRIVE(b)  (SMP_SYNC_BASE + 0x104 + 16*(b))
+#define SMP_SYNC_BARRIER_WAIT(b)    (SMP_SYNC_BASE + 0x108 + 16*(b))
+
+#define SMP_SYNC_REG(address) (*(volatile int *)(uintptr_t)(address))
+
+// Sets the software interrupt of a hart.
+static inline void smp_send_ipi(int hart) {
+  SMP_SYNC_REG(SMP_SYNC_MSIP(hart)) = 1;
+}
+
+// Clears the software interrupt of the calling hart.
+static inline void smp_clear_ipi(void) {
+  SMP_SYNC_REG(SMP_SYNC_MSIP(smp_hart_id())) = 0;
+}
+
+// Waits on hardware barrier b. The hart is stalled until all harts arrived.
+static inline void smp_hw_barrier_wait(int b) {
+  int sense = SMP_SYNC_REG(SMP_SYNC_BARRIER_ARRIVE(b));
+  SMP_SYNC_REG(SMP_SYNC_BARRIER_ARRIVE(b)) = !sense;
+  (void)SMP_SYNC_REG(SMP_SYNC_BARRIER_WAIT(b));
+}
+
+// Stops fetching until an interrupt enabled in mie is pending.
+static inline void smp_wfi(void) {
+  __asm__ volatile ("wfi" ::: "memory");
+}
+
+#endif
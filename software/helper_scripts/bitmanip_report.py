@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+
+#==========================================================================
+#   @module : bitmanip_report.py
+#   @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+#
+#   Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+#   Permission is hereby granted, free of charge, to any person obtaining a copy
+#   of this software and associated documentation files (the "Software"), to deal
+#   in the Software without restriction, including without limitation the rights
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#   copies of the Software, and to permit persons to whom the Software is
+#   furnished to do so, subject to the following conditions:
+#   The above copyright notice and this permission notice shall be included in
+#   all copies or substantial portions of the Software.
+
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#   THE SOFTWARE.
+#==========================================================================
+
+# This script builds every single core program in applications/src twice, once
+# for the base ISA and once with "trireme_gcc --bitmanip" (Zba and Zbb), runs
+# both on trireme_iss and prints the dynamic instruction count of each build.
+# It uses the compile_sim arguments. Extra arguments are passed to both builds,
+# for example --compressed or -O2.
+#
+# Example, from the software directory (trireme_iss must be built first):
+# python3 helper_scripts/bitmanip_report.py
+# python3 helper_scripts/bitmanip_report.py -O2
+
+
+import glob
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+SOFTWARE_DIRECTORY = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TRIREME_GCC = os.path.join(SOFTWARE_DIRECTORY, 'trireme_gcc')
+TRIREME_ISS = os.path.join(SOFTWARE_DIRECTORY, 'iss', 'trireme_iss')
+APPLICATIONS = os.path.join(SOFTWARE_DIRECTORY, 'applications', 'src')
+
+# Same memory layout as compile_sim
+COMPILE_SIM_ARGS = ['--ram-size', '2048', '--link-libgloss', 'nosys_trireme32',
+                    '--stack-addr', '2048', '--stack-size', '512', '--start-addr', '0',
+                    '--heap-size', '512']
+
+INSTRUCTION_COUNT = re.compile(r'hart 0: halted at PC \S+ after (\d+) instructions')
+
+
+def build(source, output_directory, extra_args):
+    name = os.path.splitext(os.path.basename(source))[0]
+    output = os.path.join(output_directory, name)
+    command = [sys.executable, TRIREME_GCC, '-o', output, '--vmh', output + '.vmh', source] + \
+        COMPILE_SIM_ARGS + extra_args
+    result = subprocess.run(command, cwd=SOFTWARE_DIRECTORY, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        print(result.stdout)
+        return None
+    return output + '.vmh'
+
+
+def count_instructions(vmh):
+    result = subprocess.run([TRIREME_ISS, vmh], stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True)
+    match = INSTRUCTION_COUNT.search(result.stdout)
+    return int(match.group(1)) if match else None
+
+
+def main():
+    if not os.path.exists(TRIREME_ISS):
+        sys.exit(f'{TRIREME_ISS} not found, run make in software/iss first')
+    extra_args = sys.argv[1:]
+    # The smp_ programs need --num-cores and the packed_ programs a core with
+    # the P extension, they are left out
+    sources = sorted(source for source in glob.glob(os.path.join(APPLICATIONS, '*.c'))
+                     if not os.path.basename(source).startswith(('smp_', 'packed_')))
+
+    print(f'{"program":<24}{"base":>12}{"zba/zbb":>12}{"reduction":>12}')
+    total_base = 0
+    total_bitmanip = 0
+    with tempfile.TemporaryDirectory() as base_directory, \
+         tempfile.TemporaryDirectory() as bitmanip_directory:
+        for source in sources:
+            name = os.path.splitext(os.path.basename(source))[0]
+            base_vmh = build(source, base_directory, extra_args)
+            bitmanip_vmh = build(source, bitmanip_directory, extra_args + ['--bitmanip'])
+            base = count_instructions(base_vmh) if base_vmh else None
+            bitmanip = count_instructions(bitmanip_vmh) if bitmanip_vmh else None
+            if base is None or bitmanip is None:
+                print(f'{name:<24}{"failed":>12}')
+                continue
+            total_base += base
+            total_bitmanip += bitmanip
+            print(f'{name:<24}{base:>12}{bitmanip:>12}{100.0*(base - bitmanip)/base:>11.1f}%')
+
+    if total_base:
+        print(f'{"total":<24}{total_base:>12}{total_bitmanip:>12}'
+              f'{100.0*(total_base - total_bitmanip)/total_base:>11.1f}%')
+
+
+if __name__ == '__main__':
+    main()
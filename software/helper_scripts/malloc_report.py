@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+
+#==========================================================================
+#   @module : malloc_report.py
+#   @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+#
+#   Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+#   Permission is hereby granted, free of charge, to any person obtaining a copy
+#   of this software and associated documentation files (the "Software"), to deal
+#   in the Software without restriction, including without limitation the rights
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#   copies of the Software, and to permit persons to whom the Software is
+#   furnished to do so, subject to the following conditions:
+#   The above copyright notice and this permission notice shall be included in
+#   all copies or substantial portions of the Software.
+
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#   THE SOFTWARE.
+#==========================================================================
+
+# This script compares libtrireme_malloc (bsp/trireme_malloc) with the newlib
+# malloc. It builds applications/src/malloc_bench.c with and without
+# "trireme_gcc --trireme-malloc", runs both on trireme_iss and prints the .text
+# size of each program and the cycles per malloc/free pair. A build with
+# ROUNDS=0 of each is subtracted, so the loop setup and the rest of the
+# program do not count. The newlib malloc extends the heap in 4 KiB steps and
+# fails with the 512 byte heap of compile_sim, so the programs are linked for
+# a 64 KiB RAM. Extra arguments are passed to every build, for example -O2.
+#
+# Example, from the software directory (trireme_iss must be built and the
+# trireme32 and trireme_malloc BSPs installed first):
+# python3 helper_scripts/malloc_report.py
+# python3 helper_scripts/malloc_report.py -O2
+
+
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+SOFTWARE_DIRECTORY = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TRIREME_GCC = os.path.join(SOFTWARE_DIRECTORY, 'trireme_gcc')
+TRIREME_ISS = os.path.join(SOFTWARE_DIRECTORY, 'iss', 'trireme_iss')
+BENCHMARK = os.path.join(SOFTWARE_DIRECTORY, 'applications', 'src', 'malloc_bench.c')
+
+ROUNDS = 32
+NUM_OBJECTS = 8  # malloc_bench.c
+ALLOCATIONS = ROUNDS * NUM_OBJECTS // 2
+
+BUILD_ARGS = ['--ram-size', '65536', '--link-libgloss', 'nosys_trireme32',
+              '--stack-addr', '65536', '--stack-size', '1024', '--start-addr', '0',
+              '--heap-size', '16384']
+
+CYCLE_COUNT = re.compile(r'hart 0: halted at PC \S+ after \d+ instructions, (\d+) cycles')
+
+SHF_EXECINSTR = 0x4
+
+
+def build(output, extra_args):
+    command = [sys.executable, TRIREME_GCC, '-o', output, '--vmh', output + '.vmh', BENCHMARK] + \
+        BUILD_ARGS + extra_args
+    result = subprocess.run(command, cwd=SOFTWARE_DIRECTORY, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0 or not os.path.exists(output + '.vmh'):
+        print(result.stdout)
+        return None
+    return output
+
+
+def text_bytes(elf):
+    """Sum of the sizes of the executable sections of an ELF file."""
+    with open(elf, 'rb') as f:
+        data = f.read()
+    is_64 = data[4] == 2
+    if is_64:
+        section_offset, = struct.unpack_from('<Q', data, 0x28)
+        entry_size, count = struct.unpack_from('<HH', data, 0x3a)
+    else:
+        section_offset, = struct.unpack_from('<I', data, 0x20)
+        entry_size, count = struct.unpack_from('<HH', data, 0x2e)
+    total = 0
+    for i in range(count):
+        entry = section_offset + i*entry_size
+        if is_64:
+            flags, = struct.unpack_from('<Q', data, entry + 0x08)
+            size, = struct.unpack_from('<Q', data, entry + 0x20)
+        else:
+            flags, = struct.unpack_from('<I', data, entry + 0x08)
+            size, = struct.unpack_from('<I', data, entry + 0x14)
+        if flags & SHF_EXECINSTR:
+            total += size
+    return total
+
+
+def count_cycles(vmh):
+    result = subprocess.run([TRIREME_ISS, vmh], stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True)
+    match = CYCLE_COUNT.search(result.stdout)
+    return int(match.group(1)) if match else None
+
+
+def main():
+    if not os.path.exists(TRIREME_ISS):
+        sys.exit(f'{TRIREME_ISS} not found, run make in software/iss first')
+    extra_args = sys.argv[1:]
+
+    print(f'{"allocator":<16}{"text bytes":>12}{"cycles/alloc":>14}')
+    with tempfile.TemporaryDirectory() as directory:
+        for name, allocator_args in [('newlib', []), ('trireme_malloc', ['--trireme-malloc'])]:
+            program = build(os.path.join(directory, name),
+                            extra_args + allocator_args + [f'-DROUNDS={ROUNDS}'])
+            baseline = build(os.path.join(directory, name + '_baseline'),
+                             extra_args + allocator_args + ['-DROUNDS=0'])
+            cycles = count_cycles(program + '.vmh') if program else None
+            baseline_cycles = count_cycles(baseline + '.vmh') if baseline else None
+            if cycles is None or baseline_cycles is None:
+                print(f'{name:<16}{"failed":>12}')
+                continue
+            print(f'{name:<16}{text_bytes(program):>12}'
+                  f'{(cycles - baseline_cycles)/ALLOCATIONS:>14.1f}')
+
+
+if __name__ == '__main__':
+    main()
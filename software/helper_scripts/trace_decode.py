@@ -0,0 +1,317 @@
+#!/usr/bin/env python3
+
+#==========================================================================
+#   @module : trace_decode.py
+#   @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+#
+#   Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+#   Permission is hereby granted, free of charge, to any person obtaining a copy
+#   of this software and associated documentation files (the "Software"), to deal
+#   in the Software without restriction, including without limitation the rights
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#   copies of the Software, and to permit persons to whom the Software is
+#   furnished to do so, subject to the following conditions:
+#   The above copyright notice and this permission notice shall be included in
+#   all copies or substantial portions of the Software.
+
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#   THE SOFTWARE.
+#==========================================================================
+
+# This script decodes the binary traces written by seven_stage_trace_writer
+# (see rtl/cores/seven_stage/tb/seven_stage_trace_writer.v). Run a seven stage
+# test bench with +trace=<prefix> to write one <prefix>.core<N>.trc file per
+# core.
+#
+# Modes:
+#   text   : one line per retired instruction
+#   stats  : retired instructions, IPC, stage occupancy and stall/flush cycles
+#            broken down by hazard
+#   konata : Kanata log for the Konata pipeline viewer. The per instruction
+#            stage timing is rebuilt from the occupancy records, so the trace
+#            must not be recorded with +trace_no_occupancy.
+#
+# Example:
+# ./trace_decode.py gcd.core0.trc --mode stats
+# ./trace_decode.py gcd.core0.trc --mode konata -o gcd.kanata
+
+import sys
+import struct
+import argparse
+
+MAGIC = 0x54525431
+
+COMMIT_RECORD = 1
+OCCUPANCY_RECORD = 2
+SYNC_RECORD = 3
+
+# Bit order of the occupancy fields matches the trace ports of seven_stage_core
+STAGES = ['FR', 'ID', 'EX', 'MI', 'MR', 'WB']
+STALL_STAGES = ['FR', 'ID', 'EX', 'MI', 'MR']
+FLUSH_STAGES = ['FR', 'ID', 'EX', 'MR', 'WB']
+HAZARDS = ['true_data', 'd_mem_issue', 'd_mem_recv', 'i_mem_issue',
+           'i_mem_recv', 'JALR_branch', 'JAL', 'clog']
+
+
+class TraceError(Exception):
+    pass
+
+
+def read_trace(file_name):
+    """Returns the trace header and a list of decoded records."""
+    with open(file_name, 'rb') as f:
+        data = f.read()
+    num_words = len(data) // 4
+    words = struct.unpack('<%dI' % num_words, data[:num_words*4])
+    if num_words < 3 or words[0] != MAGIC:
+        raise TraceError(f'{file_name} is not a Trireme trace file')
+
+    header = {
+        'data_width': words[1] >> 16,
+        'address_bits': words[1] & 0xffff,
+        'core': words[2]
+    }
+    address_words = (header['address_bits'] + 31) // 32
+    data_words = (header['data_width'] + 31) // 32
+
+    def read_wide(position, count):
+        if position + count > num_words:
+            raise TraceError('trace ends in the middle of a record')
+        value = 0
+        for i in range(count):
+            value |= words[position + i] << (32*i)
+        return value, position + count
+
+    records = []
+    cycle = 0
+    position = 3
+    while position < num_words:
+        word = words[position]
+        position += 1
+        record_type = word >> 30
+        if record_type == SYNC_RECORD:
+            cycle, position = read_wide(position, 2)
+        elif record_type == OCCUPANCY_RECORD:
+            cycle += (word >> 24) & 0x3f
+            status = word & 0xffffff
+            records.append({
+                'type': OCCUPANCY_RECORD,
+                'cycle': cycle,
+                'valid': (status >> 18) & 0x3f,
+                'stall': (status >> 13) & 0x1f,
+                'flush': (status >> 8) & 0x1f,
+                'hazards': status & 0xff
+            })
+        elif record_type == COMMIT_RECORD:
+            cycle += word & 0x3fffff
+            record = {
+                'type': COMMIT_RECORD,
+                'cycle': cycle,
+                'reg_write': (word >> 29) & 1,
+                'memory_access': (word >> 28) & 1,
+                'store': (word >> 27) & 1,
+                'rd': (word >> 22) & 0x1f
+            }
+            record['pc'], position = read_wide(position, address_words)
+            record['instruction'], position = read_wide(position, 1)
+            if record['reg_write']:
+                record['rd_data'], position = read_wide(position, data_words)
+            if record['memory_access']:
+                record['address'], position = read_wide(position, address_words)
+            records.append(record)
+        else:
+            raise TraceError(f'unknown record type at word {position-1}')
+    return header, records
+
+
+def occupancy_by_cycle(records):
+    """Yields (cycle, occupancy record) for every cycle covered by the trace."""
+    current = None
+    last_cycle = None
+    for record in records:
+        if current is not None:
+            for cycle in range(last_cycle, record['cycle']):
+                yield cycle, current
+        if record['type'] == OCCUPANCY_RECORD:
+            current = record
+        last_cycle = record['cycle']
+    if current is not None and last_cycle is not None:
+        yield last_cycle, current
+
+
+def write_text(header, records, out):
+    hex_digits = (header['data_width'] + 3) // 4
+    for record in records:
+        if record['type'] != COMMIT_RECORD:
+            continue
+        line = f"{record['cycle']:>10} core{header['core']} {record['pc']:08x} ({record['instruction']:08x})"
+        if record['reg_write']:
+            line += f" x{record['rd']:<2} = {record['rd_data']:0{hex_digits}x}"
+        if record['memory_access']:
+            line += f" {'store' if record['store'] else 'load'} [{record['address']:08x}]"
+        out.write(line + '\n')
+
+
+def write_stats(header, records, out):
+    commits = [x for x in records if x['type'] == COMMIT_RECORD]
+    cycles = 0
+    stage_busy = [0]*len(STAGES)
+    stalls = [0]*len(STALL_STAGES)
+    flushes = [0]*len(FLUSH_STAGES)
+    hazards = [0]*len(HAZARDS)
+    for _, status in occupancy_by_cycle(records):
+        cycles += 1
+        for i in range(len(STAGES)):
+            stage_busy[i] += (status['valid'] >> i) & 1
+        for i in range(len(STALL_STAGES)):
+            stalls[i] += (status['stall'] >> i) & 1
+        for i in range(len(FLUSH_STAGES)):
+            flushes[i] += (status['flush'] >> i) & 1
+        for i in range(len(HAZARDS)):
+            hazards[i] += (status['hazards'] >> i) & 1
+
+    if cycles == 0 and len(commits) > 0:
+        cycles = commits[-1]['cycle'] - commits[0]['cycle'] + 1
+
+    out.write(f"Core {header['core']}\n")
+    out.write(f"Retired instructions : {len(commits)}\n")
+    out.write(f"Cycles               : {cycles}\n")
+    if cycles > 0:
+        out.write(f"IPC                  : {len(commits)/cycles:.3f}\n")
+    if len(commits) > 0:
+        loads = sum(1 for x in commits if x['memory_access'] and not x['store'])
+        stores = sum(1 for x in commits if x['memory_access'] and x['store'])
+        out.write(f"Loads / Stores       : {loads} / {stores}\n")
+    if cycles == 0 or sum(stage_busy) == 0:
+        return
+    out.write("\nStage occupancy\n")
+    for name, busy in zip(STAGES, stage_busy):
+        out.write(f"  {name} : {busy:>10} cycles ({100.0*busy/cycles:5.1f}%)\n")
+    out.write("\nStall cycles\n")
+    for name, count in zip(STALL_STAGES, stalls):
+        out.write(f"  {name} : {count:>10} cycles ({100.0*count/cycles:5.1f}%)\n")
+    out.write("\nFlush cycles\n")
+    for name, count in zip(FLUSH_STAGES, flushes):
+        out.write(f"  {name} : {count:>10} cycles ({100.0*count/cycles:5.1f}%)\n")
+    out.write("\nHazard cycles\n")
+    for name, count in zip(HAZARDS, hazards):
+        out.write(f"  {name:<11} : {count:>10} cycles ({100.0*count/cycles:5.1f}%)\n")
+
+
+def write_konata(header, records, out):
+    """Rebuilds the stage of every instruction each cycle by replaying the
+    stall and flush signals of the pipeline registers, then writes a Kanata
+    log. Retired instructions are matched in order with the commit records.
+    """
+    commits = [x for x in records if x['type'] == COMMIT_RECORD]
+    cycles = list(occupancy_by_cycle(records))
+    if len(cycles) == 0:
+        raise TraceError('Konata output needs occupancy records')
+
+    FR, ID, EX, MI, MR, WB = range(len(STAGES))
+    content = [None]*len(STAGES)
+    next_id = 0
+    retire_id = 0
+    commit_index = 0
+
+    out.write('Kanata\t0004\n')
+    out.write(f'C=\t{cycles[0][0]}\n')
+    previous_cycle = cycles[0][0]
+
+    # Instructions already in the pipeline when the trace starts
+    for stage in range(len(STAGES)):
+        if (cycles[0][1]['valid'] >> stage) & 1:
+            content[stage] = {'id': next_id, 'stage': None}
+            out.write(f"I\t{next_id}\t{next_id}\t{header['core']}\n")
+            next_id += 1
+
+    for index, (cycle, status) in enumerate(cycles):
+        if cycle != previous_cycle:
+            out.write(f'C\t{cycle - previous_cycle}\n')
+            previous_cycle = cycle
+
+        # Stage contents for this cycle are known; report stage entries
+        for stage, entry in enumerate(content):
+            if entry is not None and entry['stage'] != stage:
+                entry['stage'] = stage
+                out.write(f"S\t{entry['id']}\t0\t{STAGES[stage]}\n")
+
+        # Instructions leaving writeback retire this cycle
+        if content[WB] is not None:
+            entry = content[WB]
+            if commit_index < len(commits):
+                commit = commits[commit_index]
+                commit_index += 1
+                label = f"{commit['pc']:08x}: {commit['instruction']:08x}"
+                if commit['reg_write']:
+                    label += f" x{commit['rd']}={commit['rd_data']:x}"
+                if commit['memory_access']:
+                    label += f" [{commit['address']:08x}]"
+                out.write(f"L\t{entry['id']}\t0\t{label}\n")
+            out.write(f"R\t{entry['id']}\t{retire_id}\t0\n")
+            retire_id += 1
+
+        stall = [(status['stall'] >> i) & 1 for i in range(len(STALL_STAGES))] + [0]
+        flush_bits = [(status['flush'] >> i) & 1 for i in range(len(FLUSH_STAGES))]
+        flush = [flush_bits[0], flush_bits[1], flush_bits[2], 0, flush_bits[3], flush_bits[4]]
+
+        # Valid bit of the fetch receive register on the next cycle tells if a
+        # new fetch entered the pipeline
+        next_fetch = False
+        if index + 1 < len(cycles):
+            next_fetch = bool(cycles[index + 1][1]['valid'] & 1)
+
+        new_content = [None]*len(STAGES)
+        for stage in range(len(STAGES)-1, -1, -1):
+            if flush[stage]:
+                new_content[stage] = None
+            elif stall[stage]:
+                new_content[stage] = content[stage]
+            elif stage == FR:
+                if next_fetch:
+                    new_content[stage] = {'id': next_id, 'stage': None}
+                    out.write(f"I\t{next_id}\t{next_id}\t{header['core']}\n")
+                    next_id += 1
+            else:
+                new_content[stage] = content[stage-1]
+
+        # Instructions that were dropped by a flush
+        survivors = set(id(x) for x in new_content if x is not None)
+        for stage, entry in enumerate(content):
+            if entry is not None and stage != WB and id(entry) not in survivors:
+                out.write(f"L\t{entry['id']}\t0\tflushed\n")
+                out.write(f"R\t{entry['id']}\t{entry['id']}\t1\n")
+        content = new_content
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode Trireme seven stage core trace files')
+    parser.add_argument('trace', help='.trc file written by seven_stage_trace_writer')
+    parser.add_argument('--mode', choices=['text', 'stats', 'konata'], default='text')
+    parser.add_argument('-o', '--output', help='output file (default: stdout)')
+    args = parser.parse_args()
+
+    try:
+        header, records = read_trace(args.trace)
+        out = open(args.output, 'w') if args.output else sys.stdout
+        if args.mode == 'text':
+            write_text(header, records, out)
+        elif args.mode == 'stats':
+            write_stats(header, records, out)
+        else:
+            write_konata(header, records, out)
+        if args.output:
+            out.close()
+    except TraceError as e:
+        print(f'trace_decode: {e}')
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,312 @@
+/** @module : cache_model
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+
+#include "cache_model.h"
+
+#include <sstream>
+
+namespace trireme {
+
+bool CacheHierarchyConfig::set(const std::string &name, unsigned value) {
+  const struct {
+    const char *name;
+    unsigned *field;
+  } fields[] = {
+    {"OFFSET_BITS_L1I",     &offset_bits_l1i},
+    {"OFFSET_BITS_L1D",     &offset_bits_l1d},
+    {"NUMBER_OF_WAYS_L1I",  &number_of_ways_l1i},
+    {"NUMBER_OF_WAYS_L1D",  &number_of_ways_l1d},
+    {"INDEX_BITS_L1I",      &index_bits_l1i},
+    {"INDEX_BITS_L1D",      &index_bits_l1d},
+    {"REPLACEMENT_MODE_L1", &replacement_mode_l1},
+    {"OFFSET_BITS_L2",      &offset_bits_l2},
+    {"NUMBER_OF_WAYS_L2",   &number_of_ways_l2},
+    {"INDEX_BITS_L2",       &index_bits_l2},
+    {"REPLACEMENT_MODE_L2", &replacement_mode_l2},
+    {"L2_INCLUSION",        &l2_inclusion},
+    {"L2_HIT_LATENCY",      &l2_hit_latency},
+    {"MEMORY_LATENCY",      &memory_latency},
+    {"UPGRADE_LATENCY",     &upgrade_latency}
+  };
+  // The shared names set the instruction and data cache together, like the
+  // modelsim/cache_sweep options.
+  if(name == "OFFSET_BITS_L1")
+    return set("OFFSET_BITS_L1I", value) && set("OFFSET_BITS_L1D", value);
+  if(name == "NUMBER_OF_WAYS_L1")
+    return set("NUMBER_OF_WAYS_L1I", value) && set("NUMBER_OF_WAYS_L1D", value);
+  if(name == "INDEX_BITS_L1")
+    return set("INDEX_BITS_L1I", value) && set("INDEX_BITS_L1D", value);
+  for(const auto &field : fields) {
+    if(name == field.name) {
+      *field.field = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string CacheHierarchyConfig::describe() const {
+  std::ostringstream text;
+  text << "L1I " << (1u << index_bits_l1i) << " sets x " << number_of_ways_l1i
+       << " ways x " << (1u << offset_bits_l1i) << " words, "
+       << "L1D " << (1u << index_bits_l1d) << " sets x " << number_of_ways_l1d
+       << " ways x " << (1u << offset_bits_l1d) << " words, "
+       << "L2 " << (1u << index_bits_l2) << " sets x " << number_of_ways_l2
+       << " ways x " << (1u << offset_bits_l2) << " words"
+       << (l2_inclusion ? " (inclusive)" : "");
+  return text.str();
+}
+
+SetAssociativeCache::SetAssociativeCache(unsigned offset_bits,
+                                         unsigned index_bits, unsigned ways,
+                                         unsigned replacement_mode)
+  : offset_bits_(offset_bits),
+    index_bits_(index_bits),
+    ways_(ways),
+    replacement_mode_(replacement_mode),
+    use_counter_(0),
+    lines_((std::size_t(1) << index_bits)*ways, Line{0, INVALID, 0}) {
+}
+
+SetAssociativeCache::Line *SetAssociativeCache::lookup(uint64_t line_address,
+                                                       bool touch) {
+  Line *set = &lines_[(line_address & ((1ull << index_bits_) - 1))*ways_];
+  for(unsigned way=0; way<ways_; way++) {
+    if(set[way].state != INVALID && set[way].tag == line_address) {
+      if(touch)
+        set[way].last_use = ++use_counter_;
+      return &set[way];
+    }
+  }
+  return nullptr;
+}
+
+SetAssociativeCache::Line *SetAssociativeCache::victim(uint64_t line_address) {
+  Line *set = &lines_[(line_address & ((1ull << index_bits_) - 1))*ways_];
+  for(unsigned way=0; way<ways_; way++) {
+    if(set[way].state == INVALID)
+      return &set[way];
+  }
+  if(replacement_mode_ != 0)
+    return &set[0];
+  Line *lru = &set[0];
+  for(unsigned way=1; way<ways_; way++) {
+    if(set[way].last_use < lru->last_use)
+      lru = &set[way];
+  }
+  return lru;
+}
+
+void SetAssociativeCache::fill(Line *line, uint64_t line_address,
+                               State state) {
+  line->tag      = line_address;
+  line->state    = state;
+  line->last_use = ++use_counter_;
+}
+
+CacheHierarchyModel::CacheHierarchyModel(const CacheHierarchyConfig &config,
+                                         unsigned num_cores)
+  : config_(config),
+    num_cores_(num_cores),
+    l2_(config.offset_bits_l2, config.index_bits_l2, config.number_of_ways_l2,
+        config.replacement_mode_l2),
+    memory_reads_(0),
+    memory_writes_(0) {
+  for(unsigned i=0; i<num_cores; i++)
+    l1_.emplace_back(config.offset_bits_l1i, config.index_bits_l1i,
+                     config.number_of_ways_l1i, config.replacement_mode_l1);
+  for(unsigned i=0; i<num_cores; i++)
+    l1_.emplace_back(config.offset_bits_l1d, config.index_bits_l1d,
+                     config.number_of_ways_l1d, config.replacement_mode_l1);
+}
+
+unsigned CacheHierarchyModel::fetch(unsigned core, uint64_t byte_address) {
+  return access(core, byte_address, false);
+}
+
+unsigned CacheHierarchyModel::load(unsigned core, uint64_t byte_address) {
+  return access(num_cores_ + core, byte_address, false);
+}
+
+unsigned CacheHierarchyModel::store(unsigned core, uint64_t byte_address) {
+  return access(num_cores_ + core, byte_address, true);
+}
+
+unsigned CacheHierarchyModel::access(unsigned l1, uint64_t byte_address,
+                                     bool write) {
+  SetAssociativeCache &cache = l1_[l1];
+  uint64_t word_address = byte_address >> 2;
+  uint64_t line_address = cache.line_address(word_address);
+  bool shared = false;
+
+  if(write)
+    cache.stats.writes++;
+  else
+    cache.stats.reads++;
+
+  SetAssociativeCache::Line *line = cache.lookup(line_address, true);
+  if(line) {
+    if(!write || line->state == SetAssociativeCache::MODIFIED)
+      return 0;
+    if(line->state == SetAssociativeCache::EXCLUSIVE) {
+      line->state = SetAssociativeCache::MODIFIED;
+      return 0;
+    }
+    // Shared line: invalidate the other copies before writing
+    cache.stats.upgrades++;
+    snoop(l1, word_address, true, shared);
+    line->state = SetAssociativeCache::MODIFIED;
+    return config_.upgrade_latency;
+  }
+
+  if(write)
+    cache.stats.write_misses++;
+  else
+    cache.stats.read_misses++;
+
+  snoop(l1, word_address, write, shared);
+  unsigned latency = config_.l2_hit_latency + l2_read(word_address);
+
+  SetAssociativeCache::Line *victim = cache.victim(line_address);
+  if(victim->state == SetAssociativeCache::MODIFIED) {
+    cache.stats.writebacks++;
+    l2_write_back(victim->tag << cache.offset_bits());
+  }
+  cache.fill(victim, line_address,
+             write  ? SetAssociativeCache::MODIFIED :
+             shared ? SetAssociativeCache::SHARED   :
+                      SetAssociativeCache::EXCLUSIVE);
+  return latency;
+}
+
+void CacheHierarchyModel::snoop(unsigned requester, uint64_t word_address,
+                                bool exclusive, bool &shared) {
+  for(unsigned i=0; i<l1_.size(); i++) {
+    if(i == requester)
+      continue;
+    SetAssociativeCache &cache = l1_[i];
+    SetAssociativeCache::Line *line =
+      cache.lookup(cache.line_address(word_address), false);
+    if(!line)
+      continue;
+    shared = true;
+    if(line->state == SetAssociativeCache::MODIFIED) {
+      cache.stats.writebacks++;
+      l2_write_back(word_address);
+    }
+    if(exclusive) {
+      line->state = SetAssociativeCache::INVALID;
+      cache.stats.invalidations++;
+    }
+    else {
+      line->state = SetAssociativeCache::SHARED;
+    }
+  }
+}
+
+unsigned CacheHierarchyModel::l2_read(uint64_t word_address) {
+  uint64_t line_address = l2_.line_address(word_address);
+  l2_.stats.reads++;
+  if(l2_.lookup(line_address, true))
+    return 0;
+  l2_.stats.read_misses++;
+  memory_reads_++;
+  l2_allocate(line_address, SetAssociativeCache::EXCLUSIVE);
+  return config_.memory_latency;
+}
+
+void CacheHierarchyModel::l2_write_back(uint64_t word_address) {
+  uint64_t line_address = l2_.line_address(word_address);
+  l2_.stats.writes++;
+  SetAssociativeCache::Line *line = l2_.lookup(line_address, true);
+  if(line) {
+    line->state = SetAssociativeCache::MODIFIED;
+    return;
+  }
+  l2_.stats.write_misses++;
+  l2_allocate(line_address, SetAssociativeCache::MODIFIED);
+}
+
+SetAssociativeCache::Line *CacheHierarchyModel::l2_allocate(
+  uint64_t line_address, SetAssociativeCache::State state) {
+  SetAssociativeCache::Line *victim = l2_.victim(line_address);
+  if(victim->state != SetAssociativeCache::INVALID) {
+    bool dirty = victim->state == SetAssociativeCache::MODIFIED;
+    if(config_.l2_inclusion) {
+      // Back-invalidate every L1 line inside the evicted L2 line. Dirty L1
+      // data leaves with the L2 victim.
+      uint64_t first_word = victim->tag << l2_.offset_bits();
+      uint64_t last_word  = first_word + (1ull << l2_.offset_bits());
+      for(SetAssociativeCache &cache : l1_) {
+        uint64_t step = 1ull << cache.offset_bits();
+        for(uint64_t word=first_word; word<last_word; word+=step) {
+          SetAssociativeCache::Line *line =
+            cache.lookup(cache.line_address(word), false);
+          if(!line)
+            continue;
+          if(line->state == SetAssociativeCache::MODIFIED) {
+            cache.stats.writebacks++;
+            dirty = true;
+          }
+          line->state = SetAssociativeCache::INVALID;
+          cache.stats.invalidations++;
+        }
+      }
+    }
+    if(dirty) {
+      l2_.stats.writebacks++;
+      memory_writes_++;
+    }
+  }
+  l2_.fill(victim, line_address, state);
+  return victim;
+}
+
+static void report_cache(std::FILE *out, const char *name,
+                         const CacheStats &stats) {
+  uint64_t accesses = stats.reads + stats.writes;
+  uint64_t misses   = stats.read_misses + stats.write_misses;
+  std::fprintf(out,
+    "  %-7s accesses %10llu  misses %9llu (%6.2f%%)  upgrades %7llu"
+    "  writebacks %7llu  invalidations %7llu\n",
+    name, (unsigned long long)accesses, (unsigned long long)misses,
+    accesses ? 100.0*misses/accesses : 0.0,
+    (unsigned long long)stats.upgrades, (unsigned long long)stats.writebacks,
+    (unsigned long long)stats.invalidations);
+}
+
+void CacheHierarchyModel::report(std::FILE *out) const {
+  char name[16];
+  std::fprintf(out, "cache hierarchy: %s\n", config_.describe().c_str());
+  for(unsigned i=0; i<l1_.size(); i++) {
+    std::snprintf(name, sizeof(name), "L1%c[%u]", i < num_cores_ ? 'I' : 'D',
+                  i % num_cores_);
+    report_cache(out, name, l1_[i].stats);
+  }
+  report_cache(out, "L2", l2_.stats);
+  std::fprintf(out, "  memory  line reads %llu  line writes %llu\n",
+               (unsigned long long)memory_reads_,
+               (unsigned long long)memory_writes_);
+}
+
+} // namespace trireme
@@ -0,0 +1,152 @@
+/** @module : cache_model
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+
+/** Module description
+ * --------------------
+ *  - Functional model of two_level_cache_hierarchy that predicts hits,
+ *    misses, writebacks and coherence traffic. It holds tags and states only,
+ *    the data always comes from the Platform memory.
+ *  - Parameters use the Verilog names of seven_stage_multicore_top and
+ *    modelsim/cache_sweep (OFFSET_BITS_L1I, INDEX_BITS_L2, ...). Lines are
+ *    indexed by word address (byte address >> 2), like cache_controller.
+ *  - L1 caches are numbered like the hierarchy ports: 0..N-1 are the
+ *    instruction caches and N..2N-1 the data caches.
+ *  - L1 caches keep MESI states and snoop each other on the shared bus. The
+ *    L2 back-invalidates L1 copies on eviction when L2_INCLUSION is set.
+ *  - Replacement fills empty ways first. REPLACEMENT_MODE 0 selects LRU and
+ *    1 selects way 0, matching the placeholder random_way in
+ *    replacement_controller.
+ */
+
+#ifndef TRIREME_ISS_CACHE_MODEL_H
+#define TRIREME_ISS_CACHE_MODEL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace trireme {
+
+struct CacheHierarchyConfig {
+  unsigned offset_bits_l1i   = 2;
+  unsigned offset_bits_l1d   = 2;
+  unsigned number_of_ways_l1i = 2;
+  unsigned number_of_ways_l1d = 2;
+  unsigned index_bits_l1i    = 5;
+  unsigned index_bits_l1d    = 5;
+  unsigned replacement_mode_l1 = 0;
+  unsigned offset_bits_l2    = 2;
+  unsigned number_of_ways_l2 = 4;
+  unsigned index_bits_l2     = 6;
+  unsigned replacement_mode_l2 = 0;
+  unsigned l2_inclusion      = 1;
+  // Extra cycles seen by the core. These are estimates of the RTL bus and
+  // memory interface latency, not values read from it.
+  unsigned l2_hit_latency    = 8;
+  unsigned memory_latency    = 20;
+  unsigned upgrade_latency   = 4;
+
+  // Sets a parameter by its Verilog name. Returns false for unknown names.
+  bool set(const std::string &name, unsigned value);
+  std::string describe() const;
+};
+
+struct CacheStats {
+  uint64_t reads       = 0;
+  uint64_t writes      = 0;
+  uint64_t read_misses = 0;
+  uint64_t write_misses = 0;
+  uint64_t upgrades    = 0;
+  uint64_t writebacks  = 0;
+  uint64_t invalidations = 0; // lines lost to coherence or back-invalidation
+};
+
+class SetAssociativeCache {
+public:
+  enum State : uint8_t { INVALID = 0, SHARED, EXCLUSIVE, MODIFIED };
+
+  struct Line {
+    uint64_t tag;   // full line address
+    State state;
+    uint32_t last_use;
+  };
+
+  SetAssociativeCache(unsigned offset_bits, unsigned index_bits,
+                      unsigned ways, unsigned replacement_mode);
+
+  unsigned offset_bits() const { return offset_bits_; }
+  uint64_t line_address(uint64_t word_address) const {
+    return word_address >> offset_bits_;
+  }
+
+  // Returns the matching line or nullptr. A hit updates the LRU state.
+  Line *lookup(uint64_t line_address, bool touch);
+  // Picks the way to allocate for line_address. The returned line still holds
+  // the victim so the caller can write it back.
+  Line *victim(uint64_t line_address);
+  void fill(Line *line, uint64_t line_address, State state);
+
+  CacheStats stats;
+
+private:
+  unsigned offset_bits_;
+  unsigned index_bits_;
+  unsigned ways_;
+  unsigned replacement_mode_;
+  uint32_t use_counter_;
+  std::vector<Line> lines_;
+};
+
+class CacheHierarchyModel {
+public:
+  CacheHierarchyModel(const CacheHierarchyConfig &config, unsigned num_cores);
+
+  // Returns the number of stall cycles the access adds to the core.
+  unsigned fetch(unsigned core, uint64_t byte_address);
+  unsigned load(unsigned core, uint64_t byte_address);
+  unsigned store(unsigned core, uint64_t byte_address);
+
+  const CacheHierarchyConfig &config() const { return config_; }
+  void report(std::FILE *out) const;
+
+private:
+  unsigned access(unsigned l1, uint64_t byte_address, bool write);
+  unsigned l2_read(uint64_t word_address);
+  void l2_write_back(uint64_t word_address);
+  SetAssociativeCache::Line *l2_allocate(uint64_t line_address,
+                                         SetAssociativeCache::State state);
+  void snoop(unsigned requester, uint64_t word_address, bool exclusive,
+             bool &shared);
+
+  CacheHierarchyConfig config_;
+  unsigned num_cores_;
+  std::vector<SetAssociativeCache> l1_;
+  SetAssociativeCache l2_;
+  uint64_t memory_reads_;
+  uint64_t memory_writes_;
+};
+
+} // namespace trireme
+
+#endif
@@ -0,0 +1,1168 @@
+/** @module : hart
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+
+#include "hart.h"
+
+#include <cstdio>
+
+namespace trireme {
+
+namespace {
+
+enum Opcode {
+  LOAD     = 0x03,
+  MISC_MEM = 0x0F,
+  OP_IMM   = 0x13,
+  AUIPC    = 0x17,
+  OP_IMM32 = 0x1B,
+  STORE    = 0x23,
+  OP       = 0x33,
+  LUI      = 0x37,
+  OP32     = 0x3B,
+  BRANCH   = 0x63,
+  JALR     = 0x67,
+  JAL      = 0x6F,
+  SYSTEM   = 0x73,
+  OP_P     = 0x77
+};
+
+// CSR addresses from CSR_unit_priv
+enum CSRAddress {
+  SSTATUS  = 0x100,
+  SIE      = 0x104,
+  STVEC    = 0x105,
+  SSCRATCH = 0x140,
+  SEPC     = 0x141,
+  SCAUSE   = 0x142,
+  STVAL    = 0x143,
+  SIP      = 0x144,
+  SATP     = 0x180,
+  MSTATUS  = 0x300,
+  MISA     = 0x301,
+  MEDELEG  = 0x302,
+  MIDELEG  = 0x303,
+  MIE      = 0x304,
+  MTVEC    = 0x305,
+  MSCRATCH = 0x340,
+  MEPC     = 0x341,
+  MCAUSE   = 0x342,
+  MTVAL    = 0x343,
+  MIP      = 0x344,
+  MHARTID  = 0xF14
+};
+
+const uint64_t MTVEC_DEFAULT = 0x400 << 2;
+const uint64_t MIDELEG_MASK  = 0x222;
+const uint64_t MIP_MASK      = 0x333;
+
+// mstatus fields
+const uint64_t MSTATUS_SIE  = 1ull << 1;
+const uint64_t MSTATUS_MIE  = 1ull << 3;
+const uint64_t MSTATUS_SPIE = 1ull << 5;
+const uint64_t MSTATUS_MPIE = 1ull << 7;
+const uint64_t MSTATUS_SPP  = 1ull << 8;
+const unsigned MSTATUS_MPP_SHIFT = 11;
+const uint64_t MSTATUS_MPP  = 3ull << MSTATUS_MPP_SHIFT;
+// uie, sie, mie, upie, spie, mpie, spp, mpp, fs, xs, mprv, sum, mxr, tvm, tw
+// and tsr. sd is added per XLEN.
+const uint64_t MSTATUS_WRITE_MASK = 0x1BBull | (0xFFFull << 11);
+// uie, sie, upie, spie, spp, fs, xs, sum and mxr
+const uint64_t SSTATUS_MASK = 0x133ull | (0xFull << 13) | (3ull << 18);
+// Hard wired SXL and UXL fields for RV64
+const uint64_t MSTATUS_XL64 = (2ull << 32) | (2ull << 34);
+const uint64_t SSTATUS_XL64 = (2ull << 32);
+
+// Exception codes raised by priv_control
+const unsigned ILLEGAL_INSTRUCTION = 2;
+const unsigned ECALL_FROM_U        = 8;
+
+// Interrupts in the priority order of CSR_unit_priv:
+// MEI, MSI, MTI, SEI, SSI, STI
+const unsigned INTERRUPT_PRIORITY[] = {11, 3, 7, 9, 1, 5};
+
+inline int64_t sext32(uint64_t value) {
+  return static_cast<int32_t>(value);
+}
+
+// Zbb count and rotate helpers on the low width bits of value
+inline uint64_t count_leading_zeros(uint64_t value, unsigned width) {
+  value <<= 64 - width;
+  return value == 0 ? width : __builtin_clzll(value);
+}
+
+inline uint64_t count_trailing_zeros(uint64_t value, unsigned width) {
+  value &= ~0ull >> (64 - width);
+  return value == 0 ? width : __builtin_ctzll(value);
+}
+
+inline uint64_t count_ones(uint64_t value, unsigned width) {
+  return __builtin_popcountll(value & (~0ull >> (64 - width)));
+}
+
+inline uint64_t rotate_right(uint64_t value, unsigned amount, unsigned width) {
+  value &= ~0ull >> (64 - width);
+  amount &= width - 1;
+  return amount == 0 ? value : (value >> amount) | (value << (width - amount));
+}
+
+// Saturating helpers of the packed SIMD (P extension) instructions
+inline int64_t saturate(int64_t value, unsigned bits) {
+  const int64_t high = (1ll << (bits - 1)) - 1;
+  const int64_t low  = -high - 1;
+  return value > high ? high : value < low ? low : value;
+}
+
+inline int64_t signed_lane(uint64_t value, unsigned bits) {
+  return static_cast<int64_t>(value << (64 - bits)) >> (64 - bits);
+}
+
+inline int64_t imm_i(uint32_t instruction) {
+  return static_cast<int32_t>(instruction) >> 20;
+}
+
+inline int64_t imm_s(uint32_t instruction) {
+  return (static_cast<int32_t>(instruction & 0xFE000000) >> 20) |
+         static_cast<int32_t>((instruction >> 7) & 0x1F);
+}
+
+inline int64_t imm_b(uint32_t instruction) {
+  return (static_cast<int32_t>(instruction & 0x80000000) >> 19) |
+         static_cast<int32_t>(((instruction & 0x80) << 4) |
+                              ((instruction >> 20) & 0x7E0) |
+                              ((instruction >> 7) & 0x1E));
+}
+
+inline int64_t imm_u(uint32_t instruction) {
+  return static_cast<int32_t>(instruction & 0xFFFFF000);
+}
+
+inline int64_t imm_j(uint32_t instruction) {
+  return (static_cast<int32_t>(instruction & 0x80000000) >> 11) |
+         static_cast<int32_t>((instruction & 0xFF000) |
+                              ((instruction >> 9) & 0x800) |
+                              ((instruction >> 20) & 0x7FE));
+}
+
+
+// Expands a 16 bit RVC instruction like rvc_expander in rtl/cores/base.
+// Floating point and reserved encodings expand to 0, an illegal instruction.
+uint32_t expand_compressed(uint32_t c, bool rv64) {
+  auto bits = [c](unsigned high, unsigned low) -> uint32_t {
+    return (c >> low) & ((1u << (high - low + 1)) - 1);
+  };
+  auto sext = [](uint32_t value, unsigned width) -> uint32_t {
+    return static_cast<uint32_t>(static_cast<int32_t>(value << (32 - width)) >>
+                                 (32 - width));
+  };
+  auto i_type = [](uint32_t imm, unsigned rs1, unsigned funct3, unsigned rd,
+                   unsigned opcode) -> uint32_t {
+    return ((imm & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+  };
+  auto s_type = [](uint32_t imm, unsigned rs2, unsigned rs1, unsigned funct3) -> uint32_t {
+    return (((imm >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+           ((imm & 0x1F) << 7) | STORE;
+  };
+  auto r_type = [](unsigned funct7, unsigned rs2, unsigned rs1, unsigned funct3,
+                   unsigned rd, unsigned opcode) -> uint32_t {
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+  };
+
+  const unsigned rd    = bits(11, 7);
+  const unsigned rs2   = bits(6, 2);
+  const unsigned rd_p  = 8 + bits(4, 2);
+  const unsigned rs1_p = 8 + bits(9, 7);
+  const unsigned rs2_p = rd_p;
+  const unsigned funct3 = bits(15, 13);
+  const uint32_t ci_imm = sext((bits(12, 12) << 5) | bits(6, 2), 6);
+  const uint32_t shamt  = (bits(12, 12) << 5) | bits(6, 2);
+  const uint32_t lw_imm = (bits(5, 5) << 6) | (bits(12, 10) << 3) | (bits(6, 6) << 2);
+  const uint32_t ld_imm = (bits(6, 5) << 6) | (bits(12, 10) << 3);
+
+  switch(c & 3) {
+    case 0:
+      switch(funct3) {
+        case 0: {
+          uint32_t imm = (bits(10, 7) << 6) | (bits(12, 11) << 4) | (bits(5, 5) << 3) |
+                         (bits(6, 6) << 2);
+          return imm ? i_type(imm, 2, 0, rd_p, OP_IMM) : 0;             // c.addi4spn
+        }
+        case 2: return i_type(lw_imm, rs1_p, 2, rd_p, LOAD);            // c.lw
+        case 3: return rv64 ? i_type(ld_imm, rs1_p, 3, rd_p, LOAD) : 0; // c.ld
+        case 6: return s_type(lw_imm, rs2_p, rs1_p, 2);                 // c.sw
+        case 7: return rv64 ? s_type(ld_imm, rs2_p, rs1_p, 3) : 0;      // c.sd
+        default: return 0;
+      }
+
+    case 1:
+      switch(funct3) {
+        case 0: return i_type(ci_imm, rd, 0, rd, OP_IMM);               // c.addi
+        case 2: return i_type(ci_imm, 0, 0, rd, OP_IMM);                // c.li
+        case 3:
+          if(rd == 2) {                                                 // c.addi16sp
+            uint32_t imm = sext((bits(12, 12) << 9) | (bits(4, 3) << 7) | (bits(5, 5) << 6) |
+                                (bits(2, 2) << 5) | (bits(6, 6) << 4), 10);
+            return imm ? i_type(imm, 2, 0, 2, OP_IMM) : 0;
+          }
+          if(shamt == 0)
+            return 0;
+          return (sext(shamt, 6) << 12) | (rd << 7) | LUI;              // c.lui
+        case 4:
+          switch(bits(11, 10)) {
+            case 0: return i_type(shamt, rs1_p, 5, rs1_p, OP_IMM);          // c.srli
+            case 1: return i_type(0x400 | shamt, rs1_p, 5, rs1_p, OP_IMM);  // c.srai
+            case 2: return i_type(ci_imm, rs1_p, 7, rs1_p, OP_IMM);         // c.andi
+            default:
+              switch((bits(12, 12) << 2) | bits(6, 5)) {
+                case 0: return r_type(0x20, rs2_p, rs1_p, 0, rs1_p, OP);    // c.sub
+                case 1: return r_type(0x00, rs2_p, rs1_p, 4, rs1_p, OP);    // c.xor
+                case 2: return r_type(0x00, rs2_p, rs1_p, 6, rs1_p, OP);    // c.or
+                case 3: return r_type(0x00, rs2_p, rs1_p, 7, rs1_p, OP);    // c.and
+                case 4: return rv64 ? r_type(0x20, rs2_p, rs1_p, 0, rs1_p, OP32) : 0; // c.subw
+                case 5: return rv64 ? r_type(0x00, rs2_p, rs1_p, 0, rs1_p, OP32) : 0; // c.addw
+                default: return 0;
+              }
+          }
+        case 6:
+        case 7: {                                                       // c.beqz, c.bnez
+          uint32_t imm = sext((bits(12, 12) << 8) | (bits(6, 5) << 6) | (bits(2, 2) << 5) |
+                              (bits(11, 10) << 3) | (bits(4, 3) << 1), 9);
+          return (((imm >> 12) & 1) << 31) | (((imm >> 5) & 0x3F) << 25) |
+                 (rs1_p << 15) | ((funct3 & 1) << 12) | (((imm >> 1) & 0xF) << 8) |
+                 (((imm >> 11) & 1) << 7) | BRANCH;
+        }
+        default: {
+          if(funct3 == 1 && rv64)
+            return i_type(ci_imm, rd, 0, rd, OP_IMM32);                 // c.addiw
+          uint32_t imm = sext((bits(12, 12) << 11) | (bits(8, 8) << 10) | (bits(10, 9) << 8) |
+                              (bits(6, 6) << 7) | (bits(7, 7) << 6) | (bits(2, 2) << 5) |
+                              (bits(11, 11) << 4) | (bits(5, 3) << 1), 12);
+          unsigned link = funct3 == 1 ? 1 : 0;                          // c.jal, c.j
+          return (((imm >> 20) & 1) << 31) | (((imm >> 1) & 0x3FF) << 21) |
+                 (((imm >> 11) & 1) << 20) | (((imm >> 12) & 0xFF) << 12) |
+                 (link << 7) | JAL;
+        }
+      }
+
+    case 2:
+      switch(funct3) {
+        case 0: return i_type(shamt, rd, 1, rd, OP_IMM);                // c.slli
+        case 2: {                                                       // c.lwsp
+          uint32_t imm = (bits(3, 2) << 6) | (bits(12, 12) << 5) | (bits(6, 4) << 2);
+          return rd ? i_type(imm, 2, 2, rd, LOAD) : 0;
+        }
+        case 3: {                                                       // c.ldsp
+          uint32_t imm = (bits(4, 2) << 6) | (bits(12, 12) << 5) | (bits(6, 5) << 3);
+          return (rv64 && rd) ? i_type(imm, 2, 3, rd, LOAD) : 0;
+        }
+        case 4:
+          if(!bits(12, 12)) {
+            if(rs2)
+              return r_type(0, rs2, 0, 0, rd, OP);                      // c.mv
+            return rd ? i_type(0, rd, 0, 0, JALR) : 0;                  // c.jr
+          }
+          if(rs2)
+            return r_type(0, rs2, rd, 0, rd, OP);                       // c.add
+          return rd ? i_type(0, rd, 0, 1, JALR) : 0x00100073;           // c.jalr, c.ebreak
+        case 6:                                                         // c.swsp
+          return s_type((bits(8, 7) << 6) | (bits(12, 9) << 2), rs2, 2, 2);
+        case 7:                                                         // c.sdsp
+          return rv64 ? s_type((bits(9, 7) << 6) | (bits(12, 10) << 3), rs2, 2, 3) : 0;
+        default: return 0;
+      }
+
+    default:
+      return 0;
+  }
+}
+
+} // namespace
+
+bool TimingConfig::set(const std::string &name, unsigned value) {
+  const struct {
+    const char *name;
+    unsigned *field;
+  } fields[] = {
+    {"load_use_penalty", &load_use_penalty},
+    {"jal_penalty",      &jal_penalty},
+    {"branch_penalty",   &branch_penalty},
+    {"trap_penalty",     &trap_penalty},
+    {"mul_latency",      &mul_latency},
+    {"div_latency",      &div_latency}
+  };
+  for(const auto &field : fields) {
+    if(name == field.name) {
+      *field.field = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+Hart::Hart(const HartConfig &config, Platform &platform,
+           CacheHierarchyModel *caches)
+  : config_(config),
+    platform_(platform),
+    caches_(caches),
+    rv32_(config.xlen == 32),
+    xlen_mask_(config.xlen == 32 ? 0xFFFFFFFFull : ~0ull),
+    xlen_msb_(1ull << (config.xlen - 1)),
+    status_(RUNNING),
+    pc_(config.reset_pc),
+    instret_(0),
+    cycles_(0),
+    traps_(0),
+    priv_(MACHINE),
+    mstatus_(0),
+    medeleg_(0),
+    mideleg_(0),
+    mie_(0),
+    mtvec_(MTVEC_DEFAULT),
+    mscratch_(0),
+    mepc_(0),
+    mcause_(0),
+    mtval_(0),
+    mip_(0),
+    sie_(0),
+    stvec_(MTVEC_DEFAULT),
+    sscratch_(0),
+    sepc_(0),
+    scause_(0),
+    stval_(0),
+    satp_(0) {
+  for(unsigned i=0; i<32; i++) {
+    x_[i]         = 0;
+    reg_ready_[i] = 0;
+  }
+}
+
+void Hart::step() {
+  if(status_ != RUNNING)
+    return;
+
+  if(mie_ != 0 && take_interrupt())
+    return;
+
+  uint32_t instruction;
+  if(!platform_.fetch(pc_, instruction)) {
+    char text[64];
+    std::snprintf(text, sizeof(text), "instruction fetch outside of RAM at PC 0x%llx",
+                  (unsigned long long)pc_);
+    stop(text);
+    return;
+  }
+  // 16 bit instructions are expanded first, the rest of step() only sees the
+  // base ISA. A 32 bit instruction in the last halfword of a fetch word takes
+  // a second fetch and a bubble, like fetch_receive with COMPRESSED = 1.
+  uint64_t length = 4;
+  if((instruction & 3) != 3) {
+    instruction = expand_compressed(instruction & 0xFFFF, !rv32_);
+    length      = 2;
+  }
+  const uint64_t fetch_bytes = config_.xlen/8;
+  const bool split_fetch = length == 4 && (pc_ % fetch_bytes) == fetch_bytes - 2;
+  if(caches_) {
+    cycles_ += caches_->fetch(config_.hart_id, pc_);
+    if(split_fetch)
+      cycles_ += caches_->fetch(config_.hart_id, pc_ + 2);
+  }
+  if(split_fetch)
+    cycles_++;
+
+  const unsigned opcode = instruction & 0x7F;
+  const unsigned rd     = (instruction >> 7) & 0x1F;
+  const unsigned funct3 = (instruction >> 12) & 0x7;
+  const unsigned rs1    = (instruction >> 15) & 0x1F;
+  const unsigned rs2    = (instruction >> 20) & 0x1F;
+  const unsigned funct7 = instruction >> 25;
+  const uint64_t a      = x_[rs1];
+  const uint64_t b      = x_[rs2];
+  const unsigned shamt_mask = rv32_ ? 0x1F : 0x3F;
+
+  uint64_t next_pc = pc_ + length;
+  instret_++;
+
+  switch(opcode) {
+    case LUI:
+      write_reg(rd, imm_u(instruction));
+      break;
+
+    case AUIPC:
+      write_reg(rd, pc_ + imm_u(instruction));
+      break;
+
+    case JAL: {
+      uint64_t target = (pc_ + imm_j(instruction)) & xlen_mask_;
+      if(is_halt_loop(instruction, target)) {
+        status_ = HALTED;
+        return;
+      }
+      write_reg(rd, pc_ + length);
+      next_pc  = target;
+      cycles_ += config_.timing.jal_penalty;
+      break;
+    }
+
+    case JALR: {
+      wait_for(rs1);
+      uint64_t target = (a + imm_i(instruction)) & ~1ull & xlen_mask_;
+      if(is_halt_loop(instruction, target)) {
+        status_ = HALTED;
+        return;
+      }
+      write_reg(rd, pc_ + length);
+      next_pc  = target;
+      cycles_ += config_.timing.branch_penalty;
+      break;
+    }
+
+    case BRANCH: {
+      wait_for(rs1);
+      wait_for(rs2);
+      bool taken;
+      switch(funct3) {
+        case 0:  taken = a == b; break;
+        case 1:  taken = a != b; break;
+        case 4:  taken = static_cast<int64_t>(a) <  static_cast<int64_t>(b); break;
+        case 5:  taken = static_cast<int64_t>(a) >= static_cast<int64_t>(b); break;
+        // Registers hold sign extended values in RV32, which keeps the
+        // unsigned order of the low 32 bits.
+        case 6:  taken = a <  b; break;
+        case 7:  taken = a >= b; break;
+        default: goto unsupported;
+      }
+      if(taken) {
+        uint64_t target = (pc_ + imm_b(instruction)) & xlen_mask_;
+        if(is_halt_loop(instruction, target)) {
+          status_ = HALTED;
+          return;
+        }
+        next_pc  = target;
+        cycles_ += config_.timing.branch_penalty;
+      }
+      break;
+    }
+
+    case LOAD: {
+      wait_for(rs1);
+      uint64_t address = (a + imm_i(instruction)) & xlen_mask_;
+      uint64_t value;
+      if(caches_)
+        cycles_ += caches_->load(config_.hart_id, address);
+      switch(funct3) {
+        case 0: value = static_cast<int8_t>(platform_.load(address, 1));   break;
+        case 1: value = static_cast<int16_t>(platform_.load(address, 2));  break;
+        case 2: value = static_cast<int32_t>(platform_.load(address, 4));  break;
+        case 3: if(rv32_) goto unsupported;
+                value = platform_.load(address, 8);                        break;
+        case 4: value = platform_.load(address, 1);                        break;
+        case 5: value = platform_.load(address, 2);                        break;
+        case 6: if(rv32_) goto unsupported;
+                value = platform_.load(address, 4);                        break;
+        default: goto unsupported;
+      }
+      write_reg(rd, value);
+      reg_ready_[rd] = cycles_ + 1 + config_.timing.load_use_penalty;
+      break;
+    }
+
+    case STORE: {
+      wait_for(rs1);
+      wait_for(rs2);
+      uint64_t address = (a + imm_s(instruction)) & xlen_mask_;
+      if(funct3 > 3 || (funct3 == 3 && rv32_))
+        goto unsupported;
+      if(caches_)
+        cycles_ += caches_->store(config_.hart_id, address);
+      platform_.store(address, b, 1u << funct3);
+      break;
+    }
+
+    case OP_IMM: {
+      wait_for(rs1);
+      int64_t imm = imm_i(instruction);
+      unsigned shamt = (instruction >> 20) & shamt_mask;
+      uint64_t value;
+      if(execute_bitmanip(instruction, a, b, value)) {
+        write_reg(rd, value);
+        break;
+      }
+      switch(funct3) {
+        case 0: value = a + imm; break;
+        case 1: value = a << shamt; break;
+        case 2: value = static_cast<int64_t>(a) < imm; break;
+        case 3: value = (a & xlen_mask_) < (static_cast<uint64_t>(imm) & xlen_mask_); break;
+        case 4: value = a ^ imm; break;
+        case 5:
+          if(instruction & 0x40000000)
+            value = rv32_ ? static_cast<uint64_t>(sext32(a) >> shamt)
+                          : static_cast<uint64_t>(static_cast<int64_t>(a) >> shamt);
+          else
+            value = (a & xlen_mask_) >> shamt;
+          break;
+        case 6: value = a | imm; break;
+        default: value = a & imm; break;
+      }
+      write_reg(rd, value);
+      break;
+    }
+
+    case OP: {
+      wait_for(rs1);
+      wait_for(rs2);
+      unsigned shamt = b & shamt_mask;
+      uint64_t value;
+      if(execute_bitmanip(instruction, a, b, value)) {
+        // Zba/Zbb
+      }
+      else if(funct7 == 0x01) {
+        // M extension
+        switch(funct3) {
+          case 0:
+            value = a*b;
+            cycles_ += config_.timing.mul_latency;
+            break;
+          case 1:
+            value = rv32_ ? static_cast<uint64_t>((sext32(a)*sext32(b)) >> 32)
+                          : static_cast<uint64_t>((static_cast<__int128>(static_cast<int64_t>(a)) *
+                                                   static_cast<int64_t>(b)) >> 64);
+            cycles_ += config_.timing.mul_latency;
+            break;
+          case 2:
+            value = rv32_ ? static_cast<uint64_t>((sext32(a)*static_cast<int64_t>(b & 0xFFFFFFFF)) >> 32)
+                          : static_cast<uint64_t>((static_cast<__int128>(static_cast<int64_t>(a)) *
+                                                   static_cast<unsigned __int128>(b)) >> 64);
+            cycles_ += config_.timing.mul_latency;
+            break;
+          case 3:
+            value = rv32_ ? ((a & 0xFFFFFFFF)*(b & 0xFFFFFFFF)) >> 32
+                          : static_cast<uint64_t>((static_cast<unsigned __int128>(a)*b) >> 64);
+            cycles_ += config_.timing.mul_latency;
+            break;
+          case 4: {
+            int64_t dividend = rv32_ ? sext32(a) : static_cast<int64_t>(a);
+            int64_t divisor  = rv32_ ? sext32(b) : static_cast<int64_t>(b);
+            int64_t minimum  = rv32_ ? INT32_MIN : INT64_MIN;
+            value = divisor == 0 ? ~0ull :
+                    (dividend == minimum && divisor == -1) ? static_cast<uint64_t>(minimum) :
+                    static_cast<uint64_t>(dividend/divisor);
+            cycles_ += config_.timing.div_latency;
+            break;
+          }
+          case 5: {
+            uint64_t dividend = a & xlen_mask_;
+            uint64_t divisor  = b & xlen_mask_;
+            value = divisor == 0 ? ~0ull : dividend/divisor;
+            cycles_ += config_.timing.div_latency;
+            break;
+          }
+          case 6: {
+            int64_t dividend = rv32_ ? sext32(a) : static_cast<int64_t>(a);
+            int64_t divisor  = rv32_ ? sext32(b) : static_cast<int64_t>(b);
+            int64_t minimum  = rv32_ ? INT32_MIN : INT64_MIN;
+            value = divisor == 0 ? static_cast<uint64_t>(dividend) :
+                    (dividend == minimum && divisor == -1) ? 0 :
+                    static_cast<uint64_t>(dividend % divisor);
+            cycles_ += config_.timing.div_latency;
+            break;
+          }
+          default: {
+            uint64_t dividend = a & xlen_mask_;
+            uint64_t divisor  = b & xlen_mask_;
+            value = divisor == 0 ? dividend : dividend % divisor;
+            cycles_ += config_.timing.div_latency;
+            break;
+          }
+        }
+      }
+      else if(funct7 == 0x00 || funct7 == 0x20) {
+        bool alt = funct7 == 0x20;
+        switch(funct3) {
+          case 0: value = alt ? a - b : a + b; break;
+          case 1: value = a << shamt; break;
+          case 2: value = static_cast<int64_t>(a) < static_cast<int64_t>(b); break;
+          case 3: value = a < b; break;
+          case 4: value = a ^ b; break;
+          case 5:
+            if(alt)
+              value = rv32_ ? static_cast<uint64_t>(sext32(a) >> shamt)
+                            : static_cast<uint64_t>(static_cast<int64_t>(a) >> shamt);
+            else
+              value = (a & xlen_mask_) >> shamt;
+            break;
+          case 6: value = a | b; break;
+          default: value = a & b; break;
+        }
+      }
+      else {
+        goto unsupported;
+      }
+      write_reg(rd, value);
+      break;
+    }
+
+    case OP_IMM32: {
+      if(rv32_)
+        goto unsupported;
+      wait_for(rs1);
+      unsigned shamt = (instruction >> 20) & 0x1F;
+      uint64_t value;
+      if(execute_bitmanip(instruction, a, b, value)) {
+        write_reg(rd, value);
+        break;
+      }
+      switch(funct3) {
+        case 0: value = sext32(a + imm_i(instruction)); break;
+        case 1: value = sext32(a << shamt); break;
+        case 5:
+          value = (instruction & 0x40000000) ? sext32(a) >> shamt
+                                             : sext32((a & 0xFFFFFFFF) >> shamt);
+          break;
+        default: goto unsupported;
+      }
+      write_reg(rd, value);
+      break;
+    }
+
+    case OP32: {
+      if(rv32_)
+        goto unsupported;
+      wait_for(rs1);
+      wait_for(rs2);
+      unsigned shamt = b & 0x1F;
+      int32_t wa = static_cast<int32_t>(a);
+      int32_t wb = static_cast<int32_t>(b);
+      uint32_t ua = static_cast<uint32_t>(a);
+      uint32_t ub = static_cast<uint32_t>(b);
+      uint64_t value;
+      if(execute_bitmanip(instruction, a, b, value)) {
+        // Zba/Zbb
+      }
+      else if(funct7 == 0x01) {
+        switch(funct3) {
+          case 0: value = sext32(ua*ub); cycles_ += config_.timing.mul_latency; break;
+          case 4:
+            value = wb == 0 ? ~0ull :
+                    (wa == INT32_MIN && wb == -1) ? sext32(INT32_MIN) : sext32(wa/wb);
+            cycles_ += config_.timing.div_latency;
+            break;
+          case 5:
+            value = ub == 0 ? ~0ull : sext32(ua/ub);
+            cycles_ += config_.timing.div_latency;
+            break;
+          case 6:
+            value = wb == 0 ? sext32(wa) :
+                    (wa == INT32_MIN && wb == -1) ? 0 : sext32(wa % wb);
+            cycles_ += config_.timing.div_latency;
+            break;
+          case 7:
+            value = ub == 0 ? sext32(ua) : sext32(ua % ub);
+            cycles_ += config_.timing.div_latency;
+            break;
+          default: goto unsupported;
+        }
+      }
+      else if(funct7 == 0x00 || funct7 == 0x20) {
+        bool alt = funct7 == 0x20;
+        switch(funct3) {
+          case 0: value = sext32(alt ? ua - ub : ua + ub); break;
+          case 1: value = sext32(ua << shamt); break;
+          case 5: value = alt ? sext32(wa >> shamt) : sext32(ua >> shamt); break;
+          default: goto unsupported;
+        }
+      }
+      else {
+        goto unsupported;
+      }
+      write_reg(rd, value);
+      break;
+    }
+
+    case OP_P: {
+      wait_for(rs1);
+      wait_for(rs2);
+      uint64_t value;
+      if(!execute_packed(instruction, a, b, value))
+        goto unsupported;
+      write_reg(rd, value);
+      break;
+    }
+
+    case MISC_MEM:
+      // fence and fence.i: memory is coherent in the model
+      break;
+
+    case SYSTEM:
+      if(funct3 == 0) {
+        execute_system(instruction);
+        return;
+      }
+      wait_for(rs1);
+      if(!csr_access(instruction))
+        return;
+      break;
+
+    default:
+    unsupported: {
+      char text[96];
+      std::snprintf(text, sizeof(text),
+                    "unsupported instruction 0x%08x at PC 0x%llx",
+                    instruction, (unsigned long long)pc_);
+      instret_--;
+      stop(text);
+      return;
+    }
+  }
+
+  pc_ = next_pc;
+  cycles_++;
+}
+
+// Executes the Zba and Zbb instructions of the OP, OP_IMM, OP32 and OP_IMM32
+// opcodes. Returns false for all other instructions. Register values are kept
+// sign extended in RV32, so signed and unsigned compares work for both XLENs.
+bool Hart::execute_bitmanip(uint32_t instruction, uint64_t a, uint64_t b,
+                            uint64_t &value) const {
+  const unsigned opcode = instruction & 0x7F;
+  const unsigned funct3 = (instruction >> 12) & 0x7;
+  const unsigned rs2    = (instruction >> 20) & 0x1F;
+  const unsigned funct7 = instruction >> 25;
+  const unsigned imm    = instruction >> 20;
+  const unsigned xlen   = rv32_ ? 32 : 64;
+
+  switch(opcode) {
+    case OP:
+      if(funct7 == 0x10 && (funct3 == 2 || funct3 == 4 || funct3 == 6))
+        value = (a << (funct3 >> 1)) + b;                         // sh1add, sh2add, sh3add
+      else if(funct7 == 0x20 && funct3 == 7) value = a & ~b;      // andn
+      else if(funct7 == 0x20 && funct3 == 6) value = a | ~b;      // orn
+      else if(funct7 == 0x20 && funct3 == 4) value = ~(a ^ b);    // xnor
+      else if(funct7 == 0x05 && funct3 >= 4) {
+        bool less = (funct3 & 1) ? a < b : static_cast<int64_t>(a) < static_cast<int64_t>(b);
+        value = (less == (funct3 < 6)) ? a : b;                   // min, minu, max, maxu
+      }
+      else if(funct7 == 0x04 && funct3 == 4 && rs2 == 0 && rv32_)
+        value = a & 0xFFFF;                                       // zext.h
+      else if(funct7 == 0x30 && funct3 == 1)
+        value = rotate_right(a, xlen - (b & (xlen - 1)), xlen);   // rol
+      else if(funct7 == 0x30 && funct3 == 5)
+        value = rotate_right(a, b, xlen);                         // ror
+      else
+        return false;
+      return true;
+
+    case OP_IMM:
+      if(funct7 == 0x30 && funct3 == 1) {
+        switch(rs2) {
+          case 0: value = count_leading_zeros(a, xlen); break;
+          case 1: value = count_trailing_zeros(a, xlen); break;
+          case 2: value = count_ones(a, xlen); break;
+          case 4: value = static_cast<int64_t>(static_cast<int8_t>(a)); break;
+          case 5: value = static_cast<int64_t>(static_cast<int16_t>(a)); break;
+          default: return false;
+        }
+      }
+      else if(funct3 == 5 && (rv32_ ? funct7 == 0x30 : (funct7 >> 1) == 0x18))
+        value = rotate_right(a, imm, xlen);                       // rori
+      else if(funct3 == 5 && imm == (rv32_ ? 0x698u : 0x6B8u)) {
+        value = 0;                                                // rev8
+        for(unsigned byte = 0; byte < xlen/8; byte++)
+          value |= ((a >> (8*byte)) & 0xFF) << (xlen - 8 - 8*byte);
+      }
+      else if(funct3 == 5 && imm == 0x287) {
+        value = 0;                                                // orc.b
+        for(unsigned byte = 0; byte < xlen/8; byte++)
+          if((a >> (8*byte)) & 0xFF)
+            value |= 0xFFull << (8*byte);
+      }
+      else
+        return false;
+      return true;
+
+    case OP32:
+      if(rv32_)
+        return false;
+      if(funct7 == 0x04 && funct3 == 0)
+        value = (a & 0xFFFFFFFF) + b;                             // add.uw
+      else if(funct7 == 0x10 && (funct3 == 2 || funct3 == 4 || funct3 == 6))
+        value = ((a & 0xFFFFFFFF) << (funct3 >> 1)) + b;          // sh1add.uw ... sh3add.uw
+      else if(funct7 == 0x04 && funct3 == 4 && rs2 == 0)
+        value = a & 0xFFFF;                                       // zext.h
+      else if(funct7 == 0x30 && funct3 == 1)
+        value = sext32(rotate_right(a, 32 - (b & 31), 32));       // rolw
+      else if(funct7 == 0x30 && funct3 == 5)
+        value = sext32(rotate_right(a, b, 32));                   // rorw
+      else
+        return false;
+      return true;
+
+    case OP_IMM32:
+      if(rv32_)
+        return false;
+      if((funct7 >> 1) == 0x02 && funct3 == 1)
+        value = (a & 0xFFFFFFFF) << (imm & 0x3F);                 // slli.uw
+      else if(funct7 == 0x30 && funct3 == 1) {
+        switch(rs2) {
+          case 0: value = count_leading_zeros(a, 32); break;      // clzw
+          case 1: value = count_trailing_zeros(a, 32); break;     // ctzw
+          case 2: value = count_ones(a, 32); break;               // cpopw
+          default: return false;
+        }
+      }
+      else if(funct7 == 0x30 && funct3 == 5)
+        value = sext32(rotate_right(a, imm, 32));                 // roriw
+      else
+        return false;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// Executes the packed SIMD subset of packed_simd_unit. funct3 000 works on 16
+// bit (and 8 bit) lanes, funct3 001 on 32 bit lanes built from two halfwords.
+// Returns false for the encodings packed_simd_unit does not implement.
+bool Hart::execute_packed(uint32_t instruction, uint64_t a, uint64_t b,
+                          uint64_t &value) const {
+  const unsigned funct3 = (instruction >> 12) & 0x7;
+  const unsigned rs2    = (instruction >> 20) & 0x1F;
+  const unsigned funct7 = instruction >> 25;
+  const unsigned xlen   = rv32_ ? 32 : 64;
+
+  value = 0;
+  if(funct3 == 1) {
+    for(unsigned lane = 0; lane < xlen; lane += 32) {
+      const uint64_t wa = (a >> lane) & 0xFFFFFFFF;
+      const uint64_t wb = (b >> lane) & 0xFFFFFFFF;
+      const int64_t  al = signed_lane(wa, 16), ah = signed_lane(wa >> 16, 16);
+      const int64_t  bl = signed_lane(wb, 16), bh = signed_lane(wb >> 16, 16);
+      int64_t result;
+      switch(funct7) {
+        case 0x1C: result = saturate(ah*bh + al*bl, 32); break;   // kmda
+        case 0x1D: result = saturate(ah*bl + al*bh, 32); break;   // kmxda
+        case 0x2C: result = ah*bh - al*bl; break;                 // smds
+        case 0x34: result = al*bl - ah*bh; break;                 // smdrs
+        case 0x3C: result = ah*bl - al*bh; break;                 // smxds
+        case 0x07: result = ((wa & 0xFFFF) << 16) | (wb & 0xFFFF); break; // pkbb16
+        case 0x0F: result = ((wa & 0xFFFF) << 16) | (wb >> 16); break;    // pkbt16
+        case 0x17: result = (wa & 0xFFFF0000) | (wb >> 16); break;        // pktt16
+        case 0x1F: result = (wa & 0xFFFF0000) | (wb & 0xFFFF); break;     // pktb16
+        default: return false;
+      }
+      value |= (static_cast<uint64_t>(result) & 0xFFFFFFFF) << lane;
+    }
+    return true;
+  }
+  if(funct3 != 0)
+    return false;
+
+  // 8 bit lanes
+  if(funct7 == 0x24 || funct7 == 0x25 || funct7 == 0x0C || funct7 == 0x0D ||
+     funct7 == 0x1C || funct7 == 0x1D) {
+    for(unsigned lane = 0; lane < xlen; lane += 8) {
+      const uint64_t ua = (a >> lane) & 0xFF, ub = (b >> lane) & 0xFF;
+      const int64_t  sa = signed_lane(ua, 8), sb = signed_lane(ub, 8);
+      int64_t result;
+      switch(funct7) {
+        case 0x24: result = sa + sb; break;                                  // add8
+        case 0x25: result = sa - sb; break;                                  // sub8
+        case 0x0C: result = saturate(sa + sb, 8); break;                     // kadd8
+        case 0x0D: result = saturate(sa - sb, 8); break;                     // ksub8
+        case 0x1C: result = ua + ub > 0xFF ? 0xFF : ua + ub; break;          // ukadd8
+        default:   result = ua < ub ? 0 : ua - ub; break;                    // uksub8
+      }
+      value |= (static_cast<uint64_t>(result) & 0xFF) << lane;
+    }
+    return true;
+  }
+
+  // 16 bit lanes. The immediate shifts take the amount from the rs2 field and
+  // rs2 bit 4 selects the rounding (.u) forms, which are not implemented,
+  // except for slli16 where it selects kslli16.
+  const bool immediate = funct7 == 0x38 || funct7 == 0x39 || funct7 == 0x3A;
+  if((funct7 == 0x38 || funct7 == 0x39) && (rs2 & 0x10))
+    return false;
+  for(unsigned lane = 0; lane < xlen; lane += 16) {
+    const uint64_t ua = (a >> lane) & 0xFFFF, ub = (b >> lane) & 0xFFFF;
+    const int64_t  sa = signed_lane(ua, 16), sb = signed_lane(ub, 16);
+    const unsigned shamt = immediate ? rs2 & 0xF : ub & 0xF;
+    int64_t result;
+    switch(funct7) {
+      case 0x20: result = sa + sb; break;                                    // add16
+      case 0x21: result = sa - sb; break;                                    // sub16
+      case 0x00: result = (sa + sb) >> 1; break;                             // radd16
+      case 0x01: result = (sa - sb) >> 1; break;                             // rsub16
+      case 0x08: result = saturate(sa + sb, 16); break;                      // kadd16
+      case 0x09: result = saturate(sa - sb, 16); break;                      // ksub16
+      case 0x18: result = ua + ub > 0xFFFF ? 0xFFFF : ua + ub; break;        // ukadd16
+      case 0x19: result = ua < ub ? 0 : ua - ub; break;                      // uksub16
+      case 0x28: case 0x38: result = sa >> shamt; break;                     // sra16, srai16
+      case 0x29: case 0x39: result = ua >> shamt; break;                     // srl16, srli16
+      case 0x2A: result = ua << shamt; break;                                // sll16
+      case 0x32: result = saturate(sa*(1 << shamt), 16); break;              // ksll16
+      case 0x3A: result = (rs2 & 0x10) ? saturate(sa*(1 << shamt), 16)       // kslli16
+                                       : static_cast<int64_t>(ua << shamt);  // slli16
+                 break;
+      case 0x26: result = ua == ub ? 0xFFFF : 0; break;                      // cmpeq16
+      case 0x06: result = sa <  sb ? 0xFFFF : 0; break;                      // scmplt16
+      case 0x0E: result = sa <= sb ? 0xFFFF : 0; break;                      // scmple16
+      case 0x16: result = ua <  ub ? 0xFFFF : 0; break;                      // ucmplt16
+      case 0x1E: result = ua <= ub ? 0xFFFF : 0; break;                      // ucmple16
+      case 0x40: result = sa < sb ? sa : sb; break;                          // smin16
+      case 0x41: result = sa < sb ? sb : sa; break;                          // smax16
+      case 0x48: result = ua < ub ? ua : ub; break;                          // umin16
+      case 0x49: result = ua < ub ? ub : ua; break;                          // umax16
+      case 0x43: result = (ua == 0x8000 && ub == 0x8000) ? 0x7FFF            // khm16
+                                                         : (sa*sb) >> 15;
+                 break;
+      default: return false;
+    }
+    value |= (static_cast<uint64_t>(result) & 0xFFFF) << lane;
+  }
+  return true;
+}
+
+void Hart::execute_system(uint32_t instruction) {
+  const unsigned rs1    = (instruction >> 15) & 0x1F;
+  const unsigned rs2    = (instruction >> 20) & 0x1F;
+  const unsigned funct7 = instruction >> 25;
+
+  if(funct7 == 0x00 && rs2 == 0 && rs1 == 0) {
+    // ecall: the exception code encodes the current privilege level
+    trap(false, ECALL_FROM_U + priv_, pc_, 0);
+    return;
+  }
+  if(priv_ == MACHINE && funct7 == 0x18 && rs2 == 2) {
+    // mret
+    unsigned mpp = (mstatus_ & MSTATUS_MPP) >> MSTATUS_MPP_SHIFT;
+    mstatus_ = (mstatus_ & ~(MSTATUS_MIE | MSTATUS_MPP)) | MSTATUS_MPIE |
+               ((mstatus_ & MSTATUS_MPIE) ? MSTATUS_MIE : 0);
+    priv_    = mpp;
+    pc_      = mepc_ & xlen_mask_;
+    cycles_ += 1 + config_.timing.trap_penalty;
+    return;
+  }
+  if(priv_ >= SUPERVISOR && funct7 == 0x08 && rs2 == 2) {
+    // sret
+    unsigned spp = (mstatus_ & MSTATUS_SPP) ? SUPERVISOR : USER;
+    mstatus_ = (mstatus_ & ~(MSTATUS_SIE | MSTATUS_SPP)) | MSTATUS_SPIE |
+               ((mstatus_ & MSTATUS_SPIE) ? MSTATUS_SIE : 0);
+    priv_    = spp;
+    pc_      = sepc_ & xlen_mask_;
+    cycles_ += 1 + config_.timing.trap_penalty;
+    return;
+  }
+  // ebreak, wfi and sfence.vma do not change architectural state here
+  pc_ += 4;
+  cycles_++;
+}
+
+bool Hart::csr_access(uint32_t instruction) {
+  const unsigned rd      = (instruction >> 7) & 0x1F;
+  const unsigned funct3  = (instruction >> 12) & 0x7;
+  const unsigned rs1     = (instruction >> 15) & 0x1F;
+  const unsigned address = instruction >> 20;
+  const uint64_t operand = (funct3 & 4) ? rs1 : x_[rs1];
+
+  // Mirrors CSR_control: reads and writes are enabled per funct3, set and
+  // clear only when rs1/zimm is not zero.
+  bool read_en  = ((funct3 & 3) == 1) ? rd != 0 : true;
+  bool write_en = (funct3 & 3) == 1;
+  bool set_en   = (funct3 & 3) == 2 && rs1 != 0;
+  bool clear_en = (funct3 & 3) == 3 && rs1 != 0;
+  if((funct3 & 3) == 0) {
+    char text[96];
+    std::snprintf(text, sizeof(text),
+                  "unsupported instruction 0x%08x at PC 0x%llx",
+                  instruction, (unsigned long long)pc_);
+    instret_--;
+    stop(text);
+    return false;
+  }
+
+  if(priv_ < ((address >> 8) & 3)) {
+    trap(false, ILLEGAL_INSTRUCTION, pc_, instruction);
+    return false;
+  }
+
+  uint64_t old_value = csr_read(address);
+  if(write_en)
+    csr_write(address, operand);
+  else if(set_en)
+    csr_write(address, old_value | operand);
+  else if(clear_en)
+    csr_write(address, old_value & ~operand);
+  if(read_en)
+    write_reg(rd, old_value);
+  return true;
+}
+
+uint64_t Hart::mip_read() const {
+  uint64_t mip = mip_;
+  if(config_.hart_id == 0) {
+    mip |= platform_.software_interrupt() ? (1ull << 3) : 0;
+    mip |= platform_.timer_interrupt()    ? (1ull << 7) : 0;
+  }
+  return mip;
+}
+
+uint64_t Hart::csr_read(unsigned address) const {
+  uint64_t sd = mstatus_ & xlen_msb_;
+  switch(address) {
+    case MSTATUS:  return mstatus_ | (rv32_ ? 0 : MSTATUS_XL64);
+    case MISA:     return 0;
+    case MEDELEG:  return medeleg_;
+    case MIDELEG:  return mideleg_;
+    case MIE:      return mie_;
+    case MTVEC:    return mtvec_;
+    case MSCRATCH: return mscratch_;
+    case MEPC:     return mepc_;
+    case MCAUSE:   return mcause_;
+    case MTVAL:    return mtval_;
+    case MIP:      return mip_read();
+    case MHARTID:  return config_.hart_id;
+    case SSTATUS:  return (mstatus_ & SSTATUS_MASK) | sd |
+                          (rv32_ ? 0 : SSTATUS_XL64);
+    case SIE:      return sie_;
+    case STVEC:    return stvec_;
+    case SSCRATCH: return sscratch_;
+    case SEPC:     return sepc_;
+    case SCAUSE:   return scause_;
+    case STVAL:    return stval_;
+    case SIP:      return mip_ & 0x222 & mideleg_;
+    case SATP:     return satp_;
+    default:       return 0;
+  }
+}
+
+void Hart::csr_write(unsigned address, uint64_t value) {
+  value &= xlen_mask_;
+  const uint64_t cause_mask = xlen_msb_ | 0xF;
+  switch(address) {
+    case MSTATUS: {
+      uint64_t mask = MSTATUS_WRITE_MASK | xlen_msb_;
+      mstatus_ = value & mask;
+      break;
+    }
+    case SSTATUS: {
+      uint64_t mask = SSTATUS_MASK | xlen_msb_;
+      mstatus_ = (mstatus_ & ~mask) | (value & mask);
+      break;
+    }
+    case MEDELEG:  medeleg_  = value;                  break;
+    case MIDELEG:  mideleg_  = value & MIDELEG_MASK;   break;
+    case MIE:      mie_      = value;                  break;
+    case MTVEC:    mtvec_    = value & ~3ull;          break;
+    case MSCRATCH: mscratch_ = value;                  break;
+    case MEPC:     mepc_     = value & ~3ull;          break;
+    case MCAUSE:   mcause_   = value & cause_mask;     break;
+    case MTVAL:    mtval_    = value;                  break;
+    case MIP:      mip_      = value & MIP_MASK;       break;
+    case SIE:      sie_      = value;                  break;
+    case STVEC:    stvec_    = value & ~3ull;          break;
+    case SSCRATCH: sscratch_ = value;                  break;
+    case SEPC:     sepc_     = value & ~3ull;          break;
+    case SCAUSE:   scause_   = value & cause_mask;     break;
+    case STVAL:    stval_    = value;                  break;
+    case SIP:      mip_      = value & MIP_MASK;       break;
+    case SATP: {
+      // Only BARE and the native Sv32/Sv39 modes are accepted
+      uint64_t mode = rv32_ ? value >> 31 : value >> 60;
+      if(mode == 0 || mode == (rv32_ ? 1u : 8u))
+        satp_ = value;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+bool Hart::interrupts_possible() const {
+  if(mie_ == 0)
+    return false;
+  bool m_intr_en = priv_ != MACHINE || (mstatus_ & MSTATUS_MIE);
+  bool s_intr_en = priv_ == USER || (priv_ == SUPERVISOR && (mstatus_ & MSTATUS_SIE));
+  return m_intr_en || (s_intr_en && (mideleg_ & mie_));
+}
+
+bool Hart::take_interrupt() {
+  uint64_t pending = mip_read() & mie_;
+  if(pending == 0)
+    return false;
+  bool m_intr_en = priv_ != MACHINE || (mstatus_ & MSTATUS_MIE);
+  bool s_intr_en = priv_ == USER || (priv_ == SUPERVISOR && (mstatus_ & MSTATUS_SIE));
+  for(unsigned code : INTERRUPT_PRIORITY) {
+    if(!(pending & (1ull << code)))
+      continue;
+    bool delegated = (mideleg_ >> code) & 1;
+    if(delegated ? s_intr_en : m_intr_en) {
+      trap(true, code, pc_, 0);
+      return true;
+    }
+  }
+  return false;
+}
+
+void Hart::trap(bool interrupt, unsigned code, uint64_t epc, uint64_t tval) {
+  uint64_t cause = (interrupt ? xlen_msb_ : 0) | code;
+  bool delegated = interrupt ? ((mideleg_ >> code) & 1)
+                             : (priv_ != MACHINE && ((medeleg_ >> code) & 1));
+  traps_++;
+  if(delegated) {
+    mstatus_ = (mstatus_ & ~(MSTATUS_SIE | MSTATUS_SPIE | MSTATUS_SPP)) |
+               ((mstatus_ & MSTATUS_SIE) ? MSTATUS_SPIE : 0) |
+               ((priv_ & 1) ? MSTATUS_SPP : 0);
+    sepc_    = epc & ~3ull;
+    scause_  = cause;
+    stval_   = tval;
+    priv_    = SUPERVISOR;
+    pc_      = stvec_;
+  }
+  else {
+    mstatus_ = (mstatus_ & ~(MSTATUS_MIE | MSTATUS_MPIE | MSTATUS_MPP)) |
+               ((mstatus_ & MSTATUS_MIE) ? MSTATUS_MPIE : 0) |
+               (static_cast<uint64_t>(priv_) << MSTATUS_MPP_SHIFT);
+    mepc_    = epc & ~3ull;
+    mcause_  = cause;
+    mtval_   = tval;
+    priv_    = MACHINE;
+    pc_      = mtvec_;
+  }
+  cycles_ += 1 + config_.timing.trap_penalty;
+}
+
+bool Hart::is_halt_loop(uint32_t instruction, uint64_t target) const {
+  // auipc rX,0 followed by jalr rX,0(rX) ends the trireme_gcc hart entry
+  // code. The testbenches stop there even with interrupts enabled.
+  const unsigned rd  = (instruction >> 7) & 0x1F;
+  const unsigned rs1 = (instruction >> 15) & 0x1F;
+  uint32_t previous;
+  if((instruction & 0x7F) == JALR && rd == rs1 && imm_i(instruction) == 0 &&
+     target + 4 == pc_ && platform_.fetch(target, previous) &&
+     previous == ((rd << 7) | AUIPC))
+    return true;
+  // Any other jump to itself only ends the program if nothing can wake it
+  return target == pc_ && !interrupts_possible();
+}
+
+} // namespace trireme
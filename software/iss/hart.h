@@ -0,0 +1,173 @@
+/** @module : hart
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+
+/** Module description
+ * --------------------
+ *  - One RV32IMC or RV64IMC hart with the machine and supervisor CSRs of
+ *    CSR_unit_priv. The CSR masks, reset values, interrupt priority and
+ *    delegation follow that module, including what it leaves out: there is
+ *    no address translation, misa reads 0, unknown CSRs read 0 and only ecall
+ *    and illegal CSR accesses raise exceptions.
+ *  - Compressed instructions are expanded like rvc_expander and take one
+ *    cycle more when a 32 bit instruction straddles two fetch words.
+ *  - mret, sret, sfence.vma, fence, fence.i, ebreak and wfi decode like in
+ *    priv_control. Everything that is neither a trap nor a return executes
+ *    as a nop.
+ *  - Cycles are estimated for the seven stage pipeline: one instruction per
+ *    cycle plus load-use stalls, control flow flushes, trap flushes and the
+ *    stall cycles reported by an optional CacheHierarchyModel.
+ *  - A hart halts when it reaches the end of the trireme_gcc hart entry code
+ *    (auipc ra,0 / jalr ra,0(ra)), or on a jump to itself while no interrupt
+ *    can be taken.
+ */
+
+#ifndef TRIREME_ISS_HART_H
+#define TRIREME_ISS_HART_H
+
+#include <cstdint>
+#include <string>
+
+#include "cache_model.h"
+#include "platform.h"
+
+namespace trireme {
+
+struct TimingConfig {
+  // Bubbles between a load and a dependent instruction directly behind it.
+  // Loads block decode while they are in execute, memory issue and memory
+  // receive.
+  unsigned load_use_penalty = 3;
+  // JAL resolves in decode, JALR and taken branches in execute.
+  unsigned jal_penalty      = 2;
+  unsigned branch_penalty   = 3;
+  // Traps and trap returns flush everything up to writeback.
+  unsigned trap_penalty     = 6;
+  unsigned mul_latency      = 0;
+  unsigned div_latency      = 0;
+
+  // Sets a value by its command line name. Returns false for unknown names.
+  bool set(const std::string &name, unsigned value);
+};
+
+struct HartConfig {
+  unsigned hart_id  = 0;
+  int      xlen     = 32;
+  uint64_t reset_pc = 0;
+  TimingConfig timing;
+};
+
+class Hart {
+public:
+  enum Status { RUNNING, HALTED, STOPPED };
+  enum Privilege { USER = 0, SUPERVISOR = 1, MACHINE = 3 };
+
+  Hart(const HartConfig &config, Platform &platform,
+       CacheHierarchyModel *caches);
+
+  // Executes one instruction or takes one interrupt.
+  void step();
+
+  Status status() const { return status_; }
+  // Why the hart stopped, for STOPPED harts.
+  const std::string &message() const { return message_; }
+  // Stops the hart, e.g. when it reaches a user supplied end PC.
+  void stop(const std::string &message) {
+    status_  = STOPPED;
+    message_ = message;
+  }
+
+  uint64_t pc() const { return pc_; }
+  uint64_t reg(unsigned index) const { return x_[index] & xlen_mask_; }
+  uint64_t instret() const { return instret_; }
+  uint64_t cycles() const { return cycles_; }
+  uint64_t traps() const { return traps_; }
+  unsigned hart_id() const { return config_.hart_id; }
+  int xlen() const { return config_.xlen; }
+
+private:
+  inline void write_reg(unsigned rd, uint64_t value) {
+    if(rd != 0)
+      x_[rd] = rv32_ ? static_cast<uint64_t>(static_cast<int64_t>(
+                         static_cast<int32_t>(value))) : value;
+  }
+  inline void wait_for(unsigned rs) {
+    if(reg_ready_[rs] > cycles_)
+      cycles_ = reg_ready_[rs];
+  }
+
+  void execute_system(uint32_t instruction);
+  bool execute_bitmanip(uint32_t instruction, uint64_t a, uint64_t b,
+                        uint64_t &value) const;
+  bool execute_packed(uint32_t instruction, uint64_t a, uint64_t b,
+                      uint64_t &value) const;
+  bool csr_access(uint32_t instruction);
+  uint64_t csr_read(unsigned address) const;
+  void csr_write(unsigned address, uint64_t value);
+  uint64_t mip_read() const;
+  bool interrupts_possible() const;
+  bool take_interrupt();
+  void trap(bool interrupt, unsigned code, uint64_t epc, uint64_t tval);
+  bool is_halt_loop(uint32_t instruction, uint64_t target) const;
+
+  HartConfig config_;
+  Platform &platform_;
+  CacheHierarchyModel *caches_;
+
+  bool     rv32_;
+  uint64_t xlen_mask_;
+  uint64_t xlen_msb_;
+
+  Status status_;
+  std::string message_;
+
+  uint64_t x_[32];
+  uint64_t pc_;
+  uint64_t reg_ready_[32];
+  uint64_t instret_;
+  uint64_t cycles_;
+  uint64_t traps_;
+
+  // CSR_unit_priv state
+  unsigned priv_;
+  uint64_t mstatus_;
+  uint64_t medeleg_;
+  uint64_t mideleg_;
+  uint64_t mie_;
+  uint64_t mtvec_;
+  uint64_t mscratch_;
+  uint64_t mepc_;
+  uint64_t mcause_;
+  uint64_t mtval_;
+  uint64_t mip_;      // software writable bits only, msip/mtip come from devices
+  uint64_t sie_;
+  uint64_t stvec_;
+  uint64_t sscratch_;
+  uint64_t sepc_;
+  uint64_t scause_;
+  uint64_t stval_;
+  uint64_t satp_;
+};
+
+} // namespace trireme
+
+#endif
@@ -0,0 +1,185 @@
+/** @module : platform
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+#include "platform.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace trireme {
+
+Platform::Platform(const PlatformConfig &config)
+  : config_(config),
+    ram_(config.ram_bytes, 0),
+    uart_bytes_written_(0),
+    time_(0),
+    mtime_offset_(0),
+    mtimecmp_(~0ull),
+    unmapped_accesses_(0) {
+  std::memset(sw_intr_register_, 0, sizeof(sw_intr_register_));
+  if(!config_.uart_input.empty()) {
+    std::ifstream input(config_.uart_input, std::ios::binary);
+    char c;
+    while(input.get(c))
+      uart_rx_fifo_.push_back(static_cast<uint8_t>(c));
+  }
+}
+
+bool Platform::load_vmh(const std::string &path, std::string &error) {
+  std::ifstream file(path);
+  if(!file) {
+    error = "could not open " + path;
+    return false;
+  }
+  std::string line;
+  uint64_t word_address = 0;
+  unsigned line_number = 0;
+  while(std::getline(file, line)) {
+    line_number++;
+    std::size_t comment = line.find("//");
+    if(comment != std::string::npos)
+      line.erase(comment);
+    std::istringstream tokens(line);
+    std::string token;
+    while(tokens >> token) {
+      char *end = nullptr;
+      bool is_address = token[0] == '@';
+      const char *digits = token.c_str() + (is_address ? 1 : 0);
+      uint64_t value = std::strtoull(digits, &end, 16);
+      if(*digits == '\0' || *end != '\0') {
+        error = path + ":" + std::to_string(line_number) + ": bad token \"" +
+                token + "\"";
+        return false;
+      }
+      if(is_address) {
+        word_address = value;
+        continue;
+      }
+      uint64_t byte_address = word_address*4;
+      if(byte_address + 4 > ram_.size()) {
+        error = path + ":" + std::to_string(line_number) +
+                ": word address 0x" + digits + " is outside of the RAM window";
+        return false;
+      }
+      uint32_t word = static_cast<uint32_t>(value);
+      std::memcpy(&ram_[byte_address], &word, 4);
+      word_address++;
+    }
+  }
+  return true;
+}
+
+uint64_t Platform::load_slow(uint64_t address, unsigned bytes) {
+  uint64_t value = 0;
+  if(config_.mmio && device_load(address, bytes, value))
+    return value;
+  for(unsigned i=0; i<bytes; i++) {
+    if(address + i < ram_.size())
+      value |= static_cast<uint64_t>(ram_[address + i]) << (8*i);
+    else {
+      unmapped_accesses_++;
+      return 0;
+    }
+  }
+  return value;
+}
+
+void Platform::store_slow(uint64_t address, uint64_t value, unsigned bytes) {
+  if(config_.mmio && device_store(address, value, bytes))
+    return;
+  if(address + bytes > ram_.size()) {
+    unmapped_accesses_++;
+    return;
+  }
+  std::memcpy(&ram_[address], &value, bytes);
+}
+
+bool Platform::device_load(uint64_t address, unsigned bytes, uint64_t &value) {
+  if(address >= UART_ADDR_MIN && address <= UART_ADDR_MAX) {
+    if(address == UART_TX_READY_ADDR) {
+      value = 1; // The TX FIFO never fills up
+    }
+    else if(address == UART_RX_READY_ADDR) {
+      value = !uart_rx_fifo_.empty();
+    }
+    else if(address == UART_RX_ADDR && !uart_rx_fifo_.empty()) {
+      value = (1 << 8) | uart_rx_fifo_.front();
+      uart_rx_fifo_.pop_front();
+    }
+    else {
+      value = 0;
+    }
+    return true;
+  }
+  if(address >= TIME_ADDR_MIN && address <= TIME_ADDR_MAX) {
+    uint64_t registers[2] = {mtime(), mtimecmp_};
+    uint8_t window[16];
+    std::memcpy(window, registers, sizeof(window));
+    uint64_t offset = address - TIME_ADDR_MIN;
+    value = 0;
+    for(unsigned i=0; i<bytes && offset + i < sizeof(window); i++)
+      value |= static_cast<uint64_t>(window[offset + i]) << (8*i);
+    return true;
+  }
+  if(address >= SW_INTR_ADDR_MIN && address <= SW_INTR_ADDR_MAX) {
+    uint64_t offset = address - SW_INTR_ADDR_MIN;
+    value = 0;
+    for(unsigned i=0; i<bytes && offset + i < sizeof(sw_intr_register_); i++)
+      value |= static_cast<uint64_t>(sw_intr_register_[offset + i]) << (8*i);
+    return true;
+  }
+  return false;
+}
+
+bool Platform::device_store(uint64_t address, uint64_t value, unsigned bytes) {
+  if(address >= UART_ADDR_MIN && address <= UART_ADDR_MAX) {
+    if(address == UART_TX_ADDR) {
+      std::putchar(static_cast<int>(value & 0xFF));
+      uart_bytes_written_++;
+    }
+    return true;
+  }
+  if(address >= TIME_ADDR_MIN && address <= TIME_ADDR_MAX) {
+    uint64_t registers[2] = {mtime(), mtimecmp_};
+    uint8_t window[16];
+    std::memcpy(window, registers, sizeof(window));
+    uint64_t offset = address - TIME_ADDR_MIN;
+    for(unsigned i=0; i<bytes && offset + i < sizeof(window); i++)
+      window[offset + i] = static_cast<uint8_t>(value >> (8*i));
+    std::memcpy(registers, window, sizeof(window));
+    // mtime keeps counting from the written value
+    mtime_offset_ = time_ - registers[0];
+    mtimecmp_     = registers[1];
+    return true;
+  }
+  if(address >= SW_INTR_ADDR_MIN && address <= SW_INTR_ADDR_MAX) {
+    uint64_t offset = address - SW_INTR_ADDR_MIN;
+    for(unsigned i=0; i<bytes && offset + i < sizeof(sw_intr_register_); i++)
+      sw_intr_register_[offset + i] = static_cast<uint8_t>(value >> (8*i));
+    return true;
+  }
+  return false;
+}
+
+} // namespace trireme
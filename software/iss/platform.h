@@ -0,0 +1,140 @@
+/** @module : platform
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/** Module description
+ * --------------------
+ *  - Memory system seen by the harts: a flat RAM window starting at address 0
+ *    and the memory mapped devices of seven_stage_priv_BRAM_top.
+ *  - The device address map mirrors the localparams of that top:
+ *      UART (mm_uart)      : RX 0xC0010, RX_READY 0xC0014,
+ *                            TX 0xC0020, TX_READY 0xC0024
+ *      timer               : MTIME 0xD0000, MTIMECMP 0xD0008
+ *                            (RV32 accesses the high halves at +4)
+ *      software interrupt  : mm_register at 0xE0000, bit 0 drives msip
+ *  - Devices are checked before the RAM window, like the address decode in
+ *    the top. Accesses that hit neither are counted, read as 0 and dropped.
+ *  - Timer and register values are byte addressable at their documented
+ *    address, independent of the data bus lane they would use in the RTL.
+ */
+
+#ifndef TRIREME_ISS_PLATFORM_H
+#define TRIREME_ISS_PLATFORM_H
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace trireme {
+
+struct PlatformConfig {
+  uint64_t ram_bytes   = 1 << 22;
+  bool     mmio        = true;
+  int      xlen        = 32;
+  std::string uart_input;
+};
+
+class Platform {
+public:
+  static const uint64_t UART_ADDR_MIN      = 0x000C0000;
+  static const uint64_t UART_ADDR_MAX      = 0x000C0027;
+  static const uint64_t UART_RX_ADDR       = 0x000C0010;
+  static const uint64_t UART_RX_READY_ADDR = 0x000C0014;
+  static const uint64_t UART_TX_ADDR       = 0x000C0020;
+  static const uint64_t UART_TX_READY_ADDR = 0x000C0024;
+  static const uint64_t TIME_ADDR_MIN      = 0x000D0000;
+  static const uint64_t TIME_ADDR_MAX      = 0x000D0010;
+  static const uint64_t MTIME_ADDR         = 0x000D0000;
+  static const uint64_t MTIMECMP_ADDR      = 0x000D0008;
+  static const uint64_t SW_INTR_ADDR_MIN   = 0x000E0000;
+  static const uint64_t SW_INTR_ADDR_MAX   = 0x000E0007;
+
+  explicit Platform(const PlatformConfig &config);
+
+  // Loads a $readmemh style image of 32-bit words. "@addr" selects a word
+  // address, so word N lands at byte address 4*N.
+  bool load_vmh(const std::string &path, std::string &error);
+
+  // Fast path for instruction fetch. Returns false outside of RAM.
+  inline bool fetch(uint64_t address, uint32_t &instruction) const {
+    if(address + 4 > ram_.size())
+      return false;
+    std::memcpy(&instruction, &ram_[address], 4);
+    return true;
+  }
+
+  inline uint64_t load(uint64_t address, unsigned bytes) {
+    if(!(config_.mmio && is_device(address)) && address + bytes <= ram_.size()) {
+      uint64_t value = 0;
+      std::memcpy(&value, &ram_[address], bytes);
+      return value;
+    }
+    return load_slow(address, bytes);
+  }
+
+  inline void store(uint64_t address, uint64_t value, unsigned bytes) {
+    if(!(config_.mmio && is_device(address)) && address + bytes <= ram_.size()) {
+      std::memcpy(&ram_[address], &value, bytes);
+      return;
+    }
+    store_slow(address, value, bytes);
+  }
+
+  // The timer counts cycles of the hart that is currently running.
+  void set_time(uint64_t cycles) { time_ = cycles; }
+  uint64_t mtime() const { return time_ - mtime_offset_; }
+  bool timer_interrupt() const { return mtime() >= mtimecmp_; }
+  bool software_interrupt() const { return sw_intr_register_[0] & 1; }
+
+  uint64_t unmapped_accesses() const { return unmapped_accesses_; }
+  uint64_t uart_bytes_written() const { return uart_bytes_written_; }
+  const std::vector<uint8_t> &ram() const { return ram_; }
+
+private:
+  static inline bool is_device(uint64_t address) {
+    // All device windows live in 0xC0000-0xEFFFF.
+    return (address >> 16) >= 0xC && (address >> 16) <= 0xE;
+  }
+
+  uint64_t load_slow(uint64_t address, unsigned bytes);
+  void store_slow(uint64_t address, uint64_t value, unsigned bytes);
+  bool device_load(uint64_t address, unsigned bytes, uint64_t &value);
+  bool device_store(uint64_t address, uint64_t value, unsigned bytes);
+
+  PlatformConfig config_;
+  std::vector<uint8_t> ram_;
+
+  std::deque<uint8_t> uart_rx_fifo_;
+  uint64_t uart_bytes_written_;
+
+  uint64_t time_;
+  uint64_t mtime_offset_;
+  uint64_t mtimecmp_;
+  uint8_t  sw_intr_register_[8];
+
+  uint64_t unmapped_accesses_;
+};
+
+} // namespace trireme
+
+#endif
@@ -0,0 +1,339 @@
+/** @module : trireme_iss
+ *  @author : Secure, Trusted, and Assured Microelectronics (STAM) Center
+
+ *  Copyright (c) 2022 Trireme (STAM/SCAI/ASU)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+
+/** Module description
+ * --------------------
+ *  - Command line front end of the Trireme instruction set simulator. Loads
+ *    a .vmh image, runs one or more harts on a shared Platform and reports
+ *    the final registers, estimated cycles, cache statistics and simulation
+ *    speed.
+ *  - Harts are interleaved by estimated cycle count, so the hart that is
+ *    furthest behind in time always runs next.
+ *  - --expect-s1 compares the s1 (x9) register of each hart with the value
+ *    the RTL testbenches check for and sets the exit status.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cache_model.h"
+#include "hart.h"
+#include "platform.h"
+
+using namespace trireme;
+
+namespace {
+
+void usage(const char *program) {
+  std::fprintf(stderr,
+    "Usage: %s [options] program.vmh\n"
+    "\n"
+    "Options:\n"
+    "  --xlen 32|64            register width (default 32)\n"
+    "  --harts N               number of harts (default 1)\n"
+    "  --reset-pc ADDR         reset PC of hart 0 (default 0)\n"
+    "  --reset-pc-stride N     reset PC distance between harts, like RESET_PC(i*16)\n"
+    "                          in seven_stage_multicore_top (default 16)\n"
+    "  --ram-bytes N           size of the RAM window at address 0 (default 4 MiB)\n"
+    "  --no-mmio               do not map the UART, timer and software interrupt\n"
+    "                          register of seven_stage_priv_BRAM_top\n"
+    "  --uart-in FILE          bytes returned by the UART RX register\n"
+    "  --cache                 attach the two_level_cache_hierarchy model\n"
+    "  --param NAME=VALUE      cache hierarchy parameter, e.g. INDEX_BITS_L1=6,\n"
+    "                          NUMBER_OF_WAYS_L2=8 or MEMORY_LATENCY=30\n"
+    "  --timing NAME=VALUE     pipeline timing: load_use_penalty, jal_penalty,\n"
+    "                          branch_penalty, trap_penalty, mul_latency, div_latency\n"
+    "  --end-pc ADDR           stop a hart when it reaches ADDR\n"
+    "  --max-instructions N    stop after N instructions in total\n"
+    "  --expect-s1 V[,V...]    expected s1 value of each hart\n"
+    "  --dump-regs             print all registers at the end\n"
+    "  --quiet                 only print mismatches and errors\n",
+    program);
+}
+
+bool parse_number(const std::string &text, uint64_t &value) {
+  if(text.empty())
+    return false;
+  char *end = nullptr;
+  value = std::strtoull(text.c_str(), &end, 0);
+  return *end == '\0';
+}
+
+bool parse_assignment(const std::string &text, std::string &name,
+                      unsigned &value) {
+  std::size_t equals = text.find('=');
+  uint64_t number;
+  if(equals == std::string::npos || !parse_number(text.substr(equals + 1), number))
+    return false;
+  name  = text.substr(0, equals);
+  value = static_cast<unsigned>(number);
+  return true;
+}
+
+const char *ABI_NAMES[32] = {
+  "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2", "s0", "s1", "a0", "a1",
+  "a2", "a3", "a4", "a5", "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+  "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  PlatformConfig platform_config;
+  CacheHierarchyConfig cache_config;
+  TimingConfig timing;
+  uint64_t harts = 1;
+  uint64_t reset_pc = 0;
+  uint64_t reset_pc_stride = 16;
+  uint64_t max_instructions = 0;
+  uint64_t end_pc = 0;
+  bool use_end_pc = false;
+  bool use_cache = false;
+  bool dump_regs = false;
+  bool quiet = false;
+  std::vector<uint64_t> expected_s1;
+  std::string program;
+
+  for(int i=1; i<argc; i++) {
+    std::string arg = argv[i];
+    auto next = [&](std::string &value) {
+      if(i + 1 >= argc) {
+        std::fprintf(stderr, "%s needs a value\n", arg.c_str());
+        std::exit(2);
+      }
+      value = argv[++i];
+    };
+    auto next_number = [&](uint64_t &value) {
+      std::string text;
+      next(text);
+      if(!parse_number(text, value)) {
+        std::fprintf(stderr, "%s: \"%s\" is not a number\n", arg.c_str(),
+                     text.c_str());
+        std::exit(2);
+      }
+    };
+    std::string text;
+    std::string name;
+    unsigned value;
+    uint64_t number;
+    if(arg == "--xlen") {
+      next_number(number);
+      if(number != 32 && number != 64) {
+        std::fprintf(stderr, "--xlen must be 32 or 64\n");
+        return 2;
+      }
+      platform_config.xlen = static_cast<int>(number);
+    }
+    else if(arg == "--harts")             next_number(harts);
+    else if(arg == "--reset-pc")          next_number(reset_pc);
+    else if(arg == "--reset-pc-stride")   next_number(reset_pc_stride);
+    else if(arg == "--ram-bytes")         next_number(platform_config.ram_bytes);
+    else if(arg == "--no-mmio")           platform_config.mmio = false;
+    else if(arg == "--uart-in")           next(platform_config.uart_input);
+    else if(arg == "--cache")             use_cache = true;
+    else if(arg == "--max-instructions")  next_number(max_instructions);
+    else if(arg == "--dump-regs")         dump_regs = true;
+    else if(arg == "--quiet")             quiet = true;
+    else if(arg == "--end-pc") {
+      next_number(end_pc);
+      use_end_pc = true;
+    }
+    else if(arg == "--param") {
+      next(text);
+      if(!parse_assignment(text, name, value) || !cache_config.set(name, value)) {
+        std::fprintf(stderr, "--param: bad cache parameter \"%s\"\n", text.c_str());
+        return 2;
+      }
+    }
+    else if(arg == "--timing") {
+      next(text);
+      if(!parse_assignment(text, name, value) || !timing.set(name, value)) {
+        std::fprintf(stderr, "--timing: bad timing parameter \"%s\"\n", text.c_str());
+        return 2;
+      }
+    }
+    else if(arg == "--expect-s1") {
+      next(text);
+      std::size_t start = 0;
+      while(start <= text.size()) {
+        std::size_t comma = text.find(',', start);
+        std::string item = text.substr(start, comma == std::string::npos ?
+                                              std::string::npos : comma - start);
+        if(!parse_number(item, number)) {
+          std::fprintf(stderr, "--expect-s1: \"%s\" is not a number\n", item.c_str());
+          return 2;
+        }
+        expected_s1.push_back(number);
+        if(comma == std::string::npos)
+          break;
+        start = comma + 1;
+      }
+    }
+    else if(arg == "-h" || arg == "--help") {
+      usage(argv[0]);
+      return 0;
+    }
+    else if(!arg.empty() && arg[0] == '-') {
+      std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+      usage(argv[0]);
+      return 2;
+    }
+    else {
+      program = arg;
+    }
+  }
+
+  if(program.empty() || harts == 0) {
+    usage(argv[0]);
+    return 2;
+  }
+  if(!expected_s1.empty() && expected_s1.size() != harts) {
+    std::fprintf(stderr, "--expect-s1 needs one value per hart\n");
+    return 2;
+  }
+
+  Platform platform(platform_config);
+  std::string error;
+  if(!platform.load_vmh(program, error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 2;
+  }
+
+  std::unique_ptr<CacheHierarchyModel> caches;
+  if(use_cache)
+    caches.reset(new CacheHierarchyModel(cache_config, harts));
+
+  std::vector<std::unique_ptr<Hart>> cores;
+  for(uint64_t i=0; i<harts; i++) {
+    HartConfig config;
+    config.hart_id  = static_cast<unsigned>(i);
+    config.xlen     = platform_config.xlen;
+    config.reset_pc = reset_pc + i*reset_pc_stride;
+    config.timing   = timing;
+    cores.emplace_back(new Hart(config, platform, caches.get()));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  uint64_t executed = 0;
+  bool limit_reached = false;
+  if(harts == 1) {
+    Hart &hart = *cores[0];
+    while(hart.status() == Hart::RUNNING) {
+      if(use_end_pc && hart.pc() == end_pc) {
+        hart.stop("reached the end PC");
+        break;
+      }
+      platform.set_time(hart.cycles());
+      hart.step();
+      if(max_instructions && ++executed >= max_instructions) {
+        limit_reached = true;
+        break;
+      }
+    }
+  }
+  else {
+    for(;;) {
+      Hart *next = nullptr;
+      for(auto &hart : cores) {
+        if(hart->status() == Hart::RUNNING &&
+           (!next || hart->cycles() < next->cycles()))
+          next = hart.get();
+      }
+      if(!next)
+        break;
+      if(use_end_pc && next->pc() == end_pc) {
+        next->stop("reached the end PC");
+        continue;
+      }
+      platform.set_time(next->cycles());
+      next->step();
+      if(max_instructions && ++executed >= max_instructions) {
+        limit_reached = true;
+        break;
+      }
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::fflush(stdout);
+
+  int exit_status = 0;
+  uint64_t total_instructions = 0;
+  int digits = platform_config.xlen/4;
+  for(auto &hart : cores) {
+    total_instructions += hart->instret();
+    const char *state = hart->status() == Hart::HALTED  ? "halted"  :
+                        hart->status() == Hart::STOPPED ? "stopped" :
+                                                          "running";
+    if(!quiet) {
+      std::fprintf(stderr,
+        "hart %u: %s at PC 0x%0*llx after %llu instructions, %llu cycles "
+        "(CPI %.2f), %llu traps\n",
+        hart->hart_id(), state, digits, (unsigned long long)hart->pc(),
+        (unsigned long long)hart->instret(), (unsigned long long)hart->cycles(),
+        hart->instret() ? double(hart->cycles())/hart->instret() : 0.0,
+        (unsigned long long)hart->traps());
+      std::fprintf(stderr, "hart %u: s1 = 0x%0*llx\n", hart->hart_id(), digits,
+                   (unsigned long long)hart->reg(9));
+    }
+    if(hart->status() == Hart::STOPPED && !hart->message().empty() &&
+       hart->message() != "reached the end PC") {
+      std::fprintf(stderr, "hart %u: %s\n", hart->hart_id(),
+                   hart->message().c_str());
+      exit_status = 1;
+    }
+    if(dump_regs) {
+      for(unsigned r=0; r<32; r++)
+        std::fprintf(stderr, "  x%-2u %-4s 0x%0*llx%s", r, ABI_NAMES[r], digits,
+                     (unsigned long long)hart->reg(r), r % 4 == 3 ? "\n" : "  ");
+    }
+    if(!expected_s1.empty()) {
+      uint64_t expected = expected_s1[hart->hart_id()];
+      if(hart->reg(9) != expected || hart->status() != Hart::HALTED) {
+        std::fprintf(stderr, "hart %u: FAILED, expected s1 = 0x%llx and a halted hart\n",
+                     hart->hart_id(), (unsigned long long)expected);
+        exit_status = 1;
+      }
+    }
+  }
+  if(limit_reached && !quiet)
+    std::fprintf(stderr, "stopped after --max-instructions %llu\n",
+                 (unsigned long long)max_instructions);
+  if(platform.unmapped_accesses())
+    std::fprintf(stderr, "warning: %llu accesses outside of RAM and devices\n",
+                 (unsigned long long)platform.unmapped_accesses());
+  if(caches && !quiet)
+    caches->report(stderr);
+  if(!quiet) {
+    double seconds = elapsed.count();
+    std::fprintf(stderr, "%llu instructions in %.3f s (%.1f MIPS)\n",
+                 (unsigned long long)total_instructions, seconds,
+                 seconds > 0 ? total_instructions/seconds/1e6 : 0.0);
+  }
+  if(!expected_s1.empty() && exit_status == 0 && !quiet)
+    std::fprintf(stderr, "PASSED\n");
+  return exit_status;
+}